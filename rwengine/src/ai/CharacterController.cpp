@@ -54,6 +54,11 @@ void CharacterController::skipActivity() {
         setActivity(nullptr);
 }
 
+void CharacterController::clearActivities() {
+    _currentActivity = nullptr;
+    _nextActivity = nullptr;
+}
+
 void CharacterController::setNextActivity(std::unique_ptr<Activity> activity) {
     if (_currentActivity == nullptr) {
         setActivity(std::move(activity));
@@ -51,7 +51,11 @@ public:
         /**
          * Wander randomly around the map
          */
-        TrafficWander
+        TrafficWander,
+        /**
+         * Follow the path graph to a destination
+         */
+        FollowRoute
     };
 
 protected:
@@ -101,6 +105,12 @@ public:
      */
     void skipActivity();
 
+    /**
+     * @brief clearActivities Drops the current and next activities, even if
+     * they can't be skipped.
+     */
+    void clearActivities();
+
     /**
      * @brief setNextActivity Sets the next Activity with a parameter.
      * @param activity
@@ -0,0 +1,148 @@
+#include "ai/CrowdSimulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float CrowdSimulation::kSeparationRadius;
+constexpr float CrowdSimulation::kSeparationSpeed;
+
+void CrowdSimulation::clear() {
+    agentX.clear();
+    agentY.clear();
+    velocityX.clear();
+    velocityY.clear();
+    obstacleX.clear();
+    obstacleY.clear();
+}
+
+size_t CrowdSimulation::addAgent(const glm::vec2& position,
+                                 const glm::vec2& velocity) {
+    agentX.push_back(position.x);
+    agentY.push_back(position.y);
+    velocityX.push_back(velocity.x);
+    velocityY.push_back(velocity.y);
+    return agentX.size() - 1;
+}
+
+void CrowdSimulation::addObstacle(const glm::vec2& position) {
+    obstacleX.push_back(position.x);
+    obstacleY.push_back(position.y);
+}
+
+uint32_t CrowdSimulation::cellHash(int x, int y) const {
+    return (uint32_t(x) * 73856093u ^ uint32_t(y) * 19349663u) & cellMask;
+}
+
+void CrowdSimulation::buildGrid() {
+    const size_t agents = agentX.size();
+    const size_t total = agents + obstacleX.size();
+
+    // Twice as many cells as entries keeps collisions rare
+    uint32_t cells = 1;
+    while (cells < total * 2) {
+        cells <<= 1;
+    }
+    cellMask = cells - 1;
+
+    auto cellOf = [&](size_t i) {
+        const float x = i < agents ? agentX[i] : obstacleX[i - agents];
+        const float y = i < agents ? agentY[i] : obstacleY[i - agents];
+        return cellHash(int(std::floor(x / kSeparationRadius)),
+                        int(std::floor(y / kSeparationRadius)));
+    };
+
+    // Counting sort by cell
+    cellStart.assign(cells + 1, 0);
+    for (size_t i = 0; i < total; ++i) {
+        cellStart[cellOf(i) + 1]++;
+    }
+    for (uint32_t c = 0; c < cells; ++c) {
+        cellStart[c + 1] += cellStart[c];
+    }
+    entries.resize(total);
+    entryX.resize(total);
+    entryY.resize(total);
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < total; ++i) {
+        const auto e = fill[cellOf(i)]++;
+        entries[e] = uint32_t(i);
+        entryX[e] = i < agents ? agentX[i] : obstacleX[i - agents];
+        entryY[e] = i < agents ? agentY[i] : obstacleY[i - agents];
+    }
+}
+
+void CrowdSimulation::separate() {
+    const size_t agents = agentX.size();
+    const float radius2 = kSeparationRadius * kSeparationRadius;
+
+    for (size_t i = 0; i < agents; ++i) {
+        const float x = agentX[i];
+        const float y = agentY[i];
+        const int cx = int(std::floor(x / kSeparationRadius));
+        const int cy = int(std::floor(y / kSeparationRadius));
+
+        // Neighbouring cells can share a hash, only visit each once
+        uint32_t visited[9];
+        size_t visitedCount = 0;
+        glm::vec2 push{};
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                const auto cell = cellHash(cx + dx, cy + dy);
+                if (std::find(visited, visited + visitedCount, cell) !=
+                    visited + visitedCount) {
+                    continue;
+                }
+                visited[visitedCount++] = cell;
+
+                for (auto e = cellStart[cell]; e < cellStart[cell + 1]; ++e) {
+                    const auto j = entries[e];
+                    if (j == i) {
+                        continue;
+                    }
+                    const glm::vec2 d(x - entryX[e], y - entryY[e]);
+                    const float d2 = glm::dot(d, d);
+                    if (d2 >= radius2) {
+                        continue;
+                    }
+                    if (d2 <= 0.f) {
+                        // Standing on each other, split them deterministically
+                        push.x += j > i ? -1.f : 1.f;
+                        continue;
+                    }
+                    const float distance = std::sqrt(d2);
+                    push += d / distance * (1.f - distance / kSeparationRadius);
+                }
+            }
+        }
+
+        const float length = glm::length(push);
+        if (length > 1.f) {
+            push /= length;
+        }
+        pushX[i] = push.x * kSeparationSpeed;
+        pushY[i] = push.y * kSeparationSpeed;
+    }
+}
+
+void CrowdSimulation::step(float dt) {
+    const size_t agents = agentX.size();
+    pushX.resize(agents);
+    pushY.resize(agents);
+    if (agents == 0) {
+        return;
+    }
+
+    buildGrid();
+    separate();
+
+    float* x = agentX.data();
+    float* y = agentY.data();
+    const float* vx = velocityX.data();
+    const float* vy = velocityY.data();
+    const float* px = pushX.data();
+    const float* py = pushY.data();
+    for (size_t i = 0; i < agents; ++i) {
+        x[i] += (vx[i] + px[i]) * dt;
+        y[i] += (vy[i] + py[i]) * dt;
+    }
+}
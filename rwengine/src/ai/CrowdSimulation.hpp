@@ -0,0 +1,76 @@
+#ifndef _RWENGINE_CROWDSIMULATION_HPP_
+#define _RWENGINE_CROWDSIMULATION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Moves many pedestrians at once without the physics engine
+ *
+ * Agents and obstacles are added for every step, agents with the velocity
+ * they want to walk at. Each agent is pushed away from everything within
+ * kSeparationRadius, found through a uniform grid, then all agents are moved
+ * in one pass. Only the ground plane is simulated, heights are left to the
+ * caller.
+ */
+class CrowdSimulation {
+public:
+    /// Agents closer than this push each other apart
+    static constexpr float kSeparationRadius = 1.f;
+    /// Fastest an agent is pushed aside, in m/s
+    static constexpr float kSeparationSpeed = 1.5f;
+
+    /// Removes every agent and obstacle
+    void clear();
+
+    /// Adds an agent and returns its index
+    size_t addAgent(const glm::vec2& position, const glm::vec2& velocity);
+
+    /// Adds something agents keep away from that doesn't move
+    void addObstacle(const glm::vec2& position);
+
+    /// Separates and moves every agent
+    void step(float dt);
+
+    glm::vec2 getPosition(size_t agent) const {
+        return {agentX[agent], agentY[agent]};
+    }
+
+    size_t getAgentCount() const {
+        return agentX.size();
+    }
+
+    size_t getObstacleCount() const {
+        return obstacleX.size();
+    }
+
+private:
+    void buildGrid();
+    void separate();
+
+    uint32_t cellHash(int x, int y) const;
+
+    // Agents, stored as separate arrays so integration vectorizes
+    std::vector<float> agentX;
+    std::vector<float> agentY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> pushX;
+    std::vector<float> pushY;
+
+    std::vector<float> obstacleX;
+    std::vector<float> obstacleY;
+
+    // Agents then obstacles sorted by grid cell, with their positions.
+    // cellStart indexes entries
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> entries;
+    std::vector<float> entryX;
+    std::vector<float> entryY;
+    uint32_t cellMask = 0;
+};
+
+#endif
@@ -64,11 +64,13 @@ void DefaultAIController::update(float dt) {
                 if (glm::length(targetDistance) <= 0.1f) {
                     // Assign the next target node
                     auto lastTarget = targetNode;
-                    std::random_device rd;
-                    std::default_random_engine re(rd());
-                    std::uniform_int_distribution<> d(
+                    if (lastTarget->connections.empty()) {
+                        break;
+                    }
+                    std::uniform_int_distribution<size_t> d(
                         0, lastTarget->connections.size() - 1);
-                    targetNode = lastTarget->connections.at(d(re));
+                    targetNode = lastTarget->connections.at(
+                        d(getCharacter()->engine->randomEngine));
                     setNextActivity(std::make_unique<Activities::GoTo>(
                         targetNode->position));
                 } else if (getCurrentActivity() == nullptr) {
@@ -91,9 +93,58 @@ void DefaultAIController::update(float dt) {
                 targetNode = node;
             }
         } break;
+        case FollowRoute:
+            updateRoute();
+            break;
         default:
             break;
     }
 
     CharacterController::update(dt);
 }
+
+void DefaultAIController::setDestination(const glm::vec3& target) {
+    auto& planner = getCharacter()->engine->routePlanner;
+    planner.cancelRoute(routeQuery);
+
+    const auto type = getCharacter()->getCurrentVehicle()
+                          ? AIGraphNode::Vehicle
+                          : AIGraphNode::Pedestrian;
+    destination = target;
+    route = nullptr;
+    routeIndex = 0;
+    routeQuery = planner.requestRoute(
+        planner.findNearestNode(getCharacter()->getPosition(), type),
+        planner.findNearestNode(target, type), type);
+    setGoal(FollowRoute);
+}
+
+void DefaultAIController::updateRoute() {
+    auto& planner = getCharacter()->engine->routePlanner;
+    if (routeQuery != 0) {
+        auto status = planner.collectRoute(routeQuery, route);
+        if (status == RoutePlanner::QueryStatus::Pending) {
+            return;
+        }
+        routeQuery = 0;
+        if (!route) {
+            // No way there along the paths
+            setGoal(None);
+            return;
+        }
+    }
+
+    if (getCurrentActivity() != nullptr || getNextActivity() != nullptr) {
+        return;
+    }
+
+    if (route && routeIndex < route->size()) {
+        setNextActivity(std::make_unique<Activities::GoTo>(
+            (*route)[routeIndex++]->position));
+    } else {
+        // Leave the path for the last stretch
+        setNextActivity(std::make_unique<Activities::GoTo>(destination));
+        route = nullptr;
+        setGoal(None);
+    }
+}
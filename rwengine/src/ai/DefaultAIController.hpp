@@ -1,11 +1,21 @@
 #ifndef _RWENGINE_DEFAULTAICONTROLLER_HPP_
 #define _RWENGINE_DEFAULTAICONTROLLER_HPP_
 #include <glm/glm.hpp>
+#include <cstddef>
+
 #include <ai/CharacterController.hpp>
+#include <ai/RoutePlanner.hpp>
 
 class DefaultAIController : public CharacterController {
     glm::vec3 gotoPos{};
 
+    glm::vec3 destination{};
+    RoutePlanner::QueryID routeQuery = 0;
+    RoutePlanner::RoutePtr route;
+    size_t routeIndex = 0;
+
+    void updateRoute();
+
 public:
     DefaultAIController()
         : CharacterController() {
@@ -14,6 +24,11 @@ public:
     glm::vec3 getTargetPosition() override;
 
     void update(float dt) override;
+
+    /**
+     * Requests a route to destination and sets the FollowRoute goal
+     */
+    void setDestination(const glm::vec3& destination);
 };
 
 #endif
@@ -0,0 +1,336 @@
+#include "ai/RoutePlanner.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtx/norm.hpp>
+
+#include "ai/AIGraph.hpp"
+
+constexpr size_t RoutePlanner::kDefaultCacheCapacity;
+constexpr size_t RoutePlanner::kDefaultUpdateBudget;
+constexpr uint32_t RoutePlanner::kNoNode;
+
+size_t RoutePlanner::KeyHash::operator()(const Key& k) const {
+    size_t h = k.start;
+    h = h * 31 + k.goal;
+    h = h * 31 + static_cast<size_t>(k.type);
+    return h;
+}
+
+RoutePlanner::RoutePlanner(const AIGraph& graph, size_t cacheCapacity)
+    : graph(graph), cacheCapacity(cacheCapacity) {
+}
+
+void RoutePlanner::invalidate() {
+    dirty = true;
+}
+
+void RoutePlanner::ensureBuilt() {
+    if (dirty || nodes.size() != graph.nodes.size()) {
+        rebuild();
+    }
+}
+
+void RoutePlanner::rebuild() {
+    dirty = false;
+
+    nodes = graph.nodes;
+    const size_t count = nodes.size();
+
+    indices.clear();
+    indices.reserve(count);
+    positions.resize(count);
+    for (auto& p : passable) {
+        p.assign(count, 0);
+    }
+    for (uint32_t n = 0; n < count; ++n) {
+        const AIGraphNode* node = nodes[n];
+        indices.emplace(node, n);
+        positions[n] = node->position;
+        if (!node->disabled) {
+            passable[node->type][n] = 1;
+        }
+    }
+
+    edgeStart.assign(count + 1, 0);
+    edges.clear();
+    edgeCosts.clear();
+    for (uint32_t n = 0; n < count; ++n) {
+        edgeStart[n] = static_cast<uint32_t>(edges.size());
+        for (const AIGraphNode* next : nodes[n]->connections) {
+            auto it = indices.find(next);
+            if (it == indices.end()) {
+                continue;
+            }
+            edges.push_back(it->second);
+            edgeCosts.push_back(
+                glm::distance(positions[n], positions[it->second]));
+        }
+    }
+    edgeStart[count] = static_cast<uint32_t>(edges.size());
+
+    for (Search* search : {&immediate, &sliced}) {
+        search->cost.resize(count);
+        search->parent.resize(count);
+        search->seen.assign(count, 0);
+        search->closed.assign(count, 0);
+        search->generation = 0;
+    }
+
+    // Node indices may have changed, so cached routes can't be trusted and a
+    // search in progress has to start again
+    cacheEntries.clear();
+    cacheIndex.clear();
+    if (sliced.active) {
+        beginSearch(sliced, sliced.key);
+    }
+}
+
+bool RoutePlanner::makeKey(AIGraphNode* start, AIGraphNode* goal,
+                           AIGraphNode::NodeType type, Key& key) {
+    if (!start || !goal || start->type != type || goal->type != type) {
+        return false;
+    }
+    auto s = indices.find(start);
+    auto g = indices.find(goal);
+    if (s == indices.end() || g == indices.end()) {
+        return false;
+    }
+    key = {s->second, g->second, type};
+    return true;
+}
+
+RoutePlanner::RoutePtr RoutePlanner::findRoute(AIGraphNode* start,
+                                               AIGraphNode* goal,
+                                               AIGraphNode::NodeType type) {
+    ensureBuilt();
+
+    Key key;
+    if (!makeKey(start, goal, type, key)) {
+        return nullptr;
+    }
+
+    RoutePtr route;
+    if (findCached(key, route)) {
+        return route;
+    }
+
+    beginSearch(immediate, key);
+    size_t budget = std::numeric_limits<size_t>::max();
+    stepSearch(immediate, budget, route);
+    cacheRoute(key, route);
+    return route;
+}
+
+RoutePlanner::QueryID RoutePlanner::requestRoute(AIGraphNode* start,
+                                                 AIGraphNode* goal,
+                                                 AIGraphNode::NodeType type) {
+    ensureBuilt();
+
+    const QueryID id = nextID++;
+    Key key;
+    if (!makeKey(start, goal, type, key)) {
+        finished.emplace(id, nullptr);
+    } else {
+        requests.push_back({id, key});
+    }
+    return id;
+}
+
+void RoutePlanner::update(size_t budget) {
+    if (requests.empty() && !sliced.active) {
+        return;
+    }
+
+    ensureBuilt();
+
+    while (budget > 0) {
+        if (!sliced.active) {
+            if (requests.empty()) {
+                return;
+            }
+            auto request = requests.front();
+            requests.pop_front();
+
+            RoutePtr route;
+            if (findCached(request.key, route)) {
+                finished.emplace(request.id, route);
+                continue;
+            }
+            slicedID = request.id;
+            beginSearch(sliced, request.key);
+        }
+
+        RoutePtr route;
+        if (stepSearch(sliced, budget, route)) {
+            cacheRoute(sliced.key, route);
+            finished.emplace(slicedID, route);
+        }
+    }
+}
+
+RoutePlanner::QueryStatus RoutePlanner::collectRoute(QueryID id,
+                                                     RoutePtr& route) {
+    auto it = finished.find(id);
+    if (it != finished.end()) {
+        route = it->second;
+        finished.erase(it);
+        return QueryStatus::Done;
+    }
+
+    if (sliced.active && slicedID == id) {
+        return QueryStatus::Pending;
+    }
+    for (const auto& request : requests) {
+        if (request.id == id) {
+            return QueryStatus::Pending;
+        }
+    }
+    return QueryStatus::Unknown;
+}
+
+void RoutePlanner::cancelRoute(QueryID id) {
+    finished.erase(id);
+    if (sliced.active && slicedID == id) {
+        sliced.active = false;
+    }
+    requests.erase(std::remove_if(requests.begin(), requests.end(),
+                                  [&](const Request& r) { return r.id == id; }),
+                   requests.end());
+}
+
+AIGraphNode* RoutePlanner::findNearestNode(const glm::vec3& position,
+                                           AIGraphNode::NodeType type) {
+    ensureBuilt();
+
+    AIGraphNode* nearest = nullptr;
+    float nearestDistance = std::numeric_limits<float>::max();
+    const auto& usable = passable[type];
+    for (size_t n = 0; n < positions.size(); ++n) {
+        if (!usable[n]) {
+            continue;
+        }
+        float d = glm::distance2(position, positions[n]);
+        if (d < nearestDistance) {
+            nearestDistance = d;
+            nearest = nodes[n];
+        }
+    }
+    return nearest;
+}
+
+void RoutePlanner::beginSearch(Search& search, const Key& key) {
+    search.key = key;
+    search.active = true;
+    search.open.clear();
+
+    // Stamps make clearing the per-node arrays unnecessary
+    if (++search.generation == 0) {
+        std::fill(search.seen.begin(), search.seen.end(), 0);
+        std::fill(search.closed.begin(), search.closed.end(), 0);
+        search.generation = 1;
+    }
+
+    search.cost[key.start] = 0.f;
+    search.parent[key.start] = kNoNode;
+    search.seen[key.start] = search.generation;
+    search.open.push_back(
+        {glm::distance(positions[key.start], positions[key.goal]), key.start});
+}
+
+bool RoutePlanner::stepSearch(Search& search, size_t& budget,
+                              RoutePtr& route) {
+    const auto& usable = passable[search.key.type];
+    const auto& goalPosition = positions[search.key.goal];
+    const uint32_t generation = search.generation;
+
+    while (!search.open.empty()) {
+        if (budget == 0) {
+            return false;
+        }
+
+        std::pop_heap(search.open.begin(), search.open.end());
+        const uint32_t node = search.open.back().node;
+        search.open.pop_back();
+
+        // Nodes are pushed again when a cheaper path is found, skip the
+        // stale entries
+        if (search.closed[node] == generation) {
+            continue;
+        }
+        search.closed[node] = generation;
+        budget--;
+        expanded++;
+
+        if (node == search.key.goal) {
+            search.active = false;
+            route = buildRoute(search);
+            return true;
+        }
+
+        const float cost = search.cost[node];
+        for (uint32_t e = edgeStart[node]; e < edgeStart[node + 1]; ++e) {
+            const uint32_t next = edges[e];
+            if (!usable[next] || search.closed[next] == generation) {
+                continue;
+            }
+            const float nextCost = cost + edgeCosts[e];
+            if (search.seen[next] == generation &&
+                search.cost[next] <= nextCost) {
+                continue;
+            }
+            search.seen[next] = generation;
+            search.cost[next] = nextCost;
+            search.parent[next] = node;
+            search.open.push_back(
+                {nextCost + glm::distance(positions[next], goalPosition),
+                 next});
+            std::push_heap(search.open.begin(), search.open.end());
+        }
+    }
+
+    // Every reachable node has been expanded
+    search.active = false;
+    route = nullptr;
+    return true;
+}
+
+RoutePlanner::RoutePtr RoutePlanner::buildRoute(const Search& search) const {
+    auto route = std::make_shared<Route>();
+    for (uint32_t n = search.key.goal; n != kNoNode; n = search.parent[n]) {
+        route->push_back(nodes[n]);
+    }
+    std::reverse(route->begin(), route->end());
+    return route;
+}
+
+bool RoutePlanner::findCached(const Key& key, RoutePtr& route) {
+    auto it = cacheIndex.find(key);
+    if (it == cacheIndex.end()) {
+        cacheMisses++;
+        return false;
+    }
+    cacheHits++;
+    cacheEntries.splice(cacheEntries.begin(), cacheEntries, it->second);
+    route = it->second->second;
+    return true;
+}
+
+void RoutePlanner::cacheRoute(const Key& key, const RoutePtr& route) {
+    if (cacheCapacity == 0) {
+        return;
+    }
+    auto it = cacheIndex.find(key);
+    if (it != cacheIndex.end()) {
+        it->second->second = route;
+        cacheEntries.splice(cacheEntries.begin(), cacheEntries, it->second);
+        return;
+    }
+    cacheEntries.emplace_front(key, route);
+    cacheIndex.emplace(key, cacheEntries.begin());
+    while (cacheEntries.size() > cacheCapacity) {
+        cacheIndex.erase(cacheEntries.back().first);
+        cacheEntries.pop_back();
+    }
+}
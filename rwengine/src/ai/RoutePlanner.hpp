@@ -0,0 +1,209 @@
+#ifndef _RWENGINE_ROUTEPLANNER_HPP_
+#define _RWENGINE_ROUTEPLANNER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <ai/AIGraphNode.hpp>
+
+class AIGraph;
+
+/**
+ * @brief Finds shortest routes over an AIGraph with A*
+ *
+ * The graph is flattened into arrays with the connections of each node
+ * stored contiguously, and the search arrays are kept between queries. The
+ * flattened graph is rebuilt when nodes are added, or after invalidate().
+ * Routes only pass through enabled nodes of one type, and are cached by
+ * start, goal and type.
+ *
+ * Routes can be found immediately with findRoute, or requested and then
+ * worked on by update() over several ticks.
+ */
+class RoutePlanner {
+public:
+    using Route = std::vector<AIGraphNode*>;
+    /// nullptr when there is no route
+    using RoutePtr = std::shared_ptr<const Route>;
+    using QueryID = uint32_t;
+
+    enum class QueryStatus {
+        /// Not started or in progress
+        Pending,
+        /// Finished, the route is nullptr if there isn't one
+        Done,
+        /// Never requested, cancelled or already collected
+        Unknown
+    };
+
+    static constexpr size_t kDefaultCacheCapacity = 256;
+    /// Node expansions per update() used by the world each tick
+    static constexpr size_t kDefaultUpdateBudget = 2000;
+
+    explicit RoutePlanner(const AIGraph& graph,
+                          size_t cacheCapacity = kDefaultCacheCapacity);
+
+    /**
+     * Rebuilds the flattened graph before the next query, needed when nodes
+     * are enabled or disabled
+     */
+    void invalidate();
+
+    /**
+     * Returns the shortest route from start to goal, including both
+     */
+    RoutePtr findRoute(AIGraphNode* start, AIGraphNode* goal,
+                       AIGraphNode::NodeType type);
+
+    /**
+     * Queues a route for update() to find, returns the ID to collect it
+     */
+    QueryID requestRoute(AIGraphNode* start, AIGraphNode* goal,
+                         AIGraphNode::NodeType type);
+
+    /**
+     * Works on requested routes, expanding at most budget nodes
+     */
+    void update(size_t budget = kDefaultUpdateBudget);
+
+    /**
+     * Returns the status of a request, and once it's done sets route and
+     * forgets the request
+     */
+    QueryStatus collectRoute(QueryID id, RoutePtr& route);
+
+    void cancelRoute(QueryID id);
+
+    /**
+     * Returns the closest enabled node of type, or nullptr
+     */
+    AIGraphNode* findNearestNode(const glm::vec3& position,
+                                 AIGraphNode::NodeType type);
+
+    size_t getNodeCount() const {
+        return nodes.size();
+    }
+
+    size_t getCacheSize() const {
+        return cacheEntries.size();
+    }
+
+    size_t getCacheHits() const {
+        return cacheHits;
+    }
+
+    size_t getCacheMisses() const {
+        return cacheMisses;
+    }
+
+    /// Nodes expanded by all searches so far
+    size_t getExpandedCount() const {
+        return expanded;
+    }
+
+private:
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    struct Key {
+        uint32_t start;
+        uint32_t goal;
+        AIGraphNode::NodeType type;
+
+        bool operator==(const Key& o) const {
+            return start == o.start && goal == o.goal && type == o.type;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    struct OpenNode {
+        float estimate;
+        uint32_t node;
+
+        /// Orders the heap by lowest estimate first
+        bool operator<(const OpenNode& o) const {
+            return estimate > o.estimate;
+        }
+    };
+
+    /**
+     * Search state, sized to the graph and reused. Entries are only valid
+     * for the search whose generation they are stamped with.
+     */
+    struct Search {
+        std::vector<float> cost;
+        std::vector<uint32_t> parent;
+        std::vector<uint32_t> seen;
+        std::vector<uint32_t> closed;
+        std::vector<OpenNode> open;
+        uint32_t generation = 0;
+        Key key{};
+        bool active = false;
+    };
+
+    struct Request {
+        QueryID id;
+        Key key;
+    };
+
+    void ensureBuilt();
+    void rebuild();
+
+    bool makeKey(AIGraphNode* start, AIGraphNode* goal,
+                 AIGraphNode::NodeType type, Key& key);
+
+    void beginSearch(Search& search, const Key& key);
+
+    /**
+     * Expands nodes until the search finishes or budget runs out, returns
+     * true when finished
+     */
+    bool stepSearch(Search& search, size_t& budget, RoutePtr& route);
+
+    RoutePtr buildRoute(const Search& search) const;
+
+    bool findCached(const Key& key, RoutePtr& route);
+    void cacheRoute(const Key& key, const RoutePtr& route);
+
+    const AIGraph& graph;
+    bool dirty = true;
+
+    // Flattened graph
+    std::vector<AIGraphNode*> nodes;
+    std::vector<glm::vec3> positions;
+    std::vector<uint8_t> passable[2];
+    /// Connections of node n are edges[edgeStart[n]] to edges[edgeStart[n+1]]
+    std::vector<uint32_t> edgeStart;
+    std::vector<uint32_t> edges;
+    std::vector<float> edgeCosts;
+    std::unordered_map<const AIGraphNode*, uint32_t> indices;
+
+    Search immediate;
+    Search sliced;
+    QueryID slicedID = 0;
+    std::deque<Request> requests;
+    std::unordered_map<QueryID, RoutePtr> finished;
+    QueryID nextID = 1;
+
+    size_t cacheCapacity;
+    /// Most recently used first
+    std::list<std::pair<Key, RoutePtr>> cacheEntries;
+    std::unordered_map<Key, std::list<std::pair<Key, RoutePtr>>::iterator,
+                       KeyHash>
+        cacheIndex;
+    size_t cacheHits = 0;
+    size_t cacheMisses = 0;
+    size_t expanded = 0;
+};
+
+#endif
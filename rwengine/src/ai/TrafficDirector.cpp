@@ -22,6 +22,15 @@
 #include <rw_mingw.hpp>
 #endif
 
+constexpr float TrafficDirector::kDefaultPhysicsRadius;
+
+namespace {
+/// Fraction of the physics radius that applies to vehicles off screen
+constexpr float kHiddenPhysicsScale = 0.5f;
+/// Fraction of the switching distance at which vehicles switch back
+constexpr float kPhysicsHysteresis = 0.9f;
+}  // namespace
+
 TrafficDirector::TrafficDirector(AIGraph* g, GameWorld* w)
     : graph(g)
     , world(w)
@@ -99,30 +108,48 @@ std::vector<GameObject*> TrafficDirector::populateNearby(
     float halfRadius2 = std::pow(radius / 2.f, 2.f);
 
     // Spawn vehicles at vehicle generators
+    struct NearbyGenerator {
+        VehicleGenerator* gen;
+        float dist2;
+        RaycastService::Handle ground;
+    };
+    std::vector<NearbyGenerator> nearby;
     auto camera2D = glm::vec2(camera.position);
     for (auto& gen : world->state->vehicleGenerators) {
         /// @todo verify how vehicle generator proximity is determined
         auto gen2D = glm::vec2(gen.position);
         float dist2 = glm::distance2(camera2D, gen2D);
         if (dist2 < radius * radius) {
-            auto position = gen.position;
-            // Check that the on-ground position is not in view
+            // Find the ground under them all at once, spawning asks again
+            // and gets the answer from the cache
+            RaycastService::Handle ground = 0;
             if (gen.position.z < -90.f) {
-                position = world->getGroundAtPosition(position);
+                ground = world->queueGroundProbe(gen.position);
             }
+            nearby.push_back({&gen, dist2, ground});
+        }
+    }
+    world->raycasts->flush(world->jobs);
+
+    for (const auto& near : nearby) {
+        auto& gen = *near.gen;
+        auto position = gen.position;
+        // Check that the on-ground position is not in view
+        if (gen.position.z < -90.f) {
+            position = world->getGroundProbeResult(near.ground, position);
+        }
 
-            if (dist2 <= halfRadius2 &&
-                camera.frustum.intersects(position, 1.f)) {
-                if (!gen.alwaysSpawn) {
-                    // Don't spawn in the view frustum unless we're forced to
-                    continue;
-                }
-            }
-            auto spawned = world->tryToSpawnVehicle(gen);
-            if (spawned) {
-                created.push_back(spawned);
+        if (near.dist2 <= halfRadius2 &&
+            camera.frustum.intersects(position, 1.f)) {
+            if (!gen.alwaysSpawn) {
+                // Don't spawn in the view frustum unless we're forced to
+                continue;
             }
         }
+        auto spawned = world->tryToSpawnVehicle(gen);
+        if (spawned) {
+            created.push_back(spawned);
+        }
     }
 
     auto type = AIGraphNode::Pedestrian;
@@ -182,3 +209,12 @@ void TrafficDirector::setPopulationLimits(int maxPeds, int maxCars) {
     maximumPedestrians = maxPeds;
     maximumCars = maxCars;
 }
+
+bool TrafficDirector::useKinematicSimulation(bool kinematic, float distance,
+                                             bool visible, float radius) {
+    float limit = visible ? radius : radius * kHiddenPhysicsScale;
+    if (kinematic) {
+        limit *= kPhysicsHysteresis;
+    }
+    return distance > limit;
+}
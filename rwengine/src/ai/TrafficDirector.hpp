@@ -12,6 +12,9 @@ class ViewCamera;
 
 class TrafficDirector {
 public:
+    /// Distance within which visible vehicles get full physics
+    static constexpr float kDefaultPhysicsRadius = 60.f;
+
     TrafficDirector(AIGraph* graph, GameWorld* world);
 
     std::vector<AIGraphNode*> findAvailableNodes(AIGraphNode::NodeType type,
@@ -34,6 +37,18 @@ public:
      */
     void setPopulationLimits(int maxPeds, int maxCars);
 
+    /**
+     * Decides if a vehicle should use the cheap kinematic simulation.
+     * Vehicles off screen switch at half the radius, and switching back
+     * happens a little closer so vehicles on the boundary don't flip.
+     * @param kinematic whether the vehicle is kinematic now
+     * @param distance distance from the camera
+     * @param visible whether the vehicle is in the camera's frustum
+     * @param radius distance within which visible vehicles use physics
+     */
+    static bool useKinematicSimulation(bool kinematic, float distance,
+                                       bool visible, float radius);
+
 private:
     AIGraph* graph;
     GameWorld* world;
@@ -0,0 +1,197 @@
+#include "audio/AudioDecoder.hpp"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/avutil.h>
+}
+
+#include <rw/defines.hpp>
+
+// Rename some functions for older libavcodec/ffmpeg versions (e.g. Ubuntu Trusty)
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(55,28,1)
+#define av_frame_alloc  avcodec_alloc_frame
+#define av_frame_free   avcodec_free_frame
+#endif
+
+AudioDecoder::~AudioDecoder() {
+    close();
+}
+
+bool AudioDecoder::open(const std::string& filename) {
+    close();
+
+    // Allocate audio frame
+    frame = av_frame_alloc();
+    if (!frame) {
+        RW_ERROR("Error allocating the audio frame");
+        return false;
+    }
+
+    // Allocate formatting context
+    if (avformat_open_input(&formatContext, filename.c_str(), nullptr,
+                            nullptr) != 0) {
+        RW_ERROR("Error opening audio file (" << filename << ")");
+        close();
+        return false;
+    }
+
+    if (avformat_find_stream_info(formatContext, nullptr) < 0) {
+        RW_ERROR("Error finding audio stream info");
+        close();
+        return false;
+    }
+
+    // Find the audio stream
+    AVCodec* codec = nullptr;
+    streamIndex = av_find_best_stream(formatContext, AVMEDIA_TYPE_AUDIO, -1,
+                                      -1, &codec, 0);
+    if (streamIndex < 0) {
+        RW_ERROR("Could not find any audio stream in the file " << filename);
+        close();
+        return false;
+    }
+
+    AVCodecContext* context = formatContext->streams[streamIndex]->codec;
+    context->codec = codec;
+
+    // Open the codec
+    if (avcodec_open2(context, context->codec, nullptr) != 0) {
+        RW_ERROR("Couldn't open the audio codec context");
+        close();
+        return false;
+    }
+    codecContext = context;
+
+    // Expose audio metadata
+    channels = codecContext->channels;
+    sampleRate = codecContext->sample_rate;
+
+    // OpenAL only supports mono or stereo, so error on more than 2 channels
+    if (channels > 2) {
+        RW_ERROR("Audio has more than two channels");
+        close();
+        return false;
+    }
+
+    // Right now we only support signed 16-bit audio
+    if (codecContext->sample_fmt != AV_SAMPLE_FMT_S16P) {
+        RW_ERROR("Audio data isn't in a planar signed 16-bit format");
+        close();
+        return false;
+    }
+
+    packet = new AVPacket;
+    av_init_packet(packet);
+    packet->data = nullptr;
+    packet->size = 0;
+    pending = new AVPacket(*packet);
+
+    return true;
+}
+
+void AudioDecoder::close() {
+    if (packet) {
+        if (packet->data) {
+            av_free_packet(packet);
+        }
+        delete packet;
+        packet = nullptr;
+    }
+    delete pending;
+    pending = nullptr;
+
+    if (frame) {
+        av_frame_free(&frame);
+    }
+    if (codecContext) {
+        avcodec_close(codecContext);
+        codecContext = nullptr;
+    }
+    if (formatContext) {
+        avformat_close_input(&formatContext);
+    }
+
+    streamIndex = -1;
+    channels = 0;
+    sampleRate = 0;
+}
+
+bool AudioDecoder::readPacket() {
+    if (packet->data) {
+        av_free_packet(packet);
+        packet->data = nullptr;
+        packet->size = 0;
+    }
+
+    while (av_read_frame(formatContext, packet) == 0) {
+        if (packet->stream_index == streamIndex) {
+            *pending = *packet;
+            return true;
+        }
+        av_free_packet(packet);
+    }
+
+    packet->data = nullptr;
+    packet->size = 0;
+    return false;
+}
+
+bool AudioDecoder::decode(std::vector<int16_t>& out, size_t count) {
+    if (!isOpen()) {
+        return false;
+    }
+
+    const size_t target = out.size() + count;
+    while (out.size() < target) {
+        if (pending->size <= 0 && !readPacket()) {
+            return false;
+        }
+
+        // Decode audio packet
+        int gotFrame = 0;
+        int len =
+            avcodec_decode_audio4(codecContext, frame, &gotFrame, pending);
+
+        if (len < 0 || !gotFrame) {
+            pending->size = 0;
+            pending->data = nullptr;
+            continue;
+        }
+
+        // Interleave the channels into the end of out
+        const auto frameSamples = static_cast<size_t>(frame->nb_samples);
+        const size_t start = out.size();
+        out.resize(start + frameSamples * channels);
+        int16_t* dest = out.data() + start;
+        for (size_t channel = 0; channel < channels; ++channel) {
+            const auto* src =
+                reinterpret_cast<const int16_t*>(frame->data[channel]);
+            for (size_t i = 0; i < frameSamples; ++i) {
+                dest[i * channels + channel] = src[i];
+            }
+        }
+
+        pending->size -= len;
+        pending->data += len;
+    }
+
+    return true;
+}
+
+void AudioDecoder::decodeAll(std::vector<int16_t>& out) {
+    if (!isOpen()) {
+        return;
+    }
+
+    // Reserve from the stream duration so the samples are rarely copied
+    const auto* stream = formatContext->streams[streamIndex];
+    if (stream->duration > 0) {
+        const double seconds = stream->duration * av_q2d(stream->time_base);
+        out.reserve(out.size() +
+                    static_cast<size_t>(seconds * sampleRate * channels));
+    }
+
+    while (decode(out, sampleRate * channels)) {
+    }
+}
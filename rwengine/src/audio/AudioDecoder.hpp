@@ -0,0 +1,73 @@
+#ifndef _RWENGINE_AUDIODECODER_HPP_
+#define _RWENGINE_AUDIODECODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVPacket;
+
+/**
+ * @brief Decodes audio files into interleaved signed 16-bit samples
+ *
+ * Samples are decoded on demand, a packet at a time, so a long file can be
+ * played while it is decoded instead of being held in memory.
+ */
+class AudioDecoder {
+public:
+    AudioDecoder() = default;
+    ~AudioDecoder();
+
+    AudioDecoder(const AudioDecoder&) = delete;
+    AudioDecoder& operator=(const AudioDecoder&) = delete;
+
+    /**
+     * Opens the first audio stream in a file
+     * @return false if the file can't be decoded
+     */
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const {
+        return codecContext != nullptr;
+    }
+
+    size_t getChannels() const {
+        return channels;
+    }
+
+    size_t getSampleRate() const {
+        return sampleRate;
+    }
+
+    /**
+     * Appends at least count samples to out, or fewer if the file ends first
+     * @return false once the end of the file has been reached
+     */
+    bool decode(std::vector<int16_t>& out, size_t count);
+
+    /// Appends every remaining sample to out
+    void decodeAll(std::vector<int16_t>& out);
+
+private:
+    /// Reads the next packet of the audio stream into pending
+    bool readPacket();
+
+    AVFormatContext* formatContext = nullptr;
+    AVCodecContext* codecContext = nullptr;
+    AVFrame* frame = nullptr;
+    /// The packet last read from the file
+    AVPacket* packet = nullptr;
+    /// The part of packet that still has to be decoded
+    AVPacket* pending = nullptr;
+    int streamIndex = -1;
+
+    size_t channels = 0;
+    size_t sampleRate = 0;
+};
+
+#endif
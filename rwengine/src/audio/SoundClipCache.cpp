@@ -0,0 +1,45 @@
+#include "audio/SoundClipCache.hpp"
+
+#include <iterator>
+
+constexpr size_t SoundClipCache::kDefaultCapacity;
+
+SoundClipCache::ClipPtr SoundClipCache::find(const std::string& path) {
+    auto it = index.find(path);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+}
+
+void SoundClipCache::insert(const std::string& path, ClipPtr clip) {
+    auto it = index.find(path);
+    if (it != index.end()) {
+        remove(it->second);
+    }
+
+    if (!clip || clip->getSize() > capacity) {
+        return;
+    }
+
+    while (size + clip->getSize() > capacity) {
+        remove(std::prev(entries.end()));
+    }
+
+    size += clip->getSize();
+    entries.emplace_front(path, std::move(clip));
+    index[path] = entries.begin();
+}
+
+void SoundClipCache::clear() {
+    entries.clear();
+    index.clear();
+    size = 0;
+}
+
+void SoundClipCache::remove(std::list<Entry>::iterator it) {
+    size -= it->second->getSize();
+    index.erase(it->first);
+    entries.erase(it);
+}
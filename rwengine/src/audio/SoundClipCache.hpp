@@ -0,0 +1,79 @@
+#ifndef _RWENGINE_SOUNDCLIPCACHE_HPP_
+#define _RWENGINE_SOUNDCLIPCACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Decoded samples of a short sound
+ */
+struct SoundClip {
+    /// Interleaved signed 16-bit samples
+    std::vector<int16_t> samples;
+    size_t channels = 0;
+    size_t sampleRate = 0;
+
+    size_t getSize() const {
+        return samples.size() * sizeof(int16_t);
+    }
+};
+
+/**
+ * @brief Keeps the most recently used decoded clips, up to a size in bytes
+ *
+ * Mission audio is loaded again every time a mission is started, the cache
+ * saves decoding the same file each time. Clips are shared, so one that is
+ * evicted while still in use stays valid for its users.
+ */
+class SoundClipCache {
+public:
+    using ClipPtr = std::shared_ptr<const SoundClip>;
+
+    static constexpr size_t kDefaultCapacity = 32 * 1024 * 1024;
+
+    explicit SoundClipCache(size_t capacity = kDefaultCapacity)
+        : capacity(capacity) {
+    }
+
+    /// Returns the clip decoded from path, or nullptr if it isn't cached
+    ClipPtr find(const std::string& path);
+
+    /**
+     * Adds a clip, evicting the least recently used clips to make room.
+     * Clips larger than the whole cache are not kept.
+     */
+    void insert(const std::string& path, ClipPtr clip);
+
+    void clear();
+
+    size_t getSize() const {
+        return size;
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    size_t getCount() const {
+        return entries.size();
+    }
+
+private:
+    using Entry = std::pair<std::string, ClipPtr>;
+
+    void remove(std::list<Entry>::iterator it);
+
+    size_t capacity;
+    size_t size = 0;
+    /// Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+#endif
@@ -1,20 +1,14 @@
 #include "audio/SoundManager.hpp"
 
+#include "audio/AudioDecoder.hpp"
 #include "audio/alCheck.hpp"
 
 extern "C" {
-#include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/avutil.h>
 }
-//ab
-#include <rw/defines.hpp>
 
-// Rename some functions for older libavcodec/ffmpeg versions (e.g. Ubuntu Trusty)
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(55,28,1)
-#define av_frame_alloc  avcodec_alloc_frame
-#define av_frame_free   avcodec_free_frame
-#endif
+#include <rw/defines.hpp>
 
 SoundManager::SoundManager() {
     initializeOpenAL();
@@ -22,6 +16,10 @@ SoundManager::SoundManager() {
 }
 
 SoundManager::~SoundManager() {
+    // Sources and buffers have to go before the context
+    streams.clear();
+    sounds.clear();
+
     // De-initialize OpenAL
     if (alContext) {
         alcMakeContextCurrent(nullptr);
@@ -64,113 +62,26 @@ bool SoundManager::initializeAVCodec() {
     return true;
 }
 
-void SoundManager::SoundSource::loadFromFile(const std::string& filename) {
-    // Allocate audio frame
-    AVFrame* frame = av_frame_alloc();
-    if (!frame) {
-        RW_ERROR("Error allocating the audio frame");
-        return;
-    }
-
-    // Allocate formatting context
-    AVFormatContext* formatContext = nullptr;
-    if (avformat_open_input(&formatContext, filename.c_str(), nullptr, nullptr) != 0) {
-        av_frame_free(&frame);
-        RW_ERROR("Error opening audio file (" << filename << ")");
-        return;
-    }
-
-    if (avformat_find_stream_info(formatContext, nullptr) < 0) {
-        av_frame_free(&frame);
-        avformat_close_input(&formatContext);
-        RW_ERROR("Error finding audio stream info");
-        return;
-    }
-
-    // Find the audio stream
-    AVCodec* codec = nullptr;
-    int streamIndex = av_find_best_stream(formatContext, AVMEDIA_TYPE_AUDIO, -1, -1, &codec, 0);
-    if (streamIndex < 0) {
-        av_frame_free(&frame);
-        avformat_close_input(&formatContext);
-        RW_ERROR("Could not find any audio stream in the file " << filename);
-        return;
+SoundClipCache::ClipPtr SoundManager::loadClip(const std::string& fileName) {
+    if (auto clip = clips.find(fileName)) {
+        return clip;
     }
 
-    AVStream* audioStream = formatContext->streams[streamIndex];
-    AVCodecContext* codecContext = audioStream->codec;
-    codecContext->codec = codec;
-
-    // Open the codec
-    if (avcodec_open2(codecContext, codecContext->codec, nullptr) != 0) {
-        av_frame_free(&frame);
-        avformat_close_input(&formatContext);
-        RW_ERROR("Couldn't open the audio codec context");
-        return;
+    AudioDecoder decoder;
+    if (!decoder.open(fileName)) {
+        return nullptr;
     }
 
-    // Expose audio metadata
-    channels = codecContext->channels;
-    sampleRate = codecContext->sample_rate;
-
-    // OpenAL only supports mono or stereo, so error on more than 2 channels
-    if(channels > 2) {
-        RW_ERROR("Audio has more than two channels");
-        av_frame_free(&frame);
-        avcodec_close(codecContext);
-        avformat_close_input(&formatContext);
-        return;
+    auto clip = std::make_shared<SoundClip>();
+    clip->channels = decoder.getChannels();
+    clip->sampleRate = decoder.getSampleRate();
+    decoder.decodeAll(clip->samples);
+    if (clip->samples.empty()) {
+        return nullptr;
     }
 
-    // Right now we only support signed 16-bit audio
-    if(codecContext->sample_fmt != AV_SAMPLE_FMT_S16P) {
-        RW_ERROR("Audio data isn't in a planar signed 16-bit format");
-        av_frame_free(&frame);
-        avcodec_close(codecContext);
-        avformat_close_input(&formatContext);
-        return;
-    }
-
-    // Start reading audio packets
-    AVPacket readingPacket;
-    av_init_packet(&readingPacket);
-
-    while (av_read_frame(formatContext, &readingPacket) == 0) {
-        if (readingPacket.stream_index == audioStream->index) {
-            AVPacket decodingPacket = readingPacket;
-
-            while (decodingPacket.size > 0) {
-                // Decode audio packet
-                int gotFrame = 0;
-                int len = avcodec_decode_audio4(codecContext, frame, &gotFrame, &decodingPacket);
-
-                if (len >= 0 && gotFrame) {
-                    // Write samples to audio buffer
-
-                    for(size_t i = 0; i < static_cast<size_t>(frame->nb_samples); i++) {
-                        // Interleave left/right channels
-                        for(size_t channel = 0; channel < channels; channel++) {
-                            int16_t sample = reinterpret_cast<int16_t *>(frame->data[channel])[i];
-                            data.push_back(sample);
-                        }
-                    }
-
-                    decodingPacket.size -= len;
-                    decodingPacket.data += len;
-                }
-                else {
-                    decodingPacket.size = 0;
-                    decodingPacket.data = nullptr;
-                }
-            }
-        }
-        av_free_packet(&readingPacket);
-    }
-
-    // Cleanup
-    av_frame_free(&frame);
-    avcodec_close(codecContext);
-    avformat_close_input(&formatContext);
+    clips.insert(fileName, clip);
+    return clip;
 }
 
 SoundManager::SoundBuffer::SoundBuffer() {
@@ -184,12 +95,17 @@ SoundManager::SoundBuffer::SoundBuffer() {
     alCheck(alSourcei(source, AL_LOOPING, AL_FALSE));
 }
 
-bool SoundManager::SoundBuffer::bufferData(SoundSource& soundSource) {
+SoundManager::SoundBuffer::~SoundBuffer() {
+    alCheck(alSourceStop(source));
+    alCheck(alSourcei(source, AL_BUFFER, 0));
+    alCheck(alDeleteSources(1, &source));
+    alCheck(alDeleteBuffers(1, &buffer));
+}
+
+bool SoundManager::SoundBuffer::bufferData(const SoundClip& clip) {
     alCheck(alBufferData(
-        buffer, soundSource.channels == 1 ? AL_FORMAT_MONO16
-                                          : AL_FORMAT_STEREO16,
-        &soundSource.data.front(), soundSource.data.size() * sizeof(int16_t),
-        soundSource.sampleRate));
+        buffer, clip.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16,
+        clip.samples.data(), clip.getSize(), clip.sampleRate));
     alCheck(alSourcei(source, AL_BUFFER, buffer));
 
     return true;
@@ -208,31 +124,48 @@ bool SoundManager::loadSound(const std::string& name,
                                        std::forward_as_tuple());
         sound = &emplaced.first->second;
 
-        sound->source.loadFromFile(fileName);
-        sound->isLoaded = sound->buffer.bufferData(sound->source);
+        auto clip = loadClip(fileName);
+        if (!clip) {
+            // Let the caller try another file under the same name
+            sounds.erase(emplaced.first);
+            return false;
+        }
+        sound->isLoaded = sound->buffer.bufferData(*clip);
     }
 
     return sound->isLoaded;
 }
+
+void SoundManager::unloadSound(const std::string& name) {
+    sounds.erase(name);
+}
+
 bool SoundManager::isLoaded(const std::string& name) {
     if (sounds.find(name) != sounds.end()) {
         return sounds[name].isLoaded;
     }
 
-    return false;
+    return streams.find(name) != streams.end();
 }
 void SoundManager::playSound(const std::string& name) {
     if (sounds.find(name) != sounds.end()) {
         alCheck(alSourcePlay(sounds[name].buffer.source));
+    } else if (streams.find(name) != streams.end()) {
+        streams[name]->play();
     }
 }
 void SoundManager::pauseSound(const std::string& name) {
     if (sounds.find(name) != sounds.end()) {
         alCheck(alSourcePause(sounds[name].buffer.source));
+    } else if (streams.find(name) != streams.end()) {
+        streams[name]->pause();
     }
 }
 
 bool SoundManager::isPaused(const std::string& name) {
+    if (streams.find(name) != streams.end()) {
+        return streams[name]->isPaused();
+    }
     if (sounds.find(name) != sounds.end()) {
         ALint sourceState;
         alCheck(alGetSourcei(sounds[name].buffer.source, AL_SOURCE_STATE,
@@ -244,6 +177,9 @@ bool SoundManager::isPaused(const std::string& name) {
 }
 
 bool SoundManager::isPlaying(const std::string& name) {
+    if (streams.find(name) != streams.end()) {
+        return streams[name]->isPlaying();
+    }
     if (sounds.find(name) != sounds.end()) {
         ALint sourceState;
         alCheck(alGetSourcei(sounds[name].buffer.source, AL_SOURCE_STATE,
@@ -260,6 +196,9 @@ void SoundManager::pauseAllSounds() {
             pauseSound(sound.first);
         }
     }
+    for (auto& stream : streams) {
+        stream.second->pause();
+    }
 }
 
 void SoundManager::resumeAllSounds() {
@@ -267,12 +206,17 @@ void SoundManager::resumeAllSounds() {
         if(isPaused(sound.first))
             playSound(sound.first);
     }
+    for (auto& stream : streams) {
+        if (stream.second->isPaused()) {
+            stream.second->play();
+        }
+    }
 }
 
 bool SoundManager::playBackground(const std::string& fileName) {
-    if (this->loadSound(fileName, fileName)) {
+    if (this->loadMusic(fileName, fileName)) {
         backgroundNoise = fileName;
-        this->playSound(fileName);
+        this->playMusic(fileName);
         return true;
     }
 
@@ -281,18 +225,31 @@ bool SoundManager::playBackground(const std::string& fileName) {
 
 bool SoundManager::loadMusic(const std::string& name,
                              const std::string& fileName) {
-    return loadSound(name, fileName);
+    auto stream = std::make_unique<SoundStream>();
+    if (!stream->open(fileName)) {
+        return false;
+    }
+    streams[name] = std::move(stream);
+    return true;
 }
 
 void SoundManager::playMusic(const std::string& name) {
     playSound(name);
 }
 void SoundManager::stopMusic(const std::string& name) {
-    if (sounds.find(name) != sounds.end()) {
+    if (streams.find(name) != streams.end()) {
+        streams.erase(name);
+    } else if (sounds.find(name) != sounds.end()) {
         alCheck(alSourceStop(sounds[name].buffer.source));
     }
 }
 
+void SoundManager::update() {
+    for (auto& stream : streams) {
+        stream.second->update();
+    }
+}
+
 void SoundManager::pause(bool p) {
     if (backgroundNoise.length() > 0) {
         if (p) {
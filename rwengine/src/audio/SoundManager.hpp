@@ -4,18 +4,30 @@
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
-#include <vector>
 
 #include <al.h>
 #include <alc.h>
 
+#include <audio/SoundClipCache.hpp>
+#include <audio/SoundStream.hpp>
+
+/**
+ * @brief Loads and plays sounds and music
+ *
+ * Sounds are decoded in full when they are loaded, through a cache of
+ * decoded clips. Music is streamed while it plays, update() has to be called
+ * every frame to keep it fed.
+ */
 class SoundManager {
 public:
     SoundManager();
     ~SoundManager();
 
     bool loadSound(const std::string& name, const std::string& fileName);
+    /// Releases a sound, its decoded clip may stay in the cache
+    void unloadSound(const std::string& name);
     bool isLoaded(const std::string& name);
     void playSound(const std::string& name);
     void pauseSound(const std::string& name);
@@ -28,33 +40,36 @@ public:
 
     bool playBackground(const std::string& fileName);
 
+    /**
+     * Opens music to be streamed, decoding starts straight away so that it
+     * is ready by the time it is played.
+     */
     bool loadMusic(const std::string& name, const std::string& fileName);
     void playMusic(const std::string& name);
+    /// Stops and releases the music
     void stopMusic(const std::string& name);
 
     void pause(bool p);
 
-private:
-    class SoundSource {
-        friend class SoundManager;
-        friend class SoundBuffer;
-
-    public:
-        void loadFromFile(const std::string& filename);
-
-    private:
-        std::vector<int16_t> data;
+    /// Queues newly decoded music, call once per frame
+    void update();
 
-        size_t channels;
-        size_t sampleRate;
-    };
+    const SoundClipCache& getClipCache() const {
+        return clips;
+    }
 
+private:
     class SoundBuffer {
         friend class SoundManager;
 
     public:
         SoundBuffer();
-        bool bufferData(SoundSource& soundSource);
+        ~SoundBuffer();
+
+        SoundBuffer(const SoundBuffer&) = delete;
+        SoundBuffer& operator=(const SoundBuffer&) = delete;
+
+        bool bufferData(const SoundClip& clip);
 
     private:
         ALuint source;
@@ -62,7 +77,6 @@ private:
     };
 
     struct Sound {
-        SoundSource source;
         SoundBuffer buffer;
         bool isLoaded = false;
     };
@@ -70,10 +84,15 @@ private:
     bool initializeOpenAL();
     bool initializeAVCodec();
 
+    /// Decodes a file, or returns it from the cache
+    SoundClipCache::ClipPtr loadClip(const std::string& fileName);
+
     ALCcontext* alContext = nullptr;
     ALCdevice* alDevice = nullptr;
 
+    SoundClipCache clips;
     std::map<std::string, Sound> sounds;
+    std::map<std::string, std::unique_ptr<SoundStream>> streams;
     std::string backgroundNoise;
 };
 
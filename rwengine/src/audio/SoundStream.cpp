@@ -0,0 +1,170 @@
+#include "audio/SoundStream.hpp"
+
+#include <utility>
+
+#include "audio/alCheck.hpp"
+
+constexpr size_t SoundStream::kBufferCount;
+constexpr size_t SoundStream::kChunkFrames;
+
+SoundStream::SoundStream() {
+    alCheck(alGenSources(1, &source));
+    alCheck(alGenBuffers(kBufferCount, buffers.data()));
+    freeBuffers.assign(buffers.begin(), buffers.end());
+
+    alCheck(alSourcef(source, AL_PITCH, 1));
+    alCheck(alSourcef(source, AL_GAIN, 1));
+    alCheck(alSource3f(source, AL_POSITION, 0, 0, 0));
+    alCheck(alSource3f(source, AL_VELOCITY, 0, 0, 0));
+    alCheck(alSourcei(source, AL_LOOPING, AL_FALSE));
+}
+
+SoundStream::~SoundStream() {
+    stopDecoding();
+    alCheck(alSourceStop(source));
+    alCheck(alSourcei(source, AL_BUFFER, 0));
+    alCheck(alDeleteSources(1, &source));
+    alCheck(alDeleteBuffers(kBufferCount, buffers.data()));
+}
+
+bool SoundStream::open(const std::string& filename) {
+    stop();
+    stopDecoding();
+
+    if (!decoder.open(filename)) {
+        return false;
+    }
+    format = decoder.getChannels() == 1 ? AL_FORMAT_MONO16
+                                        : AL_FORMAT_STEREO16;
+    sampleRate = static_cast<ALsizei>(decoder.getSampleRate());
+
+    running = true;
+    finished = false;
+    worker = std::thread(&SoundStream::decodeThread, this);
+    return true;
+}
+
+void SoundStream::stopDecoding() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    ready.clear();
+    decoder.close();
+}
+
+void SoundStream::decodeThread() {
+    const size_t chunkSamples = kChunkFrames * decoder.getChannels();
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock,
+                      [&] { return !running || ready.size() < kBufferCount; });
+            if (!running) {
+                return;
+            }
+        }
+
+        std::vector<int16_t> chunk;
+        chunk.reserve(chunkSamples);
+        bool more = decoder.decode(chunk, chunkSamples);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!chunk.empty()) {
+            ready.push_back(std::move(chunk));
+        }
+        if (!more) {
+            finished = true;
+            return;
+        }
+    }
+}
+
+void SoundStream::update() {
+    // Reclaim the buffers OpenAL has finished playing
+    ALint processed = 0;
+    alCheck(alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed));
+    while (processed-- > 0) {
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(source, 1, &buffer));
+        freeBuffers.push_back(buffer);
+    }
+
+    bool drained;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!freeBuffers.empty() && !ready.empty() &&
+               uploads.size() < freeBuffers.size()) {
+            uploads.push_back(std::move(ready.front()));
+            ready.pop_front();
+        }
+        drained = finished && ready.empty();
+    }
+    wake.notify_one();
+
+    for (auto& chunk : uploads) {
+        ALuint buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+        alCheck(alBufferData(buffer, format, chunk.data(),
+                             static_cast<ALsizei>(chunk.size() *
+                                                  sizeof(int16_t)),
+                             sampleRate));
+        alCheck(alSourceQueueBuffers(source, 1, &buffer));
+    }
+    uploads.clear();
+
+    if (!playing) {
+        return;
+    }
+
+    // The source stops by itself when it runs out of queued buffers
+    ALint state = getState();
+    if (state != AL_PLAYING && state != AL_PAUSED) {
+        if (freeBuffers.size() < kBufferCount) {
+            alCheck(alSourcePlay(source));
+        } else if (drained) {
+            playing = false;
+        }
+    }
+}
+
+void SoundStream::play() {
+    if (!decoder.isOpen()) {
+        return;
+    }
+    playing = true;
+    if (getState() == AL_PAUSED) {
+        alCheck(alSourcePlay(source));
+        return;
+    }
+    update();
+}
+
+void SoundStream::pause() {
+    if (playing) {
+        alCheck(alSourcePause(source));
+    }
+}
+
+void SoundStream::stop() {
+    playing = false;
+    alCheck(alSourceStop(source));
+}
+
+bool SoundStream::isPlaying() const {
+    return playing && getState() != AL_PAUSED;
+}
+
+bool SoundStream::isPaused() const {
+    return playing && getState() == AL_PAUSED;
+}
+
+ALint SoundStream::getState() const {
+    ALint state;
+    alCheck(alGetSourcei(source, AL_SOURCE_STATE, &state));
+    return state;
+}
@@ -0,0 +1,87 @@
+#ifndef _RWENGINE_SOUNDSTREAM_HPP_
+#define _RWENGINE_SOUNDSTREAM_HPP_
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <al.h>
+
+#include <audio/AudioDecoder.hpp>
+
+/**
+ * @brief Plays a long sound while it is decoded, for music and cutscenes
+ *
+ * A worker thread decodes the file a few chunks ahead of playback, and
+ * update() passes decoded chunks to OpenAL through a small ring of queued
+ * buffers. Only update() and the playback methods touch OpenAL, they must be
+ * called from the thread that owns the OpenAL context.
+ */
+class SoundStream {
+public:
+    /// OpenAL buffers queued on the source
+    static constexpr size_t kBufferCount = 4;
+    /// Samples per channel in each chunk
+    static constexpr size_t kChunkFrames = 16384;
+
+    SoundStream();
+    ~SoundStream();
+
+    SoundStream(const SoundStream&) = delete;
+    SoundStream& operator=(const SoundStream&) = delete;
+
+    /**
+     * Opens the file and starts decoding it in the background
+     * @return false if the file can't be decoded
+     */
+    bool open(const std::string& filename);
+
+    void play();
+    void pause();
+    void stop();
+
+    bool isPlaying() const;
+    bool isPaused() const;
+
+    /**
+     * Queues decoded chunks on the source, and restarts playback if the
+     * decoder fell behind.
+     */
+    void update();
+
+private:
+    void decodeThread();
+    /// Stops the worker and drops anything it decoded
+    void stopDecoding();
+
+    ALint getState() const;
+
+    AudioDecoder decoder;
+    ALenum format = 0;
+    ALsizei sampleRate = 0;
+
+    ALuint source;
+    std::array<ALuint, kBufferCount> buffers;
+    /// Buffers that aren't queued on the source
+    std::vector<ALuint> freeBuffers;
+    std::vector<std::vector<int16_t>> uploads;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    /// Decoded chunks waiting for a buffer, guarded by mutex
+    std::deque<std::vector<int16_t>> ready;
+    bool running = false;
+    bool finished = false;
+
+    /// Set between play() and stop() or the end of the file
+    bool playing = false;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef _RWENGINE_BOUNDEDQUEUE_HPP_
+#define _RWENGINE_BOUNDEDQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Fixed capacity, lock-free, multiple producer queue
+ *
+ * Each cell carries a sequence number that tells producers and the consumer
+ * whether it is free or filled for the current lap of the ring (D. Vyukov's
+ * bounded queue). Producers never block: tryPush fails when the queue is full.
+ * Only one thread may call tryPop at a time.
+ */
+template <class T>
+class BoundedQueue {
+public:
+    /// capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        mask = size - 1;
+        cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t getCapacity() const {
+        return mask + 1;
+    }
+
+    bool tryPush(T&& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(seq) -
+                        static_cast<ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Cell& cell = cells[pos & mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1) <
+            0) {
+            return false;
+        }
+        head.store(pos + 1, std::memory_order_relaxed);
+        value = std::move(cell.value);
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include "core/JobSystem.hpp"
+
+#include <algorithm>
+
+unsigned JobSystem::defaultWorkerCount() {
+    const unsigned threads = std::thread::hardware_concurrency();
+    return threads > 1 ? threads - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerMain, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain,
+                            const RangeFunction& fn) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+
+    Loop current;
+    current.fn = &fn;
+    current.count = count;
+    current.grain = grain;
+    current.chunks = (count + grain - 1) / grain;
+
+    if (workers.empty() || current.chunks == 1) {
+        for (size_t begin = 0; begin < count; begin += grain) {
+            fn(begin, std::min(count, begin + grain));
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        loop = &current;
+        generation++;
+    }
+    wake.notify_all();
+
+    runChunks(current);
+
+    {
+        // Every chunk has been taken, wait for the workers still running one
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+        loop = nullptr;
+    }
+
+    if (current.error) {
+        std::rethrow_exception(current.error);
+    }
+}
+
+void JobSystem::workerMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t seen = 0;
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        if (!loop) {
+            // Woke after the loop had already finished
+            continue;
+        }
+
+        Loop* current = loop;
+        busy++;
+        lock.unlock();
+        runChunks(*current);
+        lock.lock();
+        if (--busy == 0) {
+            done.notify_all();
+        }
+    }
+}
+
+void JobSystem::runChunks(Loop& current) {
+    for (;;) {
+        const size_t chunk = current.next.fetch_add(1);
+        if (chunk >= current.chunks) {
+            return;
+        }
+        const size_t begin = chunk * current.grain;
+        try {
+            (*current.fn)(begin, std::min(current.count, begin + current.grain));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!current.error) {
+                current.error = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef _RWENGINE_JOBSYSTEM_HPP_
+#define _RWENGINE_JOBSYSTEM_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed pool of worker threads for data parallel loops
+ *
+ * parallelFor splits a range into chunks that the workers and the calling
+ * thread take in turn, and returns once every chunk has run. The chunks only
+ * depend on the count and grain, so work recorded per chunk can be replayed
+ * in the same order whatever the number of threads.
+ */
+class JobSystem {
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    /// One less than the hardware threads, the caller is the last one
+    static unsigned defaultWorkerCount();
+
+    explicit JobSystem(unsigned workerCount = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned getWorkerCount() const {
+        return static_cast<unsigned>(workers.size());
+    }
+
+    /**
+     * Calls fn for each chunk [begin, end) of [0, count), at most grain
+     * items long. The first exception thrown by fn is rethrown once all
+     * chunks have finished. Only one thread may call this at a time.
+     */
+    void parallelFor(size_t count, size_t grain, const RangeFunction& fn);
+
+private:
+    struct Loop {
+        const RangeFunction* fn;
+        size_t count;
+        size_t grain;
+        size_t chunks;
+        std::atomic<size_t> next{0};
+        std::exception_ptr error;
+    };
+
+    void workerMain();
+    void runChunks(Loop& loop);
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    Loop* loop = nullptr;
+    uint64_t generation = 0;
+    unsigned busy = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -1,23 +1,143 @@
 #include <core/Logger.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <map>
 
+#include <core/BoundedQueue.hpp>
+
+namespace {
+/// How long the sink thread sleeps when the queue is empty
+constexpr auto kSinkInterval = std::chrono::milliseconds(2);
+}  // namespace
+
+constexpr size_t Logger::kDefaultQueueCapacity;
+
+Logger::Logger(std::initializer_list<MessageReceiver*> initial)
+    : receivers(initial) {
+}
+
+Logger::~Logger() {
+    stopAsync();
+}
+
 void Logger::log(const std::string& component, Logger::MessageSeverity severity,
                  const std::string& message) {
-    LogMessage m{component, severity, message};
+    if (!isEnabled(component, severity)) {
+        return;
+    }
+    dispatch(LogMessage{component, severity, message});
+}
+
+void Logger::dispatch(LogMessage&& message) {
+    // Errors often precede a crash, so they bypass the queue and can't be
+    // dropped. Anything queued before them is still written out first.
+    if (message.severity == Error) {
+        std::lock_guard<std::mutex> lock(receiverMutex);
+        if (queue) {
+            drainQueue();
+        }
+        deliver(message);
+        flushReceivers();
+        return;
+    }
+
+    if (!queue) {
+        std::lock_guard<std::mutex> lock(receiverMutex);
+        deliver(message);
+        return;
+    }
+
+    if (!queue->tryPush(std::move(message))) {
+        dropped++;
+    }
+}
+
+void Logger::deliver(const LogMessage& message) {
+    for (MessageReceiver* r : receivers) {
+        r->messageReceived(message);
+    }
+}
+
+void Logger::drainQueue() {
+    LogMessage message;
+    while (queue->tryPop(message)) {
+        deliver(message);
+    }
+}
 
+void Logger::flushReceivers() {
     for (MessageReceiver* r : receivers) {
-        r->messageReceived(m);
+        r->flush();
+    }
+}
+
+void Logger::sinkThread() {
+    while (sinkRunning) {
+        {
+            std::lock_guard<std::mutex> lock(receiverMutex);
+            drainQueue();
+        }
+        std::unique_lock<std::mutex> lock(sinkMutex);
+        sinkWake.wait_for(lock, kSinkInterval, [&] { return !sinkRunning; });
+    }
+}
+
+void Logger::startAsync(size_t capacity) {
+    if (queue) {
+        return;
+    }
+    queue = std::make_unique<BoundedQueue<LogMessage>>(capacity);
+    sinkRunning = true;
+    sink = std::thread(&Logger::sinkThread, this);
+}
+
+void Logger::stopAsync() {
+    if (!queue) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        sinkRunning = false;
     }
+    sinkWake.notify_one();
+    sink.join();
+
+    std::lock_guard<std::mutex> lock(receiverMutex);
+    drainQueue();
+    queue.reset();
+}
+
+void Logger::flush() {
+    std::lock_guard<std::mutex> lock(receiverMutex);
+    if (queue) {
+        drainQueue();
+    }
+    flushReceivers();
+}
+
+void Logger::setComponentSeverity(const std::string& component,
+                                  MessageSeverity severity) {
+    componentSeverity[component] = severity;
+}
+
+bool Logger::isComponentEnabled(const std::string& component,
+                                MessageSeverity severity) const {
+    auto it = componentSeverity.find(component);
+    if (it != componentSeverity.end()) {
+        return severity >= it->second;
+    }
+    return severity >= minimumSeverity;
 }
 
 void Logger::addReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::mutex> lock(receiverMutex);
     receivers.push_back(out);
 }
 
 void Logger::removeReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::mutex> lock(receiverMutex);
     receivers.erase(std::remove(receivers.begin(), receivers.end(), out),
                     receivers.end());
 }
@@ -47,3 +167,7 @@ void StdOutReceiver::messageReceived(const Logger::LogMessage& message) {
     std::cout << severityStr[message.severity] << " [" << message.component
               << "] " << message.message << std::endl;
 }
+
+void StdOutReceiver::flush() {
+    std::cout.flush();
+}
@@ -1,28 +1,50 @@
 #ifndef _RWENGINE_LOGGER_HPP_
 #define _RWENGINE_LOGGER_HPP_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+template <class T>
+class BoundedQueue;
+
 /**
  * Handles and stores messages from different components
  *
- * Dispatches received messages to logger outputs.
+ * Dispatches received messages to logger outputs. Messages below the
+ * severity set for their component are discarded before they are formatted.
+ *
+ * By default receivers are called on the logging thread. After startAsync()
+ * messages are queued and delivered by a background thread instead. Error
+ * messages never go through the queue: they are delivered on the logging
+ * thread after anything already queued, and receivers are flushed before
+ * log() returns.
  */
 class Logger {
 public:
     enum MessageSeverity { Verbose, Info, Warning, Error };
 
+    static constexpr size_t kDefaultQueueCapacity = 4096;
+
     struct LogMessage {
         /// The component that produced the message
         std::string component;
         /// Severity of the message.
-        MessageSeverity severity;
+        MessageSeverity severity = Info;
         /// Logged message
         std::string message;
 
+        LogMessage() = default;
+
         template <class String1, class String2>
         LogMessage(String1&& cc, MessageSeverity ss,
                    String2&& mm)
@@ -36,32 +58,153 @@ public:
      * Interface for handling logged messages.
      *
      * The Logger class will not clean up allocated MessageReceivers.
+     * Receivers are never called from more than one thread at a time.
      */
     struct MessageReceiver {
         virtual void messageReceived(const LogMessage&) = 0;
+        /// Writes out anything the receiver buffers
+        virtual void flush() {
+        }
     };
 
-    Logger(std::initializer_list<MessageReceiver*> initial = {})
-        : receivers(initial) {
-    }
+    Logger(std::initializer_list<MessageReceiver*> initial = {});
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
 
     void addReceiver(MessageReceiver* out);
     void removeReceiver(MessageReceiver* out);
 
+    /**
+     * Sets the lowest severity that is logged for components without their
+     * own setting.
+     */
+    void setMinimumSeverity(MessageSeverity severity) {
+        minimumSeverity = severity;
+    }
+
+    MessageSeverity getMinimumSeverity() const {
+        return minimumSeverity;
+    }
+
+    /**
+     * Overrides the minimum severity for one component.
+     * Not safe to call while other threads are logging.
+     */
+    void setComponentSeverity(const std::string& component,
+                              MessageSeverity severity);
+
+    bool isEnabled(const std::string& component,
+                   MessageSeverity severity) const {
+        if (componentSeverity.empty()) {
+            return severity >= minimumSeverity;
+        }
+        return isComponentEnabled(component, severity);
+    }
+
+    /**
+     * Starts delivering messages from a background thread.
+     * @param capacity Number of messages that can be queued, messages logged
+     * while the queue is full are dropped and counted.
+     */
+    void startAsync(size_t capacity = kDefaultQueueCapacity);
+
+    /**
+     * Delivers any queued messages and returns to synchronous logging.
+     */
+    void stopAsync();
+
+    bool isAsync() const {
+        return queue != nullptr;
+    }
+
+    /**
+     * Delivers every queued message on the calling thread and flushes the
+     * receivers before returning.
+     */
+    void flush();
+
+    /// Number of messages dropped because the queue was full
+    size_t getDroppedCount() const {
+        return dropped;
+    }
+
     void log(const std::string& component, Logger::MessageSeverity severity,
              const std::string& message);
 
+    /**
+     * Streams each of parts into the message, only if the severity is
+     * enabled for component.
+     */
+    template <class... Parts>
+    void log(const std::string& component, Logger::MessageSeverity severity,
+             const Parts&... parts) {
+        if (!isEnabled(component, severity)) {
+            return;
+        }
+        std::ostringstream ss;
+        using expand = int[];
+        (void)expand{0, ((void)(ss << parts), 0)...};
+        dispatch(LogMessage{component, severity, ss.str()});
+    }
+
     void verbose(const std::string& component, const std::string& message);
     void info(const std::string& component, const std::string& message);
     void warning(const std::string& component, const std::string& message);
     void error(const std::string& component, const std::string& message);
 
+    template <class Part1, class Part2, class... Parts>
+    void verbose(const std::string& component, const Part1& part1,
+                 const Part2& part2, const Parts&... parts) {
+        log(component, Verbose, part1, part2, parts...);
+    }
+    template <class Part1, class Part2, class... Parts>
+    void info(const std::string& component, const Part1& part1,
+              const Part2& part2, const Parts&... parts) {
+        log(component, Info, part1, part2, parts...);
+    }
+    template <class Part1, class Part2, class... Parts>
+    void warning(const std::string& component, const Part1& part1,
+                 const Part2& part2, const Parts&... parts) {
+        log(component, Warning, part1, part2, parts...);
+    }
+    template <class Part1, class Part2, class... Parts>
+    void error(const std::string& component, const Part1& part1,
+               const Part2& part2, const Parts&... parts) {
+        log(component, Error, part1, part2, parts...);
+    }
+
 private:
+    bool isComponentEnabled(const std::string& component,
+                            MessageSeverity severity) const;
+
+    void dispatch(LogMessage&& message);
+    void deliver(const LogMessage& message);
+    /// Delivers queued messages, the caller must hold receiverMutex
+    void drainQueue();
+    /// Flushes every receiver, the caller must hold receiverMutex
+    void flushReceivers();
+    void sinkThread();
+
     std::vector<MessageReceiver*> receivers;
+    /// Serialises calls into receivers
+    std::mutex receiverMutex;
+
+    std::atomic<MessageSeverity> minimumSeverity{Verbose};
+    std::unordered_map<std::string, MessageSeverity> componentSeverity;
+
+    std::unique_ptr<BoundedQueue<LogMessage>> queue;
+    std::atomic<size_t> dropped{0};
+    std::thread sink;
+    std::mutex sinkMutex;
+    std::condition_variable sinkWake;
+    std::atomic<bool> sinkRunning{false};
 };
 
 class StdOutReceiver : public Logger::MessageReceiver {
     void messageReceived(const Logger::LogMessage&) override;
+    void flush() override;
 };
 
 #endif
@@ -0,0 +1,187 @@
+#ifndef _RWENGINE_TIMERWHEEL_HPP_
+#define _RWENGINE_TIMERWHEEL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hierarchical timer wheel for items waiting until a point in time
+ *
+ * Time is measured in whole ticks. Level 0 has one slot per tick, and each
+ * level above covers the whole of the one below in every slot. Items move
+ * down a level when the lower one wraps, so scheduling is O(1) and
+ * advancing costs only the items that expire or cascade. Items due further
+ * ahead than the wheel covers are parked in the top level until they fit.
+ */
+template <class T>
+class TimerWheel {
+public:
+    using Time = std::uint64_t;
+
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kSlotBits;
+    static constexpr size_t kLevels = 4;
+
+    explicit TimerWheel(Time now = 0) : current(now) {
+    }
+
+    Time getTime() const {
+        return current;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * Adds an item that expires once time reaches when. Items already due
+     * expire on the next advance.
+     */
+    void schedule(T item, Time when) {
+        // Due items go in the next tick's slot
+        insert({std::move(item), when}, current + 1);
+        count++;
+    }
+
+    /**
+     * Moves time forward, calling expired(item) for each item that is due,
+     * ordered by the time they were due. expired may schedule more items.
+     */
+    template <class F>
+    void advance(Time now, F&& expired) {
+        while (current < now) {
+            if (count == 0) {
+                current = now;
+                break;
+            }
+            current++;
+
+            // When a level wraps, bring the next slot of the level above down
+            for (size_t level = 1; level < kLevels; ++level) {
+                if (((current >> (kSlotBits * (level - 1))) & (kSlots - 1)) !=
+                    0) {
+                    break;
+                }
+                cascade(level);
+            }
+
+            auto& slot = slots[0][current & (kSlots - 1)];
+            if (slot.empty()) {
+                continue;
+            }
+            std::swap(slot, scratch);
+            for (auto& entry : scratch) {
+                count--;
+                expired(std::move(entry.item));
+            }
+            scratch.clear();
+        }
+    }
+
+    /// Calls f(item, when) for every item
+    template <class F>
+    void forEach(F&& f) const {
+        for (const auto& level : slots) {
+            for (const auto& slot : level) {
+                for (const auto& entry : slot) {
+                    f(entry.item, entry.when);
+                }
+            }
+        }
+    }
+
+    /// Removes every item, calling f(item, when) for each
+    template <class F>
+    void drain(F&& f) {
+        for (auto& level : slots) {
+            for (auto& slot : level) {
+                for (auto& entry : slot) {
+                    f(std::move(entry.item), entry.when);
+                }
+                slot.clear();
+            }
+        }
+        count = 0;
+    }
+
+    /// Removes every item and sets the time
+    void reset(Time now) {
+        for (auto& level : slots) {
+            for (auto& slot : level) {
+                slot.clear();
+            }
+        }
+        count = 0;
+        current = now;
+    }
+
+private:
+    struct Entry {
+        T item;
+        Time when;
+    };
+
+    /// Files an entry by how far ahead it is, placing it no sooner than
+    /// earliest
+    void insert(Entry&& entry, Time earliest) {
+        const Time when = std::max(entry.when, earliest);
+        Time delta = when - current;
+        Time index = when;
+
+        size_t level = 0;
+        while (level < kLevels - 1 &&
+               delta >= (Time(1) << (kSlotBits * (level + 1)))) {
+            level++;
+        }
+        if (delta >= (Time(1) << (kSlotBits * kLevels))) {
+            // Too far ahead, wait in the top level's last slot to come around
+            index = current + (Time(1) << (kSlotBits * kLevels)) - 1;
+        }
+
+        auto slot = (index >> (kSlotBits * level)) & (kSlots - 1);
+        slots[level][slot].push_back(std::move(entry));
+    }
+
+    void cascade(size_t level) {
+        auto& slot =
+            slots[level][(current >> (kSlotBits * level)) & (kSlots - 1)];
+        if (slot.empty()) {
+            return;
+        }
+        std::vector<Entry> entries;
+        std::swap(slot, entries);
+        // Entries due now go in this tick's slot, which expires after the
+        // cascade
+        for (auto& entry : entries) {
+            insert(std::move(entry), current);
+        }
+        // Keep the capacity for the next lap
+        if (slot.empty()) {
+            entries.clear();
+            std::swap(slot, entries);
+        }
+    }
+
+    std::array<std::array<std::vector<Entry>, kSlots>, kLevels> slots;
+    /// Expiring entries, kept to avoid reallocating
+    std::vector<Entry> scratch;
+    Time current;
+    size_t count = 0;
+};
+
+template <class T>
+constexpr unsigned TimerWheel<T>::kSlotBits;
+template <class T>
+constexpr size_t TimerWheel<T>::kSlots;
+template <class T>
+constexpr size_t TimerWheel<T>::kLevels;
+
+#endif
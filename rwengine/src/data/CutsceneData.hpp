@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include <rw/forward.hpp>
+
 /**
  * @brief Stores data from .CUT files
  */
@@ -135,6 +137,8 @@ struct CutsceneTracks {
 struct CutsceneData {
     CutsceneMetadata meta;
     CutsceneTracks tracks;
+    /// Animations from the cutscene's IFP, released with the cutscene
+    AnimationSet animations;
 };
 
 #endif
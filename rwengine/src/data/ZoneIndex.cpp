@@ -0,0 +1,80 @@
+#include "data/ZoneIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float ZoneIndex::kDefaultCellSize;
+constexpr int ZoneIndex::kMaxCellsPerAxis;
+
+void ZoneIndex::build(ZoneDataList& zones, float size) {
+    clear();
+
+    for (auto& zone : zones) {
+        names.emplace(zone.name, &zone);
+    }
+
+    if (zones.empty()) {
+        return;
+    }
+
+    root = &zones.front();
+    origin = glm::vec2(root->min);
+
+    const glm::vec2 extent = glm::max(glm::vec2(root->max) - origin,
+                                      glm::vec2(0.f));
+    for (int a = 0; a < 2; ++a) {
+        gridSize[a] = std::max(
+            1, std::min(kMaxCellsPerAxis, int(std::ceil(extent[a] / size))));
+        cellSize[a] = std::max(extent[a] / gridSize[a], 1e-3f);
+    }
+    cells.resize(size_t(gridSize.x) * size_t(gridSize.y));
+
+    addZone(root);
+}
+
+void ZoneIndex::clear() {
+    root = nullptr;
+    gridSize = glm::ivec2(0);
+    cells.clear();
+    names.clear();
+}
+
+void ZoneIndex::addZone(ZoneData* zone) {
+    // Children first, so the first zone containing a point is the same one
+    // the recursive search finds
+    for (ZoneData* child : zone->children_) {
+        addZone(child);
+    }
+
+    const auto lo = cellAt(glm::vec2(zone->min));
+    const auto hi = cellAt(glm::vec2(zone->max));
+    for (int y = lo.y; y <= hi.y; ++y) {
+        for (int x = lo.x; x <= hi.x; ++x) {
+            cells[size_t(y) * gridSize.x + x].push_back(zone);
+        }
+    }
+}
+
+glm::ivec2 ZoneIndex::cellAt(const glm::vec2& p) const {
+    const auto c = glm::ivec2(glm::floor((p - origin) / cellSize));
+    return glm::clamp(c, glm::ivec2(0), gridSize - 1);
+}
+
+ZoneData* ZoneIndex::findZone(const std::string& name) const {
+    auto it = names.find(name);
+    return it != names.end() ? it->second : nullptr;
+}
+
+ZoneData* ZoneIndex::findLeafAt(const glm::vec3& point) const {
+    if (!root || !root->containsPoint(point)) {
+        return nullptr;
+    }
+
+    const auto c = cellAt(glm::vec2(point));
+    for (ZoneData* zone : cells[size_t(c.y) * gridSize.x + c.x]) {
+        if (zone->containsPoint(point)) {
+            return zone;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,66 @@
+#ifndef _RWENGINE_ZONEINDEX_HPP_
+#define _RWENGINE_ZONEINDEX_HPP_
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <data/ZoneData.hpp>
+
+/**
+ * @brief Accelerates zone lookups by name and by position
+ *
+ * The area of the root zone is split into a grid, each cell lists the zones
+ * of the hierarchy that overlap it with the deepest zones first. Looking up a
+ * point only tests the zones of its cell and returns the same zone as
+ * ZoneData::findLeafAtPoint on the root.
+ *
+ * The index holds pointers into the zone list, so it has to be rebuilt
+ * whenever the list or the hierarchy changes.
+ */
+class ZoneIndex {
+public:
+    static constexpr float kDefaultCellSize = 100.f;
+    /// Limits the grid size for very large root zones
+    static constexpr int kMaxCellsPerAxis = 256;
+
+    /**
+     * Indexes zones, the first zone is the root of an already built hierarchy
+     */
+    void build(ZoneDataList& zones, float cellSize = kDefaultCellSize);
+
+    void clear();
+
+    /// Returns the first zone called name, or nullptr
+    ZoneData* findZone(const std::string& name) const;
+
+    /// Returns the deepest zone containing point, or nullptr
+    ZoneData* findLeafAt(const glm::vec3& point) const;
+
+    bool empty() const {
+        return root == nullptr;
+    }
+
+    glm::ivec2 getGridSize() const {
+        return gridSize;
+    }
+
+private:
+    void addZone(ZoneData* zone);
+
+    glm::ivec2 cellAt(const glm::vec2& p) const;
+
+    ZoneData* root = nullptr;
+    glm::vec2 origin{};
+    glm::vec2 cellSize{1.f};
+    glm::ivec2 gridSize{0};
+
+    /// Candidate zones of each cell, in the order they're tested
+    std::vector<std::vector<ZoneData*>> cells;
+    std::unordered_map<std::string, ZoneData*> names;
+};
+
+#endif
@@ -26,4 +26,29 @@ public:
     }
 };
 
+/**
+ * Implements raycast callback that only hits static objects, for finding the
+ * ground under things that aren't simulated by bullet.
+ *
+ * Kinematic bodies are skipped even though bullet counts them as static, so
+ * kinematic vehicles and characters never stand in for the ground.
+ */
+class GroundRayResultCallback
+    : public btCollisionWorld::ClosestRayResultCallback {
+public:
+    GroundRayResultCallback(const btVector3& from, const btVector3& to)
+        : ClosestRayResultCallback(from, to) {
+    }
+
+    btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult,
+                             bool normalInWorldSpace) override {
+        const auto object = rayResult.m_collisionObject;
+        if (!object->isStaticObject() || object->isKinematicObject()) {
+            return 1.0;
+        }
+        return ClosestRayResultCallback::addSingleResult(rayResult,
+                                                         normalInWorldSpace);
+    }
+};
+
 #endif
@@ -0,0 +1,190 @@
+#include "dynamics/RaycastService.hpp"
+
+#include <functional>
+
+#include <btBulletDynamicsCommon.h>
+
+#include "core/JobSystem.hpp"
+#include "dynamics/RaycastCallbacks.hpp"
+
+constexpr size_t RaycastService::kFrameBudget;
+
+namespace {
+/// Rays are short, so hand them to the workers in groups
+constexpr size_t kRaysPerChunk = 32;
+
+/**
+ * Tests a ray against each broadphase leaf it passes through, the same as
+ * btCollisionWorld::rayTest without using the broadphase's shared stack
+ */
+class RayLeafCallback : public btDbvt::ICollide {
+public:
+    RayLeafCallback(const btVector3& from, const btVector3& to,
+                    btCollisionWorld::RayResultCallback& callback)
+        : callback(callback) {
+        fromTransform.setIdentity();
+        fromTransform.setOrigin(from);
+        toTransform.setIdentity();
+        toTransform.setOrigin(to);
+    }
+
+    void Process(const btDbvtNode* leaf) {
+        auto proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+        if (!callback.needsCollision(proxy)) {
+            return;
+        }
+        auto object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        btCollisionWorld::rayTestSingle(fromTransform, toTransform, object,
+                                        object->getCollisionShape(),
+                                        object->getWorldTransform(), callback);
+    }
+
+private:
+    btCollisionWorld::RayResultCallback& callback;
+    btTransform fromTransform;
+    btTransform toTransform;
+};
+
+template <class Callback>
+RaycastService::Result traceWith(btDbvtBroadphase& broadphase,
+                                 const btVector3& from, const btVector3& to,
+                                 Callback& callback) {
+    RayLeafCallback leaves(from, to, callback);
+    // Moving and fixed objects are kept in separate trees
+    for (const auto& set : broadphase.m_sets) {
+        btDbvt::rayTest(set.m_root, from, to, leaves);
+    }
+
+    RaycastService::Result result;
+    if (callback.hasHit()) {
+        const auto& p = callback.m_hitPointWorld;
+        const auto& n = callback.m_hitNormalWorld;
+        result.hit = true;
+        result.position = glm::vec3(p.x(), p.y(), p.z());
+        result.normal = glm::vec3(n.x(), n.y(), n.z());
+        result.object = callback.m_collisionObject;
+    }
+    return result;
+}
+}  // namespace
+
+RaycastService::Frame::Frame(RaycastService& service) : service(service) {
+    service.cache.clear();
+    service.stats = {};
+    service.inFrame = true;
+}
+
+RaycastService::Frame::~Frame() {
+    service.cache.clear();
+    service.inFrame = false;
+}
+
+size_t RaycastService::RayHash::operator()(const Ray& ray) const {
+    size_t h = std::hash<int>()(static_cast<int>(ray.filter));
+    auto combine = [&h](float v) {
+        h ^= std::hash<float>()(v) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    };
+    for (int i = 0; i < 3; ++i) {
+        combine(ray.from[i]);
+        combine(ray.to[i]);
+    }
+    return h;
+}
+
+RaycastService::RaycastService(btDbvtBroadphase& broadphase)
+    : broadphase(broadphase) {
+}
+
+RaycastService::Handle RaycastService::queue(const glm::vec3& from,
+                                             const glm::vec3& to,
+                                             Filter filter) {
+    if (flushed) {
+        queries.clear();
+        flushed = false;
+    }
+    stats.requested++;
+
+    const Ray ray{from, to, filter};
+    const auto handle = static_cast<Handle>(queries.size());
+    if (isCacheable(ray)) {
+        auto it = cache.find(ray);
+        if (it != cache.end()) {
+            stats.cached++;
+            queries.push_back({ray, it->second});
+            return handle;
+        }
+    }
+
+    queries.push_back({ray, {}});
+    pending.push_back(handle);
+    return handle;
+}
+
+void RaycastService::flush(JobSystem& jobs) {
+    flushed = true;
+    if (pending.empty()) {
+        return;
+    }
+
+    jobs.parallelFor(pending.size(), kRaysPerChunk,
+                     [&](size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; ++i) {
+                             auto& query = queries[pending[i]];
+                             query.result = trace(query.ray);
+                         }
+                     });
+    stats.cast += pending.size();
+
+    // The workers only read, the cache is filled in afterwards
+    for (auto handle : pending) {
+        const auto& query = queries[handle];
+        if (isCacheable(query.ray)) {
+            cache.emplace(query.ray, query.result);
+        }
+    }
+    pending.clear();
+}
+
+RaycastService::Result RaycastService::cast(const glm::vec3& from,
+                                            const glm::vec3& to,
+                                            Filter filter) {
+    stats.requested++;
+
+    const Ray ray{from, to, filter};
+    const bool cacheable = isCacheable(ray);
+    if (cacheable) {
+        auto it = cache.find(ray);
+        if (it != cache.end()) {
+            stats.cached++;
+            return it->second;
+        }
+    }
+
+    stats.cast++;
+    auto result = trace(ray);
+    if (cacheable) {
+        cache.emplace(ray, result);
+    }
+    return result;
+}
+
+RaycastService::Result RaycastService::trace(const Ray& ray) const {
+    const btVector3 from(ray.from.x, ray.from.y, ray.from.z);
+    const btVector3 to(ray.to.x, ray.to.y, ray.to.z);
+
+    switch (ray.filter) {
+        case Filter::Static: {
+            GroundRayResultCallback callback(from, to);
+            return traceWith(broadphase, from, to, callback);
+        }
+        case Filter::All: {
+            btCollisionWorld::ClosestRayResultCallback callback(from, to);
+            callback.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+            return traceWith(broadphase, from, to, callback);
+        }
+        case Filter::Default:
+            break;
+    }
+    btCollisionWorld::ClosestRayResultCallback callback(from, to);
+    return traceWith(broadphase, from, to, callback);
+}
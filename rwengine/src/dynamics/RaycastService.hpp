@@ -0,0 +1,142 @@
+#ifndef _RWENGINE_RAYCASTSERVICE_HPP_
+#define _RWENGINE_RAYCASTSERVICE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class btCollisionObject;
+class JobSystem;
+struct btDbvtBroadphase;
+
+/**
+ * @brief Casts rays against the physics world, one at a time or in batches
+ *
+ * Rays queued during a tick are cast together by flush, split across the
+ * job system. Each ray walks the broadphase with its own stack, so they
+ * don't share any state while they run. Rays against static geometry are
+ * cached while a Frame is open, so repeated ground probes are only cast
+ * once per tick.
+ */
+class RaycastService {
+public:
+    /// Rays cast in a tick before it counts as over budget
+    static constexpr size_t kFrameBudget = 1024;
+
+    enum class Filter {
+        /// Anything in the default collision group can see
+        Default,
+        /// Every object, including sensors and triggers
+        All,
+        /// Static geometry only, for finding the ground
+        Static,
+    };
+
+    struct Result {
+        bool hit = false;
+        glm::vec3 position{};
+        glm::vec3 normal{};
+        const btCollisionObject* object = nullptr;
+    };
+
+    struct Stats {
+        /// Rays asked for
+        size_t requested = 0;
+        /// Rays that were cast
+        size_t cast = 0;
+        /// Rays answered from the cache
+        size_t cached = 0;
+    };
+
+    using Handle = std::uint32_t;
+
+    /**
+     * Enables the cache until the scope ends. The world's static geometry
+     * must not change while it is open.
+     */
+    class Frame {
+    public:
+        explicit Frame(RaycastService& service);
+        ~Frame();
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+    private:
+        RaycastService& service;
+    };
+
+    explicit RaycastService(btDbvtBroadphase& broadphase);
+
+    /**
+     * Adds a ray to the next flush. Handles stay valid until a ray is
+     * queued after that flush.
+     */
+    Handle queue(const glm::vec3& from, const glm::vec3& to,
+                 Filter filter = Filter::Default);
+
+    /// Casts every queued ray
+    void flush(JobSystem& jobs);
+
+    /// The result of a queued ray, once it has been flushed
+    const Result& getResult(Handle handle) const {
+        return queries[handle].result;
+    }
+
+    /// Casts a ray straight away
+    Result cast(const glm::vec3& from, const glm::vec3& to,
+                Filter filter = Filter::Default);
+
+    /// Counts for the current tick, or the last one once it has ended
+    const Stats& getStats() const {
+        return stats;
+    }
+
+    bool isOverBudget() const {
+        return stats.cast > kFrameBudget;
+    }
+
+private:
+    struct Ray {
+        glm::vec3 from;
+        glm::vec3 to;
+        Filter filter;
+
+        bool operator==(const Ray& other) const {
+            return from == other.from && to == other.to &&
+                   filter == other.filter;
+        }
+    };
+
+    struct RayHash {
+        size_t operator()(const Ray& ray) const;
+    };
+
+    struct Query {
+        Ray ray;
+        Result result;
+    };
+
+    Result trace(const Ray& ray) const;
+
+    bool isCacheable(const Ray& ray) const {
+        return inFrame && ray.filter == Filter::Static;
+    }
+
+    btDbvtBroadphase& broadphase;
+
+    std::vector<Query> queries;
+    /// Indices of queries waiting for the next flush
+    std::vector<Handle> pending;
+    bool flushed = false;
+
+    std::unordered_map<Ray, Result, RayHash> cache;
+    bool inFrame = false;
+
+    Stats stats;
+};
+
+#endif
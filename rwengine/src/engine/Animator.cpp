@@ -11,82 +11,134 @@
 #include <algorithm>
 #include <cmath>
 
+constexpr float Animator::kReducedInterval;
+constexpr float Animator::kReducedDistance;
+constexpr float Animator::kHiddenTime;
+
+namespace {
+void setBone(ModelFrame* frame, const glm::quat& rotation,
+             const glm::vec3& translation) {
+    // One matrix so the hierarchy is only updated once
+    glm::mat4 matrix = glm::mat4_cast(rotation);
+    matrix[3] = glm::vec4(frame->getDefaultTranslation() + translation, 1.f);
+    frame->setTransform(matrix);
+}
+}  // namespace
+
 Animator::Animator(const ClumpPtr& _model) : model(_model) {
 }
 
-void Animator::tick(float dt) {
-    if (model == nullptr || animations.empty()) {
+void Animator::findBones(AnimationState& state) {
+    if (!state.boneInstances.empty()) {
         return;
     }
+    for (const auto& bone : state.animation->bones) {
+        auto frame = model->findFrame(bone.first);
+        if (!frame || bone.second->frames.empty()) {
+            continue;
+        }
+        state.boneInstances.push_back({bone.second, frame});
+    }
+}
 
-    struct BoneTransform {
-        glm::vec3 translation{};
-        glm::quat rotation{1.0f,0.0f,0.0f,0.0f};
-    };
-
-#if 0
-    // Blend all active animations together
-    std::map<ModelFrame*, BoneTransform> blendFrames;
-#endif
+float Animator::getSampleTime(const AnimationState& state, float time) const {
+    if (!state.repeat) {
+        return std::min(time, state.animation->duration);
+    }
+    return std::fmod(time, state.animation->duration);
+}
 
-    for (AnimationState& state : animations) {
-        if (state.animation == nullptr) continue;
+void Animator::evaluate(AnimationState& state) {
+    const float animTime = getSampleTime(state, state.time);
+    for (auto& b : state.boneInstances) {
+        auto kf = b.bone->getInterpolatedKeyframe(animTime);
+        setBone(b.frame, kf.rotation,
+                b.bone->type != AnimationBone::R00 ? kf.position
+                                                   : glm::vec3());
+    }
+    state.blending = false;
+}
 
-        if (state.boneInstances.empty()) {
-            for (const auto& bone : state.animation->bones) {
-                auto frame = model->findFrame(bone.first);
-                if (!frame) {
-                    continue;
-                }
-                state.boneInstances.insert({bone.second, frame});
+void Animator::blend(AnimationState& state) {
+    const float poseEnd = state.poseStart + kReducedInterval;
+    if (!state.blending || state.time < state.poseStart ||
+        state.time >= poseEnd) {
+        // Carry on from the last pose if time has just moved past it
+        const bool continues = state.blending && state.time >= poseEnd &&
+                               state.time < poseEnd + kReducedInterval;
+        const float from = getSampleTime(state, state.time);
+        const float to = getSampleTime(state, (continues ? poseEnd
+                                                          : state.time) +
+                                                  kReducedInterval);
+        for (auto& b : state.boneInstances) {
+            if (continues) {
+                b.fromRotation = b.toRotation;
+                b.fromTranslation = b.toTranslation;
+            } else {
+                auto kf = b.bone->getInterpolatedKeyframe(from);
+                b.fromRotation = kf.rotation;
+                b.fromTranslation = kf.position;
+            }
+            auto kf = b.bone->getInterpolatedKeyframe(to);
+            b.toRotation = kf.rotation;
+            b.toTranslation = kf.position;
+            if (b.bone->type == AnimationBone::R00) {
+                b.fromTranslation = b.toTranslation = glm::vec3();
             }
         }
+        state.poseStart = continues ? poseEnd : state.time;
+        state.blending = true;
+    }
 
-        state.time = state.time + dt;
+    const float alpha = (state.time - state.poseStart) / kReducedInterval;
+    for (auto& b : state.boneInstances) {
+        setBone(b.frame, glm::slerp(b.fromRotation, b.toRotation, alpha),
+                glm::mix(b.fromTranslation, b.toTranslation, alpha));
+    }
+}
 
-        float animTime = state.time;
-        if (!state.repeat) {
-            animTime = std::min(animTime, state.animation->duration);
-        } else {
-            animTime = std::fmod(animTime, state.animation->duration);
-        }
+void Animator::tick(float dt) {
+    if (model == nullptr || animations.empty()) {
+        return;
+    }
 
-        for (auto& b : state.boneInstances) {
-            if (b.first->frames.empty()) continue;
-            auto kf = b.first->getInterpolatedKeyframe(animTime);
+    for (AnimationState& state : animations) {
+        if (state.animation == nullptr) continue;
 
-            BoneTransform xform;
-            xform.rotation = kf.rotation;
-            if (b.first->type != AnimationBone::R00) {
-                xform.translation = kf.position;
-            }
+        findBones(state);
 
-#if 0
-			auto prevAnim = blendFrames.find(b.second.frameIndex);
-			if (prevAnim != blendFrames.end())
-			{
-				prevAnim->second.translation += xform.translation;
-				prevAnim->second.rotation *= xform.rotation;
-			}
-			else
-			{
-				blendFrames[b.second.frameIndex] = xform;
-			}
-#else
-            b.second->setTranslation(b.second->getDefaultTranslation() +
-                                     xform.translation);
-            b.second->setRotation(glm::mat3_cast(xform.rotation));
-#endif
+        state.time = state.time + dt;
+
+        switch (detail) {
+            case Detail::Full:
+                evaluate(state);
+                break;
+            case Detail::Reduced:
+                blend(state);
+                break;
+            case Detail::TimeOnly:
+                state.blending = false;
+                break;
         }
     }
+}
+
+Animator::Detail Animator::chooseDetail(float sinceDrawn, float distance) {
+    if (sinceDrawn > kHiddenTime) {
+        return Detail::TimeOnly;
+    }
+    return distance > kReducedDistance ? Detail::Reduced : Detail::Full;
+}
 
-#if 0
-    for (auto& p : blendFrames) {
-        p.first->setTranslation(p.first->getDefaultTranslation() +
-                                p.second.translation);
-        p.first->setRotation(glm::mat3_cast(p.second.rotation));
+void Animator::updatePose() {
+    if (model == nullptr) {
+        return;
+    }
+    for (AnimationState& state : animations) {
+        if (state.animation == nullptr) continue;
+        findBones(state);
+        evaluate(state);
     }
-#endif
 }
 
 bool Animator::isCompleted(unsigned int slot) const {
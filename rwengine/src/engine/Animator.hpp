@@ -1,8 +1,10 @@
 #ifndef _RWENGINE_ANIMATOR_HPP_
 #define _RWENGINE_ANIMATOR_HPP_
-#include <map>
 #include <vector>
 
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
 #include <rw/defines.hpp>
 #include <rw/forward.hpp>
 
@@ -20,6 +22,37 @@ class ModelFrame;
  * The Animator will blend all active animations together.
  */
 class Animator {
+public:
+    /**
+     * @brief How much work tick() does on the bones
+     */
+    enum class Detail {
+        /// Evaluates the keyframes every tick
+        Full,
+        /// Evaluates the keyframes every kReducedInterval, and blends
+        /// towards the next evaluation in between
+        Reduced,
+        /// Only advances time, the pose is left until updatePose()
+        TimeOnly
+    };
+
+    static constexpr float kReducedInterval = 0.1f;
+    /// Objects drawn further away than this use Detail::Reduced
+    static constexpr float kReducedDistance = 30.f;
+    /// Objects that haven't been drawn for this long use Detail::TimeOnly
+    static constexpr float kHiddenTime = 0.5f;
+
+private:
+    struct BoneInstance {
+        AnimationBone* bone;
+        ModelFrame* frame;
+        /// Poses blended between with Detail::Reduced
+        glm::quat fromRotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::quat toRotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 fromTranslation{};
+        glm::vec3 toTranslation{};
+    };
+
     /**
      * @brief The AnimationState struct stores information about playing
      * animations
@@ -32,7 +65,11 @@ class Animator {
         float speed;
         /// Automatically restart
         bool repeat;
-        std::map<AnimationBone*, ModelFrame*> boneInstances;
+        std::vector<BoneInstance> boneInstances;
+        /// Whether the bones hold poses to blend between, from poseStart
+        /// to poseStart + kReducedInterval
+        bool blending = false;
+        float poseStart = 0.f;
     };
 
     /**
@@ -45,6 +82,13 @@ class Animator {
      */
     std::vector<AnimationState> animations;
 
+    Detail detail = Detail::Full;
+
+    void findBones(AnimationState& state);
+    float getSampleTime(const AnimationState& state, float time) const;
+    void evaluate(AnimationState& state);
+    void blend(AnimationState& state);
+
 public:
     Animator(const ClumpPtr& _model);
 
@@ -76,6 +120,26 @@ public:
      */
     void tick(float dt);
 
+    void setDetail(Detail d) {
+        detail = d;
+    }
+
+    Detail getDetail() const {
+        return detail;
+    }
+
+    /**
+     * Picks the detail for an object from how long ago it was last drawn,
+     * and how far from the camera it was
+     */
+    static Detail chooseDetail(float sinceDrawn, float distance);
+
+    /**
+     * Evaluates every bone at the current time, for when something needs
+     * exact bone positions whatever the detail
+     */
+    void updatePose();
+
     /**
      * Returns true if the animation has finished playing.
      */
@@ -23,6 +23,7 @@
 #include "loaders/LoaderIDE.hpp"
 #include "loaders/LoaderIFP.hpp"
 #include "loaders/LoaderIPL.hpp"
+#include "loaders/TextureCache.hpp"
 #include "loaders/WeatherLoader.hpp"
 #include "platform/FileHandle.hpp"
 #include "script/SCMFile.hpp"
@@ -36,17 +37,28 @@ GameData::GameData(Logger* log, const rwfs::path& path)
         [&](const std::string& texture, const std::string&) {
             return findSlotTexture(currenttextureslot, texture);
         });
+    dffLoader.setGeometryArena(&geometryArena);
 }
 
 GameData::~GameData() = default;
 
-void GameData::load() {
-    index.indexGameDirectory(datpath);
-    index.indexTree(datpath);
+void GameData::setTextureCache(std::unique_ptr<TextureCache> cache) {
+    textureCache = std::move(cache);
+}
+
+void GameData::load(const rwfs::path& indexCache) {
+    if (indexCache.empty() || !index.loadCache(indexCache, datpath)) {
+        index.indexGameDirectory(datpath);
 
-    loadIMG("models/gta3.img");
-    /// @todo cuts.img files should be loaded differently to gta3.img
-    loadIMG("anim/cuts.img");
+        loadIMG("models/gta3.img");
+        /// @todo cuts.img files should be loaded differently to gta3.img
+        loadIMG("anim/cuts.img");
+
+        if (!indexCache.empty() && !index.saveCache(indexCache)) {
+            logger->warning("Data", "Failed to write file index cache ",
+                            indexCache.string());
+        }
+    }
 
     textureslots["particle"] = loadTextureArchive("particle.txd");
     textureslots["icons"] = loadTextureArchive("icons.txd");
@@ -73,6 +85,7 @@ void GameData::load() {
     // Clear existing zones
     gamezones = ZoneDataList{
         {"CITYZON", 0, {-4000.f, -4000.f, -500.f}, {4000.f, 4000.f, 500.f}, 0, 0, 0}};
+    rebuildZones();
 
     loadLevelFile("data/default.dat");
     loadLevelFile("data/gta3.dat");
@@ -209,8 +222,16 @@ bool GameData::loadZone(const std::string& path) {
         return false;
     }
 
-    gamezones.insert(gamezones.end(), ipll.zones.begin(), ipll.zones.end());
+    addZones(ipll.zones);
+    return true;
+}
+
+void GameData::addZones(const ZoneDataList& zones) {
+    gamezones.insert(gamezones.end(), zones.begin(), zones.end());
+    rebuildZones();
+}
 
+void GameData::rebuildZones() {
     // Build zone hierarchy
     for (ZoneData& zone : gamezones) {
         zone.children_.clear();
@@ -220,7 +241,7 @@ bool GameData::loadZone(const std::string& path) {
         gamezones[0].insertZone(zone);
     }
 
-    return true;
+    zoneIndex.build(gamezones);
 }
 
 enum ColSection {
@@ -378,6 +399,19 @@ TextureArchive GameData::loadTextureArchive(const std::string& name) {
 
     TextureArchive textures;
 
+    if (textureCache) {
+        const auto data = index.findIndexData(name);
+        std::vector<DecodedTexture> decoded;
+        if (!textureCache->decode(file, data ? data->offset : 0, decoded)) {
+            logger->error("Data", "Error loading txd: " + name);
+        }
+        // Textures that couldn't be decoded get the error texture
+        for (const auto& texture : decoded) {
+            textures[texture.name] = TextureLoader::upload(texture);
+        }
+        return textures;
+    }
+
     TextureLoader l;
     if (!l.loadFromMemory(file, textures)) {
         logger->error("Data", "Error loading txd: " + name);
@@ -678,6 +712,12 @@ bool GameData::loadAudioClip(const std::string& name,
         return false;
     }
 
+    // Only one mission clip is used at a time, the previous one can go. Its
+    // samples stay in the sound cache in case it is loaded again.
+    if (!engine->missionAudio.empty() && engine->missionAudio != name) {
+        engine->sound.unloadSound(engine->missionAudio);
+    }
+
     bool loaded = engine->sound.loadSound(name, systempath);
 
     if (!loaded) {
@@ -23,10 +23,12 @@
 #include <data/PedData.hpp>
 #include <data/Weather.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneIndex.hpp>
 #include <loaders/LoaderDFF.hpp>
 #include <loaders/LoaderIMG.hpp>
 #include <loaders/LoaderTXD.hpp>
 #include <objects/VehicleInfo.hpp>
+#include <gl/GeometryArena.hpp>
 #include <gl/TextureData.hpp>
 
 class Logger;
@@ -34,6 +36,7 @@ struct WeaponData;
 class GameWorld;
 class TextureAtlas;
 class SCMFile;
+class TextureCache;
 
 /**
  * @brief Loads and stores all "static" data such as loaded models, handling
@@ -50,7 +53,11 @@ private:
     std::string currenttextureslot;
 
     Logger* logger;
+    /// Shared vertex and index buffers for every loaded model
+    GeometryArena geometryArena;
     LoaderDFF dffLoader;
+    /// Decoded textures kept between runs, see setTextureCache
+    std::unique_ptr<TextureCache> textureCache;
 
 public:
     /**
@@ -69,6 +76,26 @@ public:
         return "PC";
     }
 
+    /**
+     * Loads models using the compact vertex layout, see LoaderDFF
+     */
+    void setCompactModels(bool compact) {
+        dffLoader.setCompactVertices(compact);
+    }
+
+    const GeometryArena& getGeometryArena() const {
+        return geometryArena;
+    }
+
+    /**
+     * Decodes texture archives through the given cache, or directly if null
+     */
+    void setTextureCache(std::unique_ptr<TextureCache> cache);
+
+    TextureCache* getTextureCache() const {
+        return textureCache.get();
+    }
+
     /**
      * Returns the game data path
      */
@@ -98,6 +125,16 @@ public:
      */
     bool loadZone(const std::string& path);
 
+    /**
+     * Adds zones to gamezones and rebuilds the zone hierarchy
+     */
+    void addZones(const ZoneDataList& zones);
+
+    /**
+     * Rebuilds the zone hierarchy and lookup index from gamezones
+     */
+    void rebuildZones();
+
     void loadCarcols(const std::string& path);
 
     void loadWeather(const std::string& path);
@@ -114,7 +151,12 @@ public:
     void loadWaterpro(const std::string& path);
     void loadWater(const std::string& path);
 
-    void load();
+    /**
+     * Indexes the game directory and archives, then loads the common data
+     * @param indexCache File to reuse the file index from if it is still
+     * valid, a fresh index is written to it otherwise. Empty to always index.
+     */
+    void load(const rwfs::path& indexCache = {});
 
     /**
      * Loads model, placement, models and textures from a level file
@@ -226,17 +268,18 @@ public:
 
     ZoneDataList mapzones;
 
+    /**
+     * Index over gamezones, @see rebuildZones
+     */
+    ZoneIndex zoneIndex;
+
     ZoneData* findZone(const std::string& name) {
-        auto it =
-            std::find_if(gamezones.begin(), gamezones.end(),
-                         [&](const ZoneData& a) { return a.name == name; });
-        return it != gamezones.end() ? &(*it) : nullptr;
+        return zoneIndex.findZone(name);
     }
 
     ZoneData* findZoneAt(const glm::vec3& pos) {
         RW_CHECK(!gamezones.empty(), "No game zones loaded");
-        ZoneData* zone = gamezones[0].findLeafAtPoint(pos);
-        return zone;
+        return zoneIndex.findLeafAt(pos);
     }
 
     std::unordered_map<ModelID, std::unique_ptr<BaseModelInfo>> modelinfo;
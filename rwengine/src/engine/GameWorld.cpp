@@ -1,5 +1,7 @@
 #include "engine/GameWorld.hpp"
 
+#include <limits>
+
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <btBulletDynamicsCommon.h>
 
@@ -20,7 +22,9 @@
 #include "data/InstanceData.hpp"
 #include "data/WeaponData.hpp"
 
+#include "loaders/BakedWorld.hpp"
 #include "loaders/LoaderCutsceneDAT.hpp"
+#include "loaders/LoaderIFP.hpp"
 #include "loaders/LoaderIPL.hpp"
 
 #include "objects/CharacterObject.hpp"
@@ -28,6 +32,7 @@
 #include "objects/InstanceObject.hpp"
 #include "objects/PickupObject.hpp"
 #include "objects/VehicleObject.hpp"
+#include "platform/FileHandle.hpp"
 
 #include "render/ViewCamera.hpp"
 
@@ -39,6 +44,16 @@
 constexpr float kMaxTrafficSpawnRadius = 100.f;
 constexpr float kMaxTrafficCleanupRadius = kMaxTrafficSpawnRadius * 1.25f;
 
+// Pedestrians nearer than these to the player or a vehicle get full physics
+constexpr float kCrowdPlayerRadius = 15.f;
+constexpr float kCrowdVehicleRadius = 8.f;
+constexpr float kCrowdHysteresis = 1.25f;
+// Crowd ground queries, relative to the character's origin
+constexpr float kCrowdGroundResample = 0.5f;
+constexpr float kCrowdStepHeight = 0.5f;
+constexpr float kCrowdGroundProbe = 2.5f;
+constexpr float kCrowdGroundOffset = 1.f;
+
 class WorldCollisionDispatcher : public btCollisionDispatcher {
 public:
     WorldCollisionDispatcher(btCollisionConfiguration* collisionConfiguration)
@@ -70,6 +85,7 @@ GameWorld::GameWorld(Logger* log, GameData* dat)
         _overlappingPairCallback.get());
     gContactProcessedCallback = ContactProcessedCallback;
     dynamicsWorld->setInternalTickCallback(PhysicsTickCallback, this);
+    raycasts = std::make_unique<RaycastService>(*broadphase);
 }
 
 GameWorld::~GameWorld() {
@@ -85,9 +101,8 @@ bool GameWorld::placeItems(const std::string& name) {
         // Find the object.
         for (const auto& inst : ipll.m_instances) {
             if (!createInstance(inst->id, inst->pos, inst->rot)) {
-                logger->error("World", "No object data for instance " +
-                                           std::to_string(inst->id) + " in " +
-                                           name);
+                logger->error("World", "No object data for instance ",
+                              inst->id, " in ", name);
             }
         }
 
@@ -100,9 +115,21 @@ bool GameWorld::placeItems(const std::string& name) {
     return false;
 }
 
+void GameWorld::placeItems(const BakedWorld& baked) {
+    const auto& instances = baked.getInstances();
+    allObjects.reserve(allObjects.size() + instances.size());
+    for (const auto& inst : instances) {
+        if (!createInstance(inst.id, inst.position, inst.rotation)) {
+            logger->error("World", "No object data for instance ", inst.id,
+                          " in ", baked.getSourceName(inst));
+        }
+    }
+}
+
 InstanceObject* GameWorld::createInstance(const uint16_t id,
                                           const glm::vec3& pos,
-                                          const glm::quat& rot) {
+                                          const glm::quat& rot,
+                                          GameObjectID gid) {
     auto oi = data->findModelInfo<SimpleModelInfo>(id);
     if (oi) {
         // Request loading of the model if it isn't loaded already.
@@ -119,12 +146,12 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
         }
 
         if (oi->name.empty()) {
-            logger->warning(
-                "World", "Instance with missing model: " + std::to_string(id));
+            logger->warning("World", "Instance with missing model: ", id);
         }
 
         auto instance =
             new InstanceObject(this, pos, rot, glm::vec3(1.f), oi, dydata);
+        instance->setGameObjectID(gid);
 
         instancePool.insert(instance);
         allObjects.push_back(instance);
@@ -172,6 +199,37 @@ void GameWorld::cleanupTraffic(const ViewCamera& focus) {
     destroyQueuedObjects();
 }
 
+void GameWorld::updateTrafficPhysics(const ViewCamera& focus) {
+    for (auto& p : vehiclePool.objects) {
+        auto vehicle = static_cast<VehicleObject*>(p.second);
+
+        // Only ambient traffic follows lanes, mission vehicles stay under
+        // the control of their scripts
+        bool kinematic = false;
+        if (vehicle->getLifetime() == GameObject::TrafficLifetime &&
+            !vehicle->isWrecked() &&
+            vehicle->getVehicle()->vehicletype_ != VehicleModelInfo::BOAT) {
+            const auto& position = vehicle->getPosition();
+            const float radius =
+                glm::length(vehicle->info->handling.dimensions) / 2.f;
+            kinematic = TrafficDirector::useKinematicSimulation(
+                vehicle->isKinematic(),
+                glm::distance(focus.position, position),
+                focus.frustum.intersects(position, radius),
+                vehiclePhysicsRadius);
+        }
+
+        // The player's vehicle is always simulated properly
+        for (const auto& seat : vehicle->seatOccupants) {
+            if (seat.second->getGameObjectID() == state->playerObject) {
+                kinematic = false;
+            }
+        }
+
+        vehicle->setKinematic(kinematic);
+    }
+}
+
 CutsceneObject* GameWorld::createCutsceneObject(const uint16_t id,
                                                 const glm::vec3& pos,
                                                 const glm::quat& rot) {
@@ -210,8 +268,8 @@ VehicleObject* GameWorld::createVehicle(const uint16_t id, const glm::vec3& pos,
     if (!vti) {
         return nullptr;
     }
-    logger->info("World", "Creating Vehicle ID " + std::to_string(id) + " (" +
-                              vti->vehiclename_ + ")");
+    logger->info("World", "Creating Vehicle ID ", id, " (", vti->vehiclename_,
+                 ")");
 
     if (!vti->isLoaded()) {
         data->loadModel(id);
@@ -338,7 +396,8 @@ CharacterObject* GameWorld::createPlayer(const glm::vec3& pos,
     return ped;
 }
 
-PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
+PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type,
+                                      GameObjectID gid) {
     auto modelInfo = data->modelinfo[id].get();
 
     RW_CHECK(modelInfo != nullptr, "Pickup Object Data is not found");
@@ -379,6 +438,7 @@ PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
         RW_UNIMPLEMENTED("Non-weapon pickups");
         pickup = new PickupObject(this, pos, modelInfo, pickuptype);
     }
+    pickup->setGameObjectID(gid);
 
     pickupPool.insert(pickup);
     allObjects.push_back(pickup);
@@ -542,7 +602,9 @@ void GameWorld::destroyObject(GameObject* object) {
 
 void GameWorld::destroyObjectQueued(GameObject* object) {
     RW_CHECK(object != nullptr, "destroying a null object?");
-    if (object) deletionQueue.insert(object);
+    if (object) {
+        defer([this, object] { deletionQueue.insert(object); });
+    }
 }
 
 void GameWorld::destroyQueuedObjects() {
@@ -552,22 +614,6 @@ void GameWorld::destroyQueuedObjects() {
     }
 }
 
-VisualFX* GameWorld::createEffect(VisualFX::EffectType type) {
-    auto effect = new VisualFX(type);
-    effects.push_back(effect);
-    return effect;
-}
-
-void GameWorld::destroyEffect(VisualFX* effect) {
-    for (auto it = effects.begin(); it != effects.end();) {
-        if (*it == effect) {
-            it = effects.erase(it);
-        } else {
-            it++;
-        }
-    }
-}
-
 void GameWorld::doWeaponScan(const WeaponScan& scan) {
     RW_CHECK(scan.type != WeaponScan::RADIUS,
              "Radius scans not implemented yet");
@@ -576,21 +622,15 @@ void GameWorld::doWeaponScan(const WeaponScan& scan) {
         // TODO
         // Requires custom ConvexResultCallback
     } else if (scan.type == WeaponScan::HITSCAN) {
-        btVector3 from(scan.center.x, scan.center.y, scan.center.z),
-            to(scan.end.x, scan.end.y, scan.end.z);
-        glm::vec3 hitEnd = scan.end;
-        btCollisionWorld::ClosestRayResultCallback cb(from, to);
-        cb.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
-        dynamicsWorld->rayTest(from, to, cb);
+        auto hit = raycasts->cast(scan.center, scan.end,
+                                  RaycastService::Filter::All);
         // TODO: did any weapons penetrate?
 
-        if (cb.hasHit()) {
-            GameObject* go = static_cast<GameObject*>(
-                cb.m_collisionObject->getUserPointer());
+        if (hit.hit) {
+            GameObject* go =
+                static_cast<GameObject*>(hit.object->getUserPointer());
             GameObject::DamageInfo di;
-            hitEnd = di.damageLocation =
-                glm::vec3(cb.m_hitPointWorld.x(), cb.m_hitPointWorld.y(),
-                          cb.m_hitPointWorld.z());
+            di.damageLocation = hit.position;
             di.damageSource = scan.center;
             di.type = GameObject::DamageInfo::Bullet;
             di.hitpoints = scan.damage;
@@ -627,20 +667,28 @@ void GameWorld::offsetGameTime(int minutes) {
     state->basic.gameHour = gameHour;
 }
 
-glm::vec3 GameWorld::getGroundAtPosition(const glm::vec3& pos) const {
-    btVector3 rayFrom(pos.x, pos.y, 100.f);
-    btVector3 rayTo(pos.x, pos.y, -100.f);
-
-    btDynamicsWorld::ClosestRayResultCallback rr(rayFrom, rayTo);
+namespace {
+/// getGroundAtPosition looks this far above and below
+constexpr float kGroundProbeHeight = 100.f;
+}  // namespace
 
-    dynamicsWorld->rayTest(rayFrom, rayTo, rr);
+glm::vec3 GameWorld::getGroundAtPosition(const glm::vec3& pos) const {
+    auto hit = raycasts->cast(glm::vec3(pos.x, pos.y, kGroundProbeHeight),
+                              glm::vec3(pos.x, pos.y, -kGroundProbeHeight),
+                              RaycastService::Filter::Static);
+    return hit.hit ? hit.position : pos;
+}
 
-    if (rr.hasHit()) {
-        auto& ws = rr.m_hitPointWorld;
-        return {ws.x(), ws.y(), ws.z()};
-    }
+RaycastService::Handle GameWorld::queueGroundProbe(const glm::vec3& pos) {
+    return raycasts->queue(glm::vec3(pos.x, pos.y, kGroundProbeHeight),
+                           glm::vec3(pos.x, pos.y, -kGroundProbeHeight),
+                           RaycastService::Filter::Static);
+}
 
-    return pos;
+glm::vec3 GameWorld::getGroundProbeResult(RaycastService::Handle probe,
+                                          const glm::vec3& pos) const {
+    const auto& hit = raycasts->getResult(probe);
+    return hit.hit ? hit.position : pos;
 }
 
 float GameWorld::getGameTime() const {
@@ -752,16 +800,28 @@ void GameWorld::loadCutscene(const std::string& name) {
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
 
-    auto datfile = data->index.openFile(lowerName + ".dat");
+    // Only the file index is shared with the loading thread, it isn't
+    // modified once the game is running
+    FileIndex* index = &data->index;
+    cutsceneLoad = std::async(std::launch::async, [index, lowerName] {
+        CutsceneData loaded;
 
-    CutsceneData* cutscene = new CutsceneData;
+        auto datfile = index->openFile(lowerName + ".dat");
+        if (datfile) {
+            LoaderCutsceneDAT loaderdat;
+            loaderdat.load(loaded.tracks, datfile);
+        }
 
-    if (datfile) {
-        LoaderCutsceneDAT loaderdat;
-        loaderdat.load(cutscene->tracks, datfile);
-    }
+        auto ifpfile = index->openFile(lowerName + ".ifp");
+        if (ifpfile) {
+            LoaderIFP loaderifp;
+            if (loaderifp.loadFromMemory(ifpfile->data)) {
+                loaded.animations = std::move(loaderifp.animations);
+            }
+        }
 
-    data->loadIFP(lowerName + ".ifp");
+        return loaded;
+    });
 
     cutsceneAudioLoaded = data->loadAudioStream(name + ".mp3");
 
@@ -776,12 +836,46 @@ void GameWorld::loadCutscene(const std::string& name) {
     if (state->currentCutscene) {
         delete state->currentCutscene;
     }
-    state->currentCutscene = cutscene;
+    state->currentCutscene = new CutsceneData;
     state->currentCutscene->meta.name = name;
-    logger->info("World", "Loaded cutscene: " + name);
+    logger->info("World", "Loading cutscene: " + name);
+}
+
+void GameWorld::finishCutsceneLoad() {
+    if (!cutsceneLoad.valid()) {
+        return;
+    }
+
+    try {
+        auto loaded = cutsceneLoad.get();
+        if (state->currentCutscene) {
+            state->currentCutscene->tracks = std::move(loaded.tracks);
+            state->currentCutscene->animations =
+                std::move(loaded.animations);
+        }
+    } catch (const std::exception& e) {
+        logger->error("Data", "Failed to load cutscene: ", e.what());
+    }
+}
+
+AnimationPtr GameWorld::findCutsceneAnimation(const std::string& name) {
+    finishCutsceneLoad();
+
+    if (state->currentCutscene) {
+        auto& animations = state->currentCutscene->animations;
+        auto it = animations.find(name);
+        if (it != animations.end()) {
+            return it->second;
+        }
+    }
+
+    auto it = data->animations.find(name);
+    return it != data->animations.end() ? it->second : nullptr;
 }
 
 void GameWorld::startCutscene() {
+    finishCutsceneLoad();
+
     state->cutsceneStartTime = getGameTime();
     state->skipCutscene = false;
 
@@ -791,6 +885,9 @@ void GameWorld::startCutscene() {
 }
 
 void GameWorld::clearCutscene() {
+    // The loading thread can't be abandoned, let it finish first
+    finishCutsceneLoad();
+
     for (auto& p : cutscenePool.objects) {
         destroyObjectQueued(p.second);
     }
@@ -820,8 +917,7 @@ bool GameWorld::isCutsceneDone() {
 void GameWorld::loadSpecialCharacter(const unsigned short index,
                                      const std::string& name) {
     constexpr uint16_t kFirstSpecialActor = 26;
-    logger->info("Data", "Loading special actor " + name + " to " +
-                             std::to_string(index));
+    logger->info("Data", "Loading special actor ", name, " to ", index);
     auto modelid = kFirstSpecialActor + index - 1;
     auto model = data->findModelInfo<PedModelInfo>(modelid);
     if (model && model->isLoaded()) {
@@ -835,8 +931,7 @@ void GameWorld::loadSpecialCharacter(const unsigned short index,
 
 void GameWorld::loadSpecialModel(const unsigned short index,
                                  const std::string& name) {
-    logger->info("Data", "Loading cutscene object " + name + " to " +
-                             std::to_string(index));
+    logger->info("Data", "Loading cutscene object ", name, " to ", index);
     // Tell the HIER model to discard the currently loaded model
     auto model = data->findModelInfo<ClumpModelInfo>(index);
     if (model && model->isLoaded()) {
@@ -859,6 +954,7 @@ void GameWorld::disableAIPaths(AIGraphNode::NodeType type, const glm::vec3& min,
             }
         }
     }
+    routePlanner.invalidate();
 }
 
 void GameWorld::enableAIPaths(AIGraphNode::NodeType type, const glm::vec3& min,
@@ -872,6 +968,7 @@ void GameWorld::enableAIPaths(AIGraphNode::NodeType type, const glm::vec3& min,
             }
         }
     }
+    routePlanner.invalidate();
 }
 
 void GameWorld::drawAreaIndicator(AreaIndicatorInfo::AreaIndicatorType type,
@@ -879,6 +976,141 @@ void GameWorld::drawAreaIndicator(AreaIndicatorInfo::AreaIndicatorType type,
     areaIndicators.push_back({type, position, radius});
 }
 
+void GameWorld::tickObjects(float dt) {
+    // Objects tick in fixed size chunks, so the deferred changes are applied
+    // in the same order however many threads there are
+    constexpr size_t kObjectsPerChunk = 64;
+
+    const size_t count = allObjects.size();
+    tickCommands.resize((count + kObjectsPerChunk - 1) / kObjectsPerChunk);
+
+    jobs.parallelFor(count, kObjectsPerChunk, [&](size_t begin, size_t end) {
+        WorldCommandBuffer::Scope scope(tickCommands[begin / kObjectsPerChunk]);
+        for (size_t i = begin; i < end; ++i) {
+            auto object = allObjects[i];
+            object->_updateLastTransform();
+            object->tickParallel(dt);
+        }
+    });
+
+    for (auto& commands : tickCommands) {
+        commands.apply();
+    }
+
+    // Objects created during the serial phase are ticked from the next frame
+    for (size_t i = 0; i < count; ++i) {
+        allObjects[i]->tickSerial(dt);
+    }
+
+    updateCrowd(dt);
+}
+
+void GameWorld::updateCrowd(float dt) {
+    auto player = pedestrianPool.find(state->playerObject);
+
+    // Characters that already have physics keep it until they're a little
+    // further away, so they don't switch back and forth
+    auto isNear = [](const CharacterObject* character, const glm::vec3& pos,
+                     float radius) {
+        if (!character->usesCrowdLocomotion()) {
+            radius *= kCrowdHysteresis;
+        }
+        return glm::distance2(character->getPosition(), pos) <
+               radius * radius;
+    };
+    auto canUseCrowd = [&](CharacterObject* character) {
+        if (character == player ||
+            character->getLifetime() != GameObject::TrafficLifetime ||
+            !character->isAlive() || character->isInWater() ||
+            character->getCurrentState().primaryActive) {
+            return false;
+        }
+        auto activity = character->controller->getCurrentActivity();
+        if (activity && !activity->canSkip(character, character->controller)) {
+            return false;
+        }
+        if (player && isNear(character, player->getPosition(),
+                             kCrowdPlayerRadius)) {
+            return false;
+        }
+        for (auto& v : vehiclePool.objects) {
+            if (isNear(character, v.second->getPosition(),
+                       kCrowdVehicleRadius)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    crowd.clear();
+    crowdAgents.clear();
+    for (auto& p : pedestrianPool.objects) {
+        auto character = static_cast<CharacterObject*>(p.second);
+        if (character->getCurrentVehicle()) {
+            continue;
+        }
+        character->setCrowdLocomotion(canUseCrowd(character));
+
+        const glm::vec2 position(character->getPosition());
+        if (character->usesCrowdLocomotion()) {
+            crowd.addAgent(position, glm::vec2(character->getMovementStep()));
+            crowdAgents.push_back(character);
+        } else {
+            crowd.addObstacle(position);
+        }
+    }
+
+    crowd.step(dt);
+
+    // Look for the ground only where characters moved away from the last
+    // place it was found, in one batch after they've all moved
+    constexpr auto kNoProbe =
+        std::numeric_limits<RaycastService::Handle>::max();
+    crowdProbes.assign(crowdAgents.size(), kNoProbe);
+    for (size_t i = 0; i < crowdAgents.size(); ++i) {
+        const auto& ground = crowdAgents[i]->crowdGround;
+        const auto position = crowd.getPosition(i);
+        if (!ground.valid || glm::distance2(position, ground.position) >
+                                 kCrowdGroundResample * kCrowdGroundResample) {
+            const float z = crowdAgents[i]->getPosition().z;
+            crowdProbes[i] = raycasts->queue(
+                glm::vec3(position, z + kCrowdStepHeight),
+                glm::vec3(position, z - kCrowdGroundProbe),
+                RaycastService::Filter::Static);
+        }
+    }
+    raycasts->flush(jobs);
+
+    for (size_t i = 0; i < crowdAgents.size(); ++i) {
+        auto character = crowdAgents[i];
+        auto& ground = character->crowdGround;
+        const auto position = crowd.getPosition(i);
+        float z = character->getPosition().z;
+
+        if (crowdProbes[i] != kNoProbe) {
+            const auto& hit = raycasts->getResult(crowdProbes[i]);
+            if (hit.hit) {
+                ground.position = position;
+                ground.height = hit.position.z;
+                ground.valid = true;
+            }
+        }
+        if (ground.valid) {
+            z = ground.height + kCrowdGroundOffset;
+        }
+
+        character->setCrowdPosition(glm::vec3(position, z));
+    }
+}
+
+void GameWorld::defer(WorldCommandBuffer::Command command) {
+    if (auto commands = WorldCommandBuffer::current()) {
+        commands->push(std::move(command));
+    } else {
+        command();
+    }
+}
+
 void GameWorld::clearTickData() {
     areaIndicators.clear();
 }
@@ -1014,10 +1246,9 @@ void GameWorld::clearObjectsWithinArea(const glm::vec3 center,
     /// area*, even if the bool is false?
 
     if (clearParticles) {
-        RW_UNUSED(clearParticles);
+        particles.clearTransient();
         RW_UNIMPLEMENTED(
-            "should clear all particles and projectiles (not limited to "
-            "area!)");
+            "should clear all projectiles (not limited to area!)");
     }
 
     // @todo Remove all temp objects, extinguish all fires, remove all
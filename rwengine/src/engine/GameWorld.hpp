@@ -2,6 +2,7 @@
 #define _RWENGINE_GAMEWORLD_HPP_
 
 #include <cstdint>
+#include <future>
 #include <map>
 #include <memory>
 #include <random>
@@ -15,14 +16,22 @@
 
 #include <ai/AIGraph.hpp>
 #include <ai/AIGraphNode.hpp>
+#include <ai/CrowdSimulation.hpp>
+#include <ai/RoutePlanner.hpp>
+#include <ai/TrafficDirector.hpp>
 #include <audio/SoundManager.hpp>
 
+#include <core/JobSystem.hpp>
+#include <dynamics/RaycastService.hpp>
+
 #include <engine/GarageController.hpp>
+#include <engine/WorldCommandBuffer.hpp>
 #include <objects/ObjectTypes.hpp>
 
-#include <render/VisualFX.hpp>
+#include <render/ParticleSystem.hpp>
 
 #include <data/Chase.hpp>
+#include <data/CutsceneData.hpp>
 
 class btCollisionDispatcher;
 class btDefaultCollisionConfiguration;
@@ -49,6 +58,7 @@ class VehicleObject;
 class PickupObject;
 
 class ViewCamera;
+class BakedWorld;
 
 struct BlipData;
 struct WeaponScan;
@@ -84,6 +94,11 @@ public:
      */
     bool placeItems(const std::string& name);
 
+    /**
+     * Places every instance of a baked world, see BakedWorld
+     */
+    void placeItems(const BakedWorld& baked);
+
     /**
      * @brief createTraffic spawn transitory peds and vehicles
      * @param viewCamera The camera to create traffic near
@@ -101,12 +116,33 @@ public:
      */
     void cleanupTraffic(const ViewCamera& viewCamera);
 
+    /**
+     * @brief updateTrafficPhysics switches vehicles not driven by the player
+     * between full physics and kinematic lane following, depending on their
+     * distance from the camera
+     * @param viewCamera
+     */
+    void updateTrafficPhysics(const ViewCamera& viewCamera);
+
+    /**
+     * Distance within which visible vehicles use full physics, see
+     * TrafficDirector::useKinematicSimulation
+     */
+    float vehiclePhysicsRadius = TrafficDirector::kDefaultPhysicsRadius;
+
+    /**
+     * Animates objects the renderer hasn't drawn lately, or only drew far
+     * away, with less detail, see Animator::chooseDetail
+     */
+    bool animationLOD = false;
+
     /**
      * Creates an instance
      */
     InstanceObject* createInstance(const uint16_t id, const glm::vec3& pos,
-                                   const glm::quat& rot = glm::quat{
-                                       1.0f, 0.0f, 0.0f, 0.0f});
+                                   const glm::quat& rot = glm::quat{1.0f, 0.0f,
+                                                                    0.0f, 0.0f},
+                                   GameObjectID gid = 0);
 
     /**
      * @brief Creates an InstanceObject for use in the current Cutscene.
@@ -143,7 +179,8 @@ public:
     /**
      * Creates a pickup
      */
-    PickupObject* createPickup(const glm::vec3& pos, int id, int type);
+    PickupObject* createPickup(const glm::vec3& pos, int id, int type,
+                               GameObjectID gid = 0);
 
     /**
      * Creates a garage
@@ -167,19 +204,27 @@ public:
     void destroyQueuedObjects();
 
     /**
-     * Performs a weapon scan against things in the world
+     * Ticks every object. tickParallel runs on the job system first, then
+     * the world changes it deferred are applied in object order, then
+     * tickSerial runs on this thread, and finally the crowd is moved.
      */
-    void doWeaponScan(const WeaponScan& scan);
+    void tickObjects(float dt);
+
+    /**
+     * Moves ambient pedestrians that aren't near the player, a vehicle or in
+     * the middle of something with CrowdSimulation instead of bullet
+     */
+    void updateCrowd(float dt);
 
     /**
-     * Allocates a new VisualFX of the given type
+     * Runs command now, or records it if this thread is in a parallel tick
      */
-    VisualFX* createEffect(VisualFX::EffectType type);
+    void defer(WorldCommandBuffer::Command command);
 
     /**
-     * Immediately destoys the given effect
+     * Performs a weapon scan against things in the world
      */
-    void destroyEffect(VisualFX* effect);
+    void doWeaponScan(const WeaponScan& scan);
 
     /**
      * Returns the current hour
@@ -200,8 +245,24 @@ public:
     //! Check if the weather conditions are rainy
     bool isRaining() const;
 
+    /**
+     * Finds the static geometry below pos, or returns pos if there is none
+     */
     glm::vec3 getGroundAtPosition(const glm::vec3& pos) const;
 
+    /**
+     * Queues the probe getGroundAtPosition casts, to find the ground under
+     * many positions in one batch
+     */
+    RaycastService::Handle queueGroundProbe(const glm::vec3& pos);
+
+    /**
+     * The ground found by a queued probe once raycasts are flushed, or pos
+     * if there is none
+     */
+    glm::vec3 getGroundProbeResult(RaycastService::Handle probe,
+                                   const glm::vec3& pos) const;
+
     float getGameTime() const;
 
     /**
@@ -284,16 +345,25 @@ public:
     AIGraph aigraph;
 
     /**
-     * Visual Effects
-     * @todo Consider using lighter handing mechanism
+     * Finds routes over aigraph
+     */
+    RoutePlanner routePlanner{aigraph};
+
+    /**
+     * Particle effects
      */
-    std::vector<VisualFX*> effects;
+    ParticleSystem particles;
 
     /**
      * Randomness Engine
      */
     std::default_random_engine randomEngine;
 
+    /**
+     * Worker threads for parallel updates
+     */
+    JobSystem jobs;
+
     /**
      * Bullet
      */
@@ -303,6 +373,11 @@ public:
     std::unique_ptr<btSequentialImpulseConstraintSolver> solver;
     std::unique_ptr<btDiscreteDynamicsWorld> dynamicsWorld;
 
+    /**
+     * Casts rays against dynamicsWorld, batching and caching them per tick
+     */
+    std::unique_ptr<RaycastService> raycasts;
+
     /**
      * @brief physicsNearCallback
      * Used to implement uprooting and other physics oddities.
@@ -319,16 +394,29 @@ public:
                                     btScalar timeStep);
 
     /**
-     * @brief Loads and starts the named cutscene.
-     * @param name
+     * @brief Makes the named cutscene current and starts loading it.
+     *
+     * The tracks and animations are read on a background thread, they are
+     * available once finishCutsceneLoad() has returned. startCutscene() and
+     * findCutsceneAnimation() wait for them.
      */
     void loadCutscene(const std::string& name);
+    /// Waits for the current cutscene's tracks and animations
+    void finishCutsceneLoad();
+    /**
+     * Finds an animation from the current cutscene's IFP, or from the
+     * animations that are always loaded.
+     */
+    AnimationPtr findCutsceneAnimation(const std::string& name);
     void startCutscene();
+    /// Ends the cutscene and releases its animations
     void clearCutscene();
     bool isCutsceneDone();
 
     std::string cutsceneAudio;
     bool cutsceneAudioLoaded;
+    /// Tracks and animations of the current cutscene, while they load
+    std::future<CutsceneData> cutsceneLoad;
     std::string missionAudio;
 
     /**
@@ -369,6 +457,19 @@ private:
      */
     std::set<GameObject*> deletionQueue;
 
+    /**
+     * Changes deferred by each chunk of objects in tickObjects
+     */
+    std::vector<WorldCommandBuffer> tickCommands;
+
+    /**
+     * Moves pedestrians using crowd locomotion, and the characters it moved
+     * in the last step with their ground probes, by agent index
+     */
+    CrowdSimulation crowd;
+    std::vector<CharacterObject*> crowdAgents;
+    std::vector<RaycastService::Handle> crowdProbes;
+
     std::vector<AreaIndicatorInfo> areaIndicators;
 
     /**
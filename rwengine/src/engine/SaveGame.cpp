@@ -5,7 +5,10 @@
 #include <cstring>
 #include <cstdio>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <utility>
 
 #include <rw/filesystem.hpp>
 
@@ -497,31 +500,571 @@ struct Block19Data {
     std::array<Block19PedType, kNrOfPedTypes> types;
 };
 
-void SaveGame::writeGame(GameState& state, const std::string& file) {
-    RW_UNUSED(state);
-    RW_UNUSED(file);
-    RW_UNIMPLEMENTED("Saving the game is not implemented yet.");
-}
+namespace {
+/// Added to the wake timer of threads on load, see loadGame
+/// @todo not hardcode +33 ms
+constexpr int kScriptWakeOffsetMS = 33;
+
+/**
+ * Bounds checked cursor over a save file that has been read into memory
+ */
+class BlockReader {
+public:
+    explicit BlockReader(const std::vector<char>& data) : data(data) {
+    }
+
+    template <class T>
+    bool read(T& out) {
+        return readBytes(&out, sizeof(out));
+    }
+
+    bool readBytes(void* out, size_t size) {
+        if (size > remaining()) {
+            return false;
+        }
+        std::memcpy(out, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    bool seek(size_t position) {
+        if (position > data.size()) {
+            return false;
+        }
+        offset = position;
+        return true;
+    }
+
+    size_t remaining() const {
+        return data.size() - offset;
+    }
+
+private:
+    const std::vector<char>& data;
+    size_t offset = 0;
+};
+
+/**
+ * Serialises blocks into a single buffer, so the file can be written at once
+ */
+class BlockWriter {
+public:
+    template <class T>
+    void write(const T& value) {
+        writeBytes(&value, sizeof(value));
+    }
+
+    void writeBytes(const void* in, size_t size) {
+        auto bytes = static_cast<const char*>(in);
+        data.insert(data.end(), bytes, bytes + size);
+    }
+
+    /// Reserves a size field, which is filled in by endSize
+    size_t beginSize() {
+        auto at = data.size();
+        write(BlockSize(0));
+        return at;
+    }
+
+    /// Sets the size at offset to the number of bytes written since
+    void endSize(size_t at) {
+        auto size = static_cast<BlockSize>(data.size() - at - sizeof(BlockSize));
+        std::memcpy(data.data() + at, &size, sizeof(size));
+    }
+
+    /// Appends the checksum of everything written so far
+    void writeChecksum() {
+        BlockDword checksum = 0;
+        for (char c : data) {
+            checksum += static_cast<uint8_t>(c);
+        }
+        write(checksum);
+    }
+
+    const std::vector<char>& getData() const {
+        return data;
+    }
+
+private:
+    std::vector<char> data;
+};
+}  // namespace
+
+bool SaveGame::writeGame(GameState& state, const std::string& file) {
+    BlockWriter writer;
+    // Most blocks wrap their data in a second size with a signature
+    auto beginSigned = [&](const char(&signature)[4]) {
+        auto outer = writer.beginSize();
+        writer.writeBytes(signature, sizeof(signature));
+        return std::make_pair(outer, writer.beginSize());
+    };
+    auto endSigned = [&](const std::pair<size_t, size_t>& sizes) {
+        writer.endSize(sizes.second);
+        writer.endSize(sizes.first);
+    };
+
+    // BLOCK 0
+    auto block = writer.beginSize();
+    writer.write(state.basic);
+
+    auto scriptBlock = beginSigned("SCR");
+    if (state.script) {
+        auto& globals = state.script->getGlobalData();
+        writer.write(static_cast<BlockDword>(globals.size()));
+        writer.writeBytes(globals.data(), globals.size());
+    } else {
+        writer.write(BlockDword(0));
+    }
+
+    Block0ScriptData scriptData{};
+    if (state.script && state.scriptOnMissionFlag) {
+        scriptData.onMissionOffset = static_cast<BlockDword>(
+            reinterpret_cast<SCMByte*>(state.scriptOnMissionFlag) -
+            state.script->getGlobals());
+    }
+    for (size_t c = 0; c < state.scriptContacts.size(); ++c) {
+        scriptData.contactInfo[c].missionFlag =
+            state.scriptContacts[c].onMissionOffset;
+        scriptData.contactInfo[c].baseBrief = state.scriptContacts[c].baseBrief;
+    }
+    if (state.script) {
+        auto scm = state.script->getFile();
+        scriptData.mainSize = scm->getMainSize();
+        scriptData.largestMissionSize = scm->getLargestMissionSize();
+        scriptData.missionCount =
+            static_cast<BlockWord>(scm->getMissionOffsets().size());
+    }
+    writer.write(static_cast<BlockDword>(sizeof(scriptData)));
+    writer.write(scriptData);
+
+    if (state.script) {
+        const auto& threads = state.script->getThreads();
+        writer.write(static_cast<BlockDword>(threads.size()));
+        for (const auto& thread : threads) {
+            Block0RunningScript script{};
+            std::strncpy(script.name, thread.name, sizeof(script.name));
+            script.programCounter = thread.programCounter;
+            for (int i = 0; i < SCM_STACK_DEPTH; ++i) {
+                script.stack[i] = thread.calls[i];
+            }
+            script.stackCounter = static_cast<BlockWord>(thread.stackDepth);
+            std::copy(thread.locals.begin(),
+                      thread.locals.begin() + sizeof(script.variables),
+                      script.variables);
+            script.ifFlag = thread.conditionResult;
+            script.ifNumber = static_cast<BlockWord>(thread.conditionCount);
+            script.wakeTimer = state.basic.lastTick +
+                               static_cast<BlockDword>(thread.wakeCounter -
+                                                       kScriptWakeOffsetMS);
+            writer.write(script);
+        }
+    } else {
+        writer.write(BlockDword(0));
+    }
+    endSigned(scriptBlock);
+    writer.endSize(block);
+
+    // BLOCK 1
+    CharacterObject* player = nullptr;
+    if (state.world) {
+        player = static_cast<CharacterObject*>(
+            state.world->pedestrianPool.find(state.playerObject));
+    }
+    block = writer.beginSize();
+    auto data = writer.beginSize();
+    writer.write(BlockDword(player ? 1 : 0));
+    if (player) {
+        Block1PlayerPed ped{};
+        const auto& cs = player->getCurrentState();
+        ped.info.position = player->getPosition();
+        ped.info.health = cs.health;
+        ped.info.armour = cs.armour;
+        for (int w = 0; w < kNrOfWeapons; ++w) {
+            ped.info.weapons[w].weaponId = cs.weapons[w].weaponId;
+            ped.info.weapons[w].inClip = cs.weapons[w].bulletsClip;
+            ped.info.weapons[w].totalBullets = cs.weapons[w].bulletsTotal;
+        }
+        ped.maxWantedLevel = state.maxWantedLevel;
+        writer.write(ped.unknown0);
+        writer.write(ped.unknown1);
+        writer.write(ped.reference);
+        writer.write(ped.info);
+        writer.write(ped.maxWantedLevel);
+        writer.write(ped.maxChaosLevel);
+        writer.write(ped.modelName);
+        writer.write(ped.align);
+    }
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 2
+    block = writer.beginSize();
+    data = writer.beginSize();
+    Block2GarageData garageData{};
+    garageData.garageCount = static_cast<BlockDword>(state.garages.size());
+    garageData.bfImportExportPortland =
+        static_cast<BlockDword>(state.importExportPortland.to_ulong());
+    garageData.bfImportExportShoreside =
+        static_cast<BlockDword>(state.importExportShoreside.to_ulong());
+    garageData.bfImportExportUnused =
+        static_cast<BlockDword>(state.importExportUnused.to_ulong());
+    writer.write(garageData.garageCount);
+    writer.write(garageData.freeBombs);
+    writer.write(garageData.freeResprays);
+    writer.write(garageData.unknown0);
+    writer.write(garageData.unknown1);
+    writer.write(garageData.unknown2);
+    writer.write(garageData.bfImportExportPortland);
+    writer.write(garageData.bfImportExportShoreside);
+    writer.write(garageData.bfImportExportUnused);
+    writer.write(garageData.GA_21lastTime);
+    writer.write(garageData.cars);
+    for (const auto& info : state.garages) {
+        StructGarage garage{};
+        garage.type = static_cast<uint8_t>(info.type);
+        garage.x1 = info.min.x;
+        garage.y1 = info.min.y;
+        garage.z1 = info.min.z;
+        garage.x2 = info.max.x;
+        garage.y2 = info.max.y;
+        garage.z2 = info.max.z;
+        writer.write(garage);
+    }
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 3, vehicles and boats are not persisted yet
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(BlockDword(0));
+    writer.write(BlockDword(0));
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 4, objects are not persisted yet
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(BlockDword(0));
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 5
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(BlockDword(0));
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 6
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(BlockDword(0));
+    writer.write(BlockDword(0));
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 7
+    block = writer.beginSize();
+    data = writer.beginSize();
+    Block7Data pickupData{};
+    writer.write(pickupData);
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 8
+    block = writer.beginSize();
+    data = writer.beginSize();
+    Block8Data phoneData{};
+    writer.write(phoneData);
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 9
+    block = writer.beginSize();
+    auto signedData = beginSigned("RST");
+    Block9Data restartData{};
+    auto copyRestarts = [](const std::vector<glm::vec4>& from,
+                           Block9Restart* to, BlockWord& count) {
+        count = static_cast<BlockWord>(std::min(from.size(), size_t(8)));
+        for (BlockWord r = 0; r < count; ++r) {
+            to[r].position = glm::vec3(from[r]);
+            to[r].angle = from[r].w;
+        }
+    };
+    copyRestarts(state.hospitalRestarts, restartData.hospitalRestarts,
+                 restartData.numHospitals);
+    copyRestarts(state.policeRestarts, restartData.policeRestarts,
+                 restartData.numPolice);
+    restartData.overrideFlag = state.overrideNextRestart;
+    restartData.overrideRestart.position =
+        glm::vec3(state.nextRestartLocation);
+    restartData.overrideRestart.angle = state.nextRestartLocation.w;
+    writer.write(restartData);
+    endSigned(signedData);
+    writer.endSize(block);
+
+    // BLOCK 10
+    block = writer.beginSize();
+    signedData = beginSigned("RDR");
+    Block10Data radarData{};
+    writer.write(radarData);
+    endSigned(signedData);
+    writer.endSize(block);
+
+    // BLOCK 11
+    block = writer.beginSize();
+    signedData = beginSigned("ZNS");
+    Block11Data zoneData{};
+    if (state.world) {
+        const auto& gamezones = state.world->data->gamezones;
+        auto zoneCount = std::min(gamezones.size(), size_t(kNrOfNavZones));
+        RW_CHECK(zoneCount == gamezones.size(), "Too many zones to save");
+        for (size_t z = 0; z < zoneCount; ++z) {
+            const auto& from = gamezones[z];
+            auto& zone = zoneData.navZones[z];
+            std::strncpy(zone.name, from.name.c_str(), sizeof(zone.name));
+            zone.coordA = from.min;
+            zone.coordB = from.max;
+            zone.type = static_cast<BlockDword>(from.type);
+            zone.level = static_cast<BlockDword>(from.island);
+            zone.dayZoneInfo = static_cast<BlockWord>(z * 2);
+            zone.nightZoneInfo = static_cast<BlockWord>(z * 2 + 1);
+
+            auto& day = zoneData.dayNightInfo[zone.dayZoneInfo];
+            auto& night = zoneData.dayNightInfo[zone.nightZoneInfo];
+            day.pedgroup = static_cast<BlockWord>(from.pedGroupDay);
+            night.pedgroup = static_cast<BlockWord>(from.pedGroupNight);
+            for (int g = 0; g < kNrOfGangs; ++g) {
+                day.gangpeddensity[g] =
+                    static_cast<BlockWord>(from.gangDensityDay[g]);
+                night.gangpeddensity[g] =
+                    static_cast<BlockWord>(from.gangDensityNight[g]);
+            }
+        }
+        zoneData.numNavZones = static_cast<BlockWord>(zoneCount);
+        zoneData.numZoneInfos = static_cast<BlockWord>(zoneCount * 2);
+    }
+    writer.write(zoneData.currentZone);
+    writer.write(zoneData.currentLevel);
+    writer.write(zoneData.findIndex);
+    writer.write(zoneData.align);
+    for (const auto& zone : zoneData.navZones) {
+        writer.write(zone.name);
+        writer.write(zone.coordA);
+        writer.write(zone.coordB);
+        writer.write(zone.type);
+        writer.write(zone.level);
+        writer.write(zone.dayZoneInfo);
+        writer.write(zone.nightZoneInfo);
+        writer.write(zone.childZone);
+        writer.write(zone.parentZone);
+        writer.write(zone.siblingZone);
+    }
+    for (const auto& info : zoneData.dayNightInfo) {
+        writer.write(info.density);
+        writer.write(info.unknown1);
+        writer.write(info.peddensity);
+        writer.write(info.copdensity);
+        writer.write(info.gangpeddensity);
+        writer.write(info.pedgroup);
+    }
+    writer.write(zoneData.numNavZones);
+    writer.write(zoneData.numZoneInfos);
+    for (const auto& zone : zoneData.mapZones) {
+        writer.write(zone.name);
+        writer.write(zone.coordA);
+        writer.write(zone.coordB);
+        writer.write(zone.type);
+        writer.write(zone.level);
+        writer.write(zone.dayZoneInfo);
+        writer.write(zone.nightZoneInfo);
+        writer.write(zone.childZone);
+        writer.write(zone.parentZone);
+        writer.write(zone.siblingZone);
+    }
+    for (const auto& audioZone : zoneData.audioZones) {
+        writer.write(audioZone);
+    }
+    writer.write(zoneData.numMapZones);
+    writer.write(zoneData.numAudioZones);
+    endSigned(signedData);
+    writer.endSize(block);
+
+    // BLOCK 12
+    block = writer.beginSize();
+    signedData = beginSigned("GNG");
+    Block12Data gangData{};
+    writer.write(gangData);
+    endSigned(signedData);
+    writer.endSize(block);
+
+    // BLOCK 13
+    block = writer.beginSize();
+    signedData = beginSigned("CGN");
+    Block13Data carGeneratorData{};
+    carGeneratorData.blockSize = sizeof(Block13Data) - sizeof(BlockDword);
+    carGeneratorData.generatorCount =
+        static_cast<BlockDword>(state.vehicleGenerators.size());
+    carGeneratorData.generatorSize = static_cast<BlockDword>(
+        state.vehicleGenerators.size() * sizeof(Block13CarGenerator));
+    writer.write(carGeneratorData);
+    for (const auto& generator : state.vehicleGenerators) {
+        Block13CarGenerator gen{};
+        gen.modelId = static_cast<BlockDword>(generator.vehicleID);
+        gen.position = generator.position;
+        gen.angle = generator.heading;
+        gen.colourFG = static_cast<BlockWord>(generator.colourFG);
+        gen.colourBG = static_cast<BlockWord>(generator.colourBG);
+        gen.force = generator.alwaysSpawn;
+        gen.alarmChance = static_cast<uint8_t>(generator.alarmThreshold);
+        gen.lockedChance = static_cast<uint8_t>(generator.lockedThreshold);
+        gen.minDelay = static_cast<BlockWord>(generator.minDelay);
+        gen.maxDelay = static_cast<BlockWord>(generator.maxDelay);
+        gen.timestamp = static_cast<BlockDword>(generator.lastSpawnTime);
+        writer.write(gen);
+    }
+    endSigned(signedData);
+    writer.endSize(block);
+
+    // BLOCK 14
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(BlockDword(0));
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 15
+    block = writer.beginSize();
+    signedData = beginSigned("AUD");
+    writer.write(BlockDword(0));
+    endSigned(signedData);
+    writer.endSize(block);
+
+    // BLOCK 16
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(state.playerInfo.money);
+    writer.write(state.playerInfo.unknown1);
+    writer.write(state.playerInfo.unknown2);
+    writer.write(state.playerInfo.unknown3);
+    writer.write(state.playerInfo.unknown4);
+    writer.write(state.playerInfo.displayedMoney);
+    writer.write(state.playerInfo.hiddenPackagesCollected);
+    writer.write(state.playerInfo.hiddenPackageCount);
+    writer.write(state.playerInfo.neverTired);
+    writer.write(state.playerInfo.fastReload);
+    writer.write(state.playerInfo.thaneOfLibertyCity);
+    writer.write(state.playerInfo.singlePayerHealthcare);
+    writer.write(state.playerInfo.unknown5);
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 17
+    block = writer.beginSize();
+    data = writer.beginSize();
+    writer.write(state.gameStats.playerKills);
+    writer.write(state.gameStats.otherKills);
+    writer.write(state.gameStats.carsExploded);
+    writer.write(state.gameStats.shotsHit);
+    writer.write(state.gameStats.pedTypesKilled);
+    writer.write(state.gameStats.helicoptersDestroyed);
+    writer.write(state.gameStats.playerProgress);
+    writer.write(state.gameStats.explosiveKgsUsed);
+    writer.write(state.gameStats.bulletsFired);
+    writer.write(state.gameStats.bulletsHit);
+    writer.write(state.gameStats.carsCrushed);
+    writer.write(state.gameStats.headshots);
+    writer.write(state.gameStats.timesBusted);
+    writer.write(state.gameStats.timesHospital);
+    writer.write(state.gameStats.daysPassed);
+    writer.write(state.gameStats.mmRainfall);
+    writer.write(state.gameStats.insaneJumpMaxDistance);
+    writer.write(state.gameStats.insaneJumpMaxHeight);
+    writer.write(state.gameStats.insaneJumpMaxFlips);
+    writer.write(state.gameStats.insaneJumpMaxRotation);
+    writer.write(state.gameStats.bestStunt);
+    writer.write(state.gameStats.uniqueStuntsFound);
+    writer.write(state.gameStats.uniqueStuntsTotal);
+    writer.write(state.gameStats.missionAttempts);
+    writer.write(state.gameStats.missionsPassed);
+    writer.write(state.gameStats.passengersDroppedOff);
+    writer.write(state.gameStats.taxiRevenue);
+    writer.write(state.gameStats.portlandPassed);
+    writer.write(state.gameStats.stauntonPassed);
+    writer.write(state.gameStats.shoresidePassed);
+    writer.write(state.gameStats.bestTurismoTime);
+    writer.write(state.gameStats.distanceWalked);
+    writer.write(state.gameStats.distanceDriven);
+    writer.write(state.gameStats.patriotPlaygroundTime);
+    writer.write(state.gameStats.aRideInTheParkTime);
+    writer.write(state.gameStats.grippedTime);
+    writer.write(state.gameStats.multistoryMayhemTime);
+    writer.write(state.gameStats.peopleSaved);
+    writer.write(state.gameStats.criminalsKilled);
+    writer.write(state.gameStats.highestParamedicLevel);
+    writer.write(state.gameStats.firesExtinguished);
+    writer.write(state.gameStats.longestDodoFlight);
+    writer.write(state.gameStats.bombDefusalTime);
+    writer.write(state.gameStats.rampagesPassed);
+    writer.write(state.gameStats.totalRampages);
+    writer.write(state.gameStats.totalMissions);
+    writer.write(state.gameStats.fastestTime);
+    writer.write(state.gameStats.highestScore);
+    writer.write(state.gameStats.peopleKilledSinceCheckpoint);
+    writer.write(state.gameStats.peopleKilledSinceLastBustedOrWasted);
+    writer.write(state.gameStats.lastMissionGXT);
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 18
+    block = writer.beginSize();
+    data = writer.beginSize();
+    Block18Data streamingData{};
+    writer.write(streamingData);
+    writer.endSize(data);
+    writer.endSize(block);
+
+    // BLOCK 19
+    block = writer.beginSize();
+    signedData = beginSigned("PTP");
+    Block19Data pedTypeData{};
+    writer.write(pedTypeData);
+    endSigned(signedData);
+    writer.endSize(block);
+
+    writer.writeChecksum();
+
+    std::ofstream saveFile(file, std::ios::binary | std::ios::trunc);
+    const auto& bytes = writer.getData();
+    if (!saveFile ||
+        !saveFile.write(bytes.data(),
+                        static_cast<std::streamsize>(bytes.size()))) {
+        RW_ERROR("Failed to write save file " << file);
+        return false;
+    }
 
-template <class T>
-bool readBlock(std::FILE* str, T& out) {
-    return std::fread(&out, sizeof(out), 1, str) == 1;
+    return true;
 }
 
 #define READ_VALUE(var)                                                   \
-    if (!readBlock(loadFile, var)) {                                      \
+    if (!reader.read(var)) {                                              \
         RW_ERROR(file << ": Failed to load block " #var);                 \
         return false;                                                     \
     }
 #define READ_SIZE(var)                                                   \
-    if (!readBlock(loadFile, var)) {                                     \
+    if (!reader.read(var)) {                                             \
         RW_ERROR(file << ": Failed to load size " #var);                 \
         return false;                                                    \
     }
+#define CHECK_COUNT(count, type)                                          \
+    if (count > reader.remaining() / sizeof(type)) {                      \
+        RW_ERROR(file << ": Invalid count " #count);                      \
+        return false;                                                     \
+    }
 #define CHECK_SIG(expected)                                               \
     {                                                                     \
         char signature[4];                                                \
-        if (fread(signature, sizeof(char), 4, loadFile) != 4) {           \
+        if (!reader.readBytes(signature, sizeof(signature))) {            \
             RW_ERROR("Failed to read signature");                         \
             return false;                                                 \
         }                                                                 \
@@ -530,17 +1073,31 @@ bool readBlock(std::FILE* str, T& out) {
             return false;                                                 \
         }                                                                 \
     }
-#define BLOCK_HEADER(sizevar)             \
-    fseek(loadFile, nextBlock, SEEK_SET); \
-    READ_SIZE(sizevar)                    \
+#define BLOCK_HEADER(sizevar)                                 \
+    if (!reader.seek(nextBlock)) {                            \
+        RW_ERROR(file << ": Block out of range " #sizevar);   \
+        return false;                                         \
+    }                                                         \
+    READ_SIZE(sizevar)                                        \
     nextBlock += sizeof(sizevar) + sizevar;
 
 bool SaveGame::loadGame(GameState& state, const std::string& file) {
-    std::FILE* loadFile = std::fopen(file.c_str(), "rb");
-    if (loadFile == nullptr) {
+    // Read the whole file up front, the blocks are parsed from memory
+    std::ifstream loadFile(file, std::ios::binary | std::ios::ate);
+    if (!loadFile) {
         RW_ERROR("Failed to open save file");
         return false;
     }
+    std::vector<char> saveData(static_cast<size_t>(loadFile.tellg()));
+    loadFile.seekg(0);
+    if (!loadFile.read(saveData.data(),
+                       static_cast<std::streamsize>(saveData.size()))) {
+        RW_ERROR("Failed to read save file");
+        return false;
+    }
+    loadFile.close();
+
+    BlockReader reader(saveData);
 
     BlockSize nextBlock = 0;
 
@@ -560,10 +1117,12 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     BlockDword scriptVarCount;
     READ_SIZE(scriptVarCount)
-    RW_ASSERT(scriptVarCount == state.script->getFile()->getGlobalsSize());
+    if (scriptVarCount != state.script->getFile()->getGlobalsSize()) {
+        RW_ERROR("Script memory size does not match the loaded script");
+        return false;
+    }
 
-    if (fread(state.script->getGlobals(), sizeof(SCMByte), scriptVarCount,
-              loadFile) != scriptVarCount) {
+    if (!reader.readBytes(state.script->getGlobals(), scriptVarCount)) {
         RW_ERROR("Failed to read script memory");
         return false;
     }
@@ -579,6 +1138,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     BlockDword numScripts;
     READ_SIZE(numScripts)
+    CHECK_COUNT(numScripts, Block0RunningScript)
     std::vector<Block0RunningScript> scripts(numScripts);
     for (size_t i = 0; i < numScripts; ++i) {
         READ_VALUE(scripts[i]);
@@ -591,6 +1151,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     READ_SIZE(playerInfoSize)
     BlockDword playerCount;
     READ_SIZE(playerCount)
+    CHECK_COUNT(playerCount, Block1PlayerPed)
 
     std::vector<Block1PlayerPed> players(playerCount);
     for (unsigned int p = 0; p < playerCount; ++p) {
@@ -633,6 +1194,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     READ_VALUE(garageData.bfImportExportUnused)
     READ_VALUE(garageData.GA_21lastTime)
     READ_VALUE(garageData.cars)
+    CHECK_COUNT(garageData.garageCount, StructGarage)
 
     std::vector<StructGarage> garages(garageData.garageCount);
     for (size_t i = 0; i < garageData.garageCount; ++i) {
@@ -666,6 +1228,8 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     BlockDword boatCount;
     READ_VALUE(vehicleCount)
     READ_VALUE(boatCount)
+    CHECK_COUNT(vehicleCount, Block3Vehicle)
+    CHECK_COUNT(boatCount, Block3Boat)
 
     std::vector<Block3Vehicle> vehicles(vehicleCount);
     for (size_t v = 0; v < vehicleCount; ++v) {
@@ -702,6 +1266,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     BlockDword objectCount;
     READ_VALUE(objectCount);
+    CHECK_COUNT(objectCount, Block4Object)
 
     std::vector<Block4Object> objects(objectCount);
     for (size_t o = 0; o < objectCount; ++o) {
@@ -767,6 +1332,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     BlockDword numPaths;
     READ_VALUE(numPaths)
+    CHECK_COUNT(numPaths, uint8_t)
     for (size_t b = 0; b < numPaths; ++b) {
         uint8_t bits;
         READ_VALUE(bits)
@@ -781,6 +1347,10 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     Block6Data craneData;
     READ_VALUE(craneData.numCranes)
     READ_VALUE(craneData.militaryCollected)
+    if (craneData.numCranes > sizeof(craneData.cranes) / sizeof(Block6Crane)) {
+        RW_ERROR(file << ": Invalid crane count");
+        return false;
+    }
     for (size_t c = 0; c < craneData.numCranes; ++c) {
         Block6Crane& crane = craneData.cranes[c];
         READ_VALUE(crane)
@@ -822,6 +1392,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     Block8Data phoneData;
     READ_VALUE(phoneData);
+    CHECK_COUNT(phoneData.numPhones, Block8Phone)
     std::vector<Block8Phone> phones(phoneData.numPhones);
     for (size_t p = 0; p < phoneData.numPhones; ++p) {
         Block8Phone& phone = phones[p];
@@ -935,6 +1506,19 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     }
     READ_VALUE(zoneData.numMapZones);
     READ_VALUE(zoneData.numAudioZones);
+    if (zoneData.numNavZones > kNrOfNavZones ||
+        zoneData.numMapZones > kNrOfMapZones) {
+        RW_ERROR(file << ": Invalid zone count");
+        return false;
+    }
+    for (int z = 0; z < zoneData.numNavZones; ++z) {
+        auto& zone = zoneData.navZones[z];
+        if (zone.dayZoneInfo >= kNrOfDayNightInfo ||
+            zone.nightZoneInfo >= kNrOfDayNightInfo) {
+            RW_ERROR(file << ": Invalid zone info index");
+            return false;
+        }
+    }
 
 #if RW_DEBUG
     std::cout << "zones: " << zoneData.numNavZones << " "
@@ -982,18 +1566,15 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
         Block11Zone& zone = zoneData.navZones[z];
         Block11ZoneInfo& day = zoneData.dayNightInfo[zone.dayZoneInfo];
         Block11ZoneInfo& night = zoneData.dayNightInfo[zone.nightZoneInfo];
-        // @toodo restore gang density
-        gamezones.emplace_back(zone.name, zone.type, zone.coordA, zone.coordB,
+        std::string name(zone.name, strnlen(zone.name, sizeof(zone.name)));
+        gamezones.emplace_back(name, zone.type, zone.coordA, zone.coordB,
                             zone.level, day.pedgroup, night.pedgroup);
-    }
-    // Re-build zone hierarchy
-    for (ZoneData& zone : gamezones) {
-        if (&zone == &gamezones[0]) {
-            continue;
+        for (int g = 0; g < kNrOfGangs; ++g) {
+            gamezones.back().gangDensityDay[g] = day.gangpeddensity[g];
+            gamezones.back().gangDensityNight[g] = night.gangpeddensity[g];
         }
-
-        gamezones[0].insertZone(zone);
     }
+    state.world->data->rebuildZones();
 
     // Block 12
     BlockSize gangBlockSize;
@@ -1023,6 +1604,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     Block13Data carGeneratorData;
     READ_VALUE(carGeneratorData);
+    CHECK_COUNT(carGeneratorData.generatorCount, Block13CarGenerator)
 
     std::vector<Block13CarGenerator> carGenerators(
         carGeneratorData.generatorCount);
@@ -1048,6 +1630,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     BlockDword particleCount;
     READ_VALUE(particleCount);
+    CHECK_COUNT(particleCount, Block14Particle)
     std::vector<Block14Particle> particles(particleCount);
     for (size_t p = 0; p < particleCount; ++p) {
         READ_VALUE(particles[p])
@@ -1067,6 +1650,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
 
     BlockDword audioCount;
     READ_VALUE(audioCount)
+    CHECK_COUNT(audioCount, Block15AudioObject)
 
     std::vector<Block15AudioObject> audioObjects(audioCount);
     for (size_t a = 0; a < audioCount; ++a) {
@@ -1221,20 +1805,21 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     state.scriptOnMissionFlag = (int32_t*)(state.script->getGlobals() +
                                            (size_t)scriptData.onMissionOffset);
 
-    auto& threads = state.script->getThreads();
     for (size_t s = 0; s < numScripts; ++s) {
-        state.script->startThread(scripts[s].programCounter);
-        SCMThread& thread = threads.back();
+        SCMThread& thread =
+            state.script->startThread(scripts[s].programCounter);
         // thread.baseAddress // ??
-        strncpy(thread.name, scripts[s].name, sizeof(SCMThread::name) - 1);
+        strncpy(thread.name, scripts[s].name, sizeof(Block0RunningScript::name));
+        thread.name[sizeof(Block0RunningScript::name)] = '\0';
         thread.conditionResult = scripts[s].ifFlag;
         thread.conditionCount = scripts[s].ifNumber;
         thread.stackDepth = scripts[s].stackCounter;
         for (int i = 0; i < SCM_STACK_DEPTH; ++i) {
             thread.calls[i] = scripts[s].stack[i];
         }
-        /* TODO not hardcode +33 ms */
-        thread.wakeCounter = scripts[s].wakeTimer - state.basic.lastTick + 33;
+        thread.wakeCounter = static_cast<int>(scripts[s].wakeTimer -
+                                              state.basic.lastTick) +
+                             kScriptWakeOffsetMS;
         for (size_t i = 0; i < sizeof(Block0RunningScript::variables); ++i) {
             thread.locals[i] = scripts[s].variables[i];
         }
@@ -1293,29 +1878,21 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     state.importExportShoreside = garageData.bfImportExportShoreside;
     state.importExportUnused = garageData.bfImportExportUnused;
 
-    std::fclose(loadFile);
-
     return true;
 }
 
 bool SaveGame::getSaveInfo(const std::string& file, BasicState* basicState) {
-    std::FILE* loadFile = std::fopen(file.c_str(), "rb");
-
-    SaveGameInfo info;
-    info.savePath = file;
-
-    // BLOCK 0
-    BlockDword blockSize;
-    if (fread(&blockSize, sizeof(BlockDword), 1, loadFile) == 0) {
+    std::ifstream loadFile(file, std::ios::binary);
+    if (!loadFile) {
         return false;
     }
 
-    // Read block 0 into state
-    if (fread(basicState, sizeof(BasicState), 1, loadFile) == 0) {
+    // Only the size of block 0 and the BasicState that begins it are needed
+    char header[sizeof(BlockSize) + sizeof(BasicState)];
+    if (!loadFile.read(header, sizeof(header))) {
         return false;
     }
-
-    std::fclose(loadFile);
+    std::memcpy(basicState, header + sizeof(BlockSize), sizeof(BasicState));
 
     return true;
 }
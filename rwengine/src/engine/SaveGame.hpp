@@ -19,9 +19,12 @@ class SaveGame {
 public:
     /**
      * Writes the entire game state to a file format that closely approximates
-     * the format used in GTA III
+     * the format used in GTA III.
+     *
+     * The blocks are serialised into memory and written with a single write.
+     * @return status, false if the file could not be written.
      */
-    static void writeGame(GameState& state, const std::string& file);
+    static bool writeGame(GameState& state, const std::string& file);
 
     /**
      * Loads an entire Game State from a file, using a format similar to the
@@ -33,6 +36,9 @@ public:
      */
     static bool loadGame(GameState& state, const std::string& file);
 
+    /**
+     * Reads the BasicState of a save, without reading the rest of the file
+     */
     static bool getSaveInfo(const std::string& file, BasicState* outState);
 
     /**
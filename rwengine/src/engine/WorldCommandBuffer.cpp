@@ -0,0 +1,30 @@
+#include "engine/WorldCommandBuffer.hpp"
+
+#include <utility>
+
+namespace {
+thread_local WorldCommandBuffer* currentBuffer = nullptr;
+}  // namespace
+
+WorldCommandBuffer::Scope::Scope(WorldCommandBuffer& buffer)
+    : previous(currentBuffer) {
+    currentBuffer = &buffer;
+}
+
+WorldCommandBuffer::Scope::~Scope() {
+    currentBuffer = previous;
+}
+
+WorldCommandBuffer* WorldCommandBuffer::current() {
+    return currentBuffer;
+}
+
+void WorldCommandBuffer::apply() {
+    // Commands may record more commands if a scope is still active, so take
+    // the list first
+    auto pending = std::move(commands);
+    commands.clear();
+    for (auto& command : pending) {
+        command();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef _RWENGINE_WORLDCOMMANDBUFFER_HPP_
+#define _RWENGINE_WORLDCOMMANDBUFFER_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Records changes to the world made while objects tick in parallel
+ *
+ * A buffer is made current on a thread with a Scope. While it is, world
+ * changes that go through GameWorld::defer (or destroyObjectQueued) are
+ * recorded instead of applied, and apply() later runs them on the game
+ * thread in the order they were recorded.
+ */
+class WorldCommandBuffer {
+public:
+    using Command = std::function<void()>;
+
+    /**
+     * Makes a buffer current on this thread until the scope ends
+     */
+    class Scope {
+    public:
+        explicit Scope(WorldCommandBuffer& buffer);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        WorldCommandBuffer* previous;
+    };
+
+    /// Buffer the calling thread records into, or nullptr
+    static WorldCommandBuffer* current();
+
+    void push(Command command) {
+        commands.push_back(std::move(command));
+    }
+
+    /// Runs and removes the commands, oldest first
+    void apply();
+
+    void clear() {
+        commands.clear();
+    }
+
+    size_t size() const {
+        return commands.size();
+    }
+
+    bool empty() const {
+        return commands.empty();
+    }
+
+private:
+    std::vector<Command> commands;
+};
+
+#endif
@@ -0,0 +1,321 @@
+#include "engine/WorldSnapshot.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include <btBulletDynamicsCommon.h>
+#include <rw/defines.hpp>
+
+#include "ai/CharacterController.hpp"
+#include "ai/PlayerController.hpp"
+#include "dynamics/CollisionInstance.hpp"
+#include "engine/GameWorld.hpp"
+#include "objects/InstanceObject.hpp"
+#include "objects/PickupObject.hpp"
+#include "objects/VehicleObject.hpp"
+
+namespace {
+// Pools restored by the snapshot, in the order objects are recreated so that
+// vehicles exist before the characters seated in them
+const GameObject::Type kSnapshotTypes[] = {
+    GameObject::Instance, GameObject::Vehicle, GameObject::Character,
+    GameObject::Pickup};
+
+GameWorld::ObjectPool* getPool(GameWorld& world, GameObject::Type type) {
+    switch (type) {
+        case GameObject::Instance:
+            return &world.instancePool;
+        case GameObject::Character:
+            return &world.pedestrianPool;
+        case GameObject::Vehicle:
+            return &world.vehiclePool;
+        case GameObject::Pickup:
+            return &world.pickupPool;
+        default:
+            return nullptr;
+    }
+}
+
+btRigidBody* getRigidBody(GameObject* object) {
+    switch (object->type()) {
+        case GameObject::Vehicle:
+            return static_cast<VehicleObject*>(object)
+                ->collision->getBulletBody();
+        case GameObject::Instance: {
+            auto instance = static_cast<InstanceObject*>(object);
+            return instance->body ? instance->body->getBulletBody() : nullptr;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+bool isPlayerCharacter(GameWorld& world, CharacterObject* character) {
+    return std::any_of(world.players.begin(), world.players.end(),
+                       [&](PlayerController* player) {
+                           return player->getCharacter() == character;
+                       });
+}
+
+GameObject* findObject(GameWorld& world,
+                       const std::pair<GameObject::Type, GameObjectID>& ref) {
+    auto pool = getPool(world, ref.first);
+    return pool ? pool->find(ref.second) : nullptr;
+}
+}  // namespace
+
+WorldSnapshot::WorldSnapshot(GameWorld& world)
+    : randomEngine(world.randomEngine)
+    , garageControllerCount(world.garageControllers.size()) {
+    for (auto type : kSnapshotTypes) {
+        for (auto& p : getPool(world, type)->objects) {
+            auto object = p.second;
+
+            ObjectState s;
+            s.id = p.first;
+            s.type = type;
+            s.modelID = object->getModelInfo<BaseModelInfo>()->id();
+            s.position = object->getPosition();
+            s.rotation = object->getRotation();
+            s.lifetime = object->getLifetime();
+
+            if (auto body = getRigidBody(object)) {
+                const auto& lv = body->getLinearVelocity();
+                const auto& av = body->getAngularVelocity();
+                s.linearVelocity = {lv.x(), lv.y(), lv.z()};
+                s.angularVelocity = {av.x(), av.y(), av.z()};
+            }
+
+            switch (type) {
+                case GameObject::Character: {
+                    auto character = static_cast<CharacterObject*>(object);
+                    s.character = character->getCurrentState();
+                    s.isPlayer = isPlayerCharacter(world, character);
+                    if (auto vehicle = character->getCurrentVehicle()) {
+                        s.vehicle = vehicle->getGameObjectID();
+                        s.seat = character->getCurrentSeat();
+                    }
+                } break;
+                case GameObject::Vehicle: {
+                    auto vehicle = static_cast<VehicleObject*>(object);
+                    s.health = vehicle->health;
+                    s.colourPrimary = vehicle->colourPrimary;
+                    s.colourSecondary = vehicle->colourSecondary;
+                    s.steering = vehicle->getSteeringAngle();
+                    s.throttle = vehicle->getThrottle();
+                    s.braking = vehicle->getBraking();
+                    s.handbraking = vehicle->getHandbraking();
+                } break;
+                case GameObject::Pickup: {
+                    auto pickup = static_cast<PickupObject*>(object);
+                    s.pickupType = pickup->getPickupType();
+                    s.enabled = pickup->isEnabled();
+                    s.collected = pickup->isCollected();
+                } break;
+                default:
+                    break;
+            }
+
+            objects.push_back(s);
+        }
+    }
+
+    if (world.state) {
+        hasState = true;
+        state = *world.state;
+        for (auto object : world.state->missionObjects) {
+            missionObjects.emplace_back(object->type(),
+                                        object->getGameObjectID());
+        }
+        for (const auto& garage : world.state->garages) {
+            garageTargets.emplace_back(
+                garage.target ? garage.target->type() : GameObject::Unknown,
+                garage.target ? garage.target->getGameObjectID() : 0);
+        }
+
+        if (world.state->script) {
+            hasScript = true;
+            script = world.state->script->createSnapshot();
+        }
+    }
+}
+
+void WorldSnapshot::restore(GameWorld& world) const {
+    world.destroyQueuedObjects();
+
+    // Seating is rebuilt from the snapshot once every object exists again
+    for (auto& p : world.vehiclePool.objects) {
+        static_cast<VehicleObject*>(p.second)->ejectAll();
+    }
+
+    std::set<std::pair<GameObject::Type, GameObjectID>> captured;
+    for (const auto& s : objects) {
+        captured.emplace(s.type, s.id);
+    }
+
+    auto destroy = [&](GameObject* object) {
+        if (object->type() == GameObject::Character) {
+            auto& players = world.players;
+            players.erase(std::remove_if(players.begin(), players.end(),
+                                         [&](PlayerController* player) {
+                                             return player->getCharacter() ==
+                                                    object;
+                                         }),
+                          players.end());
+        }
+        for (auto it = world.modelInstances.begin();
+             it != world.modelInstances.end();) {
+            if (it->second == object) {
+                it = world.modelInstances.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        world.destroyObject(object);
+    };
+
+    std::vector<GameObject*> stale;
+    for (auto type : kSnapshotTypes) {
+        for (auto& p : getPool(world, type)->objects) {
+            if (captured.find({type, p.first}) == captured.end()) {
+                stale.push_back(p.second);
+            }
+        }
+    }
+    for (auto& p : world.projectilePool.objects) {
+        stale.push_back(p.second);
+    }
+    for (auto object : stale) {
+        destroy(object);
+    }
+
+    for (const auto& s : objects) {
+        auto object = getPool(world, s.type)->find(s.id);
+        if (object == nullptr) {
+            switch (s.type) {
+                case GameObject::Instance:
+                    object = world.createInstance(s.modelID, s.position,
+                                                  s.rotation, s.id);
+                    break;
+                case GameObject::Vehicle:
+                    object = world.createVehicle(s.modelID, s.position,
+                                                 s.rotation, s.id);
+                    break;
+                case GameObject::Character:
+                    object = s.isPlayer
+                                 ? world.createPlayer(s.position, s.rotation,
+                                                      s.id)
+                                 : world.createPedestrian(
+                                       s.modelID, s.position, s.rotation, s.id);
+                    break;
+                case GameObject::Pickup:
+                    object = world.createPickup(s.position, s.modelID,
+                                                s.pickupType, s.id);
+                    break;
+                default:
+                    break;
+            }
+            RW_CHECK(object != nullptr, "Failed to recreate snapshot object");
+            if (object == nullptr) {
+                continue;
+            }
+        }
+
+        object->setPosition(s.position);
+        object->setRotation(s.rotation);
+        object->setLifetime(s.lifetime);
+        object->_updateLastTransform();
+
+        if (auto body = getRigidBody(object)) {
+            body->setLinearVelocity(btVector3(
+                s.linearVelocity.x, s.linearVelocity.y, s.linearVelocity.z));
+            body->setAngularVelocity(btVector3(
+                s.angularVelocity.x, s.angularVelocity.y, s.angularVelocity.z));
+            body->activate();
+        }
+
+        switch (s.type) {
+            case GameObject::Character: {
+                auto character = static_cast<CharacterObject*>(object);
+                character->getCurrentState() = s.character;
+                character->controller->clearActivities();
+            } break;
+            case GameObject::Vehicle: {
+                auto vehicle = static_cast<VehicleObject*>(object);
+                vehicle->health = s.health;
+                vehicle->colourPrimary = s.colourPrimary;
+                vehicle->colourSecondary = s.colourSecondary;
+                vehicle->setSteeringAngle(s.steering);
+                vehicle->setThrottle(s.throttle);
+                vehicle->setBraking(s.braking);
+                vehicle->setHandbraking(s.handbraking);
+            } break;
+            case GameObject::Pickup: {
+                auto pickup = static_cast<PickupObject*>(object);
+                pickup->setEnabled(s.enabled);
+                pickup->setCollected(s.collected);
+            } break;
+            default:
+                break;
+        }
+    }
+
+    for (const auto& s : objects) {
+        if (s.type != GameObject::Character || s.vehicle == 0) {
+            continue;
+        }
+        auto character = static_cast<CharacterObject*>(
+            world.pedestrianPool.find(s.id));
+        auto vehicle =
+            static_cast<VehicleObject*>(world.vehiclePool.find(s.vehicle));
+        if (character && vehicle) {
+            vehicle->setOccupant(s.seat, character);
+            character->setCurrentVehicle(vehicle, s.seat);
+        }
+    }
+
+    // Followers may still point at characters that were just destroyed
+    for (auto& p : world.pedestrianPool.objects) {
+        auto controller = static_cast<CharacterObject*>(p.second)->controller;
+        auto target = controller->getTargetCharacter();
+        if (target && world.pedestrianPool.find(
+                          target->getGameObjectID()) != target) {
+            controller->setTargetCharacter(nullptr);
+        }
+    }
+
+    if (world.garageControllers.size() > garageControllerCount) {
+        world.garageControllers.resize(garageControllerCount);
+    }
+
+    if (hasState && world.state) {
+        auto& current = *world.state;
+        // Runtime links belong to the running game rather than the snapshot
+        auto previous = current;
+        current = state;
+        current.world = previous.world;
+        current.script = previous.script;
+        current.currentCutscene = previous.currentCutscene;
+        current.scriptOnMissionFlag = previous.scriptOnMissionFlag;
+        current.input[0] = previous.input[0];
+        current.input[1] = previous.input[1];
+
+        current.missionObjects.clear();
+        for (const auto& ref : missionObjects) {
+            if (auto object = findObject(world, ref)) {
+                current.missionObjects.push_back(object);
+            }
+        }
+        for (size_t i = 0;
+             i < current.garages.size() && i < garageTargets.size(); ++i) {
+            current.garages[i].target = findObject(world, garageTargets[i]);
+        }
+
+        if (hasScript && current.script) {
+            current.script->restoreSnapshot(script);
+        }
+    }
+
+    world.randomEngine = randomEngine;
+    world.particles.clearTransient();
+}
@@ -0,0 +1,101 @@
+#ifndef _RWENGINE_WORLDSNAPSHOT_HPP_
+#define _RWENGINE_WORLDSNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <engine/GameState.hpp>
+#include <objects/CharacterObject.hpp>
+#include <objects/GameObject.hpp>
+#include <script/ScriptMachine.hpp>
+
+class GameWorld;
+
+/**
+ * @brief In-memory copy of the mutable parts of a GameWorld
+ *
+ * Captures the object pools, object transforms and physics velocities, the
+ * GameState and the script machine, so that a world can be rolled back
+ * without reloading any GameData. Intended for resetting tests and tools to a
+ * known state cheaply.
+ *
+ * Objects keep their GameObjectIDs across a restore, objects created after
+ * the snapshot are destroyed and objects destroyed since are recreated from
+ * their model. Projectiles and transient particles are cleared, character AI
+ * activities are reset.
+ */
+class WorldSnapshot {
+public:
+    /**
+     * Captures the current state of world, and its GameState and
+     * ScriptMachine if it has them.
+     */
+    explicit WorldSnapshot(GameWorld& world);
+
+    /**
+     * Rolls world back to the captured state.
+     * world must be the same world (or share its GameData) that was captured.
+     */
+    void restore(GameWorld& world) const;
+
+    size_t getObjectCount() const {
+        return objects.size();
+    }
+
+private:
+    /// Refers to an object by pool, since pointers don't survive a restore
+    using ObjectRef = std::pair<GameObject::Type, GameObjectID>;
+
+    struct ObjectState {
+        GameObjectID id;
+        GameObject::Type type;
+        uint16_t modelID;
+        glm::vec3 position;
+        glm::quat rotation;
+        GameObject::ObjectLifetime lifetime;
+        glm::vec3 linearVelocity{};
+        glm::vec3 angularVelocity{};
+
+        // Characters
+        CharacterState character{};
+        bool isPlayer = false;
+        GameObjectID vehicle = 0;
+        size_t seat = 0;
+
+        // Vehicles
+        float health = 0.f;
+        glm::u8vec3 colourPrimary{};
+        glm::u8vec3 colourSecondary{};
+        float steering = 0.f;
+        float throttle = 0.f;
+        float braking = 0.f;
+        bool handbraking = false;
+
+        // Pickups
+        int pickupType = 0;
+        bool enabled = true;
+        bool collected = false;
+    };
+
+    std::vector<ObjectState> objects;
+
+    bool hasState = false;
+    GameState state;
+    std::vector<ObjectRef> missionObjects;
+    std::vector<ObjectRef> garageTargets;
+
+    bool hasScript = false;
+    ScriptMachine::Snapshot script;
+
+    std::default_random_engine randomEngine;
+    size_t garageControllerCount = 0;
+};
+
+#endif
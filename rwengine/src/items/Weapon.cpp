@@ -5,11 +5,16 @@
 #include <glm/glm.hpp>
 
 #include "data/WeaponData.hpp"
+#include "engine/Animator.hpp"
 #include "engine/GameWorld.hpp"
 #include "objects/CharacterObject.hpp"
 #include "objects/ProjectileObject.hpp"
 
 void Weapon::fireHitscan(WeaponData* weapon, CharacterObject* owner) {
+    // The pose may be out of date if the owner animates with less detail
+    if (owner->animator->getDetail() != Animator::Detail::Full) {
+        owner->animator->updatePose();
+    }
     auto handFrame = owner->getClump()->findFrame("srhand");
     glm::mat4 handMatrix = handFrame->getWorldTransform();
 
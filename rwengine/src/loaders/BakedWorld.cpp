@@ -0,0 +1,194 @@
+#include "loaders/BakedWorld.hpp"
+
+#include <fstream>
+#include <utility>
+
+#include "data/InstanceData.hpp"
+#include "loaders/LoaderIPL.hpp"
+
+constexpr uint32_t BakedWorld::kVersion;
+
+namespace {
+constexpr uint32_t kBakeMagic = 0x42575752;  // "RWWB"
+
+// Instances are read and written as raw memory
+static_assert(sizeof(BakedWorld::Instance) == 9 * sizeof(uint32_t),
+              "Baked instances must be tightly packed");
+
+template <class T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writeValue(out, static_cast<uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+template <class T>
+bool readValue(std::istream& in, T& value) {
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readString(std::istream& in, std::string& str) {
+    uint32_t size;
+    if (!readValue(in, size)) {
+        return false;
+    }
+    str.resize(size);
+    return size == 0 || bool(in.read(&str[0], size));
+}
+}  // namespace
+
+bool BakedWorld::stampSources(const SourceList& sources,
+                              std::vector<SourceStamp>& out) {
+    out.clear();
+    rwfs::error_code ec;
+    for (const auto& source : sources) {
+        auto size = rwfs::file_size(source.second, ec);
+        if (ec) {
+            return false;
+        }
+        auto writeTime = rwfs::write_time_value(source.second, ec);
+        if (ec) {
+            return false;
+        }
+        out.push_back(
+            {source.first, source.second, uint64_t(size), writeTime});
+    }
+    return true;
+}
+
+bool BakedWorld::bake(const SourceList& sources) {
+    instances.clear();
+    zones.clear();
+    if (!stampSources(sources, stamps)) {
+        return false;
+    }
+
+    uint32_t sourceIndex = 0;
+    for (const auto& source : sources) {
+        LoaderIPL ipll;
+        if (!ipll.load(source.second)) {
+            return false;
+        }
+
+        instances.reserve(instances.size() + ipll.m_instances.size());
+        for (const auto& inst : ipll.m_instances) {
+            instances.push_back({inst->id, sourceIndex, inst->pos, inst->rot});
+        }
+        zones.insert(zones.end(), ipll.zones.begin(), ipll.zones.end());
+        sourceIndex++;
+    }
+
+    return true;
+}
+
+bool BakedWorld::save(const rwfs::path& path) const {
+    std::ofstream out(path.string(), std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    writeValue(out, kBakeMagic);
+    writeValue(out, kVersion);
+
+    writeValue(out, static_cast<uint32_t>(stamps.size()));
+    for (const auto& stamp : stamps) {
+        writeString(out, stamp.name);
+        writeString(out, stamp.path);
+        writeValue(out, stamp.size);
+        writeValue(out, stamp.writeTime);
+    }
+
+    writeValue(out, static_cast<uint32_t>(zones.size()));
+    for (const auto& zone : zones) {
+        writeString(out, zone.name);
+        writeValue(out, static_cast<int32_t>(zone.type));
+        writeValue(out, zone.min);
+        writeValue(out, zone.max);
+        writeValue(out, static_cast<int32_t>(zone.island));
+    }
+
+    writeValue(out, static_cast<uint32_t>(instances.size()));
+    out.write(reinterpret_cast<const char*>(instances.data()),
+              static_cast<std::streamsize>(instances.size() *
+                                           sizeof(Instance)));
+
+    return bool(out);
+}
+
+bool BakedWorld::load(const rwfs::path& path, const SourceList& sources) {
+    std::ifstream in(path.string(), std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        return false;
+    }
+    const auto fileSize = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+    // Guards against allocating for counts a truncated file can't hold
+    auto fits = [&](uint64_t count, uint64_t minimumSize) {
+        return count * minimumSize <=
+               fileSize - static_cast<uint64_t>(in.tellg());
+    };
+
+    uint32_t magic, version, count;
+    if (!readValue(in, magic) || !readValue(in, version) ||
+        magic != kBakeMagic || version != kVersion) {
+        return false;
+    }
+
+    // The bake is only valid for the same sources, unchanged
+    std::vector<SourceStamp> current;
+    if (!stampSources(sources, current) || !readValue(in, count) ||
+        count != current.size()) {
+        return false;
+    }
+    for (const auto& expected : current) {
+        SourceStamp stamp;
+        if (!readString(in, stamp.name) || !readString(in, stamp.path) ||
+            !readValue(in, stamp.size) || !readValue(in, stamp.writeTime)) {
+            return false;
+        }
+        if (stamp.name != expected.name || stamp.path != expected.path ||
+            stamp.size != expected.size ||
+            stamp.writeTime != expected.writeTime) {
+            return false;
+        }
+    }
+
+    ZoneDataList bakedZones;
+    if (!readValue(in, count) || !fits(count, sizeof(uint32_t))) {
+        return false;
+    }
+    bakedZones.resize(count);
+    for (auto& zone : bakedZones) {
+        int32_t type, island;
+        if (!readString(in, zone.name) || !readValue(in, type) ||
+            !readValue(in, zone.min) || !readValue(in, zone.max) ||
+            !readValue(in, island)) {
+            return false;
+        }
+        zone.type = type;
+        zone.island = island;
+    }
+
+    std::vector<Instance> bakedInstances;
+    if (!readValue(in, count) || !fits(count, sizeof(Instance))) {
+        return false;
+    }
+    bakedInstances.resize(count);
+    if (!in.read(reinterpret_cast<char*>(bakedInstances.data()),
+                 static_cast<std::streamsize>(count * sizeof(Instance)))) {
+        return false;
+    }
+    for (const auto& instance : bakedInstances) {
+        if (instance.source >= current.size()) {
+            return false;
+        }
+    }
+
+    stamps = std::move(current);
+    zones = std::move(bakedZones);
+    instances = std::move(bakedInstances);
+    return true;
+}
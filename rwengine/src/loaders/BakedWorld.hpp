@@ -0,0 +1,83 @@
+#ifndef _RWENGINE_BAKEDWORLD_HPP_
+#define _RWENGINE_BAKEDWORLD_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <data/ZoneData.hpp>
+#include <rw/filesystem.hpp>
+
+/**
+ * @brief Instance placements and zones of every IPL, in one binary file
+ *
+ * The text IPLs remain the source of truth: bake() parses them once, save()
+ * writes the result with the size and modification time of each source, and
+ * load() rejects the file if any source has changed since. Instances are
+ * stored as a flat array that is read back in a single block, so placing the
+ * world needs no text parsing or per-instance InstanceData.
+ */
+class BakedWorld {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    /// IPL name (as listed in gta.dat) => path on disk
+    using SourceList = std::map<std::string, std::string>;
+
+    struct Instance {
+        int32_t id;
+        /// Index of the IPL in the SourceList the instance came from
+        uint32_t source;
+        glm::vec3 position;
+        glm::quat rotation;
+    };
+
+    /**
+     * Parses every IPL in sources, replacing any existing contents
+     * @return false if any of the IPLs could not be loaded
+     */
+    bool bake(const SourceList& sources);
+
+    bool save(const rwfs::path& path) const;
+
+    /**
+     * Loads a baked world, if it was baked from exactly these sources and
+     * none of them have changed since.
+     */
+    bool load(const rwfs::path& path, const SourceList& sources);
+
+    const std::vector<Instance>& getInstances() const {
+        return instances;
+    }
+
+    /// Zones, in the order the text loader would have found them
+    const ZoneDataList& getZones() const {
+        return zones;
+    }
+
+    /// Name of the IPL an instance was placed by
+    const std::string& getSourceName(const Instance& instance) const {
+        return stamps[instance.source].name;
+    }
+
+private:
+    struct SourceStamp {
+        std::string name;
+        std::string path;
+        uint64_t size;
+        int64_t writeTime;
+    };
+
+    static bool stampSources(const SourceList& sources,
+                             std::vector<SourceStamp>& out);
+
+    std::vector<SourceStamp> stamps;
+    std::vector<Instance> instances;
+    ZoneDataList zones;
+};
+
+#endif
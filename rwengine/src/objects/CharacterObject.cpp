@@ -108,6 +108,7 @@ void CharacterObject::createActor(const glm::vec2& size) {
 }
 
 void CharacterObject::destroyActor() {
+    crowdLocomotion = false;
     if (physCharacter) {
         engine->dynamicsWorld->removeCollisionObject(physObject);
         engine->dynamicsWorld->removeAction(physCharacter);
@@ -260,6 +261,19 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
 }
 
 void CharacterObject::tick(float dt) {
+    tickParallel(dt);
+    tickSerial(dt);
+}
+
+void CharacterObject::tickParallel(float dt) {
+    // Gameplay follows the player's pose, so it's always exact
+    if (!isPlayer()) {
+        updateAnimationDetail();
+    }
+    animator->tick(dt);
+}
+
+void CharacterObject::tickSerial(float dt) {
     if (controller) {
         controller->update(dt);
 
@@ -269,7 +283,6 @@ void CharacterObject::tick(float dt) {
         }
     }
 
-    animator->tick(dt);
     updateCharacter(dt);
 
     // Ensure the character doesn't need to be reset
@@ -279,7 +292,7 @@ void CharacterObject::tick(float dt) {
 }
 
 void CharacterObject::tickPhysics(float dt) {
-    if (physCharacter) {
+    if (physCharacter && !crowdLocomotion) {
         auto s = currenteMovementStep * dt;
         physCharacter->setWalkDirection(btVector3(s.x, s.y, s.z));
     }
@@ -355,6 +368,11 @@ void CharacterObject::updateCharacter(float dt) {
             currenteMovementStep = glm::vec3();
         }
 
+        if (crowdLocomotion) {
+            // GameWorld::updateCrowd moves the character
+            return;
+        }
+
         auto Pos =
             physCharacter->getGhostObject()->getWorldTransform().getOrigin();
         position = glm::vec3(Pos.x(), Pos.y(), Pos.z());
@@ -403,6 +421,39 @@ void CharacterObject::updateCharacter(float dt) {
     }
 }
 
+void CharacterObject::setCrowdLocomotion(bool enable) {
+    if (enable == crowdLocomotion || !physCharacter) {
+        return;
+    }
+    crowdLocomotion = enable;
+    crowdGround.valid = false;
+
+    auto& world = engine->dynamicsWorld;
+    world->removeCollisionObject(physObject);
+    if (enable) {
+        // Without the static filter the broadphase finds no pairs for it
+        world->removeAction(physCharacter);
+        world->addCollisionObject(physObject,
+                                  btBroadphaseProxy::KinematicFilter,
+                                  btBroadphaseProxy::SensorTrigger);
+    } else {
+        world->addCollisionObject(
+            physObject, btBroadphaseProxy::KinematicFilter,
+            btBroadphaseProxy::StaticFilter | btBroadphaseProxy::SensorTrigger);
+        world->addAction(physCharacter);
+        physCharacter->warp(btVector3(position.x, position.y, position.z));
+    }
+}
+
+void CharacterObject::setCrowdPosition(const glm::vec3& pos) {
+    position = pos;
+    getClump()->getFrame()->setTranslation(pos);
+    if (physCharacter) {
+        auto& wt = physObject->getWorldTransform();
+        wt.setOrigin(btVector3(pos.x, pos.y, pos.z));
+    }
+}
+
 void CharacterObject::setPosition(const glm::vec3& pos) {
     auto realPos = pos;
     if (physCharacter) {
@@ -542,7 +593,7 @@ float CharacterObject::getJumpSpeed() const {
 }
 
 bool CharacterObject::isOnGround() const {
-    if (physCharacter) {
+    if (physCharacter && !crowdLocomotion) {
         return physCharacter->onGround();
     }
     return true;
@@ -72,6 +72,8 @@ private:
 
     bool motionBlockedByActivity;
 
+    bool crowdLocomotion = false;
+
     glm::vec3 updateMovementAnimation(float dt);
     glm::vec3 currenteMovementStep{};
 
@@ -106,8 +108,40 @@ public:
 
     void tick(float dt) override;
 
+    /// Poses the skeleton
+    void tickParallel(float dt) override;
+
+    /// Runs the controller and moves the character
+    void tickSerial(float dt) override;
+
     void tickPhysics(float dt);
 
+    /**
+     * Switches between the bullet character controller and crowd locomotion,
+     * where GameWorld::updateCrowd moves the character along with the other
+     * ambient pedestrians. The collision object stays for weapon scans.
+     */
+    void setCrowdLocomotion(bool enable);
+
+    bool usesCrowdLocomotion() const {
+        return crowdLocomotion;
+    }
+
+    /// Velocity the character is trying to walk at
+    const glm::vec3& getMovementStep() const {
+        return currenteMovementStep;
+    }
+
+    /// Moves the character while it uses crowd locomotion
+    void setCrowdPosition(const glm::vec3& pos);
+
+    /// Ground under a crowd character, and where it was last found
+    struct CrowdGround {
+        glm::vec2 position{};
+        float height = 0.f;
+        bool valid = false;
+    } crowdGround;
+
     const CharacterState& getCurrentState() const {
         return currentState;
     }
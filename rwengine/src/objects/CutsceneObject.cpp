@@ -24,6 +24,10 @@ CutsceneObject::CutsceneObject(GameWorld *engine, const glm::vec3 &pos,
 CutsceneObject::~CutsceneObject() = default;
 
 void CutsceneObject::tick(float dt) {
+    tickParallel(dt);
+}
+
+void CutsceneObject::tickParallel(float dt) {
     animator->tick(dt);
 }
 
@@ -29,6 +29,12 @@ public:
 
     void tick(float dt) override;
 
+    void tickParallel(float dt) override;
+
+    void tickSerial(float dt) override {
+        RW_UNUSED(dt);
+    }
+
     void setParentActor(GameObject* parent, ModelFrame* bone);
 
     GameObject* getParentActor() const {
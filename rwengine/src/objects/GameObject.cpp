@@ -3,6 +3,7 @@
 #include <glm/gtc/constants.hpp>
 
 #include "engine/Animator.hpp"
+#include "engine/GameWorld.hpp"
 
 GameObject::~GameObject() {
     if (animator) {
@@ -14,6 +15,34 @@ GameObject::~GameObject() {
     }
 }
 
+void GameObject::updateAnimationDetail() {
+    if (!animator) {
+        return;
+    }
+    auto detail = engine->animationLOD
+                      ? Animator::chooseDetail(
+                            engine->getGameTime() - lastDrawnTime,
+                            lastDrawnDistance)
+                      : Animator::Detail::Full;
+    // The first tick after being hidden evaluates every bone, instead of
+    // starting a blend from the stale pose
+    if (animator->getDetail() == Animator::Detail::TimeOnly &&
+        detail != Animator::Detail::TimeOnly) {
+        detail = Animator::Detail::Full;
+    }
+    animator->setDetail(detail);
+}
+
+bool GameObject::refreshHiddenPose() {
+    if (!animator || animator->getDetail() != Animator::Detail::TimeOnly) {
+        return false;
+    }
+    animator->updatePose();
+    // Until the next tick picks a detail from the new draw time
+    animator->setDetail(Animator::Detail::Full);
+    return true;
+}
+
 void GameObject::setPosition(const glm::vec3& pos) {
     _lastPosition = position = pos;
 }
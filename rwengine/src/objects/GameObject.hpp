@@ -59,6 +59,13 @@ public:
      */
     bool visible;
 
+    /**
+     * Game time the object was last drawn at, and its distance from the
+     * camera then
+     */
+    float lastDrawnTime = -std::numeric_limits<float>::max();
+    float lastDrawnDistance = 0.f;
+
     GameObject(GameWorld* engine, const glm::vec3& pos, const glm::quat& rot,
                BaseModelInfo* modelinfo)
         : _lastPosition(pos)
@@ -197,8 +204,51 @@ public:
         return inWater;
     }
 
+    /**
+     * Updates the object, the same as tickParallel followed by tickSerial
+     */
     virtual void tick(float dt) = 0;
 
+    /**
+     * Part of the update that may run on a worker thread, alongside other
+     * objects. It must only modify this object, other changes to the world
+     * go through GameWorld::defer.
+     */
+    virtual void tickParallel(float dt) {
+        RW_UNUSED(dt);
+    }
+
+    /**
+     * Rest of the update, run on the game thread after every object's
+     * tickParallel
+     */
+    virtual void tickSerial(float dt) {
+        tick(dt);
+    }
+
+    /**
+     * Called by the renderer when it draws part of the object
+     * @param time game time of the frame
+     * @param distance from the camera
+     */
+    void setDrawn(float time, float distance) {
+        lastDrawnTime = time;
+        lastDrawnDistance = distance;
+    }
+
+    /**
+     * Sets the animator's detail from when the object was last drawn, or to
+     * full if the world doesn't have animation LOD enabled
+     */
+    void updateAnimationDetail();
+
+    /**
+     * Called by the renderer before drawing, evaluates the pose if it was
+     * left stale while the object was hidden
+     * @return true if the pose changed
+     */
+    bool refreshHiddenPose();
+
     /**
      * @brief Function used to modify the last transform
      * @param newPos
@@ -63,7 +63,10 @@ void InstanceObject::tick(float dt) {
 }
 
 void InstanceObject::tickPhysics(float dt) {
-    if (animator) animator->tick(dt);
+    if (animator) {
+        updateAnimationDetail();
+        animator->tick(dt);
+    }
 
     if (!body || !dynamics) {
         return;
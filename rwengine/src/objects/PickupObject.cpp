@@ -136,21 +136,21 @@ PickupObject::PickupObject(GameWorld* world, const glm::vec3& position,
     else if (modelinfo->name == "health" || modelinfo->name == "bonus")
         m_colourId = 13;
 
-    m_corona = world->createEffect(VisualFX::Particle);
-    m_corona->particle.position = getPosition();
-    m_corona->particle.direction = glm::vec3(0.f, 0.f, 1.f);
-    m_corona->particle.orientation = VisualFX::ParticleData::Camera;
+    ParticleSystem::Particle corona;
+    corona.position = getPosition();
+    corona.orientation = ParticleSystem::Camera;
 
     // @todo float package should float on the water
     if (m_type == FloatingPackage) {
         // verify offset and texture?
-        m_corona->particle.position += glm::vec3(0.f, 0.f, 0.7f);
-        m_corona->particle.texture =
+        corona.position += glm::vec3(0.f, 0.f, 0.7f);
+        corona.texture =
             engine->data->findSlotTexture("particle", "coronastar");
     } else {
-        m_corona->particle.texture =
+        corona.texture =
             engine->data->findSlotTexture("particle", "coronaringa");
     }
+    m_corona = world->particles.spawn(corona);
 
     auto flags = behaviourFlags(m_type);
     RW_UNUSED(flags);
@@ -165,8 +165,7 @@ PickupObject::PickupObject(GameWorld* world, const glm::vec3& position,
 PickupObject::~PickupObject() {
     if (m_ghost) {
         setEnabled(false);
-        engine->destroyEffect(m_corona);
-        delete m_corona;
+        engine->particles.remove(m_corona);
         delete m_ghost;
         delete m_shape;
     }
@@ -201,8 +200,9 @@ void PickupObject::tick(float dt) {
     float red = (*colour >> 16) & 0xFF;
     float green = (*colour >> 8) & 0xFF;
     float blue = *colour & 0xFF;
-    m_corona->particle.colour =
-        glm::vec4(red / 255.f, green / 255.f, blue / 255.f, 1.f) * colourValue;
+    engine->particles.setColour(
+        m_corona,
+        glm::vec4(red / 255.f, green / 255.f, blue / 255.f, 1.f) * colourValue);
 
     if (m_enabled) {
         // Sort out interactions with things that may or may not be players.
@@ -246,10 +246,10 @@ void PickupObject::setEnabled(bool enabled) {
     if (!m_enabled && enabled) {
         engine->dynamicsWorld->addCollisionObject(
             m_ghost, btBroadphaseProxy::SensorTrigger);
-        m_corona->particle.size = glm::vec2(1.5f, 1.5f);
+        engine->particles.setSize(m_corona, glm::vec2(1.5f, 1.5f));
     } else if (m_enabled && !enabled) {
         engine->dynamicsWorld->removeCollisionObject(m_ghost);
-        m_corona->particle.size = glm::vec2(0.f, 0.f);
+        engine->particles.setSize(m_corona, glm::vec2(0.f, 0.f));
     }
 
     m_enabled = enabled;
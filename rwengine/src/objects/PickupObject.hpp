@@ -7,6 +7,7 @@
 #include <rw/defines.hpp>
 
 #include <objects/GameObject.hpp>
+#include <render/ParticleSystem.hpp>
 
 class btPairCachingGhostObject;
 class btSphereShape;
@@ -14,7 +15,6 @@ class btSphereShape;
 class BaseModelInfo;
 class GameWorld;
 class CharacterObject;
-class VisualFX;
 
 /**
  * @brief The PickupObject class
@@ -87,7 +87,7 @@ private:
     bool m_enabled;
     float m_enableTimer;
     bool m_collected;
-    VisualFX* m_corona;
+    ParticleSystem::Handle m_corona;
     short m_colourId;
 
     PickupType m_type;
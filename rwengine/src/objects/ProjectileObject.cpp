@@ -7,9 +7,9 @@
 #include "data/WeaponData.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameWorld.hpp"
-#include "render/VisualFX.hpp"
+#include "render/ParticleSystem.hpp"
 
-void ProjectileObject::checkPhysicsContact() {
+bool ProjectileObject::checkPhysicsContact() {
     btManifoldArray manifoldArray;
     btBroadphasePairArray& pairArray =
         _ghostBody->getOverlappingPairCache()->getOverlappingPairArray();
@@ -42,11 +42,11 @@ void ProjectileObject::checkPhysicsContact() {
             /// @todo check if this is a suitable level to check c.f
             /// btManifoldPoint
             // It's happening
-            explode();
-
-            return;
+            return true;
         }
     }
+
+    return false;
 }
 
 void ProjectileObject::explode() {
@@ -79,15 +79,15 @@ void ProjectileObject::explode() {
 
         auto tex = engine->data->findSlotTexture("particle", "explo02");
 
-        auto explosion = engine->createEffect(VisualFX::Particle);
-        explosion->particle.size = glm::vec2(exp_size);
-        explosion->particle.texture = tex;
-        explosion->particle.starttime = engine->getGameTime();
-        explosion->particle.lifetime = 0.5f;
-        explosion->particle.orientation = VisualFX::ParticleData::Camera;
-        explosion->particle.colour = glm::vec4(1.0f);
-        explosion->particle.position = getPosition();
-        explosion->particle.direction = glm::vec3(0.f, 0.f, 1.f);
+        ParticleSystem::Particle explosion;
+        explosion.size = glm::vec2(exp_size);
+        explosion.texture = tex;
+        explosion.starttime = engine->getGameTime();
+        explosion.lifetime = 0.5f;
+        explosion.orientation = ParticleSystem::Camera;
+        explosion.colour = glm::vec4(1.0f);
+        explosion.position = getPosition();
+        engine->particles.spawn(explosion);
 
         _exploded = true;
         engine->destroyObjectQueued(this);
@@ -164,6 +164,10 @@ ProjectileObject::~ProjectileObject() {
 }
 
 void ProjectileObject::tick(float dt) {
+    tickParallel(dt);
+}
+
+void ProjectileObject::tickParallel(float dt) {
     if (_body == nullptr) return;
 
     auto& bttr = _body->getWorldTransform();
@@ -174,12 +178,14 @@ void ProjectileObject::tick(float dt) {
 
     _info.time -= dt;
 
+    bool hit = false;
     if (_ghostBody) {
         _ghostBody->setWorldTransform(_body->getWorldTransform());
-        checkPhysicsContact();
+        hit = checkPhysicsContact();
     }
 
-    if (_info.time <= 0.f) {
-        explode();
+    // Exploding damages other objects and removes the physics bodies
+    if (hit || _info.time <= 0.f) {
+        engine->defer([this] { explode(); });
     }
 }
@@ -45,7 +45,8 @@ private:
 
     bool _exploded;
 
-    void checkPhysicsContact();
+    /// Returns true if the projectile has hit something
+    bool checkPhysicsContact();
     void explode();
     void cleanup();
 
@@ -60,6 +61,12 @@ public:
 
     void tick(float dt) override;
 
+    void tickParallel(float dt) override;
+
+    void tickSerial(float dt) override {
+        RW_UNUSED(dt);
+    }
+
     Type type() const override {
         return Projectile;
     }
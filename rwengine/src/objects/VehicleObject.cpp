@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cstdlib>
 #include <limits>
+#include <random>
+#include <vector>
 
 #include <BulletDynamics/Vehicle/btRaycastVehicle.h>
 #include <btBulletDynamicsCommon.h>
@@ -12,6 +14,7 @@
 #include <data/Clump.hpp>
 #include <rw/types.hpp>
 
+#include "ai/AIGraphNode.hpp"
 #include "dynamics/CollisionInstance.hpp"
 #include "dynamics/RaycastCallbacks.hpp"
 #include "engine/GameData.hpp"
@@ -22,6 +25,11 @@
 #define PART_CLOSE_VELOCITY 0.25f
 constexpr float kVehicleMaxExitVelocity = 0.15f;
 
+// Kinematic traffic tuning
+constexpr float kLaneArrivalDistance = 2.f;
+constexpr float kKinematicTurnRate = 1.5f;
+constexpr float kGroundProbeHeight = 5.f;
+
 /**
  * A raycaster that will ignore the body of the vehicle when casting rays
  */
@@ -308,7 +316,11 @@ void VehicleObject::tick(float dt) {
 }
 
 void VehicleObject::tickPhysics(float dt) {
-    RW_UNUSED(dt);
+    if (kinematic) {
+        tickKinematic(dt);
+        updateOccupants();
+        return;
+    }
 
     if (physVehicle) {
         // todo: a real engine function
@@ -348,22 +360,7 @@ void VehicleObject::tickPhysics(float dt) {
             }
         }
 
-        // Update passenger positions
-        for (auto& seat : seatOccupants) {
-            auto character = static_cast<CharacterObject*>(seat.second);
-
-            glm::vec3 passPosition{};
-            if (character->isEnteringOrExitingVehicle()) {
-                passPosition = getSeatEntryPositionWorld(seat.first);
-            } else {
-                passPosition = getPosition();
-                if (seat.first < info->seats.size()) {
-                    passPosition +=
-                        getRotation() * (info->seats[seat.first].offset);
-                }
-            }
-            seat.second->updateTransform(passPosition, getRotation());
-        }
+        updateOccupants();
 
         if (getVehicle()->vehicletype_ == VehicleModelInfo::BOAT) {
             if (isInWater()) {
@@ -518,12 +515,169 @@ void VehicleObject::tickPhysics(float dt) {
     }
 }
 
+void VehicleObject::updateOccupants() {
+    for (auto& seat : seatOccupants) {
+        auto character = static_cast<CharacterObject*>(seat.second);
+
+        glm::vec3 passPosition{};
+        if (character->isEnteringOrExitingVehicle()) {
+            passPosition = getSeatEntryPositionWorld(seat.first);
+        } else {
+            passPosition = getPosition();
+            if (seat.first < info->seats.size()) {
+                passPosition +=
+                    getRotation() * (info->seats[seat.first].offset);
+            }
+        }
+        seat.second->updateTransform(passPosition, getRotation());
+    }
+}
+
+void VehicleObject::setKinematic(bool enable) {
+    if (enable == kinematic) {
+        return;
+    }
+    kinematic = enable;
+
+    auto body = collision->getBulletBody();
+    const auto forward = getRotation() * glm::vec3(0.f, 1.f, 0.f);
+    laneTarget = nullptr;
+    lanePrevious = nullptr;
+
+    if (enable) {
+        // Parked cars stay put, driven ones carry on at their speed
+        const auto& v = body->getLinearVelocity();
+        const float speed =
+            glm::dot(forward, glm::vec3(v.x(), v.y(), v.z()));
+        kinematicSpeed = getOccupant(0) ? std::max(0.f, speed) : 0.f;
+
+        engine->dynamicsWorld->removeAction(physVehicle);
+        body->setCollisionFlags(body->getCollisionFlags() |
+                                btCollisionObject::CF_KINEMATIC_OBJECT);
+        collision->changeMass(0.f);
+        body->setLinearVelocity(btVector3(0.f, 0.f, 0.f));
+        body->setAngularVelocity(btVector3(0.f, 0.f, 0.f));
+
+        float ground;
+        if (findGround(getPosition(), ground)) {
+            kinematicHeight = getPosition().z - ground;
+        } else if (!info->wheels.empty()) {
+            kinematicHeight = getVehicle()->wheelscale_ / 2.f -
+                              info->wheels[0].position.z;
+        }
+
+        auto nearest = engine->routePlanner.findNearestNode(
+            getPosition(), AIGraphNode::Vehicle);
+        if (nearest &&
+            glm::dot(forward, nearest->position - getPosition()) < 0.f) {
+            // Don't turn around for a node that's already been passed
+            lanePrevious = nearest;
+            laneTarget = nextLaneNode(nearest, nullptr);
+        } else {
+            laneTarget = nearest;
+        }
+    } else {
+        body->setCollisionFlags(body->getCollisionFlags() &
+                                ~btCollisionObject::CF_KINEMATIC_OBJECT);
+        collision->changeMass(info->handling.mass);
+        engine->dynamicsWorld->addAction(physVehicle);
+
+        const auto velocity = forward * kinematicSpeed;
+        body->setLinearVelocity(btVector3(velocity.x, velocity.y, velocity.z));
+        body->setAngularVelocity(btVector3(0.f, 0.f, 0.f));
+        body->activate(true);
+    }
+}
+
+void VehicleObject::tickKinematic(float dt) {
+    auto position = getPosition();
+    auto rotation = getRotation();
+
+    if (laneTarget && kinematicSpeed > 0.f) {
+        auto toTarget = glm::vec2(laneTarget->position - position);
+        if (glm::length(toTarget) <= kLaneArrivalDistance) {
+            auto next = nextLaneNode(laneTarget, lanePrevious);
+            lanePrevious = laneTarget;
+            laneTarget = next;
+            if (laneTarget) {
+                toTarget = glm::vec2(laneTarget->position - position);
+            }
+        }
+
+        const float distance = glm::length(toTarget);
+        if (laneTarget && distance > 0.f) {
+            const auto direction = toTarget / distance;
+            const float step = std::min(kinematicSpeed * dt, distance);
+            position += glm::vec3(direction * step, 0.f);
+
+            // Turn towards the lane, the model's forward is +y
+            const auto forward = rotation * glm::vec3(0.f, 1.f, 0.f);
+            const float yaw = std::atan2(-forward.x, forward.y);
+            float turn = std::atan2(-direction.x, direction.y) - yaw;
+            turn = std::remainder(turn, 2.f * glm::pi<float>());
+            const float maxTurn = kKinematicTurnRate * dt;
+            turn = glm::clamp(turn, -maxTurn, maxTurn);
+            rotation = glm::angleAxis(yaw + turn, glm::vec3(0.f, 0.f, 1.f));
+        }
+    }
+
+    float ground;
+    if (findGround(position, ground)) {
+        position.z = ground + kinematicHeight;
+    }
+
+    setPosition(position);
+    setRotation(rotation);
+}
+
+AIGraphNode* VehicleObject::nextLaneNode(AIGraphNode* from,
+                                         AIGraphNode* previous) {
+    const auto forward = getRotation() * glm::vec3(0.f, 1.f, 0.f);
+    std::vector<AIGraphNode*> ahead;
+    std::vector<AIGraphNode*> behind;
+    for (auto node : from->connections) {
+        if (node == previous || node->disabled ||
+            node->type != AIGraphNode::Vehicle) {
+            continue;
+        }
+        if (glm::dot(forward, node->position - from->position) >= 0.f) {
+            ahead.push_back(node);
+        } else {
+            behind.push_back(node);
+        }
+    }
+
+    auto& choices = ahead.empty() ? behind : ahead;
+    if (choices.empty()) {
+        // A dead end, go back the way we came
+        return previous;
+    }
+    std::uniform_int_distribution<size_t> pick(0, choices.size() - 1);
+    return choices[pick(engine->randomEngine)];
+}
+
+bool VehicleObject::findGround(const glm::vec3& position,
+                               float& height) const {
+    auto hit = engine->raycasts->cast(
+        glm::vec3(position.x, position.y, position.z + kGroundProbeHeight),
+        glm::vec3(position.x, position.y, position.z - kGroundProbeHeight),
+        RaycastService::Filter::Static);
+    if (!hit.hit) {
+        return false;
+    }
+    height = hit.position.z;
+    return true;
+}
+
 bool VehicleObject::isFlipped() const {
     auto up = getRotation() * glm::vec3(0.f, 0.f, 1.f);
     return up.z <= -0.1f;
 }
 
 float VehicleObject::getVelocity() const {
+    if (kinematic) {
+        return kinematicSpeed;
+    }
     if (physVehicle) {
         return (physVehicle->getCurrentSpeedKmHour() * 1000.f) / (60.f * 60.f);
     }
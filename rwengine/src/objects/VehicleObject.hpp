@@ -15,6 +15,7 @@
 #include <objects/VehicleInfo.hpp>
 
 class Atomic;
+struct AIGraphNode;
 class CharacterObject;
 class CollisionInstance;
 class GameWorld;
@@ -42,6 +43,14 @@ private:
 
     std::array<Atomic*, 6> extras_;
 
+    bool kinematic = false;
+    /// Speed along the lanes while kinematic, in m/s
+    float kinematicSpeed = 0.f;
+    /// Height of the origin above the ground while kinematic
+    float kinematicHeight = 0.f;
+    AIGraphNode* laneTarget = nullptr;
+    AIGraphNode* lanePrevious = nullptr;
+
 public:
     float health;
 
@@ -126,6 +135,17 @@ public:
 
     void tickPhysics(float dt);
 
+    /**
+     * Switches between the full raycast vehicle and a cheap kinematic mode
+     * that follows the vehicle path graph at a constant speed, for traffic
+     * far from the camera. The speed carries over in both directions.
+     */
+    void setKinematic(bool enable);
+
+    bool isKinematic() const {
+        return kinematic;
+    }
+
     bool isFlipped() const;
 
     float getVelocity() const;
@@ -197,6 +217,11 @@ private:
     void registerPart(ModelFrame* mf);
     void createObjectHinge(Part* part);
     void destroyObjectHinge(Part* part);
+
+    void updateOccupants();
+    void tickKinematic(float dt);
+    AIGraphNode* nextLaneNode(AIGraphNode* from, AIGraphNode* previous);
+    bool findGround(const glm::vec3& position, float& height) const;
 };
 
 #endif
@@ -1,6 +1,7 @@
 #include "render/GameRenderer.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cmath>
 #include <string>
@@ -23,7 +24,7 @@
 #include "objects/GameObject.hpp"
 #include "render/ObjectRenderer.hpp"
 #include "render/GameShaders.hpp"
-#include "render/VisualFX.hpp"
+#include "render/ParticleSystem.hpp"
 
 const size_t skydomeSegments = 8, skydomeRows = 10;
 constexpr uint32_t kMissingTextureBytes[] = {
@@ -40,18 +41,12 @@ struct WaterVertex {
     float x, y;
 };
 
-/// @todo collapse all of these into "VertPNC" etc.
-struct ParticleVert {
-    static const AttributeList vertex_attributes() {
-        return {{ATRS_Position, 2, sizeof(ParticleVert), 0ul},
-                {ATRS_TexCoord, 2, sizeof(ParticleVert), 2ul * sizeof(float)},
-                {ATRS_Colour, 3, sizeof(ParticleVert), 4ul * sizeof(float)}};
-    }
-
-    float x, y;
-    float u, v;
-    float r, g, b;
-};
+const AttributeList ParticleVert::vertex_attributes() {
+    return {{ATRS_Position, 3, sizeof(ParticleVert), 0ul},
+            {ATRS_TexCoord, 2, sizeof(ParticleVert), 3ul * sizeof(float)},
+            {ATRS_Colour, 4, sizeof(ParticleVert), 5ul * sizeof(float),
+             GL_UNSIGNED_BYTE}};
+}
 
 GameRenderer::GameRenderer(Logger* log, GameData* _data)
     : data(_data)
@@ -60,7 +55,8 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     , _renderAlpha(0.f)
     , _renderWorld(nullptr)
     , cullOverride(false)
-    , map(renderer, _data)
+    , sprites(renderer)
+    , map(renderer, _data, &sprites)
     , water(this)
     , text(this) {
     logger->info("Renderer", renderer->getIDString());
@@ -175,44 +171,34 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     glGenTextures(1, &debugTex);
     glGenVertexArrays(1, &debugVAO);
 
-    particleGeom.uploadVertices<ParticleVert>(
-        {{0.5f, 0.5f, 1.f, 1.f, 1.f, 1.f, 1.f},
-         {-0.5f, 0.5f, 0.f, 1.f, 1.f, 1.f, 1.f},
-         {0.5f, -0.5f, 1.f, 0.f, 1.f, 1.f, 1.f},
-         {-0.5f, -0.5f, 0.f, 0.f, 1.f, 1.f, 1.f}});
+    // Particle vertices are rebuilt every frame, upload nothing for now so
+    // the buffer exists when the attributes are bound
+    particleGeom.uploadVertices(particleVertices);
     particleDraw.addGeometry(&particleGeom);
-    particleDraw.setFaceType(GL_TRIANGLE_STRIP);
+    particleDraw.setFaceType(GL_TRIANGLES);
 
     ssRectGeom.uploadVertices(sspaceRect);
     ssRectDraw.addGeometry(&ssRectGeom);
     ssRectDraw.setFaceType(GL_TRIANGLE_STRIP);
 
-    ssRectProgram =
-        compileProgram(GameShaders::ScreenSpaceRect::VertexShader,
-                       GameShaders::ScreenSpaceRect::FragmentShader);
-
-    ssRectTexture = glGetUniformLocation(ssRectProgram, "texture");
-    ssRectColour = glGetUniformLocation(ssRectProgram, "colour");
-    ssRectSize = glGetUniformLocation(ssRectProgram, "size");
-    ssRectOffset = glGetUniformLocation(ssRectProgram, "offset");
+    ssRectProg =
+        renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
+                               GameShaders::ScreenSpaceRect::FragmentShader);
 
+    renderer->setUniformTexture(ssRectProg.get(), "tex", 0);
 }
 
 GameRenderer::~GameRenderer() {
     glDeleteFramebuffers(1, &framebufferName);
-    glDeleteProgram(ssRectProgram);
 }
 
 float mix(uint8_t a, uint8_t b, float num) {
     return a + (b - a) * num;
 }
 
-void GameRenderer::setupRender() {
-    // Set the viewport
-    const glm::ivec2& vp = getRenderer()->getViewport();
-    glViewport(0, 0, vp.x, vp.y);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebufferName);
-    glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+void GameRenderer::setupRender(const glm::vec4& clearColour) {
+    renderer->setFramebuffer(framebufferName);
+    renderer->clear(clearColour);
 }
 
 void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
@@ -225,10 +211,6 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     // Store the input camera,
     _camera = camera;
 
-    setupRender();
-
-    glBindVertexArray(vao);
-
     float tod = world->getHour() + world->getMinute() / 60.f;
 
     const auto currentWeather = WeatherCondition(state->basic.nextWeather);
@@ -261,9 +243,9 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
         weather.fogStart,
         _camera.frustum.far};
 
-    renderer->setSceneParameters(sceneParams);
+    setupRender(glm::vec4(weather.skyBottomColor, 1.f));
 
-    renderer->clear(glm::vec4(weather.skyBottomColor, 1.f));
+    renderer->setSceneParameters(sceneParams);
 
     _camera.frustum.update(proj * view);
     if (cullOverride) {
@@ -281,6 +263,8 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
 
     RW_PROFILE_BEGIN("RenderList");
 
+    auto renderListStart = std::chrono::steady_clock::now();
+
     // This is sequential at the moment, it should be easy to make it
     // run in parallel with a good threading system.
     RenderList renderList;
@@ -293,66 +277,29 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
                                   (cullOverride ? cullingCamera : _camera),
                                   _renderAlpha, getMissingTexture());
 
-    // World Objects
-    for (auto object : world->allObjects) {
-        objectRenderer.buildRenderList(object, renderList);
+    if (occlusionCulling) {
+        auto& cullCamera = cullOverride ? cullingCamera : _camera;
+        occlusion.begin(cullCamera.frustum.projection() *
+                        cullCamera.getView());
+        objectRenderer.buildOcclusion(&occlusion);
     }
 
-    // Area indicators
-    auto sphereModel = getSpecialModel(ZoneCylinderA);
-    for (auto& i : world->getAreaIndicators()) {
-        glm::mat4 m(1.f);
-        m = glm::translate(m, i.position);
-        m = glm::scale(
-            m, glm::vec3(i.radius +
-                         0.15f * glm::sin(_renderWorld->getGameTime() * 5.f)));
-
-        objectRenderer.renderClump(sphereModel.get(), m, nullptr, renderList);
-    }
-
-    // Render arrows above anything that isn't radar only (or hidden)
-    auto arrowModel = getSpecialModel(Arrow);
-    for (auto& blip : world->state->radarBlips) {
-        auto dm = blip.second.display;
-        if (dm == BlipData::Hide || dm == BlipData::RadarOnly) {
-            continue;
-        }
-
-        glm::mat4 model{1.0f};
-
-        if (blip.second.target > 0) {
-            auto object = world->getBlipTarget(blip.second);
-            if (object) {
-                model = object->getTimeAdjustedTransform(_renderAlpha);
-            }
-        } else {
-            model = glm::translate(model, blip.second.coord);
-        }
-
-        float a = world->getGameTime() * glm::pi<float>();
-        model = glm::translate(model,
-                               glm::vec3(0.f, 0.f, 2.5f + glm::sin(a) * 0.5f));
-        model = glm::rotate(model, a, glm::vec3(0.f, 0.f, 1.f));
-        model = glm::scale(model, glm::vec3(1.5f, 1.5f, 1.5f));
-        objectRenderer.renderClump(arrowModel.get(), model, nullptr, renderList);
-    }
+    objectRenderer.buildWorldRenderList(getSpecialModel(ZoneCylinderA).get(),
+                                        getSpecialModel(Arrow).get(),
+                                        renderList);
 
     RW_PROFILE_END();
     culled += objectRenderer.culled;
+    occluded = objectRenderer.occluded;
     renderer->pushDebugGroup("Objects");
     renderer->pushDebugGroup("RenderList");
     // Also parallelizable
     RW_PROFILE_BEGIN("Sort");
-    // Earlier position in the array means earlier object's rendering
-    // Transparent objects should be sorted and rendered after opaque
-    std::sort(renderList.begin(), renderList.end(),
-              [](const Renderer::RenderInstruction& a,
-                 const Renderer::RenderInstruction& b) {
-                    if (a.drawInfo.blendMode==BlendMode::BLEND_NONE && b.drawInfo.blendMode!=BlendMode::BLEND_NONE) return true;
-                    if (a.drawInfo.blendMode!=BlendMode::BLEND_NONE && b.drawInfo.blendMode==BlendMode::BLEND_NONE) return false;
-                    return (a.sortKey > b.sortKey);
-              });
+    ObjectRenderer::sortRenderList(renderList);
     RW_PROFILE_END();
+    renderListTime = std::chrono::duration<float>(
+                         std::chrono::steady_clock::now() - renderListStart)
+                         .count();
     RW_PROFILE_BEGIN("Draw");
     renderer->drawBatched(renderList);
     RW_PROFILE_END();
@@ -370,8 +317,6 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
 
     renderer->pushDebugGroup("Sky");
 
-    glBindVertexArray(vao);
-
     Renderer::DrawParameters dp;
     dp.start = 0;
     dp.count = skydomeSegments * skydomeRows * 6;
@@ -390,7 +335,7 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     renderEffects(world);
     profEffects = renderer->popDebugGroup();
 
-    glDisable(GL_DEPTH_TEST);
+    renderer->setDepthTest(false);
 
     GLuint splashTexName = 0;
     auto fc = world->state->fadeColour;
@@ -408,19 +353,8 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
 
     float fadeTimer = world->getGameTime() - world->state->fadeStart;
     if ((fadeTimer <= world->state->fadeTime || !world->state->fadeOut) && !world->isPaused()) {
-        /// @todo rewrite this render code to use renderer class
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glUseProgram(ssRectProgram);
-        glUniform2f(ssRectOffset, 0.f, 0.f);
-        glUniform2f(ssRectSize, 1.f, 1.f);
-
-        glUniform1i(ssRectTexture, 0);
-
         if (splashTexName != 0) {
-            glBindTexture(GL_TEXTURE_2D, splashTexName);
             fc = glm::u16vec3(0, 0, 0);
-        } else {
-            glBindTexture(GL_TEXTURE_2D, 0);
         }
 
         float fadeFrac = 1.f;
@@ -432,10 +366,8 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
 
         glm::vec4 fadeNormed(fc.r / 255.f, fc.g / 255.f, fc.b / 255.f, a);
 
-        glUniform4fv(ssRectColour, 1, glm::value_ptr(fadeNormed));
-
-        glBindVertexArray(ssRectDraw.getVAOName());
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        drawScreenRect(glm::vec2(0.f), glm::vec2(1.f), fadeNormed,
+                       splashTexName);
     }
 
     if ((world->state->isCinematic || world->state->currentCutscene) &&
@@ -444,19 +376,11 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     }
 
     renderPostProcess();
-
-    glUseProgram(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
 }
 
 void GameRenderer::renderPostProcess() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glStencilMask(0xFF);
-    glClearStencil(0x00);
-    glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT |
-            GL_STENCIL_BUFFER_BIT);
+    renderer->setFramebuffer(0);
+    renderer->clear(glm::vec4(0.f), false, true, true);
 
     renderer->useProgram(postProg.get());
 
@@ -468,6 +392,24 @@ void GameRenderer::renderPostProcess() {
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
 }
 
+void GameRenderer::drawScreenRect(const glm::vec2& offset,
+                                  const glm::vec2& size,
+                                  const glm::vec4& colour, GLuint texture) {
+    renderer->useProgram(ssRectProg.get());
+    renderer->setUniform(ssRectProg.get(), "offset", offset);
+    renderer->setUniform(ssRectProg.get(), "size", size);
+    renderer->setUniform(ssRectProg.get(), "colour", colour);
+
+    Renderer::DrawParameters dp;
+    dp.start = 0;
+    dp.count = ssRectGeom.getCount();
+    dp.textures = {texture};
+    dp.blendMode = BlendMode::BLEND_ALPHA;
+    dp.depthWrite = false;
+
+    renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, dp);
+}
+
 void GameRenderer::renderEffects(GameWorld* world) {
     renderer->useProgram(particleProg.get());
 
@@ -475,54 +417,66 @@ void GameRenderer::renderEffects(GameWorld* world) {
     auto cfwd = glm::normalize(glm::inverse(_camera.rotation) *
                                glm::vec3(0.f, 1.f, 0.f));
 
-    auto& effects = world->effects;
-
-    std::sort(effects.begin(), effects.end(),
-              [&](const VisualFX* a, const VisualFX* b) {
-                  return glm::distance(a->getPosition(), cpos) >
-                         glm::distance(b->getPosition(), cpos);
-              });
+    // Corners of the billboard quad as two triangles, with texture coords
+    static const glm::vec4 kCorners[] = {
+        {0.5f, 0.5f, 1.f, 1.f},   {-0.5f, 0.5f, 0.f, 1.f},
+        {0.5f, -0.5f, 1.f, 0.f},  {0.5f, -0.5f, 1.f, 0.f},
+        {-0.5f, 0.5f, 0.f, 1.f},  {-0.5f, -0.5f, 0.f, 0.f},
+    };
 
-    for (VisualFX* fx : effects) {
-        // Other effects not implemented yet
-        if (fx->getType() != VisualFX::Particle) continue;
+    // Particles are drawn additively, so there's no need to sort them and
+    // each pool can be drawn with a single upload and draw.
+    for (const auto& pool : world->particles.getPools()) {
+        const auto count = pool->getCount();
+        if (count == 0) {
+            continue;
+        }
 
-        auto& particle = fx->particle;
+        particleVertices.clear();
+        particleVertices.reserve(count * 6);
 
-        auto& p = particle.position;
+        for (size_t i = 0; i < count; ++i) {
+            auto p = pool->getPosition(i);
 
-        // Figure the direction to the camera center.
-        auto amp = cpos - p;
-        glm::vec3 ptc = particle.up;
+            // Figure the direction to the camera center.
+            auto amp = cpos - p;
+            glm::vec3 ptc = pool->up[i];
 
-        if (particle.orientation == VisualFX::ParticleData::UpCamera) {
-            ptc = glm::normalize(amp - (glm::dot(amp, cfwd)) * cfwd);
-        } else if (particle.orientation == VisualFX::ParticleData::Camera) {
-            ptc = amp;
-        }
+            if (pool->orientation[i] == ParticleSystem::UpCamera) {
+                ptc = glm::normalize(amp - (glm::dot(amp, cfwd)) * cfwd);
+            } else if (pool->orientation[i] == ParticleSystem::Camera) {
+                ptc = amp;
+            }
 
-        ptc = glm::normalize(ptc);
+            // Basis of a plane facing ptc, as glm::lookAt would compute
+            auto forward = glm::normalize(ptc);
+            auto right =
+                glm::normalize(glm::cross(forward, glm::vec3(0.f, 0.f, 1.f)));
+            auto up = glm::cross(right, forward);
 
-        glm::mat4 transformMat(1.f);
+            const auto& size = pool->size[i];
+            auto colour = glm::u8vec4(
+                glm::clamp(pool->colour[i], 0.f, 1.f) * 255.f);
 
-        glm::mat4 lookMat = glm::lookAt(
-            glm::vec3(0.0f,0.0f,0.0f),
-            ptc,
-            glm::vec3(0.0f,0.0f,1.0f));
+            for (const auto& corner : kCorners) {
+                particleVertices.push_back(
+                    {p + right * (corner.x * size.x) + up * (corner.y * size.y),
+                     glm::vec2(corner.z, corner.w), colour});
+            }
+        }
 
-        transformMat = glm::scale(glm::translate(transformMat,p),
-            glm::vec3(particle.size,1.0f)) * glm::inverse(lookMat);
+        particleGeom.uploadVertices(particleVertices);
 
         Renderer::DrawParameters dp;
-        dp.textures = {particle.texture->getName()};
+        dp.textures = {pool->getTexture()->getName()};
         dp.ambient = 1.f;
-        dp.colour = glm::u8vec4(particle.colour * 255.f);
+        dp.colour = glm::u8vec4(255);
         dp.start = 0;
-        dp.count = 4;
+        dp.count = particleVertices.size();
         dp.blendMode = BlendMode::BLEND_ADDITIVE;
         dp.diffuse = 1.f;
 
-        renderer->drawArrays(transformMat, &particleDraw, dp);
+        renderer->drawArrays(glm::mat4(1.0f), &particleDraw, dp);
     }
 }
 
@@ -531,67 +485,17 @@ void GameRenderer::drawOnScreenText() {
 }
 
 void GameRenderer::drawTexture(TextureData* texture, glm::vec4 extents) {
-    glUseProgram(ssRectProgram);
-
-    // Move into NDC
-    extents.x /= renderer->getViewport().x;
-    extents.y /= renderer->getViewport().y;
-    extents.z /= renderer->getViewport().x;
-    extents.w /= renderer->getViewport().y;
-    extents.x += extents.z / 2.f;
-    extents.y += extents.w / 2.f;
-    extents.x -= .5f;
-    extents.y -= .5f;
-    extents *= glm::vec4(2.f, -2.f, 1.f, 1.f);
-
-    /// @todo rewrite this render code to use renderer class
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glUniform2f(ssRectOffset, extents.x, extents.y);
-    glUniform2f(ssRectSize, extents.z, extents.w);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture->getName());
-    glUniform1i(ssRectTexture, 0);
-    glUniform4f(ssRectColour, 0.f, 0.f, 0.f, 1.f);
-
-    glBindVertexArray(ssRectDraw.getVAOName());
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-    // Ooops
-    renderer->invalidate();
+    uiBatch.addRect(texture->getName(), extents, glm::vec4(0.f, 0.f, 1.f, 1.f),
+                    glm::u8vec4(255));
 }
 
 void GameRenderer::drawColour(const glm::vec4& colour, glm::vec4 extents) {
-    glUseProgram(ssRectProgram);
-
-    // Move into NDC
-    extents.x /= renderer->getViewport().x;
-    extents.y /= renderer->getViewport().y;
-    extents.z /= renderer->getViewport().x;
-    extents.w /= renderer->getViewport().y;
-    extents.x += extents.z / 2.f;
-    extents.y += extents.w / 2.f;
-    extents.x -= .5f;
-    extents.y -= .5f;
-    extents *= glm::vec4(2.f, -2.f, 1.f, 1.f);
-
-    /// @todo rewrite this render code to use renderer class
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glUniform2f(ssRectOffset, extents.x, extents.y);
-    glUniform2f(ssRectSize, extents.z, extents.w);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glUniform1i(ssRectTexture, 0);
-    glUniform4f(ssRectColour, colour.r, colour.g, colour.b, colour.a);
-
-    glBindVertexArray(ssRectDraw.getVAOName());
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-    // Ooops
-    renderer->invalidate();
+    uiBatch.addRect(0, extents, glm::vec4(0.f, 0.f, 1.f, 1.f),
+                    glm::u8vec4(glm::clamp(colour, 0.f, 1.f) * 255.f + 0.5f));
+}
+
+void GameRenderer::flushUI() {
+    sprites.draw(uiBatch);
 }
 
 void GameRenderer::renderPaths() {
@@ -678,24 +582,13 @@ void GameRenderer::renderPaths() {
 }
 
 void GameRenderer::renderLetterbox() {
-    /// @todo rewrite this render code to use renderer class
-    glUseProgram(ssRectProgram);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     const float cinematicExperienceSize = 0.15f;
-    glUniform2f(ssRectOffset, 0.f, -1.f * (1.f - cinematicExperienceSize));
-    glUniform2f(ssRectSize, 1.f, cinematicExperienceSize);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glUniform1i(ssRectTexture, 0);
-    glUniform4f(ssRectColour, 0.f, 0.f, 0.f, 1.f);
-
-    glBindVertexArray(ssRectDraw.getVAOName());
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-    glUniform2f(ssRectOffset, 0.f, 1.f * (1.f - cinematicExperienceSize));
-    glUniform2f(ssRectSize, 1.f, cinematicExperienceSize);
-
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    const glm::vec2 size(1.f, cinematicExperienceSize);
+    const glm::vec4 black(0.f, 0.f, 0.f, 1.f);
+    drawScreenRect(glm::vec2(0.f, -1.f * (1.f - cinematicExperienceSize)),
+                   size, black);
+    drawScreenRect(glm::vec2(0.f, 1.f * (1.f - cinematicExperienceSize)),
+                   size, black);
 }
 
 void GameRenderer::setViewport(int w, int h) {
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -14,6 +15,9 @@
 
 #include <render/OpenGLRenderer.hpp>
 #include <render/MapRenderer.hpp>
+#include <render/OcclusionBuffer.hpp>
+#include <render/SpriteBatch.hpp>
+#include <render/SpriteRenderer.hpp>
 #include <render/TextRenderer.hpp>
 #include <render/ViewCamera.hpp>
 #include <render/WaterRenderer.hpp>
@@ -23,6 +27,17 @@ class GameData;
 class GameWorld;
 class TextureData;
 
+/**
+ * @brief World space vertex of a particle billboard
+ */
+struct ParticleVert {
+    static const AttributeList vertex_attributes();
+
+    glm::vec3 position;
+    glm::vec2 texcoord;
+    glm::u8vec4 colour;
+};
+
 /**
  * @brief Implements high level drawing logic and low level draw commands
  *
@@ -54,6 +69,15 @@ class GameRenderer {
     /** Number of culling events */
     size_t culled;
 
+    /** Large occluders drawn on the CPU to cull what's behind them */
+    OcclusionBuffer occlusion;
+    bool occlusionCulling = true;
+    /** Number of culling events caused by occlusion */
+    size_t occluded = 0;
+
+    /** Seconds spent building and sorting the last render list */
+    float renderListTime = 0.f;
+
     GLuint framebufferName;
     GLuint fbTextures[2];
     GLuint fbRenderBuffers[1];
@@ -62,8 +86,10 @@ class GameRenderer {
     /// Texture used to replace textures missing from the data
     GLuint m_missingTexture;
 
+    /// Streaming buffer the particle pools are drawn from, one pool at a time
     GeometryBuffer particleGeom;
     DrawBuffer particleDraw;
+    std::vector<ParticleVert> particleVertices;
 
     std::vector<VertexP2> sspaceRect = {
             {-1.f, -1.f}, {1.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f},
@@ -72,6 +98,9 @@ class GameRenderer {
     GeometryBuffer ssRectGeom;
     DrawBuffer ssRectDraw;
 
+    /// Text and rectangles waiting for flushUI()
+    SpriteBatch uiBatch;
+
 public:
     GameRenderer(Logger* log, GameData* data);
     ~GameRenderer();
@@ -81,8 +110,7 @@ public:
     std::unique_ptr<Renderer::ShaderProgram> skyProg;
     std::unique_ptr<Renderer::ShaderProgram> particleProg;
 
-    GLuint ssRectProgram;
-    GLint ssRectTexture, ssRectColour, ssRectSize, ssRectOffset;
+    std::unique_ptr<Renderer::ShaderProgram> ssRectProg;
 
     GLuint skydomeVBO, skydomeIBO, debugVBO;
     GLuint debugTex;
@@ -102,6 +130,22 @@ public:
         return culled;
     }
 
+    size_t getOccludedCount() const {
+        return occluded;
+    }
+
+    void setOcclusionCulling(bool enable) {
+        occlusionCulling = enable;
+    }
+
+    bool getOcclusionCulling() const {
+        return occlusionCulling;
+    }
+
+    float getRenderListTime() const {
+        return renderListTime;
+    }
+
     /**
      * Renders the world using the parameters of the passed Camera.
      * Note: The camera's near and far planes are overriden by weather effects.
@@ -124,18 +168,40 @@ public:
     void drawOnScreenText();
 
     /**
-     * @brief Draws a texture on the screen
+     * @brief Queues a texture to be drawn on the screen by flushUI()
      */
     void drawTexture(TextureData* texture, glm::vec4 extents);
     void drawColour(const glm::vec4& colour, glm::vec4 extents);
 
+    /**
+     * @brief Draws everything queued for the UI since the last flush
+     *
+     * Anything drawn directly after this appears over the queued UI.
+     */
+    void flushUI();
+
+    SpriteBatch& getUIBatch() {
+        return uiBatch;
+    }
+
     /** method for rendering AI debug information */
     void renderPaths();
 
     /** Increases cinematic value */
     void renderLetterbox();
 
-    void setupRender();
+    /**
+     * Draws a rectangle in normalised device coordinates over the frame,
+     * blended by the colour's alpha
+     */
+    void drawScreenRect(const glm::vec2& offset, const glm::vec2& size,
+                        const glm::vec4& colour, GLuint texture = 0);
+
+    /**
+     * Directs drawing to the frame buffer that renderPostProcess() presents
+     * and clears it
+     */
+    void setupRender(const glm::vec4& clearColour);
     void renderPostProcess();
 
     std::shared_ptr<Renderer> getRenderer() {
@@ -149,6 +215,7 @@ public:
         cullOverride = override;
     }
 
+    SpriteRenderer sprites;
     MapRenderer map;
     WaterRenderer water;
     TextRenderer text;
@@ -170,6 +170,8 @@ layout(std140) uniform ObjectData {
 	float diffusefac;
 	float ambientfac;
 	float visibility;
+	vec4 positionOffset;
+	vec4 positionScale;
 };
 
 void main()
@@ -177,7 +179,8 @@ void main()
 	Normal = normal;
 	TexCoords = texCoords;
 	Colour = _colour;
-	vec4 worldspace = model * vec4(position, 1.0);
+	vec3 decoded = positionOffset.xyz + position * positionScale.xyz;
+	vec4 worldspace = model * vec4(decoded, 1.0);
 	vec4 viewspace = view * worldspace;
 	gl_Position = projection * viewspace;
 
@@ -211,6 +214,8 @@ layout(std140) uniform ObjectData {
 	float diffusefac;
 	float ambientfac;
 	float visibility;
+	vec4 positionOffset;
+	vec4 positionScale;
 };
 
 float alphaThreshold = (1.0/255.0);
@@ -253,6 +258,8 @@ layout(std140) uniform ObjectData {
 	float diffusefac;
 	float ambientfac;
 	float visibility;
+	vec4 positionOffset;
+	vec4 positionScale;
 };
 
 #define ALPHA_DISCARD_THRESHOLD 0.01
@@ -264,7 +271,7 @@ void main()
 	if(c.a <= ALPHA_DISCARD_THRESHOLD) discard;
 	float fogZ = (gl_FragCoord.z / gl_FragCoord.w);
 	float fogfac = clamp( (fogStart-fogZ)/(fogEnd-fogStart), 0.0, 1.0 );
-	vec4 tint = vec4(colour.rgb, visibility);
+	vec4 tint = vec4(colour.rgb * Colour.rgb, visibility);
 	outColour = c * tint;
 })";
 
@@ -299,6 +306,44 @@ void main()
 	outColour = vec4(colour.rgb + c.rgb, colour.a * c.a);
 })";
 
+const char* Sprite::VertexShader = R"(
+#version 330
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in float alphaOnly;
+layout(location = 2) in vec4 colour;
+layout(location = 3) in vec2 texcoord;
+out vec2 TexCoord;
+out vec4 Colour;
+out float AlphaOnly;
+
+uniform mat4 proj;
+
+void main()
+{
+	gl_Position = proj * vec4(position, 0.0, 1.0);
+	TexCoord = texcoord;
+	Colour = colour;
+	AlphaOnly = alphaOnly;
+})";
+
+const char* Sprite::FragmentShader = R"(
+#version 330
+
+in vec2 TexCoord;
+in vec4 Colour;
+in float AlphaOnly;
+uniform sampler2D spriteTexture;
+out vec4 outColour;
+
+void main()
+{
+	vec4 c = texture(spriteTexture, TexCoord);
+	// Fonts only provide coverage, their colour comes from the vertex
+	c.rgb = mix(c.rgb, vec3(1.0), AlphaOnly);
+	outColour = c * Colour;
+})";
+
 const char* DefaultPostProcess::VertexShader = R"(
 #version 330
 
@@ -47,6 +47,11 @@ struct ScreenSpaceRect {
     static const char* FragmentShader;
 };
 
+/**
+ * @brief Screen space quads drawn by SpriteRenderer
+ */
+SHADER_VF(Sprite);
+
 SHADER_VF(DefaultPostProcess);
 }
 
@@ -14,6 +14,25 @@
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
 #include "objects/GameObject.hpp"
+#include "render/SpriteRenderer.hpp"
+
+namespace {
+/// Corners of the unit rect, in SpriteBatch order
+const SpriteBatch::Corners kUnitCorners{
+    {{-.5f, -.5f}, {.5f, -.5f}, {.5f, .5f}, {-.5f, .5f}}};
+
+SpriteBatch::Corners transformCorners(const glm::mat4& m) {
+    SpriteBatch::Corners corners;
+    for (size_t c = 0; c < corners.size(); ++c) {
+        corners[c] = glm::vec2(m * glm::vec4(kUnitCorners[c], 0.f, 1.f));
+    }
+    return corners;
+}
+
+glm::u8vec4 toColour(const glm::vec4& colour) {
+    return glm::u8vec4(glm::clamp(colour, 0.f, 1.f) * 255.f + 0.5f);
+}
+}  // namespace
 
 const char* MapVertexShader = R"(
 #version 330
@@ -46,8 +65,9 @@ void main()
 	outColour = vec4(colour.rgb + c.rgb, colour.a * c.a);
 })";
 
-MapRenderer::MapRenderer(std::shared_ptr<Renderer> renderer, GameData* _data)
-    : data(_data), renderer(renderer) {
+MapRenderer::MapRenderer(std::shared_ptr<Renderer> renderer, GameData* _data,
+                         SpriteRenderer* sprites)
+    : data(_data), renderer(renderer), sprites(sprites) {
     rectGeom.uploadVertices<VertexP2>(
         {{-.5f, -.5f}, {.5f, -.5f}, {.5f, .5f}, {-.5f, .5f}});
     rect.addGeometry(&rectGeom);
@@ -113,7 +133,6 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
     view = glm::rotate(view, mi.rotation, glm::vec3(0.f, 0.f, 1.f));
     view = glm::translate(
         view, glm::vec3(glm::vec2(-1.f, 1.f) * mi.worldCenter, 0.f));
-    renderer->setUniform(rectProg.get(), "view", view);
 
     // radar00 = -x, +y
     // incrementing in X, then Y
@@ -125,9 +144,6 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
         std::string num = (m < 10 ? "0" : "");
         std::string name = "radar" + num + std::to_string(m);
         auto texture = world->data->findSlotTexture(name, name);
-        dp.textures = {texture->getName()};
-
-        dp.count = 4;
 
         int mX = initX + (m % mapBlockLine);
         int mY = initY + (m / mapBlockLine);
@@ -138,12 +154,15 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
         tilemodel = glm::translate(tilemodel, glm::vec3(tc, 0.f));
         tilemodel = glm::scale(tilemodel, glm::vec3(tileSize, 1.f));
 
-        renderer->setUniform(rectProg.get(), "model", tilemodel);
-
-        renderer->drawArrays(glm::mat4(1.0f), &rect, dp);
+        batch.addQuad(texture->getName(), transformCorners(view * tilemodel),
+                      glm::vec4(0.f, 0.f, .99f, .99f), glm::u8vec4(255));
     }
 
+    // The tiles are drawn while the stencil is still clipping
+    sprites->draw(batch);
+
     // From here on out we will work in screenspace
+    renderer->useProgram(rectProg.get());
     renderer->setUniform(rectProg.get(), "view", glm::mat4(1.0f));
 
     if (mi.clipToSize) {
@@ -153,6 +172,7 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
         TextureData::Handle radarDisc =
             data->findSlotTexture("hud", "radardisc");
         dp.textures = {radarDisc->getName()};
+        dp.count = 4;
 
         glm::mat4 model{1.0f};
         model = glm::translate(model, glm::vec3(mi.screenPosition, 0.0f));
@@ -168,12 +188,12 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
     if (player) {
         glm::vec2 plyblip(player->getPosition());
         float hdg = glm::roll(player->getRotation());
-        drawBlip(plyblip, view, mi, "radar_centre",
-                 glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 18.0f, mi.rotation - hdg);
+        addBlip(plyblip, view, mi, "radar_centre",
+                glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 18.0f, mi.rotation - hdg);
     }
 
-    drawBlip(mi.worldCenter + glm::vec2(0.f, mi.worldSize), view, mi,
-             "radar_north", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 24.f);
+    addBlip(mi.worldCenter + glm::vec2(0.f, mi.worldSize), view, mi,
+            "radar_north", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 24.f);
 
     for (auto& radarBlip : world->state->radarBlips) {
         const auto& blip = radarBlip.second;
@@ -193,8 +213,8 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
 
         const auto& texture = blip.texture;
         if (!texture.empty()) {
-            drawBlip(blippos, view, mi, texture,
-                     glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 18.0f);
+            addBlip(blippos, view, mi, texture,
+                    glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 18.0f);
         } else {
             // Colours from http://www.gtamodding.com/wiki/0165 (colors not
             // specific to that opcode!)
@@ -232,18 +252,20 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
                              1.0f  // Note: Alpha is not controlled by blip
                              );
 
-            drawBlip(blippos, view, mi, colour, blip.size * 2.0f);
+            addBlip(blippos, view, mi, colour, blip.size * 2.0f);
         }
     }
 
+    sprites->draw(batch);
+
     /// @TODO migrate to using the renderer
     renderer->invalidate();
     renderer->popDebugGroup();
 }
 
-void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                              const MapInfo& mi, const std::string& texture,
-                              glm::vec4 colour, float size, float heading) {
+void MapRenderer::addBlip(const glm::vec2& coord, const glm::mat4& view,
+                          const MapInfo& mi, const std::string& texture,
+                          const glm::vec4& colour, float size, float heading) {
     glm::vec2 adjustedCoord = coord;
     if (mi.clipToSize) {
         float maxDist = mi.worldSize / 2.f;
@@ -260,32 +282,25 @@ void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
     model = glm::translate(model, viewPos);
     model = glm::scale(model, glm::vec3(size));
     model = glm::rotate(model, heading, glm::vec3(0.f, 0.f, 1.f));
-    renderer->setUniform(rectProg.get(), "model", model);
 
     GLuint tex = 0;
+    glm::u8vec4 tint = toColour(colour);
     if (!texture.empty()) {
         auto sprite = data->findSlotTexture("hud", texture);
         tex = sprite->getName();
+        // Textured blips are passed black, the texture alone is drawn
+        tint = glm::u8vec4(255, 255, 255, tint.a);
     }
-    renderer->setUniform(rectProg.get(), "colour", colour);
-
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-}
 
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, const std::string& texture,
-                           glm::vec4 colour, float size, float heading) {
-    prepareBlip(coord, view, mi, texture, colour, size, heading);
-    glBindVertexArray(rect.getVAOName());
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    batch.addQuad(tex, transformCorners(model), glm::vec4(0.f, 0.f, .99f, .99f),
+                  tint);
 }
 
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, glm::vec4 colour, float size) {
-    drawBlip(coord, view, mi, "", colour, size);
-    // Draw outline
-    renderer->setUniform(rectProg.get(), "colour", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+void MapRenderer::addBlip(const glm::vec2& coord, const glm::mat4& view,
+                          const MapInfo& mi, const glm::vec4& colour,
+                          float size) {
+    // Outline, as a black quad one pixel larger on each side
+    addBlip(coord, view, mi, "", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),
+            size + 2.f);
+    addBlip(coord, view, mi, "", colour, size);
 }
@@ -10,14 +10,18 @@
 #include <gl/GeometryBuffer.hpp>
 
 #include "render/OpenGLRenderer.hpp"
+#include "render/SpriteBatch.hpp"
 
 class GameData;
+class SpriteRenderer;
 class GameWorld;
 
 #define MAP_BLOCK_SIZE 63
 
 /**
  * Utility class for rendering the world map, in the menu and radar.
+ *
+ * The map tiles and the blips are each drawn as one SpriteBatch.
  */
 class MapRenderer {
 public:
@@ -36,7 +40,8 @@ public:
         bool clipToSize = true;
     };
 
-    MapRenderer(std::shared_ptr<Renderer> renderer, GameData* data);
+    MapRenderer(std::shared_ptr<Renderer> renderer, GameData* data,
+                SpriteRenderer* sprites);
 
     void draw(GameWorld* world, const MapInfo& mi);
 
@@ -52,14 +57,14 @@ private:
 
     std::unique_ptr<Renderer::ShaderProgram> rectProg;
 
-    void prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                     const MapInfo& mi, const std::string& texture,
-                     glm::vec4 colour, float size, float heading);
-    void drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                  const MapInfo& mi, const std::string& texture,
-                  glm::vec4 colour, float size, float heading = 0.0f);
-    void drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                  const MapInfo& mi, glm::vec4 colour, float size);
+    SpriteRenderer* sprites;
+    SpriteBatch batch;
+
+    void addBlip(const glm::vec2& coord, const glm::mat4& view,
+                 const MapInfo& mi, const std::string& texture,
+                 const glm::vec4& colour, float size, float heading = 0.0f);
+    void addBlip(const glm::vec2& coord, const glm::mat4& view,
+                 const MapInfo& mi, const glm::vec4& colour, float size);
 };
 
 #endif
@@ -1,17 +1,22 @@
 #include "render/ObjectRenderer.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <BulletDynamics/Vehicle/btRaycastVehicle.h>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <data/Clump.hpp>
 
+#include "data/CollisionModel.hpp"
 #include "data/CutsceneData.hpp"
 #include "data/WeaponData.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "render/OcclusionBuffer.hpp"
 #include "render/ViewCamera.hpp"
 
 // Objects that we know how to turn into renderlist entries
@@ -35,6 +40,19 @@ constexpr float kMagicLODDistance = 330.f;
 constexpr float kVehicleLODDistance = 70.f;
 constexpr float kVehicleDrawDistance = 280.f;
 
+constexpr size_t ObjectRenderer::kMaxOccluders;
+constexpr size_t ObjectRenderer::kMaxOccluderTriangles;
+
+namespace {
+/// Handles times provided by TOBJ data
+bool isShownAtHour(const SimpleModelInfo* modelinfo, int hour) {
+    if (modelinfo->timeOff < modelinfo->timeOn) {
+        return hour < modelinfo->timeOff || hour >= modelinfo->timeOn;
+    }
+    return hour < modelinfo->timeOff && hour >= modelinfo->timeOn;
+}
+}  // namespace
+
 RenderKey createKey(float normalizedDepth, Renderer::Textures& textures) {
     return (uint32_t(0x7FFFFF * normalizedDepth) << 8 |
             uint8_t(0xFF & (!textures.empty() ? textures[0] : 0)));
@@ -50,7 +68,10 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
 
         dp.colour = {255, 255, 255, 255};
         dp.count = subgeom.numIndices;
-        dp.start = subgeom.start;
+        dp.start = geom->getFirstIndex() + subgeom.start;
+        dp.baseVertex = geom->getBaseVertex();
+        dp.positionOffset = geom->positionOffset;
+        dp.positionScale = geom->positionScale;
         dp.textures = {0};
         dp.visibility = 1.f;
 
@@ -106,7 +127,7 @@ void ObjectRenderer::renderGeometry(Geometry* geom,
         float depth = (distance - m_camera.frustum.near) /
                       (m_camera.frustum.far - m_camera.frustum.near);
         outList.emplace_back(createKey(depth * depth, dp.textures), modelMatrix,
-                             &geom->dbuff, dp);
+                             geom->getDrawBuffer(), dp);
     }
 }
 
@@ -129,6 +150,23 @@ void ObjectRenderer::renderAtomic(Atomic* atomic,
         return;
     }
 
+    if (m_occlusion && !m_occlusion->isVisible(boundpos, bounds.radius) &&
+        std::find(m_occluders.begin(), m_occluders.end(), object) ==
+            m_occluders.end()) {
+        culled++;
+        occluded++;
+        return;
+    }
+
+    if (object) {
+        // Objects hidden for a while only kept their animation time
+        if (object->refreshHiddenPose()) {
+            transform = worldtransform * frame->getWorldTransform();
+        }
+        object->setDrawn(m_world->getGameTime(),
+                         glm::distance(m_camera.position, boundpos));
+    }
+
     renderGeometry(geometry.get(), transform, object, render);
 }
 
@@ -158,16 +196,8 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
 
     auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
 
-    // Handles times provided by TOBJ data
-    const auto currentHour = m_world->getHour();
-    if (modelinfo->timeOff < modelinfo->timeOn) {
-        if (currentHour >= modelinfo->timeOff &&
-            currentHour < modelinfo->timeOn)
-            return;
-    } else {
-        if (currentHour >= modelinfo->timeOff ||
-            currentHour < modelinfo->timeOn)
-            return;
+    if (!isShownAtHour(modelinfo, m_world->getHour())) {
+        return;
     }
 
     float mindist = glm::length(instance->getPosition() - m_camera.position) /
@@ -224,7 +254,7 @@ void ObjectRenderer::renderCharacter(CharacterObject* pedestrian,
         }
     }
 
-    renderClump(pedestrian->getClump().get(), glm::mat4(1.0f), nullptr,
+    renderClump(pedestrian->getClump().get(), glm::mat4(1.0f), pedestrian,
                 outList);
 
     auto item = pedestrian->getActiveItem();
@@ -382,3 +412,131 @@ void ObjectRenderer::buildRenderList(GameObject* object, RenderList& outList) {
             break;
     }
 }
+
+void ObjectRenderer::buildWorldRenderList(Clump* indicatorModel,
+                                          Clump* arrowModel,
+                                          RenderList& outList) {
+    // World Objects
+    for (auto object : m_world->allObjects) {
+        buildRenderList(object, outList);
+    }
+
+    // Area indicators
+    if (indicatorModel) {
+        for (auto& i : m_world->getAreaIndicators()) {
+            glm::mat4 m(1.f);
+            m = glm::translate(m, i.position);
+            m = glm::scale(
+                m, glm::vec3(i.radius +
+                             0.15f * glm::sin(m_world->getGameTime() * 5.f)));
+
+            renderClump(indicatorModel, m, nullptr, outList);
+        }
+    }
+
+    // Render arrows above anything that isn't radar only (or hidden)
+    if (!arrowModel) {
+        return;
+    }
+    for (auto& blip : m_world->state->radarBlips) {
+        auto dm = blip.second.display;
+        if (dm == BlipData::Hide || dm == BlipData::RadarOnly) {
+            continue;
+        }
+
+        glm::mat4 model{1.0f};
+
+        if (blip.second.target > 0) {
+            auto object = m_world->getBlipTarget(blip.second);
+            if (object) {
+                model = object->getTimeAdjustedTransform(m_renderAlpha);
+            }
+        } else {
+            model = glm::translate(model, blip.second.coord);
+        }
+
+        float a = m_world->getGameTime() * glm::pi<float>();
+        model = glm::translate(model,
+                               glm::vec3(0.f, 0.f, 2.5f + glm::sin(a) * 0.5f));
+        model = glm::rotate(model, a, glm::vec3(0.f, 0.f, 1.f));
+        model = glm::scale(model, glm::vec3(1.5f, 1.5f, 1.5f));
+        renderClump(arrowModel, model, nullptr, outList);
+    }
+}
+
+void ObjectRenderer::sortRenderList(RenderList& list) {
+    // Earlier position in the array means earlier object's rendering
+    // Transparent objects should be sorted and rendered after opaque
+    std::sort(list.begin(), list.end(),
+              [](const Renderer::RenderInstruction& a,
+                 const Renderer::RenderInstruction& b) {
+                  const bool aOpaque =
+                      a.drawInfo.blendMode == BlendMode::BLEND_NONE;
+                  const bool bOpaque =
+                      b.drawInfo.blendMode == BlendMode::BLEND_NONE;
+                  if (aOpaque != bOpaque) {
+                      return aOpaque;
+                  }
+                  return a.sortKey > b.sortKey;
+              });
+}
+
+void ObjectRenderer::buildOcclusion(OcclusionBuffer* buffer) {
+    m_occlusion = buffer;
+    m_occluders.clear();
+    if (!buffer) {
+        return;
+    }
+
+    struct Candidate {
+        float score;
+        InstanceObject* instance;
+        CollisionModel* collision;
+    };
+    std::vector<Candidate> candidates;
+
+    const auto hour = m_world->getHour();
+    for (const auto& p : m_world->instancePool.objects) {
+        auto instance = static_cast<InstanceObject*>(p.second);
+        // Moving objects and anything see-through can't hide others
+        if (!instance->isVisible() || instance->dynamics) {
+            continue;
+        }
+        auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
+        auto collision = modelinfo->getCollision();
+        if (!collision ||
+            (modelinfo->flags & (SimpleModelInfo::DRAW_LAST |
+                                 SimpleModelInfo::NO_ZBUFFER_WRITE)) ||
+            !isShownAtHour(modelinfo, hour)) {
+            continue;
+        }
+
+        const auto& sphere = collision->boundingSphere;
+        const auto center = instance->getPosition() +
+                            instance->getRotation() * sphere.center;
+        const float score = OcclusionBuffer::occluderScore(
+            m_camera.position, center, sphere.radius);
+        if (score <= 0.f ||
+            !m_camera.frustum.intersects(center, sphere.radius)) {
+            continue;
+        }
+        candidates.push_back({score, instance, collision});
+    }
+
+    const auto count = std::min(candidates.size(), kMaxOccluders);
+    std::partial_sort(candidates.begin(), candidates.begin() + count,
+                      candidates.end(),
+                      [](const Candidate& a, const Candidate& b) {
+                          return a.score > b.score;
+                      });
+
+    size_t submitted = 0;
+    for (size_t i = 0; i < count && submitted < kMaxOccluderTriangles; ++i) {
+        auto instance = candidates[i].instance;
+        glm::mat4 transform =
+            glm::translate(glm::mat4(1.f), instance->getPosition()) *
+            glm::mat4_cast(instance->getRotation());
+        submitted += buffer->addCollision(transform, *candidates[i].collision);
+        m_occluders.push_back(instance);
+    }
+}
@@ -2,6 +2,7 @@
 #define _RWENGINE_OBJECTRENDERER_HPP_
 
 #include <cstddef>
+#include <vector>
 
 #include <gl/gl_core_3_3.h>
 
@@ -20,6 +21,7 @@ class CutsceneObject;
 class GameObject;
 class GameWorld;
 class InstanceObject;
+class OcclusionBuffer;
 class PickupObject;
 class ProjectileObject;
 class VehicleObject;
@@ -34,9 +36,15 @@ struct Geometry;
  */
 class ObjectRenderer {
 public:
+    /// Most occluders rasterized into the occlusion buffer each frame
+    static constexpr size_t kMaxOccluders = 24;
+    /// Occluders stop being added once this many triangles are submitted
+    static constexpr size_t kMaxOccluderTriangles = 8192;
+
     ObjectRenderer(GameWorld* world, const ViewCamera& camera,
                    float renderAlpha, GLuint errorTexture)
         : culled(0)
+        , occluded(0)
         , m_world(world)
         , m_camera(camera)
         , m_renderAlpha(renderAlpha)
@@ -49,8 +57,34 @@ public:
      * Exports rendering instructions for an object
      */
     size_t culled;
+    /// Number of atomics culled by the occlusion buffer, included in culled
+    size_t occluded;
     void buildRenderList(GameObject* object, RenderList& outList);
 
+    /**
+     * @brief Rasterizes the largest instances on screen into buffer
+     *
+     * The buffer must already have begun the frame. Atomics are then tested
+     * against it until the next call, pass nullptr to stop testing.
+     */
+    void buildOcclusion(OcclusionBuffer* buffer);
+
+    /**
+     * @brief Exports rendering instructions for the whole world
+     *
+     * Covers every object, the area indicators and the arrows above blips.
+     * Indicators and arrows are skipped if their model is null.
+     */
+    void buildWorldRenderList(Clump* indicatorModel, Clump* arrowModel,
+                              RenderList& outList);
+
+    /**
+     * @brief Sorts a render list into drawing order
+     *
+     * Opaque instructions come first, then the rest, each by descending key.
+     */
+    static void sortRenderList(RenderList& list);
+
     void renderGeometry(Geometry* geom, const glm::mat4& modelMatrix,
                         GameObject* object, RenderList& outList);
 
@@ -76,6 +110,9 @@ private:
     const ViewCamera& m_camera;
     float m_renderAlpha;
     GLuint m_errorTexture;
+    const OcclusionBuffer* m_occlusion = nullptr;
+    /// Instances drawn into the occlusion buffer, never culled by it
+    std::vector<GameObject*> m_occluders;
 
     void renderInstance(InstanceObject* instance, RenderList& outList);
     void renderCharacter(CharacterObject* pedestrian, RenderList& outList);
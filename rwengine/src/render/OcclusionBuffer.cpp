@@ -0,0 +1,213 @@
+#include "render/OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "data/CollisionModel.hpp"
+
+constexpr size_t OcclusionBuffer::kDefaultWidth;
+constexpr size_t OcclusionBuffer::kDefaultHeight;
+constexpr float OcclusionBuffer::kDepthBias;
+constexpr float OcclusionBuffer::kMinOccluderRadius;
+
+namespace {
+/// Points nearer than this to the camera plane can't be projected safely
+constexpr float kMinW = 0.01f;
+
+constexpr int kBoxFaces[12][3] = {
+    {0, 1, 3}, {0, 3, 2}, {4, 6, 7}, {4, 7, 5}, {0, 4, 5}, {0, 5, 1},
+    {2, 3, 7}, {2, 7, 6}, {0, 2, 6}, {0, 6, 4}, {1, 5, 7}, {1, 7, 3},
+};
+
+glm::vec3 boxCorner(const glm::vec3& min, const glm::vec3& max, int i) {
+    return {(i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y,
+            (i & 4) ? max.z : min.z};
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer(size_t width, size_t height)
+    : width(width), height(height), depth(width * height, 0.f) {
+}
+
+void OcclusionBuffer::begin(const glm::mat4& vp) {
+    viewProjection = vp;
+    std::fill(depth.begin(), depth.end(), 0.f);
+    triangles = 0;
+}
+
+bool OcclusionBuffer::project(const glm::vec3& p, glm::vec3& screen) const {
+    const auto clip = viewProjection * glm::vec4(p, 1.f);
+    if (clip.w < kMinW) {
+        return false;
+    }
+    const float iw = 1.f / clip.w;
+    screen.x = (clip.x * iw * 0.5f + 0.5f) * width;
+    screen.y = (clip.y * iw * 0.5f + 0.5f) * height;
+    screen.z = iw;
+    return true;
+}
+
+void OcclusionBuffer::addTriangle(const glm::vec3& a, const glm::vec3& b,
+                                  const glm::vec3& c) {
+    // Clipping would only make the occluder smaller, so skip it instead
+    glm::vec3 v0, v1, v2;
+    if (!project(a, v0) || !project(b, v1) || !project(c, v2)) {
+        return;
+    }
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+    // Both windings occlude, make it counter clockwise
+    if (area < 0.f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // Pixels with their centre inside the triangle's bounds
+    const int x0 = std::max(
+        0, int(std::ceil(std::min({v0.x, v1.x, v2.x}) - 0.5f)));
+    const int x1 = std::min(
+        int(width) - 1, int(std::floor(std::max({v0.x, v1.x, v2.x}) - 0.5f)));
+    const int y0 = std::max(
+        0, int(std::ceil(std::min({v0.y, v1.y, v2.y}) - 0.5f)));
+    const int y1 = std::min(
+        int(height) - 1,
+        int(std::floor(std::max({v0.y, v1.y, v2.y}) - 0.5f)));
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    triangles++;
+
+    // Edge functions opposite each vertex, their steps along x, and depth
+    // divided by area so the edge values weight it directly
+    const float stepX0 = v2.y - v1.y;
+    const float stepX1 = v0.y - v2.y;
+    const float stepX2 = v1.y - v0.y;
+    const float px = x0 + 0.5f;
+    const float invArea = 1.f / area;
+    const float iw0 = v0.z * invArea;
+    const float iw1 = v1.z * invArea;
+    const float iw2 = v2.z * invArea;
+
+    for (int y = y0; y <= y1; ++y) {
+        const float py = y + 0.5f;
+        const float e0 = (v2.x - v1.x) * (py - v1.y) - stepX0 * (px - v1.x);
+        const float e1 = (v0.x - v2.x) * (py - v2.y) - stepX1 * (px - v2.x);
+        const float e2 = (v1.x - v0.x) * (py - v0.y) - stepX2 * (px - v0.x);
+        float* row = depth.data() + y * width;
+
+        // No branches, so the compiler is free to vectorize this loop
+        for (int x = x0; x <= x1; ++x) {
+            const float fx = float(x - x0);
+            const float w0 = e0 - stepX0 * fx;
+            const float w1 = e1 - stepX1 * fx;
+            const float w2 = e2 - stepX2 * fx;
+            const float d = w0 * iw0 + w1 * iw1 + w2 * iw2;
+            // Compute both sides and select, with floating point traps on
+            // the compiler won't if-convert arithmetic that only one needs
+            const float current = row[x];
+            const float nearest = std::max(current, d);
+            row[x] = std::min(w0, std::min(w1, w2)) >= 0.f ? nearest : current;
+        }
+    }
+}
+
+void OcclusionBuffer::addBox(const glm::mat4& transform, const glm::vec3& min,
+                             const glm::vec3& max) {
+    glm::vec3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        corners[i] =
+            glm::vec3(transform * glm::vec4(boxCorner(min, max, i), 1.f));
+    }
+    for (const auto& face : kBoxFaces) {
+        addTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+    }
+}
+
+size_t OcclusionBuffer::addCollision(const glm::mat4& transform,
+                                     const CollisionModel& collision) {
+    for (const auto& box : collision.boxes) {
+        addBox(transform, box.min, box.max);
+    }
+
+    scratch.clear();
+    scratch.reserve(collision.vertices.size());
+    for (const auto& v : collision.vertices) {
+        scratch.emplace_back(transform * glm::vec4(v, 1.f));
+    }
+    for (const auto& face : collision.faces) {
+        if (face.tri[0] >= scratch.size() || face.tri[1] >= scratch.size() ||
+            face.tri[2] >= scratch.size()) {
+            continue;
+        }
+        addTriangle(scratch[face.tri[0]], scratch[face.tri[1]],
+                    scratch[face.tri[2]]);
+    }
+
+    return collision.boxes.size() * 12 + collision.faces.size();
+}
+
+bool OcclusionBuffer::isVisible(const glm::vec3& min,
+                                const glm::vec3& max) const {
+    if (triangles == 0) {
+        return true;
+    }
+
+    float minX = std::numeric_limits<float>::max();
+    float minY = minX;
+    float maxX = -minX;
+    float maxY = -minX;
+    float nearest = minX;
+    for (int i = 0; i < 8; ++i) {
+        const auto clip =
+            viewProjection * glm::vec4(boxCorner(min, max, i), 1.f);
+        if (clip.w < kMinW) {
+            return true;
+        }
+        const float iw = 1.f / clip.w;
+        const float x = (clip.x * iw * 0.5f + 0.5f) * width;
+        const float y = (clip.y * iw * 0.5f + 0.5f) * height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::min(nearest, clip.w);
+    }
+
+    nearest -= kDepthBias;
+    if (nearest < kMinW) {
+        return true;
+    }
+    const float threshold = 1.f / nearest;
+
+    // Every pixel the bounds touch
+    const int x0 = std::max(0, int(std::floor(minX)));
+    const int x1 = std::min(int(width) - 1, int(std::floor(maxX)));
+    const int y0 = std::max(0, int(std::floor(minY)));
+    const int y1 = std::min(int(height) - 1, int(std::floor(maxY)));
+    if (x0 > x1 || y0 > y1) {
+        // Off screen, that's for the frustum to decide
+        return true;
+    }
+
+    for (int y = y0; y <= y1; ++y) {
+        const float* row = depth.data() + y * width;
+        if (*std::min_element(row + x0, row + x1 + 1) <= threshold) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float OcclusionBuffer::occluderScore(const glm::vec3& cameraPosition,
+                                     const glm::vec3& center, float radius) {
+    if (radius < kMinOccluderRadius) {
+        return 0.f;
+    }
+    return radius / std::max(glm::distance(cameraPosition, center), radius);
+}
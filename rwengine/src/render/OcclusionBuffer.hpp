@@ -0,0 +1,103 @@
+#ifndef _RWENGINE_OCCLUSIONBUFFER_HPP_
+#define _RWENGINE_OCCLUSIONBUFFER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct CollisionModel;
+
+/**
+ * @brief Low resolution depth buffer for culling objects hidden by others
+ *
+ * Large occluders are rasterized on the CPU each frame, then object bounds
+ * are tested against the result before they are added to the render list.
+ * The buffer stores 1 / view depth, so depth interpolates linearly across
+ * the screen and 0 is infinitely far away.
+ *
+ * Both sides err towards visible: occluders that cross the near plane are
+ * skipped and bounds are tested against every pixel they touch.
+ */
+class OcclusionBuffer {
+public:
+    static constexpr size_t kDefaultWidth = 256;
+    static constexpr size_t kDefaultHeight = 128;
+    /// Distance in world units an object must be behind an occluder
+    static constexpr float kDepthBias = 1.f;
+    /// Occluders smaller than this aren't worth rasterizing
+    static constexpr float kMinOccluderRadius = 10.f;
+
+    OcclusionBuffer(size_t width = kDefaultWidth,
+                    size_t height = kDefaultHeight);
+
+    /**
+     * Clears the buffer and sets the transform used to project occluders
+     * and bounds for this frame
+     */
+    void begin(const glm::mat4& viewProjection);
+
+    void addTriangle(const glm::vec3& a, const glm::vec3& b,
+                     const glm::vec3& c);
+
+    /// Adds the faces of a box given in the space of transform
+    void addBox(const glm::mat4& transform, const glm::vec3& min,
+                const glm::vec3& max);
+
+    /**
+     * Adds the boxes and faces of a collision model
+     * @return the number of triangles added
+     */
+    size_t addCollision(const glm::mat4& transform,
+                        const CollisionModel& collision);
+
+    /// Returns false if the box is certainly hidden behind occluders
+    bool isVisible(const glm::vec3& min, const glm::vec3& max) const;
+
+    bool isVisible(const glm::vec3& center, float radius) const {
+        return isVisible(center - glm::vec3(radius),
+                         center + glm::vec3(radius));
+    }
+
+    /**
+     * Ranks a potential occluder by how much of the screen it covers, 0 if
+     * it's too small to be worth using
+     */
+    static float occluderScore(const glm::vec3& cameraPosition,
+                               const glm::vec3& center, float radius);
+
+    size_t getWidth() const {
+        return width;
+    }
+
+    size_t getHeight() const {
+        return height;
+    }
+
+    /// Returns 1 / view depth of the nearest occluder at a pixel
+    float getDepth(size_t x, size_t y) const {
+        return depth[y * width + x];
+    }
+
+    size_t getTriangleCount() const {
+        return triangles;
+    }
+
+    bool empty() const {
+        return triangles == 0;
+    }
+
+private:
+    /// Projects a point, returns false if it's behind the near plane
+    bool project(const glm::vec3& p, glm::vec3& screen) const;
+
+    size_t width;
+    size_t height;
+    glm::mat4 viewProjection{1.f};
+    std::vector<float> depth;
+    size_t triangles = 0;
+    /// Collision vertices in world space, kept to avoid reallocating
+    std::vector<glm::vec3> scratch;
+};
+
+#endif
@@ -247,7 +247,7 @@ void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
 }
 
 void OpenGLRenderer::clear(const glm::vec4& colour, bool clearColour,
-                           bool clearDepth) {
+                           bool clearDepth, bool clearStencil) {
     auto flags = 0;
     if (clearColour) {
         flags |= GL_COLOR_BUFFER_BIT;
@@ -258,12 +258,58 @@ void OpenGLRenderer::clear(const glm::vec4& colour, bool clearColour,
         flags |= GL_DEPTH_BUFFER_BIT;
         setDepthWrite(true);
     }
+    if (clearStencil) {
+        flags |= GL_STENCIL_BUFFER_BIT;
+        glClearStencil(0x00);
+        glStencilMask(0xFF);
+    }
 
     glClear(flags);
 
     if (depthWriteWasEnabled != depthWriteEnabled) {
         setDepthWrite(depthWriteWasEnabled);
     }
+    if (clearStencil && stencilMode == StencilMode::Test) {
+        glStencilMask(0x00);
+    }
+}
+
+void OpenGLRenderer::setFramebuffer(GLuint framebuffer) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, getViewport().x, getViewport().y);
+}
+
+void OpenGLRenderer::setDrawAttachment(GLuint attachment) {
+    GLenum buffers[] = {GL_COLOR_ATTACHMENT0 + attachment};
+    glDrawBuffers(1, buffers);
+}
+
+void OpenGLRenderer::setDepthTest(bool enable) {
+    if (enable) {
+        glEnable(GL_DEPTH_TEST);
+    } else {
+        glDisable(GL_DEPTH_TEST);
+    }
+}
+
+void OpenGLRenderer::setStencilMode(StencilMode mode) {
+    switch (mode) {
+        case StencilMode::Disabled:
+            glDisable(GL_STENCIL_TEST);
+            break;
+        case StencilMode::Write:
+            glEnable(GL_STENCIL_TEST);
+            glStencilFunc(GL_ALWAYS, 1, 0xFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+            glStencilMask(0xFF);
+            break;
+        case StencilMode::Test:
+            glEnable(GL_STENCIL_TEST);
+            glStencilFunc(GL_EQUAL, 1, 0xFF);
+            glStencilMask(0x00);
+            break;
+    }
+    stencilMode = mode;
 }
 
 void OpenGLRenderer::setSceneParameters(
@@ -287,6 +333,8 @@ void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
                              glm::vec4(p.colour.r / 255.f, p.colour.g / 255.f,
                                        p.colour.b / 255.f, p.colour.a / 255.f),
                              1.f, 1.f, p.visibility};
+    objectData.positionOffset = glm::vec4(p.positionOffset, 0.f);
+    objectData.positionScale = glm::vec4(p.positionScale, 0.f);
     uploadUBO(UBOObject, objectData);
 
     drawCounter++;
@@ -302,8 +350,10 @@ void OpenGLRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
                           const Renderer::DrawParameters& p) {
     setDrawState(model, draw, p);
 
-    glDrawElements(draw->getFaceType(), p.count, GL_UNSIGNED_INT,
-                   (void*)(sizeof(RenderIndex) * p.start));
+    glDrawElementsBaseVertex(draw->getFaceType(), p.count,
+                             draw->getIndexType(),
+                             (void*)(draw->getIndexSize() * p.start),
+                             p.baseVertex);
 }
 
 void OpenGLRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
@@ -1,6 +1,7 @@
 #ifndef _RWENGINE_OPENGLRENDERER_HPP_
 #define _RWENGINE_OPENGLRENDERER_HPP_
 
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <map>
@@ -62,6 +63,18 @@ enum class BlendMode {
     BLEND_ADDITIVE
 };
 
+/**
+ * Stencil state used to mask drawing to an area, such as the water surface
+ */
+enum class StencilMode {
+    /// No stencil test
+    Disabled,
+    /// Draws mark the stencil buffer
+    Write,
+    /// Draws only pass where the stencil buffer is marked
+    Test
+};
+
 class Renderer {
 public:
     typedef std::vector<GLuint> Textures;
@@ -80,6 +93,8 @@ public:
         size_t count;
         /// Start index.
         unsigned int start;
+        /// Added to each index
+        int baseVertex = 0;
         /// Textures to use
         Textures textures;
         /// Blending mode
@@ -94,6 +109,9 @@ public:
         float diffuse;
         /// Material
         float visibility;
+        /// Decodes quantized vertex positions, @see CompactGeometryVertex
+        glm::vec3 positionOffset{0.f};
+        glm::vec3 positionScale{1.f};
 
         // Default state -- should be moved to materials
         DrawParameters()
@@ -132,6 +150,10 @@ public:
         float diffuse;
         float ambient;
         float visibility;
+        float padding_ = 0.f;
+        /// Decodes quantized positions, @see DrawParameters
+        glm::vec4 positionOffset{0.f};
+        glm::vec4 positionScale{1.f};
     };
 
     struct SceneUniformData {
@@ -178,7 +200,17 @@ public:
                             float f) = 0;
 
     virtual void clear(const glm::vec4& colour, bool clearColour = true,
-                       bool clearDepth = true) = 0;
+                       bool clearDepth = true, bool clearStencil = false) = 0;
+
+    /**
+     * Directs drawing to a framebuffer, 0 for the window, covering the
+     * whole viewport
+     */
+    virtual void setFramebuffer(GLuint framebuffer) = 0;
+    /// Selects the colour attachment of the framebuffer that draws write to
+    virtual void setDrawAttachment(GLuint attachment) = 0;
+    virtual void setDepthTest(bool enable) = 0;
+    virtual void setStencilMode(StencilMode mode) = 0;
 
     virtual void setSceneParameters(const SceneUniformData& data) = 0;
 
@@ -306,8 +338,13 @@ public:
                     float f) override;
     void useProgram(ShaderProgram* p) override;
 
-    void clear(const glm::vec4& colour, bool clearColour,
-               bool clearDepth) override;
+    void clear(const glm::vec4& colour, bool clearColour, bool clearDepth,
+               bool clearStencil) override;
+
+    void setFramebuffer(GLuint framebuffer) override;
+    void setDrawAttachment(GLuint attachment) override;
+    void setDepthTest(bool enable) override;
+    void setStencilMode(StencilMode mode) override;
 
     void setSceneParameters(const SceneUniformData& data) override;
 
@@ -349,6 +386,7 @@ private:
     OpenGLShaderProgram* currentProgram = nullptr;
     BlendMode blendMode = BlendMode::BLEND_NONE;
     bool depthWriteEnabled = false;
+    StencilMode stencilMode = StencilMode::Disabled;
     GLuint currentUBO = 0;
     GLuint currentUnit = 0;
     std::map<GLuint, GLuint> currentTextures;
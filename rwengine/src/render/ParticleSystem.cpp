@@ -0,0 +1,207 @@
+#include "render/ParticleSystem.hpp"
+
+#include <rw/defines.hpp>
+
+constexpr size_t ParticleSystem::kDefaultPoolCapacity;
+
+ParticlePool::ParticlePool(const TextureData::Handle& texture, size_t capacity)
+    : px(capacity)
+    , py(capacity)
+    , pz(capacity)
+    , vx(capacity)
+    , vy(capacity)
+    , vz(capacity)
+    , starttime(capacity)
+    , lifetime(capacity)
+    , size(capacity)
+    , colour(capacity)
+    , up(capacity)
+    , orientation(capacity)
+    , slot(capacity)
+    , texture(texture)
+    , capacity(capacity) {
+}
+
+ParticleSystem::ParticleSystem(size_t poolCapacity)
+    : poolCapacity(poolCapacity) {
+}
+
+ParticlePool* ParticleSystem::getPool(const TextureData::Handle& texture) {
+    auto it = poolIndex.find(texture.get());
+    if (it != poolIndex.end()) {
+        return pools[it->second].get();
+    }
+    poolIndex[texture.get()] = static_cast<uint32_t>(pools.size());
+    pools.emplace_back(std::make_unique<ParticlePool>(texture, poolCapacity));
+    return pools.back().get();
+}
+
+ParticleSystem::Handle ParticleSystem::spawn(const Particle& particle) {
+    if (!particle.texture) {
+        return {};
+    }
+
+    auto pool = getPool(particle.texture);
+    if (pool->isFull()) {
+        dropped++;
+        return {};
+    }
+
+    uint32_t slotIndex;
+    if (freeSlots.empty()) {
+        slotIndex = static_cast<uint32_t>(slots.size());
+        slots.push_back({0, 0, 1});
+    } else {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    auto i = pool->count++;
+    auto& slot = slots[slotIndex];
+    slot.pool = poolIndex[particle.texture.get()];
+    slot.index = static_cast<uint32_t>(i);
+
+    pool->px[i] = particle.position.x;
+    pool->py[i] = particle.position.y;
+    pool->pz[i] = particle.position.z;
+    pool->vx[i] = particle.velocity.x;
+    pool->vy[i] = particle.velocity.y;
+    pool->vz[i] = particle.velocity.z;
+    pool->starttime[i] = particle.starttime;
+    pool->lifetime[i] = particle.lifetime;
+    pool->size[i] = particle.size;
+    pool->colour[i] = particle.colour;
+    pool->up[i] = particle.up;
+    pool->orientation[i] = particle.orientation;
+    pool->slot[i] = slotIndex;
+
+    return {slotIndex, slot.generation};
+}
+
+const ParticleSystem::Slot* ParticleSystem::getSlot(Handle handle) const {
+    if (handle.slot >= slots.size()) {
+        return nullptr;
+    }
+    const auto& slot = slots[handle.slot];
+    if (slot.generation != handle.generation) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+bool ParticleSystem::isValid(Handle handle) const {
+    return getSlot(handle) != nullptr;
+}
+
+void ParticleSystem::remove(Handle handle) {
+    auto slot = getSlot(handle);
+    if (slot) {
+        removeAt(slot->pool, slot->index);
+    }
+}
+
+void ParticleSystem::removeAt(uint32_t poolId, size_t index) {
+    auto& pool = *pools[poolId];
+    RW_CHECK(index < pool.count, "Particle index out of range");
+
+    auto removedSlot = pool.slot[index];
+    slots[removedSlot].generation++;
+    freeSlots.push_back(removedSlot);
+
+    auto last = --pool.count;
+    if (index != last) {
+        pool.px[index] = pool.px[last];
+        pool.py[index] = pool.py[last];
+        pool.pz[index] = pool.pz[last];
+        pool.vx[index] = pool.vx[last];
+        pool.vy[index] = pool.vy[last];
+        pool.vz[index] = pool.vz[last];
+        pool.starttime[index] = pool.starttime[last];
+        pool.lifetime[index] = pool.lifetime[last];
+        pool.size[index] = pool.size[last];
+        pool.colour[index] = pool.colour[last];
+        pool.up[index] = pool.up[last];
+        pool.orientation[index] = pool.orientation[last];
+        pool.slot[index] = pool.slot[last];
+        slots[pool.slot[index]].index = static_cast<uint32_t>(index);
+    }
+}
+
+void ParticleSystem::setPosition(Handle handle, const glm::vec3& position) {
+    if (auto slot = getSlot(handle)) {
+        auto& pool = *pools[slot->pool];
+        pool.px[slot->index] = position.x;
+        pool.py[slot->index] = position.y;
+        pool.pz[slot->index] = position.z;
+    }
+}
+
+void ParticleSystem::setColour(Handle handle, const glm::vec4& colour) {
+    if (auto slot = getSlot(handle)) {
+        pools[slot->pool]->colour[slot->index] = colour;
+    }
+}
+
+void ParticleSystem::setSize(Handle handle, const glm::vec2& size) {
+    if (auto slot = getSlot(handle)) {
+        pools[slot->pool]->size[slot->index] = size;
+    }
+}
+
+void ParticleSystem::tick(float gameTime, float dt) {
+    for (uint32_t p = 0; p < pools.size(); ++p) {
+        auto& pool = *pools[p];
+
+        // Expire first so the integration loop only sees live particles
+        for (size_t i = 0; i < pool.count;) {
+            float lifetime = pool.lifetime[i];
+            if (lifetime >= 0.f && gameTime >= pool.starttime[i] + lifetime) {
+                removeAt(p, i);
+            } else {
+                ++i;
+            }
+        }
+
+        const auto count = pool.count;
+        float* px = pool.px.data();
+        float* py = pool.py.data();
+        float* pz = pool.pz.data();
+        const float* vx = pool.vx.data();
+        const float* vy = pool.vy.data();
+        const float* vz = pool.vz.data();
+        for (size_t i = 0; i < count; ++i) {
+            px[i] += vx[i] * dt;
+            py[i] += vy[i] * dt;
+            pz[i] += vz[i] * dt;
+        }
+    }
+}
+
+void ParticleSystem::clearTransient() {
+    for (uint32_t p = 0; p < pools.size(); ++p) {
+        auto& pool = *pools[p];
+        for (size_t i = 0; i < pool.count;) {
+            if (pool.lifetime[i] >= 0.f) {
+                removeAt(p, i);
+            } else {
+                ++i;
+            }
+        }
+    }
+}
+
+void ParticleSystem::clear() {
+    for (uint32_t p = 0; p < pools.size(); ++p) {
+        while (pools[p]->count > 0) {
+            removeAt(p, pools[p]->count - 1);
+        }
+    }
+}
+
+size_t ParticleSystem::getParticleCount() const {
+    size_t count = 0;
+    for (const auto& pool : pools) {
+        count += pool->count;
+    }
+    return count;
+}
@@ -0,0 +1,190 @@
+#ifndef _RWENGINE_PARTICLESYSTEM_HPP_
+#define _RWENGINE_PARTICLESYSTEM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <gl/TextureData.hpp>
+
+/**
+ * @brief Fixed capacity structure-of-arrays storage for particles that share
+ * a texture.
+ *
+ * Live particles are always packed into [0, count), removal swaps the last
+ * particle into the hole. Each array is allocated to capacity up front so
+ * spawning never allocates.
+ */
+class ParticlePool {
+public:
+    ParticlePool(const TextureData::Handle& texture, size_t capacity);
+
+    const TextureData::Handle& getTexture() const {
+        return texture;
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    size_t getCount() const {
+        return count;
+    }
+
+    bool isFull() const {
+        return count == capacity;
+    }
+
+    glm::vec3 getPosition(size_t i) const {
+        return {px[i], py[i], pz[i]};
+    }
+
+    // Kinematics, split per component so integration vectorizes
+    std::vector<float> px, py, pz;
+    std::vector<float> vx, vy, vz;
+
+    std::vector<float> starttime;
+    /// Negative lifetimes never expire
+    std::vector<float> lifetime;
+
+    std::vector<glm::vec2> size;
+    std::vector<glm::vec4> colour;
+    /// Only used by Free orientation particles
+    std::vector<glm::vec3> up;
+    std::vector<uint8_t> orientation;
+
+    /// The handle slot that refers to each particle
+    std::vector<uint32_t> slot;
+
+private:
+    friend class ParticleSystem;
+
+    TextureData::Handle texture;
+    size_t capacity;
+    size_t count = 0;
+};
+
+/**
+ * @brief Owns every particle in the world, grouped into one pool per texture
+ *
+ * Particles are referred to by generational handles, which remain valid when
+ * other particles in the same pool are removed and become invalid once their
+ * own particle has been removed or has expired.
+ */
+class ParticleSystem {
+public:
+    static constexpr size_t kDefaultPoolCapacity = 1024;
+
+    /** Particle orientation modes */
+    enum Orientation : uint8_t {
+        Free,    /** faces direction using up */
+        Camera,  /** Faces towards the camera */
+        UpCamera /** Face closes point in camera's look direction */
+    };
+
+    /**
+     * @brief Initial state of a particle passed to spawn()
+     */
+    struct Particle {
+        glm::vec3 position{};
+        /** Velocity in world units per second */
+        glm::vec3 velocity{};
+        Orientation orientation = Free;
+        /** Game time at particle instantiation */
+        float starttime = 0.f;
+        /** Number of seconds particle should exist for, negative values =
+         * forever */
+        float lifetime = -1.f;
+        TextureData::Handle texture;
+        glm::vec2 size{1.f, 1.f};
+        /** Up direction (only used in Free mode) */
+        glm::vec3 up{0.f, 0.f, 1.f};
+        /** Render tint colour */
+        glm::vec4 colour{1.f, 1.f, 1.f, 1.f};
+    };
+
+    struct Handle {
+        uint32_t slot = std::numeric_limits<uint32_t>::max();
+        uint32_t generation = 0;
+    };
+
+    explicit ParticleSystem(size_t poolCapacity = kDefaultPoolCapacity);
+
+    /**
+     * Adds a particle to the pool for its texture.
+     * @return A handle to the particle, or an invalid handle if the pool was
+     * full or the particle has no texture.
+     */
+    Handle spawn(const Particle& particle);
+
+    /**
+     * Removes the particle, does nothing if the handle is no longer valid
+     */
+    void remove(Handle handle);
+
+    bool isValid(Handle handle) const;
+
+    void setPosition(Handle handle, const glm::vec3& position);
+    void setColour(Handle handle, const glm::vec4& colour);
+    void setSize(Handle handle, const glm::vec2& size);
+
+    /**
+     * Integrates particle positions and removes expired particles
+     * @param gameTime current game time, used for expiry
+     * @param dt time step to integrate velocities over
+     */
+    void tick(float gameTime, float dt);
+
+    /**
+     * Removes every particle with a finite lifetime
+     */
+    void clearTransient();
+
+    /**
+     * Removes every particle
+     */
+    void clear();
+
+    size_t getParticleCount() const;
+
+    /**
+     * Number of spawns rejected because their pool was full
+     */
+    size_t getDroppedCount() const {
+        return dropped;
+    }
+
+    const std::vector<std::unique_ptr<ParticlePool>>& getPools() const {
+        return pools;
+    }
+
+private:
+    struct Slot {
+        uint32_t pool;
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    ParticlePool* getPool(const TextureData::Handle& texture);
+
+    /// Swap-removes the particle at index, keeping handles up to date
+    void removeAt(uint32_t pool, size_t index);
+
+    const Slot* getSlot(Handle handle) const;
+
+    size_t poolCapacity;
+    size_t dropped = 0;
+
+    std::vector<std::unique_ptr<ParticlePool>> pools;
+    std::unordered_map<const TextureData*, uint32_t> poolIndex;
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
+
+#endif
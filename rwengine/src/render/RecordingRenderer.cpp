@@ -0,0 +1,222 @@
+#include "render/RecordingRenderer.hpp"
+
+#include <rw/defines.hpp>
+
+RecordingRenderer::RecordingRenderer() {
+    swap();
+}
+
+std::string RecordingRenderer::getIDString() const {
+    return "Recording Renderer";
+}
+
+std::unique_ptr<Renderer::ShaderProgram> RecordingRenderer::createShader(
+    const std::string& vert, const std::string& frag) {
+    RW_UNUSED(vert);
+    RW_UNUSED(frag);
+    return std::make_unique<RecordingShaderProgram>();
+}
+
+void RecordingRenderer::setProgramBlockBinding(ShaderProgram* p,
+                                               const std::string& name,
+                                               GLint point) {
+    RW_UNUSED(p);
+    RW_UNUSED(name);
+    RW_UNUSED(point);
+}
+
+void RecordingRenderer::setUniformTexture(ShaderProgram* p,
+                                          const std::string& name,
+                                          GLint tex) {
+    RW_UNUSED(name);
+    setUniformData(p, sizeof(tex));
+}
+
+void RecordingRenderer::setUniform(ShaderProgram* p, const std::string& name,
+                                   const glm::mat4& m) {
+    RW_UNUSED(name);
+    setUniformData(p, sizeof(m));
+}
+
+void RecordingRenderer::setUniform(ShaderProgram* p, const std::string& name,
+                                   const glm::vec4& v) {
+    RW_UNUSED(name);
+    setUniformData(p, sizeof(v));
+}
+
+void RecordingRenderer::setUniform(ShaderProgram* p, const std::string& name,
+                                   const glm::vec3& v) {
+    RW_UNUSED(name);
+    setUniformData(p, sizeof(v));
+}
+
+void RecordingRenderer::setUniform(ShaderProgram* p, const std::string& name,
+                                   const glm::vec2& v) {
+    RW_UNUSED(name);
+    setUniformData(p, sizeof(v));
+}
+
+void RecordingRenderer::setUniform(ShaderProgram* p, const std::string& name,
+                                   float f) {
+    RW_UNUSED(name);
+    setUniformData(p, sizeof(f));
+}
+
+void RecordingRenderer::setUniformData(ShaderProgram* p, size_t size) {
+    useProgram(p);
+    stats.uniformSets++;
+    stats.bytesUploaded += size;
+}
+
+void RecordingRenderer::useProgram(ShaderProgram* p) {
+    if (p != currentProgram) {
+        currentProgram = p;
+        stats.programChanges++;
+    }
+}
+
+void RecordingRenderer::clear(const glm::vec4& colour, bool clearColour,
+                              bool clearDepth, bool clearStencil) {
+    RW_UNUSED(colour);
+    RW_UNUSED(clearColour);
+    RW_UNUSED(clearDepth);
+    RW_UNUSED(clearStencil);
+    record(CommandType::Clear, 0, nullptr, 0);
+}
+
+void RecordingRenderer::setFramebuffer(GLuint framebuffer) {
+    if (framebuffer != currentFramebuffer) {
+        currentFramebuffer = framebuffer;
+        stats.framebufferChanges++;
+    }
+    record(CommandType::SetFramebuffer, 0, nullptr, 0);
+}
+
+void RecordingRenderer::setDrawAttachment(GLuint attachment) {
+    RW_UNUSED(attachment);
+}
+
+void RecordingRenderer::setDepthTest(bool enable) {
+    RW_UNUSED(enable);
+}
+
+void RecordingRenderer::setStencilMode(StencilMode mode) {
+    RW_UNUSED(mode);
+}
+
+void RecordingRenderer::setSceneParameters(const SceneUniformData& data) {
+    stats.bytesUploaded += sizeof(data);
+    lastSceneData = data;
+}
+
+void RecordingRenderer::setDrawState(DrawBuffer* draw,
+                                     const DrawParameters& p) {
+    ProfileInfo* prof =
+        currentDebugDepth > 0 ? &profileInfo[currentDebugDepth - 1] : nullptr;
+
+    if (draw != currentDbuff) {
+        currentDbuff = draw;
+        stats.bufferChanges++;
+        bufferCounter++;
+        if (prof) {
+            prof->buffers++;
+        }
+    }
+
+    for (GLuint u = 0; u < p.textures.size(); ++u) {
+        auto& current = currentTextures[u];
+        if (current != p.textures[u]) {
+            current = p.textures[u];
+            stats.textureChanges++;
+            textureCounter++;
+            if (prof) {
+                prof->textures++;
+            }
+        }
+    }
+
+    if (p.blendMode != blendMode) {
+        blendMode = p.blendMode;
+        stats.blendChanges++;
+    }
+    if (p.depthWrite != depthWriteEnabled) {
+        depthWriteEnabled = p.depthWrite;
+        stats.depthWriteChanges++;
+    }
+
+    stats.bytesUploaded += sizeof(ObjectUniformData);
+    stats.draws++;
+    stats.primitives += p.count;
+    drawCounter++;
+    if (prof) {
+        prof->uploads++;
+        prof->draws++;
+        prof->primitives += p.count;
+    }
+}
+
+void RecordingRenderer::record(CommandType type, RenderKey key,
+                               DrawBuffer* draw, size_t count) {
+    commands.push_back({type, key, draw, count});
+}
+
+void RecordingRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
+                             const DrawParameters& p) {
+    RW_UNUSED(model);
+    setDrawState(draw, p);
+    record(CommandType::Draw, 0, draw, p.count);
+}
+
+void RecordingRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
+                                   const DrawParameters& p) {
+    RW_UNUSED(model);
+    setDrawState(draw, p);
+    record(CommandType::DrawArrays, 0, draw, p.count);
+}
+
+void RecordingRenderer::drawBatched(const RenderList& list) {
+    commands.reserve(commands.size() + list.size());
+    for (auto& ri : list) {
+        setDrawState(ri.dbuff, ri.drawInfo);
+        record(CommandType::DrawBatched, ri.sortKey, ri.dbuff,
+               ri.drawInfo.count);
+    }
+}
+
+void RecordingRenderer::invalidate() {
+    currentDbuff = nullptr;
+    currentProgram = nullptr;
+    currentTextures.clear();
+    blendMode = BlendMode::BLEND_NONE;
+}
+
+void RecordingRenderer::pushDebugGroup(const std::string& title) {
+    RW_UNUSED(title);
+    RW_ASSERT(currentDebugDepth < MAX_DEBUG_DEPTH);
+    profileInfo[currentDebugDepth] = ProfileInfo{};
+    currentDebugDepth++;
+}
+
+const Renderer::ProfileInfo& RecordingRenderer::popDebugGroup() {
+    RW_ASSERT(currentDebugDepth > 0);
+    currentDebugDepth--;
+    ProfileInfo& prof = profileInfo[currentDebugDepth];
+
+    // Add counters to the parent group
+    if (currentDebugDepth > 0) {
+        ProfileInfo& p = profileInfo[currentDebugDepth - 1];
+        p.draws += prof.draws;
+        p.buffers += prof.buffers;
+        p.primitives += prof.primitives;
+        p.textures += prof.textures;
+        p.uploads += prof.uploads;
+    }
+
+    return prof;
+}
+
+void RecordingRenderer::reset() {
+    commands.clear();
+    stats = Stats{};
+    swap();
+}
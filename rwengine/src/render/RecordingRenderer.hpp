@@ -0,0 +1,138 @@
+#ifndef _RWENGINE_RECORDINGRENDERER_HPP_
+#define _RWENGINE_RECORDINGRENDERER_HPP_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <render/OpenGLRenderer.hpp>
+
+/**
+ * @brief Renderer that records what it is asked to draw instead of drawing
+ *
+ * Nothing here touches GL, so it can stand in for OpenGLRenderer in headless
+ * benchmarks and tests. State changes are filtered the same way
+ * OpenGLRenderer filters them, so the counters match the GL calls a real
+ * frame would make.
+ */
+class RecordingRenderer : public Renderer {
+public:
+    class RecordingShaderProgram : public ShaderProgram {
+    public:
+        ~RecordingShaderProgram() override = default;
+    };
+
+    enum class CommandType {
+        Clear,
+        SetFramebuffer,
+        Draw,
+        DrawArrays,
+        /// A draw issued through drawBatched
+        DrawBatched
+    };
+
+    struct Command {
+        CommandType type;
+        /// Sort key of batched draws, 0 for anything else
+        RenderKey key;
+        DrawBuffer* dbuff;
+        /// Number of indices or vertices drawn
+        size_t count;
+    };
+
+    struct Stats {
+        size_t draws = 0;
+        size_t primitives = 0;
+        size_t programChanges = 0;
+        size_t bufferChanges = 0;
+        size_t textureChanges = 0;
+        size_t blendChanges = 0;
+        size_t depthWriteChanges = 0;
+        size_t framebufferChanges = 0;
+        size_t uniformSets = 0;
+        /// Uniform data and uniform buffer entries sent for the frame
+        size_t bytesUploaded = 0;
+    };
+
+    RecordingRenderer();
+
+    std::string getIDString() const override;
+
+    std::unique_ptr<ShaderProgram> createShader(
+        const std::string& vert, const std::string& frag) override;
+    void setProgramBlockBinding(ShaderProgram* p, const std::string& name,
+                                GLint point) override;
+    void setUniformTexture(ShaderProgram* p, const std::string& name,
+                           GLint tex) override;
+    void setUniform(ShaderProgram* p, const std::string& name,
+                    const glm::mat4& m) override;
+    void setUniform(ShaderProgram* p, const std::string& name,
+                    const glm::vec4& v) override;
+    void setUniform(ShaderProgram* p, const std::string& name,
+                    const glm::vec3& v) override;
+    void setUniform(ShaderProgram* p, const std::string& name,
+                    const glm::vec2& v) override;
+    void setUniform(ShaderProgram* p, const std::string& name,
+                    float f) override;
+    void useProgram(ShaderProgram* p) override;
+
+    void clear(const glm::vec4& colour, bool clearColour, bool clearDepth,
+               bool clearStencil) override;
+
+    void setFramebuffer(GLuint framebuffer) override;
+    void setDrawAttachment(GLuint attachment) override;
+    void setDepthTest(bool enable) override;
+    void setStencilMode(StencilMode mode) override;
+
+    void setSceneParameters(const SceneUniformData& data) override;
+
+    void draw(const glm::mat4& model, DrawBuffer* draw,
+              const DrawParameters& p) override;
+    void drawArrays(const glm::mat4& model, DrawBuffer* draw,
+                    const DrawParameters& p) override;
+
+    void drawBatched(const RenderList& list) override;
+
+    void invalidate() override;
+
+    void pushDebugGroup(const std::string& title) override;
+    const ProfileInfo& popDebugGroup() override;
+
+    const std::vector<Command>& getCommands() const {
+        return commands;
+    }
+
+    const Stats& getStats() const {
+        return stats;
+    }
+
+    /**
+     * Forgets the recorded commands and statistics. The state cache is kept,
+     * as GL state would be between frames.
+     */
+    void reset();
+
+private:
+    void setDrawState(DrawBuffer* draw, const DrawParameters& p);
+    void record(CommandType type, RenderKey key, DrawBuffer* draw,
+                size_t count);
+    void setUniformData(ShaderProgram* p, size_t size);
+
+    std::vector<Command> commands;
+    Stats stats;
+
+    // State Cache
+    DrawBuffer* currentDbuff = nullptr;
+    ShaderProgram* currentProgram = nullptr;
+    BlendMode blendMode = BlendMode::BLEND_NONE;
+    bool depthWriteEnabled = false;
+    GLuint currentFramebuffer = 0;
+    std::map<GLuint, GLuint> currentTextures;
+
+    ProfileInfo profileInfo[MAX_DEBUG_DEPTH];
+    int currentDebugDepth = 0;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "render/SpriteBatch.hpp"
+
+#include <algorithm>
+
+const AttributeList SpriteVertex::vertex_attributes() {
+    // alphaOnly has no semantic of its own, it rides in the normal slot
+    return {{ATRS_Position, 2, sizeof(SpriteVertex), 0ul},
+            {ATRS_TexCoord, 2, sizeof(SpriteVertex), 2ul * sizeof(float)},
+            {ATRS_Colour, 4, sizeof(SpriteVertex), 4ul * sizeof(float),
+             GL_UNSIGNED_BYTE},
+            {ATRS_Normal, 1, sizeof(SpriteVertex),
+             4ul * sizeof(float) + sizeof(glm::u8vec4)}};
+}
+
+void SpriteBatch::addRect(GLuint texture, const glm::vec4& rect,
+                          const glm::vec4& uv, const glm::u8vec4& colour,
+                          bool alphaOnly) {
+    addQuad(texture,
+            {{{rect.x, rect.y},
+              {rect.x + rect.z, rect.y},
+              {rect.x + rect.z, rect.y + rect.w},
+              {rect.x, rect.y + rect.w}}},
+            uv, colour, alphaOnly);
+}
+
+void SpriteBatch::addQuad(GLuint texture, const Corners& corners,
+                          const glm::vec4& uv, const glm::u8vec4& colour,
+                          bool alphaOnly) {
+    const glm::vec2 texcoords[4] = {
+        {uv.x, uv.y}, {uv.z, uv.y}, {uv.z, uv.w}, {uv.x, uv.w}};
+    Quad quad{layer, texture, {}};
+    for (size_t c = 0; c < 4; ++c) {
+        quad.corners[c] = {corners[c], texcoords[c], colour,
+                           alphaOnly ? 1.f : 0.f};
+    }
+    quads.push_back(quad);
+}
+
+void SpriteBatch::build(std::vector<SpriteVertex>& vertices,
+                        std::vector<Batch>& batches) {
+    vertices.clear();
+    batches.clear();
+
+    std::stable_sort(quads.begin(), quads.end(),
+                     [](const Quad& a, const Quad& b) {
+                         if (a.layer != b.layer) {
+                             return a.layer < b.layer;
+                         }
+                         return a.texture < b.texture;
+                     });
+
+    vertices.reserve(quads.size() * 6);
+    for (const auto& quad : quads) {
+        if (batches.empty() || batches.back().texture != quad.texture) {
+            batches.push_back({quad.texture, GLint(vertices.size()), 0});
+        }
+        const auto& c = quad.corners;
+        vertices.insert(vertices.end(), {c[0], c[1], c[2], c[2], c[3], c[0]});
+        batches.back().count += 6;
+    }
+}
+
+void SpriteBatch::clear() {
+    quads.clear();
+    layer = 0;
+}
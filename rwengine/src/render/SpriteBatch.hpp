@@ -0,0 +1,94 @@
+#ifndef _RWENGINE_SPRITEBATCH_HPP_
+#define _RWENGINE_SPRITEBATCH_HPP_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <gl/GeometryBuffer.hpp>
+#include <gl/gl_core_3_3.h>
+
+/**
+ * @brief Screen space vertex of a SpriteBatch quad
+ */
+struct SpriteVertex {
+    /// Position in pixels, from the top left of the screen
+    glm::vec2 position{};
+    glm::vec2 texcoord{};
+    glm::u8vec4 colour{};
+    /// 1 to take only the alpha from the texture, used by the bitmap fonts
+    float alphaOnly = 0.f;
+
+    static const AttributeList vertex_attributes();
+};
+
+/**
+ * @brief Collects 2D quads so a whole layer of the UI can be drawn together
+ *
+ * Quads are ordered by layer and then by texture, quads with the same layer
+ * and texture keep the order they were added in. Texture 0 is drawn as plain
+ * colour. The batch itself doesn't touch GL, @see SpriteRenderer to draw it.
+ */
+class SpriteBatch {
+public:
+    /// Range of vertices that share a texture
+    struct Batch {
+        GLuint texture;
+        GLint start;
+        GLsizei count;
+    };
+
+    /// Corners are top left, top right, bottom right, bottom left
+    using Corners = std::array<glm::vec2, 4>;
+
+    /// Layer that following quads are added to, higher layers are on top
+    void setLayer(int l) {
+        layer = l;
+    }
+
+    int getLayer() const {
+        return layer;
+    }
+
+    /**
+     * Adds an axis aligned rectangle
+     * @param rect x, y, width and height in pixels
+     * @param uv top left and bottom right texture coordinates
+     */
+    void addRect(GLuint texture, const glm::vec4& rect, const glm::vec4& uv,
+                 const glm::u8vec4& colour, bool alphaOnly = false);
+
+    void addQuad(GLuint texture, const Corners& corners, const glm::vec4& uv,
+                 const glm::u8vec4& colour, bool alphaOnly = false);
+
+    size_t getQuadCount() const {
+        return quads.size();
+    }
+
+    bool empty() const {
+        return quads.empty();
+    }
+
+    /**
+     * Sorts the quads into triangles and fills batches with the ranges that
+     * can be drawn together.
+     */
+    void build(std::vector<SpriteVertex>& vertices,
+               std::vector<Batch>& batches);
+
+    void clear();
+
+private:
+    struct Quad {
+        int layer;
+        GLuint texture;
+        std::array<SpriteVertex, 4> corners;
+    };
+
+    std::vector<Quad> quads;
+    int layer = 0;
+};
+
+#endif
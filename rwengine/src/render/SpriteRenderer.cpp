@@ -0,0 +1,60 @@
+#include "render/SpriteRenderer.hpp"
+
+#include <cstdint>
+
+#include "render/GameShaders.hpp"
+
+SpriteRenderer::SpriteRenderer(std::shared_ptr<Renderer> renderer)
+    : renderer(renderer) {
+    program = renderer->createShader(GameShaders::Sprite::VertexShader,
+                                     GameShaders::Sprite::FragmentShader);
+    renderer->setUniformTexture(program.get(), "spriteTexture", 0);
+
+    const uint8_t white[] = {0xFF, 0xFF, 0xFF, 0xFF};
+    glGenTextures(1, &whiteTexture);
+    glBindTexture(GL_TEXTURE_2D, whiteTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // Sprites are rebuilt every time they are drawn, upload nothing for now so
+    // the buffer exists when the attributes are bound
+    geometry.uploadVertices(vertices);
+    drawBuffer.addGeometry(&geometry);
+    drawBuffer.setFaceType(GL_TRIANGLES);
+}
+
+SpriteRenderer::~SpriteRenderer() {
+    glDeleteTextures(1, &whiteTexture);
+}
+
+void SpriteRenderer::draw(SpriteBatch& batch) {
+    lastDrawCount = 0;
+    if (batch.empty()) {
+        return;
+    }
+
+    renderer->pushDebugGroup("Sprites");
+
+    batch.build(vertices, batches);
+    batch.clear();
+    geometry.uploadVertices(vertices);
+
+    renderer->useProgram(program.get());
+    renderer->setUniform(program.get(), "proj",
+                         renderer->get2DProjection());
+
+    Renderer::DrawParameters dp;
+    dp.blendMode = BlendMode::BLEND_ALPHA;
+    dp.depthWrite = false;
+    for (const auto& b : batches) {
+        dp.start = b.start;
+        dp.count = b.count;
+        dp.textures = {b.texture != 0 ? b.texture : whiteTexture};
+        renderer->drawArrays(glm::mat4(1.0f), &drawBuffer, dp);
+    }
+    lastDrawCount = batches.size();
+
+    renderer->popDebugGroup();
+}
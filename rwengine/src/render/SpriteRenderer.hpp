@@ -0,0 +1,49 @@
+#ifndef _RWENGINE_SPRITERENDERER_HPP_
+#define _RWENGINE_SPRITERENDERER_HPP_
+
+#include <memory>
+#include <vector>
+
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/gl_core_3_3.h>
+
+#include <render/OpenGLRenderer.hpp>
+#include <render/SpriteBatch.hpp>
+
+/**
+ * @brief Draws SpriteBatches in screen space
+ *
+ * Every quad in a batch is uploaded to one streaming vertex buffer, then
+ * each run of quads that shares a texture is drawn with a single call.
+ */
+class SpriteRenderer {
+public:
+    SpriteRenderer(std::shared_ptr<Renderer> renderer);
+    ~SpriteRenderer();
+
+    /**
+     * Draws everything in batch over the current frame, then clears it
+     */
+    void draw(SpriteBatch& batch);
+
+    /// Number of draw calls made by the last draw()
+    size_t getLastDrawCount() const {
+        return lastDrawCount;
+    }
+
+private:
+    std::shared_ptr<Renderer> renderer;
+    std::unique_ptr<Renderer::ShaderProgram> program;
+
+    /// Drawn in place of texture 0, so plain colour quads can share a batch
+    GLuint whiteTexture;
+
+    GeometryBuffer geometry;
+    DrawBuffer drawBuffer;
+    std::vector<SpriteVertex> vertices;
+    std::vector<SpriteBatch::Batch> batches;
+    size_t lastDrawCount = 0;
+};
+
+#endif
@@ -0,0 +1,238 @@
+#include "render/TextLayoutCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+
+constexpr size_t TextLayoutCache::kDefaultCapacity;
+
+namespace {
+int charToIndex(uint16_t g) {
+    // Correct for the default font maps
+    /// @todo confirm for JA / RU font maps
+    return g - 32;
+}
+
+glm::vec4 indexToCoord(int font, int index) {
+    float x = int(index % 16);
+    float y = int(index / 16) + 0.01f;
+    float fontHeight = ((font == 0) ? 16.f : 13.f);
+    glm::vec2 gsize(1.f / 16.f, 1.f / fontHeight);
+    return glm::vec4(x, y, x + 1, y + 0.98f) * glm::vec4(gsize, gsize);
+}
+}  // namespace
+
+size_t TextLayoutCache::KeyHash::operator()(const Key& k) const {
+    // FNV-1a over the characters, then the parameters
+    size_t h = 2166136261u;
+    auto mix = [&](size_t v) { h = (h ^ v) * 16777619u; };
+    for (auto c : k.text) {
+        mix(c);
+    }
+    mix(size_t(k.font));
+    mix(std::hash<float>()(k.size));
+    mix(size_t(k.wrapX));
+    mix(k.forceColour ? 1 : 0);
+    return h;
+}
+
+TextLayoutCache::TextLayoutCache(size_t capacity) : capacity(capacity) {
+    std::fill(glyphData.begin(), glyphData.end(), GlyphInfo{.9f});
+
+    glyphData[charToIndex(' ')].widthFrac = 0.4f;
+    glyphData[charToIndex('-')].widthFrac = 0.5f;
+    glyphData[charToIndex('\'')].widthFrac = 0.5f;
+    glyphData[charToIndex('(')].widthFrac = 0.45f;
+    glyphData[charToIndex(')')].widthFrac = 0.45f;
+    glyphData[charToIndex(':')].widthFrac = 0.65f;
+    glyphData[charToIndex('$')].widthFrac = 0.65f;
+
+    for (char g = '0'; g <= '9'; ++g) {
+        glyphData[charToIndex(g)].widthFrac = 0.65f;
+    }
+
+    // Assumes contigious a-z character encoding
+    for (char g = 0; g <= ('z' - 'a'); g++) {
+        switch (('a' + g)) {
+            case 'i':
+                glyphData[charToIndex('a' + g)].widthFrac = 0.4f;
+                glyphData[charToIndex('A' + g)].widthFrac = 0.4f;
+                break;
+            case 'l':
+                glyphData[charToIndex('a' + g)].widthFrac = 0.5f;
+                glyphData[charToIndex('A' + g)].widthFrac = 0.5f;
+                break;
+            case 'm':
+                glyphData[charToIndex('a' + g)].widthFrac = 1.0f;
+                glyphData[charToIndex('A' + g)].widthFrac = 1.0f;
+                break;
+            case 'w':
+                glyphData[charToIndex('a' + g)].widthFrac = 1.0f;
+                glyphData[charToIndex('A' + g)].widthFrac = 1.0f;
+                break;
+            default:
+                glyphData[charToIndex('a' + g)].widthFrac = 0.7f;
+                glyphData[charToIndex('A' + g)].widthFrac = 0.7f;
+                break;
+        }
+    }
+}
+
+const TextLayoutCache::Layout& TextLayoutCache::layout(const GameString& text,
+                                                       int font, float size,
+                                                       int wrapX,
+                                                       bool forceColour) {
+    Key key{text, font, size, wrapX, forceColour};
+    auto it = index.find(key);
+    if (it != index.end()) {
+        hits++;
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+    }
+
+    misses++;
+    entries.emplace_front(key,
+                          buildLayout(text, font, size, wrapX, forceColour));
+    index.emplace(std::move(key), entries.begin());
+
+    while (entries.size() > std::max<size_t>(capacity, 1)) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+
+    return entries.front().second;
+}
+
+TextLayoutCache::Layout TextLayoutCache::buildLayout(GameString text, int font,
+                                                     float size, int wrapX,
+                                                     bool forceColour) const {
+    Layout layout;
+
+    glm::vec2 coord(0.f, 0.f);
+    // We should track real size not just chars.
+    auto lineLength = 0;
+
+    glm::vec2 ss(size);
+
+    glm::u8vec3 colour{};
+    bool useBaseColour = true;
+    auto setColour = [&](const glm::u8vec3& c) {
+        colour = c;
+        useBaseColour = false;
+    };
+
+    float maxWidth = 0.f;
+    float maxHeight = ss.y;
+
+    for (size_t i = 0; i < text.length(); ++i) {
+        char16_t c = text[i];
+
+        // Handle any markup changes.
+        if (c == '~' && text.length() > i + 1) {
+            switch (text[i + 1]) {
+                case 'b':  // Blue
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(128, 167, 243));
+                    break;
+                case 'g':  // Green
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(95, 160, 106));
+                    break;
+                case 'h':  // White
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(225, 225, 225));
+                    break;
+                case 'k': {  // Key
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    // Extract the key name from the /next/ markup
+                    auto keyend = text.find('~', i + 1);
+                    auto keyname = text.substr(i + 1, keyend - i - 1);
+                    // Since we don't have a key map yet, just print out the
+                    // name
+                    text.erase(text.begin() + i, text.begin() + keyend);
+                    text.insert(i, keyname);
+                    break;
+                }
+                case 'l':  // Black
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(0, 0, 0));
+                    break;
+                case 'p':  // Purple
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(168, 110, 252));
+                    break;
+                case 'r':  // Red
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(113, 43, 73));
+                    break;
+                case 'w':  // Gray
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(175, 175, 175));
+                    break;
+                case 'y':  // Yellow
+                    text.erase(text.begin() + i, text.begin() + i + 3);
+                    setColour(glm::u8vec3(210, 196, 106));
+                    break;
+            }
+
+            c = text[i];
+        }
+
+        if (forceColour) {
+            useBaseColour = true;
+        }
+
+        // Handle special chars.
+        if (c == '\n') {
+            coord.x = 0.f;
+            coord.y += ss.y;
+            maxHeight = coord.y + ss.y;
+            lineLength = 0;
+            continue;
+        }
+
+        int glyph = charToIndex(c);
+        if (glyph < 0 || glyph >= GAME_GLYPHS) {
+            continue;
+        }
+
+        // If we're not at the start of the column, check if the current word
+        // will need to be wrapped
+        if (wrapX > 0 && coord.x > 0.f && !std::isspace(c)) {
+            auto wend = std::find_if(std::begin(text) + i, std::end(text),
+                                     [](char x) { return std::isspace(x); });
+            if (wend != std::end(text)) {
+                auto word = std::distance(std::begin(text) + i, wend);
+                if (lineLength + word >= wrapX) {
+                    coord.x = 0;
+                    coord.y += ss.y;
+                    maxHeight = coord.y + ss.y;
+                    lineLength = 0;
+                }
+            }
+        }
+
+        auto& data = glyphData[glyph];
+        auto tex = indexToCoord(font, glyph);
+
+        ss.x = size * data.widthFrac;
+        tex.z = tex.x + (tex.z - tex.x) * data.widthFrac;
+
+        lineLength++;
+
+        layout.glyphs.push_back(
+            {glm::vec4(coord, ss), tex, colour, useBaseColour});
+        coord.x += ss.x;
+        maxWidth = std::max(coord.x, maxWidth);
+    }
+
+    layout.size = glm::vec2(maxWidth, maxHeight);
+    layout.glyphSize = ss;
+    return layout;
+}
+
+void TextLayoutCache::clear() {
+    entries.clear();
+    index.clear();
+}
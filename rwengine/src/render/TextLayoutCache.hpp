@@ -0,0 +1,117 @@
+#ifndef _RWENGINE_TEXTLAYOUTCACHE_HPP_
+#define _RWENGINE_TEXTLAYOUTCACHE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <data/GameTexts.hpp>
+
+#define GAME_FONTS 3
+#define GAME_GLYPHS 192
+
+/**
+ * @brief Lays out bitmap font text and keeps the most recently used layouts
+ *
+ * Laying out a string means parsing its markup, wrapping it and measuring
+ * each glyph. Most of the HUD shows the same strings every frame, so layouts
+ * are cached by everything that affects them: the text, font, size, wrap
+ * width and whether markup colours are ignored.
+ */
+class TextLayoutCache {
+public:
+    static constexpr size_t kDefaultCapacity = 256;
+
+    /**
+     * Stores the information for kerning a glyph
+     */
+    struct GlyphInfo {
+        float widthFrac;
+    };
+
+    struct Glyph {
+        /// x, y, width and height relative to the text position
+        glm::vec4 rect;
+        /// Top left and bottom right coordinates in the font texture
+        glm::vec4 uv;
+        /// Colour set by markup, unless useBaseColour is set
+        glm::u8vec3 colour;
+        bool useBaseColour;
+    };
+
+    struct Layout {
+        std::vector<Glyph> glyphs;
+        /// Width of the longest line and height of all lines
+        glm::vec2 size{};
+        /// Size of the last glyph, used to pad the background
+        glm::vec2 glyphSize{};
+    };
+
+    explicit TextLayoutCache(size_t capacity = kDefaultCapacity);
+
+    /**
+     * Returns the layout of text, laying it out if it isn't cached.
+     * The reference is valid until the next call.
+     */
+    const Layout& layout(const GameString& text, int font, float size,
+                         int wrapX, bool forceColour);
+
+    /// Lays out text without caching it
+    Layout buildLayout(GameString text, int font, float size, int wrapX,
+                       bool forceColour) const;
+
+    size_t getSize() const {
+        return entries.size();
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    size_t getHits() const {
+        return hits;
+    }
+
+    size_t getMisses() const {
+        return misses;
+    }
+
+    void clear();
+
+private:
+    struct Key {
+        GameString text;
+        int font;
+        float size;
+        int wrapX;
+        bool forceColour;
+
+        bool operator==(const Key& o) const {
+            return font == o.font && size == o.size && wrapX == o.wrapX &&
+                   forceColour == o.forceColour && text == o.text;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    using Entry = std::pair<Key, Layout>;
+
+    std::array<GlyphInfo, GAME_GLYPHS> glyphData;
+
+    size_t capacity;
+    /// Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+#endif
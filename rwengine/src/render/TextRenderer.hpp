@@ -1,28 +1,19 @@
 #ifndef _RWENGINE_TEXTRENDERER_HPP_
 #define _RWENGINE_TEXTRENDERER_HPP_
 
-#include <array>
-#include <memory>
 #include <string>
-#include <array>
 
 #include <glm/glm.hpp>
 
-#include <gl/DrawBuffer.hpp>
-#include <gl/GeometryBuffer.hpp>
-
 #include <data/GameTexts.hpp>
-#include <render/OpenGLRenderer.hpp>
-
-#define GAME_FONTS 3
-#define GAME_GLYPHS 192
+#include <render/TextLayoutCache.hpp>
 
 class GameRenderer;
 /**
  * @brief Handles rendering of bitmap font textures.
  *
- * In future, strings textures might be cached to improve performance, but
- * for now, we just render each glyph on it's own quad
+ * Each glyph is a quad in the GameRenderer's UI SpriteBatch, laid out by a
+ * TextLayoutCache so repeated strings aren't parsed and measured again.
  */
 class TextRenderer {
 public:
@@ -52,28 +43,25 @@ public:
         TextInfo();
     };
 
-    /**
-     * Stores the information for kerning a glyph
-     */
-    struct GlyphInfo {
-        float widthFrac;
-    };
-
     TextRenderer(GameRenderer* renderer);
     ~TextRenderer();
 
     void setFontTexture(int index, const std::string& font);
 
+    /**
+     * Queues the text to be drawn when the UI is next flushed
+     * @see GameRenderer::flushUI
+     */
     void renderText(const TextInfo& ti, bool forceColour = false);
 
+    const TextLayoutCache& getLayoutCache() const {
+        return layouts;
+    }
+
 private:
     std::string fonts[GAME_FONTS];
-    std::array<GlyphInfo, GAME_GLYPHS> glyphData;
+    TextLayoutCache layouts;
 
     GameRenderer* renderer;
-    std::unique_ptr<Renderer::ShaderProgram> textShader;
-
-    GeometryBuffer gb;
-    DrawBuffer db;
 };
 #endif
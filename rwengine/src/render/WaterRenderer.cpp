@@ -117,29 +117,22 @@ void WaterRenderer::render(GameRenderer* renderer, GameWorld* world) {
     wdp.textures = {0};
     glm::mat4 m(1.0);
 
-    glEnable(GL_STENCIL_TEST);
-    glDisable(GL_DEPTH_TEST);
+    r->setStencilMode(StencilMode::Write);
+    r->setDepthTest(false);
 
-    glStencilFunc(GL_ALWAYS, 1, 0xFF);
-    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-    glStencilMask(0xFF);
-
-    GLenum buffers[] = {GL_COLOR_ATTACHMENT1};
-    glDrawBuffers(1, buffers);
-    glClear(GL_STENCIL_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+    r->setDrawAttachment(1);
+    r->clear(glm::vec4(0.f), true, false, true);
 
     r->useProgram(maskProg.get());
 
     r->drawArrays(m, &maskDraw, wdp);
 
-    glStencilFunc(GL_EQUAL, 1, 0xFF);
-    glStencilMask(0x00);
-    glEnable(GL_DEPTH_TEST);
+    r->setStencilMode(StencilMode::Test);
+    r->setDepthTest(true);
 
     r->useProgram(waterProg.get());
 
-    buffers[0] = GL_COLOR_ATTACHMENT0;
-    glDrawBuffers(1, buffers);
+    r->setDrawAttachment(0);
 
     r->setUniform(waterProg.get(), "time", world->getGameTime());
     r->setUniform(waterProg.get(), "waveParams",
@@ -153,5 +146,5 @@ void WaterRenderer::render(GameRenderer* renderer, GameWorld* world) {
 
     r->drawArrays(m, &gridDraw, wdp);
 
-    glDisable(GL_STENCIL_TEST);
+    r->setStencilMode(StencilMode::Disabled);
 }
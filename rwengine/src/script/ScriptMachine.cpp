@@ -1,8 +1,13 @@
 #include "script/ScriptMachine.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+#include <rw/defines.hpp>
 
 #include "ai/PlayerController.hpp"
 #include "core/Logger.hpp"
@@ -30,7 +35,14 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
     }
     if (t.wakeCounter > 0) return;
 
+    // Jump targets and resumed threads start a new block for the profiler
+    auto blockStart = t.programCounter;
+    std::chrono::steady_clock::time_point instructionStart;
+
     while (t.wakeCounter == 0) {
+        if (profiler) {
+            instructionStart = std::chrono::steady_clock::now();
+        }
         auto pc = t.programCounter;
         auto opcode = file->read<SCMOpcode>(pc);
 
@@ -81,9 +93,8 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
                         globalData.data() + v;  //* SCM_VARIABLE_SIZE;
                     if (v >= file->getGlobalsSize()) {
                         state->world->logger->error(
-                            "SCM", "Global Out of bounds! " +
-                                       std::to_string(v) + " " +
-                                       std::to_string(file->getGlobalsSize()));
+                            "SCM", "Global Out of bounds! ", v, " ",
+                            file->getGlobalsSize());
                     }
                     pc += sizeof(SCMByte) * 2;
                 } break;
@@ -168,6 +179,15 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
 
             t.conditionResult = (t.conditionMask != 0);
         }
+
+        if (profiler) {
+            profiler->record(t.name, blockStart, pc, opcode,
+                             std::chrono::steady_clock::now() -
+                                 instructionStart);
+            if (t.programCounter != pc) {
+                blockStart = t.programCounter;
+            }
+        }
     }
 
     SCMOpcodeParameter p;
@@ -196,7 +216,7 @@ ScriptMachine::ScriptMachine(GameState* _state, SCMFile* file,
               globalData.begin());
 }
 
-void ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
+SCMThread& ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
     SCMThread t;
     for (int i = 0; i < SCM_THREAD_LOCAL_SIZE * SCM_VARIABLE_SIZE; ++i) {
         t.locals[i] = 0;
@@ -214,20 +234,118 @@ void ScriptMachine::startThread(SCMThread::pc_t start, bool mission) {
     t.deathOrArrestCheck = true;
     t.wastedOrBusted = false;
     _activeThreads.push_back(t);
+    runQueue.push_back({std::prev(_activeThreads.end()), nextThreadOrder++});
+    return _activeThreads.back();
+}
+
+std::list<SCMThread>& ScriptMachine::getThreads() {
+    wakeAllThreads();
+    return _activeThreads;
+}
+
+void ScriptMachine::setProfiling(bool enable) {
+    if (!enable) {
+        profiler.reset();
+    } else if (!profiler) {
+        profiler = std::make_unique<ScriptProfiler>();
+    }
 }
 
 SCMByte* ScriptMachine::getGlobals() {
     return globalData.data();
 }
 
+bool ScriptMachine::canSleep(const SCMThread& t) {
+    // Mission threads watch for the player dying or being arrested every
+    // tick, even while waiting
+    return !(t.isMission && t.deathOrArrestCheck);
+}
+
 void ScriptMachine::execute(float dt) {
     int ms = dt * 1000.f;
-    for (auto t = _activeThreads.begin(); t != _activeThreads.end(); ++t) {
-        auto& thread = *t;
+    const auto now = sleepingThreads.getTime() + std::max(ms, 0);
+
+    bool woken = false;
+    sleepingThreads.advance(now, [&](ScheduledThread scheduled) {
+        scheduled.thread->wakeCounter = 0;
+        runQueue.push_back(scheduled);
+        woken = true;
+    });
+    if (woken) {
+        std::sort(runQueue.begin(), runQueue.end());
+    }
+
+    // Threads started by scripts are appended and run in this tick too
+    nextRunQueue.clear();
+    for (size_t i = 0; i < runQueue.size(); ++i) {
+        auto scheduled = runQueue[i];
+        auto& thread = *scheduled.thread;
         executeThread(thread, ms);
 
         if (thread.finished) {
-            t = _activeThreads.erase(t);
+            _activeThreads.erase(scheduled.thread);
+        } else if (thread.wakeCounter > 0 && canSleep(thread)) {
+            sleepingThreads.schedule(scheduled, now + thread.wakeCounter);
+        } else {
+            nextRunQueue.push_back(scheduled);
         }
     }
+    runningThreads = runQueue.size();
+    std::swap(runQueue, nextRunQueue);
+}
+
+void ScriptMachine::wakeAllThreads() {
+    if (sleepingThreads.empty()) {
+        return;
+    }
+    const auto now = sleepingThreads.getTime();
+    sleepingThreads.drain([&](ScheduledThread scheduled, std::uint64_t when) {
+        scheduled.thread->wakeCounter = static_cast<int>(when - now);
+        runQueue.push_back(scheduled);
+    });
+    std::sort(runQueue.begin(), runQueue.end());
+}
+
+void ScriptMachine::resetSchedule() {
+    runQueue.clear();
+    sleepingThreads.reset(sleepingThreads.getTime());
+    nextThreadOrder = 0;
+    for (auto it = _activeThreads.begin(); it != _activeThreads.end(); ++it) {
+        runQueue.push_back({it, nextThreadOrder++});
+    }
+}
+
+ScriptMachine::Snapshot ScriptMachine::createSnapshot() const {
+    Snapshot snapshot{_activeThreads, globalData, randomNumberGen};
+
+    // Sleeping threads only learn their wakeCounter when they wake
+    if (!sleepingThreads.empty()) {
+        const auto now = sleepingThreads.getTime();
+        std::unordered_map<const SCMThread*, int> remaining;
+        sleepingThreads.forEach(
+            [&](const ScheduledThread& scheduled, std::uint64_t when) {
+                remaining[&*scheduled.thread] = static_cast<int>(when - now);
+            });
+        auto copy = snapshot.threads.begin();
+        for (const auto& thread : _activeThreads) {
+            auto it = remaining.find(&thread);
+            if (it != remaining.end()) {
+                copy->wakeCounter = it->second;
+            }
+            ++copy;
+        }
+    }
+
+    return snapshot;
+}
+
+void ScriptMachine::restoreSnapshot(const Snapshot& snapshot) {
+    RW_CHECK(snapshot.globals.size() == globalData.size(),
+             "Snapshot globals size doesn't match");
+    _activeThreads = snapshot.threads;
+    resetSchedule();
+    std::copy_n(snapshot.globals.begin(),
+                std::min(snapshot.globals.size(), globalData.size()),
+                globalData.begin());
+    randomNumberGen = snapshot.randomNumberGen;
 }
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iomanip>
 #include <list>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -12,6 +13,8 @@
 #include <random>
 #include <type_traits>
 
+#include <core/TimerWheel.hpp>
+#include <script/ScriptProfiler.hpp>
 #include <script/ScriptTypes.hpp>
 
 class GameState;
@@ -133,10 +136,28 @@ public:
         return file;
     }
 
-    void startThread(SCMThread::pc_t start, bool mission = false);
+    /**
+     * @brief Creates a thread that starts running on the next execute, or in
+     * the current one if called by a script.
+     * @return the new thread, which stays valid until it finishes
+     */
+    SCMThread& startThread(SCMThread::pc_t start, bool mission = false);
+
+    /**
+     * @brief Returns every thread, in the order they were started.
+     *
+     * Sleeping threads are woken with their remaining wakeCounter, so that
+     * changes made to them take effect. Don't call this from an opcode.
+     */
+    std::list<SCMThread>& getThreads();
+
+    /// Number of threads woken up and executed by the last execute
+    size_t getRunningThreadCount() const {
+        return runningThreads;
+    }
 
-    std::list<SCMThread>& getThreads() {
-        return _activeThreads;
+    size_t getSleepingThreadCount() const {
+        return sleepingThreads.size();
     }
 
     SCMByte* getGlobals();
@@ -160,6 +181,18 @@ public:
         debugFlag = flag;
     }
 
+    /**
+     * @brief Starts or stops recording the time taken by each instruction.
+     *
+     * Stopping discards the profile.
+     */
+    void setProfiling(bool enable);
+
+    /// Returns the profile being recorded, or nullptr when not profiling
+    ScriptProfiler* getProfiler() const {
+        return profiler.get();
+    }
+
     template<typename T>
     typename std::enable_if<std::is_integral<T>::value, T>::type
     getRandomNumber(T min, T max) {
@@ -176,19 +209,72 @@ public:
 
     /**
      * @brief executes threads until they are all in waiting state.
+     *
+     * Threads waiting for longer than this tick sleep in a timer wheel, so
+     * only the ones that are due are visited.
      */
     void execute(float dt);
 
+    /**
+     * @brief Copy of the threads, globals and random state of the machine
+     */
+    struct Snapshot {
+        std::list<SCMThread> threads;
+        std::vector<SCMByte> globals;
+        std::mt19937 randomNumberGen;
+    };
+
+    Snapshot createSnapshot() const;
+
+    /**
+     * @brief Restores a snapshot taken from a machine running the same file.
+     *
+     * Globals are copied in place, so pointers into them stay valid.
+     */
+    void restoreSnapshot(const Snapshot& snapshot);
+
 private:
     SCMFile* file;
     ScriptModule* module;
     GameState* state;
     bool debugFlag;
 
+    /// Threads live in a list so that removing one doesn't move the others
     std::list<SCMThread> _activeThreads;
 
+    using ThreadHandle = std::list<SCMThread>::iterator;
+
+    struct ScheduledThread {
+        ThreadHandle thread;
+        /// Threads run in the order they were started
+        std::uint64_t order;
+
+        bool operator<(const ScheduledThread& other) const {
+            return order < other.order;
+        }
+    };
+
+    /// Threads that will run in the next execute
+    std::vector<ScheduledThread> runQueue;
+    std::vector<ScheduledThread> nextRunQueue;
+    /// Threads waiting for their wakeCounter to run out, by wake time in ms
+    TimerWheel<ScheduledThread> sleepingThreads;
+    std::uint64_t nextThreadOrder = 0;
+    size_t runningThreads = 0;
+
+    std::unique_ptr<ScriptProfiler> profiler;
+
     void executeThread(SCMThread& t, int msPassed);
 
+    /// Returns true if a waiting thread doesn't need to run until it wakes
+    static bool canSleep(const SCMThread& t);
+
+    /// Moves every sleeping thread back to the run queue
+    void wakeAllThreads();
+
+    /// Rebuilds the run queue from the thread list
+    void resetSchedule();
+
     std::vector<SCMByte> globalData;
 
     std::mt19937 randomNumberGen;
@@ -0,0 +1,165 @@
+#include "script/ScriptProfiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+namespace {
+/// Thread names aren't always terminated
+constexpr size_t kMaxThreadName = 16;
+
+void sortByTime(std::vector<ScriptProfiler::Entry>& entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const ScriptProfiler::Entry& a,
+                 const ScriptProfiler::Entry& b) {
+                  return a.time != b.time ? a.time > b.time
+                                          : a.name < b.name;
+              });
+}
+
+void writeRows(std::ostream& out, const char* type,
+               const std::vector<ScriptProfiler::Entry>& entries) {
+    for (const auto& entry : entries) {
+        const auto us = entry.time.count() / 1000.0;
+        out << type << "," << entry.name << "," << entry.count << "," << us
+            << "," << (entry.count > 0 ? us / entry.count : 0.0) << "\n";
+    }
+}
+}  // namespace
+
+size_t ScriptProfiler::KeyHash::operator()(const Key& key) const {
+    size_t h = std::hash<std::string>()(key.thread);
+    h ^= std::hash<SCMAddress>()(key.block) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<SCMOpcode>()(key.opcode) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+void ScriptProfiler::record(const char* thread, SCMAddress block,
+                            SCMAddress end, SCMOpcode opcode, Duration time) {
+    auto& sample =
+        samples[{std::string(thread, strnlen(thread, kMaxThreadName)), block,
+                 opcode}];
+    sample.count++;
+    sample.time += time;
+    sample.end = std::max(sample.end, end);
+}
+
+void ScriptProfiler::reset() {
+    samples.clear();
+}
+
+std::uint64_t ScriptProfiler::getInstructionCount() const {
+    std::uint64_t count = 0;
+    for (const auto& sample : samples) {
+        count += sample.second.count;
+    }
+    return count;
+}
+
+ScriptProfiler::Duration ScriptProfiler::getTotalTime() const {
+    Duration time{0};
+    for (const auto& sample : samples) {
+        time += sample.second.time;
+    }
+    return time;
+}
+
+template <class F>
+std::vector<ScriptProfiler::Entry> ScriptProfiler::summarise(F&& name) const {
+    std::unordered_map<std::string, Entry> totals;
+    for (const auto& sample : samples) {
+        auto key = name(sample.first);
+        auto& entry = totals[key];
+        entry.count += sample.second.count;
+        entry.time += sample.second.time;
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(totals.size());
+    for (auto& total : totals) {
+        total.second.name = total.first;
+        entries.push_back(std::move(total.second));
+    }
+    sortByTime(entries);
+    return entries;
+}
+
+std::vector<ScriptProfiler::Entry> ScriptProfiler::getOpcodes() const {
+    return summarise([](const Key& key) { return getOpcodeName(key.opcode); });
+}
+
+std::vector<ScriptProfiler::Entry> ScriptProfiler::getThreads() const {
+    return summarise([](const Key& key) { return key.thread; });
+}
+
+std::vector<ScriptProfiler::Entry> ScriptProfiler::getBlocks() const {
+    // A block's end is only known once every opcode in it has been seen
+    std::map<std::pair<std::string, SCMAddress>, Sample> blocks;
+    for (const auto& sample : samples) {
+        auto& block = blocks[{sample.first.thread, sample.first.block}];
+        block.count += sample.second.count;
+        block.time += sample.second.time;
+        block.end = std::max(block.end, sample.second.end);
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(blocks.size());
+    for (const auto& block : blocks) {
+        entries.push_back({getBlockName(block.first.first, block.first.second,
+                                        block.second.end),
+                           block.second.count, block.second.time});
+    }
+    sortByTime(entries);
+    return entries;
+}
+
+void ScriptProfiler::writeCSV(std::ostream& out) const {
+    out << std::fixed << std::setprecision(3);
+    out << "type,name,count,total_us,mean_us\n";
+    writeRows(out, "thread", getThreads());
+    writeRows(out, "block", getBlocks());
+    writeRows(out, "opcode", getOpcodes());
+}
+
+void ScriptProfiler::writeFolded(std::ostream& out) const {
+    std::map<std::pair<std::string, SCMAddress>, SCMAddress> blockEnds;
+    for (const auto& sample : samples) {
+        auto& end = blockEnds[{sample.first.thread, sample.first.block}];
+        end = std::max(end, sample.second.end);
+    }
+
+    // Sorted so that exports can be compared
+    std::vector<std::pair<std::string, std::int64_t>> stacks;
+    stacks.reserve(samples.size());
+    for (const auto& sample : samples) {
+        const auto& key = sample.first;
+        stacks.emplace_back(
+            key.thread + ";" +
+                getBlockName({}, key.block,
+                             blockEnds[{key.thread, key.block}]) +
+                ";" + getOpcodeName(key.opcode),
+            sample.second.time.count());
+    }
+    std::sort(stacks.begin(), stacks.end());
+    for (const auto& stack : stacks) {
+        out << stack.first << " " << stack.second << "\n";
+    }
+}
+
+std::string ScriptProfiler::getOpcodeName(SCMOpcode opcode) {
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(4) << std::hex << opcode;
+    return ss.str();
+}
+
+std::string ScriptProfiler::getBlockName(const std::string& thread,
+                                         SCMAddress start, SCMAddress end) {
+    std::stringstream ss;
+    ss << thread << "@" << std::setfill('0') << std::setw(6) << std::hex
+       << start << "-" << std::setw(6) << end;
+    return ss.str();
+}
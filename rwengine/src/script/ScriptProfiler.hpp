@@ -0,0 +1,90 @@
+#ifndef _RWENGINE_SCRIPTPROFILER_HPP_
+#define _RWENGINE_SCRIPTPROFILER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <script/ScriptTypes.hpp>
+
+/**
+ * @brief Counts how often and how long script instructions run
+ *
+ * ScriptMachine records every instruction it executes while a profiler is
+ * attached. Samples are kept per thread, basic block and opcode, and can be
+ * summed up by any of the three. A basic block here is the run of
+ * instructions between a jump target, or the point a thread resumed, and
+ * the next jump or wait.
+ */
+class ScriptProfiler {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    struct Entry {
+        std::string name;
+        std::uint64_t count = 0;
+        Duration time{0};
+    };
+
+    /**
+     * Adds one execution of an instruction
+     * @param thread name of the thread running it
+     * @param block address the basic block starts at
+     * @param end address following the instruction
+     */
+    void record(const char* thread, SCMAddress block, SCMAddress end,
+                SCMOpcode opcode, Duration time);
+
+    void reset();
+
+    std::uint64_t getInstructionCount() const;
+    Duration getTotalTime() const;
+
+    /// Totals for each opcode, thread, or block, most time first
+    std::vector<Entry> getOpcodes() const;
+    std::vector<Entry> getThreads() const;
+    std::vector<Entry> getBlocks() const;
+
+    /// Writes one row per thread, block and opcode
+    void writeCSV(std::ostream& out) const;
+
+    /// Writes thread;block;opcode stacks with their time in nanoseconds,
+    /// as read by flamegraph.pl
+    void writeFolded(std::ostream& out) const;
+
+    static std::string getOpcodeName(SCMOpcode opcode);
+    static std::string getBlockName(const std::string& thread,
+                                    SCMAddress start, SCMAddress end);
+
+private:
+    struct Key {
+        std::string thread;
+        SCMAddress block;
+        SCMOpcode opcode;
+
+        bool operator==(const Key& other) const {
+            return block == other.block && opcode == other.opcode &&
+                   thread == other.thread;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Sample {
+        std::uint64_t count = 0;
+        Duration time{0};
+        SCMAddress end = 0;
+    };
+
+    template <class F>
+    std::vector<Entry> summarise(F&& name) const;
+
+    std::unordered_map<Key, Sample, KeyHash> samples;
+};
+
+#endif
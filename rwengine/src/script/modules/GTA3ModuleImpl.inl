@@ -853,9 +853,7 @@ void opcode_004e(const ScriptArguments& args) {
     @arg arg2 
 */
 void opcode_004f(const ScriptArguments& args, const ScriptLabel arg1) {
-    args.getVM()->startThread(arg1, false);
-    auto& threads = args.getVM()->getThreads();
-    SCMThread& thread = threads.back();
+    SCMThread& thread = args.getVM()->startThread(arg1, false);
     // Copy arguments to locals
     /// @todo prevent overflow
     /// @todo don't do pointer casting
@@ -7882,7 +7880,7 @@ void opcode_02e6(const ScriptArguments& args, const ScriptObject object, const S
     auto cutscene = args.getObject<CutsceneObject>(0);
     std::string animName = arg2;
     std::transform(animName.begin(), animName.end(), animName.begin(), ::tolower);
-    auto anim = args.getWorld()->data->animations[animName];
+    auto anim = args.getWorld()->findCutsceneAnimation(animName);
     if( anim ) {
     	cutscene->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
     }
@@ -8088,7 +8086,7 @@ void opcode_02f5(const ScriptArguments& args, const ScriptObject object, const S
     GameObject* head = args.getObject<CutsceneObject>(0);
     std::string animName = args[1].string;
     std::transform(animName.begin(), animName.end(), animName.begin(), ::tolower);
-    auto anim = args.getWorld()->data->animations[animName];
+    auto anim = args.getWorld()->findCutsceneAnimation(animName);
     if( anim ) {
     	head->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
     }
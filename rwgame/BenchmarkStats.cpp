@@ -0,0 +1,181 @@
+#include "BenchmarkStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <utility>
+
+namespace {
+constexpr float kSecondsToMS = 1000.f;
+
+float getPhaseTime(const FrameTimings& timings, BenchmarkStats::Phase phase) {
+    switch (phase) {
+        case BenchmarkStats::Update:
+            return timings.update;
+        case BenchmarkStats::RenderListBuild:
+            return timings.renderListBuild;
+        case BenchmarkStats::Draw:
+            return timings.draw;
+        case BenchmarkStats::Swap:
+            return timings.swap;
+        default:
+            return timings.total;
+    }
+}
+}  // namespace
+
+BenchmarkStats::BenchmarkStats(std::vector<float> hitchThresholds)
+    : hitchThresholds(std::move(hitchThresholds)) {
+    std::sort(this->hitchThresholds.begin(), this->hitchThresholds.end());
+}
+
+void BenchmarkStats::addSample(uint32_t iteration,
+                               const FrameTimings& timings) {
+    samples.push_back({iteration, timings});
+}
+
+const char* BenchmarkStats::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Update:
+            return "update";
+        case RenderListBuild:
+            return "renderlist";
+        case Draw:
+            return "draw";
+        case Swap:
+            return "swap";
+        default:
+            return "total";
+    }
+}
+
+float BenchmarkStats::percentile(const std::vector<float>& sorted, float p) {
+    if (sorted.empty()) {
+        return 0.f;
+    }
+    auto rank = static_cast<size_t>(
+        std::ceil(p / 100.f * static_cast<float>(sorted.size())));
+    rank = std::min(std::max(rank, size_t(1)), sorted.size());
+    return sorted[rank - 1];
+}
+
+BenchmarkStats::Summary BenchmarkStats::summarise(Phase phase) const {
+    Summary summary;
+    summary.hitches.resize(hitchThresholds.size(), 0);
+    if (samples.empty()) {
+        return summary;
+    }
+
+    std::vector<float> times;
+    times.reserve(samples.size());
+    float sum = 0.f;
+    for (const auto& sample : samples) {
+        float ms = getPhaseTime(sample.timings, phase) * kSecondsToMS;
+        times.push_back(ms);
+        sum += ms;
+        for (size_t i = 0; i < hitchThresholds.size(); ++i) {
+            if (ms > hitchThresholds[i]) {
+                summary.hitches[i]++;
+            }
+        }
+    }
+    std::sort(times.begin(), times.end());
+
+    summary.count = times.size();
+    summary.min = times.front();
+    summary.max = times.back();
+    summary.mean = sum / static_cast<float>(times.size());
+    summary.p50 = percentile(times, 50.f);
+    summary.p95 = percentile(times, 95.f);
+    summary.p99 = percentile(times, 99.f);
+    return summary;
+}
+
+void BenchmarkStats::writeJSON(std::ostream& out,
+                               const std::string& name) const {
+    out << std::fixed << std::setprecision(4);
+    out << "{\n  \"benchmark\": \"" << name << "\",\n";
+    out << "  \"frames\": " << samples.size() << ",\n";
+
+    out << "  \"hitchThresholdsMS\": [";
+    for (size_t i = 0; i < hitchThresholds.size(); ++i) {
+        out << (i ? ", " : "") << hitchThresholds[i];
+    }
+    out << "],\n";
+
+    out << "  \"phases\": {\n";
+    for (int p = 0; p < PhaseCount; ++p) {
+        auto phase = static_cast<Phase>(p);
+        auto summary = summarise(phase);
+        out << "    \"" << getPhaseName(phase) << "\": {"
+            << "\"min\": " << summary.min << ", \"mean\": " << summary.mean
+            << ", \"p50\": " << summary.p50 << ", \"p95\": " << summary.p95
+            << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max
+            << ", \"hitches\": [";
+        for (size_t i = 0; i < summary.hitches.size(); ++i) {
+            out << (i ? ", " : "") << summary.hitches[i];
+        }
+        out << "]}" << (p + 1 < PhaseCount ? "," : "") << "\n";
+    }
+    out << "  },\n";
+
+    out << "  \"samples\": [\n";
+    for (size_t s = 0; s < samples.size(); ++s) {
+        const auto& sample = samples[s];
+        out << "    [" << sample.iteration;
+        for (int p = 0; p < PhaseCount; ++p) {
+            out << ", "
+                << getPhaseTime(sample.timings, static_cast<Phase>(p)) *
+                       kSecondsToMS;
+        }
+        out << "]" << (s + 1 < samples.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void BenchmarkStats::writeCSV(std::ostream& out) const {
+    out << std::fixed << std::setprecision(4);
+    out << "iteration,frame";
+    for (int p = 0; p < PhaseCount; ++p) {
+        out << "," << getPhaseName(static_cast<Phase>(p)) << "_ms";
+    }
+    out << "\n";
+    for (size_t s = 0; s < samples.size(); ++s) {
+        const auto& sample = samples[s];
+        out << sample.iteration << "," << s;
+        for (int p = 0; p < PhaseCount; ++p) {
+            out << ","
+                << getPhaseTime(sample.timings, static_cast<Phase>(p)) *
+                       kSecondsToMS;
+        }
+        out << "\n";
+    }
+}
+
+void BenchmarkStats::writeText(std::ostream& out,
+                               const std::string& name) const {
+    out << "Results =============\n"
+        << "Benchmark: " << name << "\n"
+        << "Frames: " << samples.size() << "\n"
+        << std::fixed << std::setprecision(3)
+        << "Phase         min     p50     p95     p99     max (ms)\n";
+    for (int p = 0; p < PhaseCount; ++p) {
+        auto phase = static_cast<Phase>(p);
+        auto summary = summarise(phase);
+        out << std::left << std::setw(10) << getPhaseName(phase)
+            << std::right << std::setw(8) << summary.min << std::setw(8)
+            << summary.p50 << std::setw(8) << summary.p95 << std::setw(8)
+            << summary.p99 << std::setw(8) << summary.max << "\n";
+    }
+
+    auto total = summarise(Total);
+    for (size_t i = 0; i < hitchThresholds.size(); ++i) {
+        out << "Frames over " << hitchThresholds[i]
+            << " ms: " << total.hitches[i] << "\n";
+    }
+    if (total.mean > 0.f) {
+        out << "Avg frametime: " << total.mean << " ms ("
+            << kSecondsToMS / total.mean << " fps)\n";
+    }
+    out << std::flush;
+}
@@ -0,0 +1,106 @@
+#ifndef RWGAME_BENCHMARKSTATS_HPP
+#define RWGAME_BENCHMARKSTATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Wall clock time spent in each phase of one frame, in seconds
+ */
+struct FrameTimings {
+    /// Fixed-step simulation (physics, states and the world tick)
+    float update = 0.f;
+    /// Render list construction and sorting in GameRenderer::renderWorld
+    float renderListBuild = 0.f;
+    /// Everything else between the start of rendering and the swap
+    float draw = 0.f;
+    /// Buffer swap, including any time blocked on the driver
+    float swap = 0.f;
+    /// The whole frame, including input handling
+    float total = 0.f;
+};
+
+/**
+ * @brief Collects per-frame timing samples and summarises them
+ *
+ * Samples are grouped by iteration (one pass over the benchmark track) so that
+ * warm-up laps can be discarded and the measured laps reported together.
+ */
+class BenchmarkStats {
+public:
+    enum Phase {
+        Update,
+        RenderListBuild,
+        Draw,
+        Swap,
+        Total,
+        PhaseCount
+    };
+
+    struct Sample {
+        uint32_t iteration;
+        FrameTimings timings;
+    };
+
+    /// Distribution of one phase's frame times, in milliseconds
+    struct Summary {
+        size_t count = 0;
+        float min = 0.f;
+        float mean = 0.f;
+        float p50 = 0.f;
+        float p95 = 0.f;
+        float p99 = 0.f;
+        float max = 0.f;
+        /// Number of samples above each of the hitch thresholds
+        std::vector<size_t> hitches;
+    };
+
+    /**
+     * @param hitchThresholds frame times in milliseconds above which a frame
+     * is counted as a hitch
+     */
+    explicit BenchmarkStats(std::vector<float> hitchThresholds = {33.3f,
+                                                                  50.f, 100.f});
+
+    void addSample(uint32_t iteration, const FrameTimings& timings);
+
+    void clear() {
+        samples.clear();
+    }
+
+    const std::vector<Sample>& getSamples() const {
+        return samples;
+    }
+
+    const std::vector<float>& getHitchThresholds() const {
+        return hitchThresholds;
+    }
+
+    Summary summarise(Phase phase) const;
+
+    static const char* getPhaseName(Phase phase);
+
+    /**
+     * Nearest-rank percentile of an ascending sorted range
+     * @param p percentile in the range [0, 100]
+     */
+    static float percentile(const std::vector<float>& sorted, float p);
+
+    /// Writes the per-phase summary and every sample as a JSON document
+    void writeJSON(std::ostream& out, const std::string& name) const;
+
+    /// Writes one row per sample, times in milliseconds
+    void writeCSV(std::ostream& out) const;
+
+    /// Writes a short human readable summary
+    void writeText(std::ostream& out, const std::string& name) const;
+
+private:
+    std::vector<float> hitchThresholds;
+    std::vector<Sample> samples;
+};
+
+#endif
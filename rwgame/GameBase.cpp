@@ -45,7 +45,13 @@ GameBase::GameBase(Logger &inlog, int argc, char *argv[]) :
     po::options_description desc_devel("Developer options");
     desc_devel.add_options()(
         "test,t", "Starts a new game in a test location")(
-        "benchmark,b", po::value<std::string>()->value_name("PATH"), "Run benchmark from file");
+        "benchmark,b", po::value<std::string>()->value_name("PATH"), "Run benchmark from file")(
+        "benchmark-warmup", po::value<unsigned int>()->value_name("N"), "Number of unmeasured benchmark laps")(
+        "benchmark-iterations", po::value<unsigned int>()->value_name("N"), "Number of measured benchmark laps")(
+        "benchmark-output", po::value<std::string>()->value_name("PATH"), "Write benchmark results to a .json or .csv file")(
+        "benchmark-hitch", po::value<std::vector<float>>()->multitoken()->value_name("MS"), "Frame time thresholds counted as hitches")(
+        "texture-cache", po::value<unsigned int>()->value_name("MB"), "Keep decoded textures in a cache of up to MB megabytes")(
+        "texture-cache-validate", "Check cached textures against the game data");
     po::options_description desc("Generic options");
     desc.add_options()(
         "config,c", po::value<rwfs::path>()->value_name("PATH"), "Path of configuration file")(
@@ -104,11 +110,14 @@ GameBase::GameBase(Logger &inlog, int argc, char *argv[]) :
 
     window.create(kWindowTitle + " [" + kBuildStr + "]", w, h, fullscreen);
 
-    SET_RW_ABORT_CB([this]() {window.showCursor();},
+    SET_RW_ABORT_CB([this]() {log.flush(); window.showCursor();},
             [this]() {window.hideCursor();});
+    SET_RW_ERROR_CB(
+        [this](const std::string& message) { log.error("Debug", message); });
 }
 
 GameBase::~GameBase() {
+    SET_RW_ERROR_CB(nullptr);
     SDL_Quit();
 
     log.info("Game", "Done cleaning up");
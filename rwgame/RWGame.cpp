@@ -13,6 +13,8 @@
 #include <core/Profiler.hpp>
 
 #include <engine/SaveGame.hpp>
+#include <loaders/BakedWorld.hpp>
+#include <loaders/TextureCache.hpp>
 #include <objects/GameObject.hpp>
 
 #include <script/SCMFile.hpp>
@@ -22,6 +24,7 @@
 #include <objects/VehicleObject.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -53,6 +56,22 @@ RWGame::RWGame(Logger& log, int argc, char* argv[])
     std::string benchFile(options.count("benchmark")
                               ? options["benchmark"].as<std::string>()
                               : "");
+    BenchmarkState::Options benchOptions;
+    if (options.count("benchmark-warmup")) {
+        benchOptions.warmupIterations =
+            options["benchmark-warmup"].as<unsigned int>();
+    }
+    if (options.count("benchmark-iterations")) {
+        benchOptions.measuredIterations =
+            std::max(options["benchmark-iterations"].as<unsigned int>(), 1u);
+    }
+    if (options.count("benchmark-output")) {
+        benchOptions.outputPath = options["benchmark-output"].as<std::string>();
+    }
+    if (options.count("benchmark-hitch")) {
+        benchOptions.hitchThresholds =
+            options["benchmark-hitch"].as<std::vector<float>>();
+    }
 
     log.info("Game", "Game directory: " + config.getGameDataPath().string());
 
@@ -61,7 +80,24 @@ RWGame::RWGame(Logger& log, int argc, char* argv[])
                                  config.getGameDataPath().string());
     }
 
-    data.load();
+    // Models stay loaded for the whole session, keep them small
+    data.setCompactModels(true);
+
+    // The texture cache writes to disk, so it's only used when asked for
+    uint64_t textureCacheSize = 0;
+    if (options.count("texture-cache")) {
+        textureCacheSize =
+            uint64_t(options["texture-cache"].as<unsigned int>()) << 20;
+    }
+    if (textureCacheSize > 0) {
+        auto cache = std::make_unique<TextureCache>(
+            config.getConfigPath().parent_path() / "texturecache",
+            textureCacheSize);
+        cache->setValidate(options.count("texture-cache-validate") != 0);
+        data.setTextureCache(std::move(cache));
+    }
+
+    data.load(config.getConfigPath().parent_path() / "fileindex.cache");
 
     for (const auto& p : kSpecialModels) {
         auto model = data.loadClump(p.second.first, p.second.second);
@@ -94,7 +130,8 @@ RWGame::RWGame(Logger& log, int argc, char* argv[])
 
     StateManager::get().enter<LoadingState>(this, [=]() {
         if (!benchFile.empty()) {
-            StateManager::get().enter<BenchmarkState>(this, benchFile);
+            StateManager::get().enter<BenchmarkState>(this, benchFile,
+                                                      benchOptions);
         } else if (test) {
             StateManager::get().enter<IngameState>(this, true, "test");
         } else if (newgame) {
@@ -120,14 +157,33 @@ void RWGame::newGame() {
     // Destroy the current world and start over
     world = std::make_unique<GameWorld>(&log, &data);
     world->dynamicsWorld->setDebugDrawer(&debug);
+    // Objects record when they're drawn, so the rest can animate less
+    world->animationLOD = true;
 
     // Associate the new world with the new state and vice versa
     state.world = world.get();
     world->state = &state;
 
-    for (auto ipl : world->data->iplLocations) {
-        world->data->loadZone(ipl.second);
-        world->placeItems(ipl.second);
+    // Place the world from the baked IPLs, rebaking if they have changed
+    BakedWorld baked;
+    auto bakePath = config.getConfigPath().parent_path() / "world.bake";
+    bool haveBake = baked.load(bakePath, data.iplLocations);
+    if (!haveBake && baked.bake(data.iplLocations)) {
+        haveBake = true;
+        if (!baked.save(bakePath)) {
+            log.warning("Game", "Failed to write baked world ",
+                        bakePath.string());
+        }
+    }
+
+    if (haveBake) {
+        data.addZones(baked.getZones());
+        world->placeItems(baked);
+    } else {
+        for (auto ipl : world->data->iplLocations) {
+            world->data->loadZone(ipl.second);
+            world->placeItems(ipl.second);
+        }
     }
 }
 
@@ -378,6 +434,9 @@ int RWGame::run() {
     while (StateManager::currentState() && running) {
         RW_PROFILE_FRAME_BOUNDARY();
 
+        auto frameStart = chrono::steady_clock::now();
+        FrameTimings timings;
+
         RW_PROFILE_BEGIN("Input");
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -418,6 +477,8 @@ int RWGame::run() {
         }
         RW_PROFILE_END();
 
+        world->sound.update();
+
         auto currentFrame = chrono::steady_clock::now();
         auto frameTime =
             chrono::duration<float>(currentFrame - lastFrame).count();
@@ -434,6 +495,7 @@ int RWGame::run() {
             auto deltaTimeWithTimeScale =
                 deltaTime * world->state->basic.timeScale;
 
+            auto updateStart = chrono::steady_clock::now();
             RW_PROFILE_BEGIN("Update");
             while (accumulatedTime >= deltaTime) {
                 if (!StateManager::currentState()) {
@@ -458,11 +520,16 @@ int RWGame::run() {
                 accumulatedTime -= deltaTime;
             }
             RW_PROFILE_END();
+            timings.update = chrono::duration<float>(
+                                 chrono::steady_clock::now() - updateStart)
+                                 .count();
         }
 
+        auto renderStart = chrono::steady_clock::now();
         RW_PROFILE_BEGIN("Render");
         RW_PROFILE_BEGIN("engine");
         render(1, frameTime);
+        renderer.flushUI();
         RW_PROFILE_END();
 
         RW_PROFILE_BEGIN("state");
@@ -473,8 +540,20 @@ int RWGame::run() {
         RW_PROFILE_END();
 
         renderProfile();
+        renderer.flushUI();
 
+        auto swapStart = chrono::steady_clock::now();
         getWindow().swap();
+        auto frameEnd = chrono::steady_clock::now();
+
+        timings.renderListBuild = renderer.getRenderListTime();
+        timings.draw = std::max(
+            chrono::duration<float>(swapStart - renderStart).count() -
+                timings.renderListBuild,
+            0.f);
+        timings.swap = chrono::duration<float>(frameEnd - swapStart).count();
+        timings.total = chrono::duration<float>(frameEnd - frameStart).count();
+        lastFrameTimings = timings;
 
         // Make sure the topmost state is the correct state
         StateManager::get().updateStack();
@@ -492,6 +571,10 @@ void RWGame::tick(float dt) {
 
     static float clockAccumulator = 0.f;
     if (currState->shouldWorldUpdate()) {
+        // Static geometry doesn't change during the tick, so ground probes
+        // can be shared
+        RaycastService::Frame raycastFrame(*world->raycasts);
+
         world->chase.update(dt);
 
         // Clear out any per-tick state.
@@ -512,23 +595,11 @@ void RWGame::tick(float dt) {
             clockAccumulator -= 1.f;
         }
 
-        // Clean up old VisualFX
-        for (int i = 0; i < static_cast<int>(world->effects.size()); ++i) {
-            VisualFX* effect = world->effects[i];
-            if (effect->getType() == VisualFX::Particle) {
-                auto& part = effect->particle;
-                if (part.lifetime < 0.f) continue;
-                if (world->getGameTime() >= part.starttime + part.lifetime) {
-                    world->destroyEffect(effect);
-                    --i;
-                }
-            }
-        }
+        world->particles.tick(world->getGameTime(), dt);
 
-        for (auto& object : world->allObjects) {
-            object->_updateLastTransform();
-            object->tick(dt);
-        }
+        world->routePlanner.update();
+
+        world->tickObjects(dt);
 
         for (auto& gc : world->garageControllers) {
             gc->tick(dt);
@@ -554,6 +625,7 @@ void RWGame::tick(float dt) {
                                       currentCam.getView());
             // Use the current camera position to spawn pedestrians.
             world->cleanupTraffic(currentCam);
+            world->updateTrafficPhysics(currentCam);
             // Only create new traffic outside cutscenes
             if (!state.currentCutscene) {
                 world->createTraffic(currentCam);
@@ -640,8 +712,9 @@ void RWGame::renderDebugStats(float time) {
     std::stringstream ss;
     ss << "FPS: " << (1000.f / time_average) << " (" << time_average << "ms)\n"
        << "Frame: " << time_ms << "ms\n"
-       << "Draws/Culls/Textures/Buffers: " << lastDraws << "/"
+       << "Draws/Culls/Occluded/Textures/Buffers: " << lastDraws << "/"
        << renderer.getCulledCount() << "/"
+       << renderer.getOccludedCount() << "/"
        << renderer.getRenderer()->getTextureCount() << "/"
        << renderer.getRenderer()->getBufferCount() << "\n";
 
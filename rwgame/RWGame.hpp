@@ -15,6 +15,7 @@
 #include <script/modules/GTA3Module.hpp>
 #include "game.hpp"
 
+#include "BenchmarkStats.hpp"
 #include "GameBase.hpp"
 
 class PlayerController;
@@ -44,6 +45,7 @@ class RWGame : public GameBase {
 
     DebugViewMode debugview_ = DebugViewMode::Disabled;
     int lastDraws{};  /// Number of draws issued for the last frame.
+    FrameTimings lastFrameTimings;  /// Phase timings of the last frame.
 
     std::string cheatInputWindow = std::string(32, ' ');
 
@@ -78,6 +80,13 @@ public:
         return vm.get();
     }
 
+    /**
+     * Returns the phase timings of the last completed frame
+     */
+    const FrameTimings& getLastFrameTimings() const {
+        return lastFrameTimings;
+    }
+
     bool hitWorldRay(glm::vec3& hit, glm::vec3& normal,
                      GameObject** object = nullptr) {
         auto vc = currentCam;
@@ -10,6 +10,8 @@ int main(int argc, char* argv[]) {
     // Initialise Logging before anything else happens
     StdOutReceiver logstdout;
     Logger logger({ &logstdout });
+    // Keep console output off the game thread
+    logger.startAsync();
 
     try {
         RWGame game(logger, argc, argv);
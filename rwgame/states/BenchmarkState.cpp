@@ -1,17 +1,30 @@
 #include "BenchmarkState.hpp"
 #include <engine/GameState.hpp>
+#include <rw/filesystem.hpp>
 #include "RWGame.hpp"
 
 #include <fstream>
 #include <iostream>
 
-BenchmarkState::BenchmarkState(RWGame* game, const std::string& benchfile)
-    : State(game), benchfile(benchfile), benchmarkTime(0.f), duration(0.f), frameCounter(0) {
+BenchmarkState::BenchmarkState(RWGame* game, const std::string& benchfile,
+                               const Options& options)
+    : State(game)
+    , benchfile(benchfile)
+    , options(options)
+    , stats(options.hitchThresholds)
+    , benchmarkTime(0.f)
+    , duration(0.f)
+    , frameCounter(0) {
 }
 
 void BenchmarkState::enter() {
     getWindow().hideCursor();
 
+    // Resuming after a suspension, the track is already loaded
+    if (!track.empty()) {
+        return;
+    }
+
     std::ifstream benchstream(benchfile);
 
     unsigned int clockHour;
@@ -54,43 +67,78 @@ void BenchmarkState::enter() {
         track.push_back(point);
     }
 
-    std::cout << "Loaded " << track.size() << " points" << std::endl;
+    std::cout << "Loaded " << track.size() << " points, "
+              << options.warmupIterations << " warm-up and "
+              << options.measuredIterations << " measured laps" << std::endl;
 }
 
 void BenchmarkState::exit() {
-    std::cout << "Results =============\n"
-              << "Benchmark: " << benchfile << "\n"
-              << "Frames: " << frameCounter << "\n"
-              << "Duration: " << duration << " seconds\n"
-              << "Avg frametime: " << std::setprecision(3)
-              << (duration / frameCounter) << " (" << (frameCounter / duration)
-              << " fps)" << std::endl;
+    if (hasExited() && !reported) {
+        writeResults();
+        reported = true;
+    }
+}
+
+void BenchmarkState::writeResults() {
+    stats.writeText(std::cout, benchfile);
+
+    if (options.outputPath.empty()) {
+        return;
+    }
+
+    std::ofstream out(options.outputPath);
+    if (!out) {
+        std::cerr << "Failed to open benchmark output " << options.outputPath
+                  << std::endl;
+        return;
+    }
+
+    if (rwfs::path(options.outputPath).extension() == ".csv") {
+        stats.writeCSV(out);
+    } else {
+        stats.writeJSON(out, benchfile);
+    }
+    std::cout << "Wrote results to " << options.outputPath << std::endl;
 }
 
 void BenchmarkState::tick(float dt) {
-    if (!track.empty()) {
-        TrackPoint& a = track.front();
-        TrackPoint& b = track.back();
-        for (TrackPoint& p : track) {
-            if (benchmarkTime < p.time) {
-                b = p;
-                break;
-            }
-            a = p;
-        }
-        if (benchmarkTime > duration) {
+    if (track.empty()) {
+        done();
+        return;
+    }
+
+    // The track is sorted by time, so only ever step the cursor forwards
+    while (trackCursor + 1 < track.size() &&
+           track[trackCursor + 1].time <= benchmarkTime) {
+        trackCursor++;
+    }
+    const TrackPoint& a = track[trackCursor];
+    const TrackPoint& b = track[std::min(trackCursor + 1, track.size() - 1)];
+    if (b.time != a.time) {
+        float alpha = (benchmarkTime - a.time) / (b.time - a.time);
+        trackCam.position = glm::mix(a.position, b.position, alpha);
+        trackCam.rotation = glm::slerp(a.angle, b.angle, alpha);
+    }
+
+    benchmarkTime += dt;
+    if (benchmarkTime > duration) {
+        iteration++;
+        if (iteration >=
+            options.warmupIterations + options.measuredIterations) {
             done();
         }
-        if (b.time != a.time) {
-            float alpha = (benchmarkTime - a.time) / (b.time - a.time);
-            trackCam.position = glm::mix(a.position, b.position, alpha);
-            trackCam.rotation = glm::slerp(a.angle, b.angle, alpha);
-        }
-        benchmarkTime += dt;
+        benchmarkTime = 0.f;
+        trackCursor = 0;
     }
 }
 
 void BenchmarkState::draw(GameRenderer* r) {
+    // The timings available now belong to the previous frame, which was
+    // only ours if this isn't the first frame drawn.
+    if (frameCounter > 0 && iteration >= options.warmupIterations) {
+        stats.addSample(iteration - options.warmupIterations,
+                        game->getLastFrameTimings());
+    }
     frameCounter++;
     State::draw(r);
 }
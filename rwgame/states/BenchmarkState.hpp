@@ -3,24 +3,48 @@
 
 #include "State.hpp"
 
+#include "BenchmarkStats.hpp"
+
 class BenchmarkState : public State {
+public:
+    struct Options {
+        /// Laps of the track to run before recording samples
+        unsigned int warmupIterations = 0;
+        /// Laps of the track to record
+        unsigned int measuredIterations = 1;
+        /// If set, results are written here as JSON or CSV (by extension)
+        std::string outputPath;
+        /// Frame time thresholds in milliseconds counted as hitches
+        std::vector<float> hitchThresholds{33.3f, 50.f, 100.f};
+    };
+
+private:
     struct TrackPoint {
         float time;
         glm::vec3 position{};
         glm::quat angle{1.0f,0.0f,0.0f,0.0f};
     };
     std::vector<TrackPoint> track;
+    /// Index of the track point at or before benchmarkTime
+    size_t trackCursor = 0;
 
     ViewCamera trackCam;
 
     std::string benchfile;
+    Options options;
+    BenchmarkStats stats;
 
     float benchmarkTime;
     float duration;
     uint32_t frameCounter;
+    uint32_t iteration = 0;
+    bool reported = false;
+
+    void writeResults();
 
 public:
-    BenchmarkState(RWGame* game, const std::string& benchfile);
+    BenchmarkState(RWGame* game, const std::string& benchfile,
+                   const Options& options);
 
     void enter() override;
 
@@ -2,6 +2,7 @@
 #include <ai/PlayerController.hpp>
 #include <data/WeaponData.hpp>
 #include <engine/GameState.hpp>
+#include <fstream>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <iostream>
@@ -9,6 +10,7 @@
 #include <objects/InstanceObject.hpp>
 #include <objects/VehicleObject.hpp>
 #include <script/SCMFile.hpp>
+#include <script/ScriptMachine.hpp>
 #include <sstream>
 #include "RWGame.hpp"
 
@@ -33,6 +35,21 @@ static void jumpCharacter(RWGame* game, CharacterObject* player,
     }
 }
 
+static double toMS(ScriptProfiler::Duration time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+static void printProfileEntries(
+    std::ostream& out, const char* title,
+    const std::vector<ScriptProfiler::Entry>& entries) {
+    constexpr size_t kProfileRows = 5;
+    out << title << "\n";
+    for (size_t i = 0; i < std::min(entries.size(), kProfileRows); ++i) {
+        out << "  " << entries[i].name << " " << entries[i].count << "x "
+            << toMS(entries[i].time) << "ms\n";
+    }
+}
+
 std::shared_ptr<Menu> DebugState::createDebugMenu() {
     CharacterObject* player = nullptr;
     if (game->getPlayer()) {
@@ -59,7 +76,24 @@ std::shared_ptr<Menu> DebugState::createDebugMenu() {
          {"Full Health", [=] { player->getCurrentState().health = 100.f; }},
          {"Full Armour", [=] { player->getCurrentState().armour = 100.f; }},
          {"Cull Here",
-          [=] { game->getRenderer().setCullOverride(true, _debugCam); }}},
+          [=] { game->getRenderer().setCullOverride(true, _debugCam); }},
+         {"Toggle Occlusion Culling",
+          [=] {
+              auto& renderer = game->getRenderer();
+              renderer.setOcclusionCulling(!renderer.getOcclusionCulling());
+          }},
+         {"Toggle Animation LOD",
+          [=] {
+              auto world = game->getWorld();
+              world->animationLOD = !world->animationLOD;
+          }},
+         {"Toggle Script Profiler",
+          [=] {
+              if (auto vm = game->getScriptVM()) {
+                  vm->setProfiling(vm->getProfiler() == nullptr);
+              }
+          }},
+         {"Export Script Profile", [=] { exportScriptProfile(); }}},
         kDebugFont, kDebugEntryHeight);
 
     menu->offset = kDebugMenuOffset;
@@ -363,6 +397,21 @@ void DebugState::tick(float dt) {
     }
 }
 
+void DebugState::exportScriptProfile() {
+    auto vm = game->getScriptVM();
+    auto profiler = vm ? vm->getProfiler() : nullptr;
+    if (!profiler) {
+        return;
+    }
+
+    std::ofstream csv("script_profile.csv");
+    profiler->writeCSV(csv);
+    std::ofstream folded("script_profile.folded");
+    profiler->writeFolded(folded);
+    getWorld()->logger->info(
+        "Script", "Wrote script_profile.csv and script_profile.folded");
+}
+
 void DebugState::draw(GameRenderer* r) {
     // Draw useful information like camera position.
     std::stringstream ss;
@@ -370,6 +419,22 @@ void DebugState::draw(GameRenderer* r) {
     auto zone = getWorld()->data->findZoneAt(_debugCam.position);
     ss << (zone ? zone->name : "No Zone") << "\n";
 
+    const auto& raycasts = getWorld()->raycasts->getStats();
+    ss << "Raycasts: " << raycasts.cast << " cast, " << raycasts.cached
+       << " cached"
+       << (getWorld()->raycasts->isOverBudget() ? " (over budget)" : "")
+       << "\n";
+
+    auto vm = game->getScriptVM();
+    if (vm && vm->getProfiler()) {
+        auto profiler = vm->getProfiler();
+        ss << "Script: " << profiler->getInstructionCount()
+           << " instructions, " << toMS(profiler->getTotalTime()) << "ms\n";
+        printProfileEntries(ss, "Threads", profiler->getThreads());
+        printProfileEntries(ss, "Blocks", profiler->getBlocks());
+        printProfileEntries(ss, "Opcodes", profiler->getOpcodes());
+    }
+
     TextRenderer::TextInfo ti;
     ti.text = GameStringUtil::fromString(ss.str());
     ti.font = 2;
@@ -39,6 +39,9 @@ public:
     void spawnFollower(unsigned int id);
     void giveItem(int slot);
 
+    /// Writes the script profile as CSV and folded stacks
+    void exportScriptProfile();
+
     const ViewCamera& getCamera(float) override;
 };
 
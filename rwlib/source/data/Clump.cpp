@@ -6,6 +6,43 @@
 #include <queue>
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+CompactGeometryVertex::CompactGeometryVertex(const GeometryVertex& vertex,
+                                             const glm::vec3& offset,
+                                             const glm::vec3& scale)
+    : position(glm::round(
+          glm::clamp((vertex.position - offset) / scale, -1.f, 1.f) *
+          32767.f))
+    , normal(glm::packSnorm3x10_1x2(glm::vec4(vertex.normal, 0.f)))
+    , texcoord(glm::packHalf1x16(vertex.texcoord.x),
+               glm::packHalf1x16(vertex.texcoord.y))
+    , colour(vertex.colour) {
+}
+
+std::vector<CompactGeometryVertex> CompactGeometryVertex::compact(
+    const std::vector<GeometryVertex>& vertices, glm::vec3& offset,
+    glm::vec3& scale) {
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+    for (const auto& vertex : vertices) {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+    if (vertices.empty()) {
+        min = max = glm::vec3(0.f);
+    }
+    offset = (min + max) * 0.5f;
+    // Flat axes still need a non-zero scale to divide by
+    scale = glm::max((max - min) * 0.5f, glm::vec3(1e-6f));
+
+    std::vector<CompactGeometryVertex> compacted;
+    compacted.reserve(vertices.size());
+    for (const auto& vertex : vertices) {
+        compacted.emplace_back(vertex, offset, scale);
+    }
+    return compacted;
+}
 
 Geometry::Geometry() : EBO(0), flags(0) {
 }
@@ -9,6 +9,7 @@
 
 #include <gl/gl_core_3_3.h>
 #include <gl/DrawBuffer.hpp>
+#include <gl/GeometryArena.hpp>
 #include <gl/GeometryBuffer.hpp>
 #include <gl/TextureData.hpp>
 #include <loaders/RWBinaryStream.hpp>
@@ -109,6 +110,7 @@ public:
 struct SubGeometry {
     GLuint start = 0;
     size_t material = 0;
+    /// Only held until the geometry is uploaded
     std::vector<uint32_t> indices;
     size_t numIndices = 0;
 };
@@ -138,6 +140,51 @@ struct GeometryVertex {
     GeometryVertex() = default;
 };
 
+/**
+ * Compact alternative to GeometryVertex, 20 bytes instead of 36.
+ *
+ * Positions are 16 bit normalized offsets within the geometry's bounding box
+ * and are decoded by the shader using Geometry::positionOffset and
+ * positionScale. Normals are packed as 10:10:10:2 and texture coordinates as
+ * half floats.
+ */
+struct CompactGeometryVertex {
+    glm::i16vec3 position{}; /* 0 */
+    int16_t padding = 0;     /* 6 */
+    uint32_t normal = 0;     /* 8 */
+    glm::u16vec2 texcoord{}; /* 12 */
+    glm::u8vec4 colour{};    /* 16 */
+
+    /** @see GeometryBuffer */
+    static const AttributeList vertex_attributes() {
+        return {{ATRS_Position, 3, sizeof(CompactGeometryVertex), 0ul,
+                 GL_SHORT},
+                {ATRS_Normal, 4, sizeof(CompactGeometryVertex), 8ul,
+                 GL_INT_2_10_10_10_REV},
+                {ATRS_TexCoord, 2, sizeof(CompactGeometryVertex), 12ul,
+                 GL_HALF_FLOAT},
+                {ATRS_Colour, 4, sizeof(CompactGeometryVertex), 16ul,
+                 GL_UNSIGNED_BYTE}};
+    }
+
+    /**
+     * Packs vertex, quantizing its position to the box offset +/- scale
+     */
+    CompactGeometryVertex(const GeometryVertex& vertex,
+                          const glm::vec3& offset, const glm::vec3& scale);
+
+    CompactGeometryVertex() = default;
+
+    /**
+     * Packs vertices into the compact layout
+     * @param offset receives the centre of the box positions are relative to
+     * @param scale receives the half extents of the box
+     */
+    static std::vector<CompactGeometryVertex> compact(
+        const std::vector<GeometryVertex>& vertices, glm::vec3& offset,
+        glm::vec3& scale);
+};
+
 /**
  * Geometry
  */
@@ -174,6 +221,13 @@ struct Geometry {
 
     GLuint EBO;
 
+    /// Set instead of the buffers above when stored in a GeometryArena
+    GeometryArena::Allocation allocation;
+
+    /// Decodes positions: offset + stored position * scale
+    glm::vec3 positionOffset{0.f};
+    glm::vec3 positionScale{1.f};
+
     RW::BSGeometryBounds geometryBounds;
 
     uint32_t clumpNum;
@@ -187,6 +241,20 @@ struct Geometry {
 
     Geometry();
     ~Geometry();
+
+    DrawBuffer* getDrawBuffer() {
+        return allocation ? allocation.getDrawBuffer() : &dbuff;
+    }
+
+    /// Offset added to every index when drawing
+    GLint getBaseVertex() const {
+        return allocation.getBaseVertex();
+    }
+
+    /// Added to each SubGeometry's start when drawing
+    GLuint getFirstIndex() const {
+        return allocation.getFirstIndex();
+    }
 };
 
 /**
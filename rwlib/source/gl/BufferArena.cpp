@@ -0,0 +1,68 @@
+#include "gl/BufferArena.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "rw/defines.hpp"
+
+constexpr size_t BufferArena::kInvalidOffset;
+
+BufferArena::BufferArena(size_t capacity) : capacity(capacity) {
+    if (capacity > 0) {
+        freeRanges.emplace(0, capacity);
+    }
+}
+
+size_t BufferArena::allocate(size_t size) {
+    if (size == 0) {
+        return kInvalidOffset;
+    }
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+        if (it->second < size) {
+            continue;
+        }
+        auto offset = it->first;
+        auto remaining = it->second - size;
+        freeRanges.erase(it);
+        if (remaining > 0) {
+            freeRanges.emplace(offset + size, remaining);
+        }
+        used += size;
+        return offset;
+    }
+    return kInvalidOffset;
+}
+
+void BufferArena::free(size_t offset, size_t size) {
+    RW_CHECK(offset + size <= capacity, "Freed range is outside the arena");
+    RW_CHECK(size <= used, "Freed more than was allocated");
+    if (size == 0) {
+        return;
+    }
+    used -= size;
+
+    auto next = freeRanges.lower_bound(offset);
+    if (next != freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+    if (next != freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+    freeRanges.emplace_hint(next, offset, size);
+}
+
+BufferArena::Stats BufferArena::getStats() const {
+    Stats stats;
+    stats.capacity = capacity;
+    stats.used = used;
+    stats.freeRanges = freeRanges.size();
+    for (const auto& range : freeRanges) {
+        stats.largestFree = std::max(stats.largestFree, range.second);
+    }
+    return stats;
+}
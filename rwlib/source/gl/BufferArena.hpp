@@ -0,0 +1,62 @@
+#ifndef _LIBRW_BUFFERARENA_HPP_
+#define _LIBRW_BUFFERARENA_HPP_
+#include <cstddef>
+#include <map>
+
+/**
+ * Sub-allocates ranges of a fixed size buffer
+ *
+ * Only the bookkeeping is done here, sizes and offsets are in whatever unit
+ * the owner chooses (e.g. vertices or indices). Free ranges are kept sorted
+ * by offset: allocation takes the first range that fits and freed ranges are
+ * merged with their neighbours.
+ */
+class BufferArena {
+public:
+    static constexpr size_t kInvalidOffset = static_cast<size_t>(-1);
+
+    struct Stats {
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t freeRanges = 0;
+        size_t largestFree = 0;
+
+        /**
+         * 0 when all of the free space is in one range, approaching 1 as it
+         * is split into smaller pieces.
+         */
+        float fragmentation() const {
+            size_t free = capacity - used;
+            return free == 0 ? 0.f : 1.f - float(largestFree) / float(free);
+        }
+    };
+
+    explicit BufferArena(size_t capacity);
+
+    /**
+     * @return the offset of the range, or kInvalidOffset if no free range is
+     * large enough
+     */
+    size_t allocate(size_t size);
+
+    /// Returns a range given by allocate()
+    void free(size_t offset, size_t size);
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    size_t getUsed() const {
+        return used;
+    }
+
+    Stats getStats() const;
+
+private:
+    size_t capacity;
+    size_t used = 0;
+    /// Offset => size of each free range
+    std::map<size_t, size_t> freeRanges;
+};
+
+#endif
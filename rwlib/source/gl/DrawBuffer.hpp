@@ -1,5 +1,7 @@
 #ifndef _LIBRW_DRAWBUFFER_HPP_
 #define _LIBRW_DRAWBUFFER_HPP_
+#include <cstddef>
+
 #include <gl/gl_core_3_3.h>
 
 class GeometryBuffer;
@@ -12,6 +14,8 @@ class DrawBuffer {
 
     GLenum facetype;
 
+    GLenum indextype = GL_UNSIGNED_INT;
+
 public:
     DrawBuffer();
     ~DrawBuffer();
@@ -28,6 +32,22 @@ public:
         return facetype;
     }
 
+    /**
+     * Sets the type of the element array, GL_UNSIGNED_INT by default
+     */
+    void setIndexType(GLenum it) {
+        indextype = it;
+    }
+
+    GLenum getIndexType() const {
+        return indextype;
+    }
+
+    size_t getIndexSize() const {
+        return indextype == GL_UNSIGNED_SHORT ? sizeof(GLushort)
+                                              : sizeof(GLuint);
+    }
+
     /**
      * Adds a Geometry Buffer to the Draw Buffer.
      */
@@ -0,0 +1,177 @@
+#include "gl/GeometryArena.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "rw/defines.hpp"
+
+constexpr size_t GeometryArena::kPageVertices;
+constexpr size_t GeometryArena::kPageIndices;
+
+namespace {
+size_t indexSize(GLenum indexType) {
+    return indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort)
+                                          : sizeof(GLuint);
+}
+
+bool sameAttributes(const AttributeList& a, const AttributeList& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const AttributeIndex& x, const AttributeIndex& y) {
+                          return x.sem == y.sem && x.size == y.size &&
+                                 x.stride == y.stride &&
+                                 x.offset == y.offset && x.type == y.type;
+                      });
+}
+}  // namespace
+
+struct GeometryArena::Page {
+    GeometryBuffer gbuff;
+    DrawBuffer dbuff;
+    GLuint ebo = 0;
+
+    GLsizei stride;
+    BufferArena vertices;
+    BufferArena indices;
+
+    Page(const AttributeList& attributes, GLsizei stride, GLenum faceType,
+         GLenum indexType, size_t vertexCapacity, size_t indexCapacity)
+        : stride(stride), vertices(vertexCapacity), indices(indexCapacity) {
+        gbuff.uploadVertices(static_cast<GLsizei>(vertexCapacity),
+                             vertexCapacity * stride, nullptr);
+        gbuff.getDataAttributes() = attributes;
+        dbuff.setFaceType(faceType);
+        dbuff.setIndexType(indexType);
+        dbuff.addGeometry(&gbuff);
+
+        // Bound while the VAO is, so the VAO keeps it
+        glGenBuffers(1, &ebo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                     indexCapacity * indexSize(indexType), nullptr,
+                     GL_STATIC_DRAW);
+    }
+
+    ~Page() {
+        glDeleteBuffers(1, &ebo);
+    }
+
+    bool matches(const AttributeList& attributes, GLenum faceType,
+                 GLenum indexType) const {
+        return dbuff.getFaceType() == faceType &&
+               dbuff.getIndexType() == indexType &&
+               sameAttributes(gbuff.getDataAttributes(), attributes);
+    }
+};
+
+GeometryArena::Allocation::Allocation(Allocation&& other)
+    : page(std::move(other.page))
+    , vertexOffset(other.vertexOffset)
+    , vertexCount(other.vertexCount)
+    , indexOffset(other.indexOffset)
+    , indexCount(other.indexCount) {
+    other.page = nullptr;
+}
+
+GeometryArena::Allocation& GeometryArena::Allocation::operator=(
+    Allocation&& other) {
+    if (this != &other) {
+        release();
+        page = std::move(other.page);
+        other.page = nullptr;
+        vertexOffset = other.vertexOffset;
+        vertexCount = other.vertexCount;
+        indexOffset = other.indexOffset;
+        indexCount = other.indexCount;
+    }
+    return *this;
+}
+
+GeometryArena::Allocation::~Allocation() {
+    release();
+}
+
+void GeometryArena::Allocation::release() {
+    if (page) {
+        page->vertices.free(vertexOffset, vertexCount);
+        page->indices.free(indexOffset, indexCount);
+        page = nullptr;
+    }
+}
+
+DrawBuffer* GeometryArena::Allocation::getDrawBuffer() const {
+    return page ? &page->dbuff : nullptr;
+}
+
+GeometryArena::Allocation GeometryArena::allocate(
+    const AttributeList& attributes, GLsizei stride, const GLvoid* vertices,
+    size_t vertexCount, GLenum faceType, GLenum indexType,
+    const GLvoid* indices, size_t indexCount) {
+    Allocation allocation;
+    if (vertexCount == 0 || indexCount == 0) {
+        return allocation;
+    }
+
+    for (const auto& page : pages) {
+        if (!page->matches(attributes, faceType, indexType)) {
+            continue;
+        }
+        auto vertexOffset = page->vertices.allocate(vertexCount);
+        if (vertexOffset == BufferArena::kInvalidOffset) {
+            continue;
+        }
+        auto indexOffset = page->indices.allocate(indexCount);
+        if (indexOffset == BufferArena::kInvalidOffset) {
+            page->vertices.free(vertexOffset, vertexCount);
+            continue;
+        }
+        allocation.page = page;
+        allocation.vertexOffset = vertexOffset;
+        allocation.indexOffset = indexOffset;
+        break;
+    }
+
+    if (!allocation.page) {
+        // Oversized geometry gets a page of its own size
+        auto page = std::make_shared<Page>(
+            attributes, stride, faceType, indexType,
+            std::max(kPageVertices, vertexCount),
+            std::max(kPageIndices, indexCount));
+        allocation.page = page;
+        allocation.vertexOffset = page->vertices.allocate(vertexCount);
+        allocation.indexOffset = page->indices.allocate(indexCount);
+        pages.push_back(std::move(page));
+    }
+    allocation.vertexCount = vertexCount;
+    allocation.indexCount = indexCount;
+
+    auto& page = *allocation.page;
+    page.gbuff.updateVertices(allocation.vertexOffset * stride,
+                              vertexCount * stride, vertices);
+
+    auto size = indexSize(indexType);
+    glBindVertexArray(page.dbuff.getVAOName());
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.ebo);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, allocation.indexOffset * size,
+                    indexCount * size, indices);
+
+    return allocation;
+}
+
+GeometryArena::Stats GeometryArena::getStats() const {
+    Stats stats;
+    stats.pages = pages.size();
+    auto add = [](BufferArena::Stats& total, const BufferArena::Stats& page,
+                  size_t unit) {
+        total.capacity += page.capacity * unit;
+        total.used += page.used * unit;
+        total.freeRanges += page.freeRanges;
+        total.largestFree =
+            std::max(total.largestFree, page.largestFree * unit);
+    };
+    for (const auto& page : pages) {
+        add(stats.vertices, page->vertices.getStats(), page->stride);
+        add(stats.indices, page->indices.getStats(),
+            page->dbuff.getIndexSize());
+    }
+    return stats;
+}
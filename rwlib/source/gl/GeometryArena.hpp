@@ -0,0 +1,106 @@
+#ifndef _LIBRW_GEOMETRYARENA_HPP_
+#define _LIBRW_GEOMETRYARENA_HPP_
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <gl/BufferArena.hpp>
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/gl_core_3_3.h>
+
+/**
+ * Stores many geometries in a few large vertex and index buffers
+ *
+ * Geometries with the same vertex format, face type and index type share a
+ * page: one VBO, EBO and VAO. A geometry's indices are relative to its own
+ * first vertex, draws add the allocation's base vertex and first index.
+ * Ranges are returned to their page when the Allocation is destroyed.
+ */
+class GeometryArena {
+    struct Page;
+
+public:
+    static constexpr size_t kPageVertices = 1 << 16;
+    static constexpr size_t kPageIndices = 1 << 18;
+
+    /**
+     * Owns a geometry's ranges of a page, and keeps the page alive
+     */
+    class Allocation {
+    public:
+        Allocation() = default;
+        Allocation(Allocation&& other);
+        Allocation& operator=(Allocation&& other);
+        ~Allocation();
+
+        Allocation(const Allocation&) = delete;
+        Allocation& operator=(const Allocation&) = delete;
+
+        explicit operator bool() const {
+            return page != nullptr;
+        }
+
+        DrawBuffer* getDrawBuffer() const;
+
+        /// Offset added to every index of the geometry
+        GLint getBaseVertex() const {
+            return static_cast<GLint>(vertexOffset);
+        }
+
+        /// Position of the geometry's first index in the page
+        GLuint getFirstIndex() const {
+            return static_cast<GLuint>(indexOffset);
+        }
+
+    private:
+        friend class GeometryArena;
+
+        void release();
+
+        std::shared_ptr<Page> page;
+        size_t vertexOffset = 0;
+        size_t vertexCount = 0;
+        size_t indexOffset = 0;
+        size_t indexCount = 0;
+    };
+
+    /// Totals over every page, in bytes
+    struct Stats {
+        size_t pages = 0;
+        BufferArena::Stats vertices;
+        BufferArena::Stats indices;
+    };
+
+    GeometryArena() = default;
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    /**
+     * Copies vertices and indices into a page, creating one if none of the
+     * matching pages has room.
+     *
+     * vertex_attributes() is assumed to exist, as for GeometryBuffer.
+     */
+    template <class T>
+    Allocation allocate(const std::vector<T>& vertices, GLenum faceType,
+                        GLenum indexType, const GLvoid* indices,
+                        size_t indexCount) {
+        return allocate(T::vertex_attributes(), sizeof(T), vertices.data(),
+                        vertices.size(), faceType, indexType, indices,
+                        indexCount);
+    }
+
+    Allocation allocate(const AttributeList& attributes, GLsizei stride,
+                        const GLvoid* vertices, size_t vertexCount,
+                        GLenum faceType, GLenum indexType,
+                        const GLvoid* indices, size_t indexCount);
+
+    Stats getStats() const;
+
+private:
+    std::vector<std::shared_ptr<Page>> pages;
+};
+
+#endif
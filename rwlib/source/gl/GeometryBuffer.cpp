@@ -18,3 +18,9 @@ void GeometryBuffer::uploadVertices(GLsizei num, GLsizeiptr size,
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, size, mem, GL_STATIC_DRAW);
 }
+
+void GeometryBuffer::updateVertices(GLintptr offset, GLsizeiptr size,
+                                    const GLvoid* mem) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, mem);
+}
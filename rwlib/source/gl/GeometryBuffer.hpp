@@ -75,6 +75,11 @@ public:
      */
     void uploadVertices(GLsizei num, GLsizeiptr size, const GLvoid* mem);
 
+    /**
+     * Replaces part of the buffer's contents, without resizing it.
+     */
+    void updateVertices(GLintptr offset, GLsizeiptr size, const GLvoid* mem);
+
     const AttributeList& getDataAttributes() const {
         return attributes;
     }
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstring>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -144,6 +145,56 @@ LoaderDFF::GeometryList LoaderDFF::readGeometryList(const RWBStream &stream) {
     return geometrylist;
 }
 
+namespace {
+template <class Vertex, class Index>
+void uploadBuffers(Geometry &geom, GeometryArena *arena,
+                   const std::vector<Vertex> &vertices,
+                   const std::vector<Index> &indices, GLenum indexType) {
+    GLenum faceType = geom.facetype == Geometry::Triangles ? GL_TRIANGLES
+                                                           : GL_TRIANGLE_STRIP;
+    if (arena) {
+        geom.allocation = arena->allocate(vertices, faceType, indexType,
+                                          indices.data(), indices.size());
+        if (geom.allocation) {
+            return;
+        }
+    }
+
+    geom.dbuff.setFaceType(faceType);
+    geom.dbuff.setIndexType(indexType);
+    geom.gbuff.uploadVertices(vertices);
+    geom.dbuff.addGeometry(&geom.gbuff);
+
+    glGenBuffers(1, &geom.EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(Index) * indices.size(),
+                 indices.data(), GL_STATIC_DRAW);
+}
+
+template <class Index>
+void uploadGeometry(Geometry &geom, GeometryArena *arena, bool compact,
+                    const std::vector<GeometryVertex> &vertices,
+                    GLenum indexType) {
+    size_t icount = std::accumulate(
+        geom.subgeom.begin(), geom.subgeom.end(), 0u,
+        [](size_t a, const SubGeometry &b) { return a + b.numIndices; });
+    std::vector<Index> indices(icount);
+    for (const auto &sg : geom.subgeom) {
+        std::copy(sg.indices.begin(), sg.indices.end(),
+                  indices.begin() + sg.start);
+    }
+
+    if (compact) {
+        uploadBuffers(geom, arena,
+                      CompactGeometryVertex::compact(
+                          vertices, geom.positionOffset, geom.positionScale),
+                      indices, indexType);
+    } else {
+        uploadBuffers(geom, arena, vertices, indices, indexType);
+    }
+}
+}  // namespace
+
 GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
     auto geomStream = stream.getInnerStream();
 
@@ -248,23 +299,19 @@ GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
         }
     }
 
-    geom->dbuff.setFaceType(geom->facetype == Geometry::Triangles
-                                ? GL_TRIANGLES
-                                : GL_TRIANGLE_STRIP);
-    geom->gbuff.uploadVertices(verts);
-    geom->dbuff.addGeometry(&geom->gbuff);
-
-    glGenBuffers(1, &geom->EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom->EBO);
+    // Every index of a small enough mesh fits in 16 bits
+    if (numVerts <= std::numeric_limits<std::uint16_t>::max() + 1u) {
+        uploadGeometry<std::uint16_t>(*geom, geometryArena, compactVertices,
+                                      verts, GL_UNSIGNED_SHORT);
+    } else {
+        uploadGeometry<std::uint32_t>(*geom, geometryArena, compactVertices,
+                                      verts, GL_UNSIGNED_INT);
+    }
 
-    size_t icount = std::accumulate(
-        geom->subgeom.begin(), geom->subgeom.end(), 0u,
-        [](size_t a, const SubGeometry &b) { return a + b.numIndices; });
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * icount, nullptr,
-                 GL_STATIC_DRAW);
+    // The GPU copy is all that is drawn from
     for (auto &sg : geom->subgeom) {
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sg.start * sizeof(uint32_t),
-                        sizeof(uint32_t) * sg.numIndices, sg.indices.data());
+        sg.indices.clear();
+        sg.indices.shrink_to_fit();
     }
 
     return geom;
@@ -37,8 +37,29 @@ public:
         texturelookup = tlc;
     }
 
+    /**
+     * Uploads vertices using CompactGeometryVertex instead of GeometryVertex
+     */
+    void setCompactVertices(bool compact) {
+        compactVertices = compact;
+    }
+
+    bool getCompactVertices() const {
+        return compactVertices;
+    }
+
+    /**
+     * Stores geometry in arena instead of in buffers of its own, the arena
+     * must outlive the loader. nullptr gives each geometry its own buffers.
+     */
+    void setGeometryArena(GeometryArena* arena) {
+        geometryArena = arena;
+    }
+
 private:
     TextureLookupCallback texturelookup;
+    bool compactVertices = false;
+    GeometryArena* geometryArena = nullptr;
 
     FrameList readFrameList(const RWBStream& stream);
 
@@ -9,6 +9,7 @@
 
 #include "gl/gl_core_3_3.h"
 #include "loaders/RWBinaryStream.hpp"
+#include "loaders/TextureDecoder.hpp"
 #include "platform/FileHandle.hpp"
 #include "rw/defines.hpp"
 
@@ -37,7 +38,14 @@ TextureData::Handle getErrorTexture() {
 const size_t paletteSize = 1024;
 
 static
-void processPalette(uint32_t* fullColor, RW::BinaryStreamSection& rootSection) {
+const TextureDecoder& getDecoder() {
+    static TextureDecoder decoder;
+    return decoder;
+}
+
+static
+void processPalette(uint32_t* fullColor, size_t pixels,
+                    RW::BinaryStreamSection& rootSection) {
     uint8_t* dataBase = reinterpret_cast<uint8_t*>(
         rootSection.raw() + sizeof(RW::BSSectionHeader) +
         sizeof(RW::BSTextureNative) - 4);
@@ -46,19 +54,35 @@ void processPalette(uint32_t* fullColor, RW::BinaryStreamSection& rootSection) {
     uint32_t raster_size = *reinterpret_cast<uint32_t*>(dataBase + paletteSize);
     uint32_t* palette = reinterpret_cast<uint32_t*>(dataBase);
 
-    for (size_t j = 0; j < raster_size; ++j) {
-        *(fullColor++) = palette[coldata[j]];
+    getDecoder().expandPalette(coldata, palette, fullColor,
+                               std::min<size_t>(raster_size, pixels));
+}
+
+void TextureLoader::generateMips(DecodedTexture& texture) {
+    if (texture.levels.empty()) {
+        return;
+    }
+    texture.levels.resize(1);
+    auto size = texture.size;
+    while (size.x > 1 || size.y > 1) {
+        const glm::ivec2 next(std::max(1, size.x / 2), std::max(1, size.y / 2));
+        std::vector<uint32_t> level(size_t(next.x) * next.y);
+        TextureDecoder::downsample(texture.levels.back().data(), size.x,
+                                   size.y, level.data());
+        texture.levels.push_back(std::move(level));
+        size = next;
     }
 }
 
 static
-TextureData::Handle createTexture(RW::BSTextureNative& texNative,
-                                  RW::BinaryStreamSection& rootSection) {
+bool decodeTexture(RW::BSTextureNative& texNative,
+                   RW::BinaryStreamSection& rootSection,
+                   DecodedTexture& texture) {
     // TODO: Exception handling.
     if (texNative.platform != 8) {
         RW_ERROR("Unsupported texture platform " << std::dec
                   << texNative.platform);
-        return getErrorTexture();
+        return false;
     }
 
     bool isPal8 =
@@ -75,55 +99,73 @@ TextureData::Handle createTexture(RW::BSTextureNative& texNative,
     if (!(isPal8 || isFulc)) {
         RW_ERROR("Unsupported raster format " << std::dec
                   << texNative.rasterformat);
-        return getErrorTexture();
+        return false;
     }
 
-    GLuint textureName = 0;
-
-    if (isPal8) {
-        std::vector<uint32_t> fullColor(texNative.width * texNative.height);
+    texture.size = {texNative.width, texNative.height};
+    texture.transparent = transparent;
+    texture.filterflags = texNative.filterflags;
+    texture.wrapU = texNative.wrapU;
+    texture.wrapV = texNative.wrapV;
 
-        processPalette(fullColor.data(), rootSection);
+    // Everything is converted to RGBA here rather than by the driver
+    const size_t pixels = size_t(texNative.width) * texNative.height;
+    std::vector<uint32_t> fullColor(pixels);
 
-        glGenTextures(1, &textureName);
-        glBindTexture(GL_TEXTURE_2D, textureName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width,
-                     texNative.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                     fullColor.data());
-    } else if (isFulc) {
+    if (isPal8) {
+        processPalette(fullColor.data(), pixels, rootSection);
+    } else {
         auto coldata = rootSection.raw() + sizeof(RW::BSTextureNative);
         coldata += sizeof(uint32_t);
 
-        GLenum type = GL_UNSIGNED_BYTE, format = GL_RGBA;
         switch (texNative.rasterformat) {
             case RW::BSTextureNative::FORMAT_1555:
-                format = GL_RGBA;
-                type = GL_UNSIGNED_SHORT_1_5_5_5_REV;
+                getDecoder().expand1555(
+                    reinterpret_cast<const uint16_t*>(coldata),
+                    fullColor.data(), pixels);
                 break;
             case RW::BSTextureNative::FORMAT_8888:
-                format = GL_BGRA;
-                // type = GL_UNSIGNED_INT_8_8_8_8_REV;
                 coldata += 8;
-                type = GL_UNSIGNED_BYTE;
+                getDecoder().swizzleBGRA(
+                    reinterpret_cast<const uint32_t*>(coldata),
+                    fullColor.data(), pixels);
                 break;
             case RW::BSTextureNative::FORMAT_888:
-                format = GL_BGRA;
-                type = GL_UNSIGNED_BYTE;
+                getDecoder().swizzleBGRA(
+                    reinterpret_cast<const uint32_t*>(coldata),
+                    fullColor.data(), pixels);
                 break;
             default:
                 break;
         }
+    }
 
-        glGenTextures(1, &textureName);
-        glBindTexture(GL_TEXTURE_2D, textureName);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texNative.width,
-                     texNative.height, 0, format, type, coldata);
-    } else {
+    texture.levels.push_back(std::move(fullColor));
+    TextureLoader::generateMips(texture);
+    return true;
+}
+
+TextureData::Handle TextureLoader::upload(const DecodedTexture& texture) {
+    if (texture.levels.empty()) {
         return getErrorTexture();
     }
 
+    GLuint textureName = 0;
+    glGenTextures(1, &textureName);
+    glBindTexture(GL_TEXTURE_2D, textureName);
+
+    auto size = texture.size;
+    for (size_t level = 0; level < texture.levels.size(); ++level) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, size.x,
+                     size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     texture.levels[level].data());
+        size = glm::max(size / 2, glm::ivec2(1));
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                    static_cast<GLint>(texture.levels.size() - 1));
+
     GLenum texFilter = GL_LINEAR;
-    switch (texNative.filterflags & 0xFF) {
+    switch (texture.filterflags & 0xFF) {
         default:
         case RW::BSTextureNative::FILTER_LINEAR:
             texFilter = GL_LINEAR;
@@ -138,7 +180,7 @@ TextureData::Handle createTexture(RW::BSTextureNative& texNative,
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texFilter);
 
     GLenum texwrap = GL_REPEAT;
-    switch (texNative.wrapU) {
+    switch (texture.wrapU) {
         default:
         case RW::BSTextureNative::WRAP_WRAP:
             texwrap = GL_REPEAT;
@@ -152,7 +194,7 @@ TextureData::Handle createTexture(RW::BSTextureNative& texNative,
     }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texwrap);
 
-    switch (texNative.wrapV) {
+    switch (texture.wrapV) {
         default:
         case RW::BSTextureNative::WRAP_WRAP:
             texwrap = GL_REPEAT;
@@ -166,18 +208,19 @@ TextureData::Handle createTexture(RW::BSTextureNative& texNative,
     }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texwrap);
 
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    return TextureData::create(textureName, {texNative.width, texNative.height},
-                               transparent);
+    return TextureData::create(textureName, texture.size,
+                               texture.transparent);
 }
 
-bool TextureLoader::loadFromMemory(const FileHandle& file,
-                                   TextureArchive& inTextures) {
+/// Calls fn for every texture, returns false if any couldn't be decoded
+template <class F>
+static
+bool forEachTexture(const FileHandle& file, F&& fn) {
     auto data = file->data;
     RW::BinaryStreamSection root(data);
     /*auto texDict =*/root.readStructure<RW::BSTextureDictionary>();
 
+    bool decoded = true;
     size_t rootI = 0;
     while (root.hasMoreData(rootI)) {
         auto rootSection = root.getNextChildSection(rootI);
@@ -186,15 +229,31 @@ bool TextureLoader::loadFromMemory(const FileHandle& file,
 
         RW::BSTextureNative texNative =
             rootSection.readStructure<RW::BSTextureNative>();
-        std::string name = std::string(texNative.diffuseName);
-        std::string alpha = std::string(texNative.alphaName);
-        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-        std::transform(alpha.begin(), alpha.end(), alpha.begin(), ::tolower);
 
-        auto texture = createTexture(texNative, rootSection);
+        DecodedTexture texture;
+        texture.name = std::string(texNative.diffuseName);
+        std::transform(texture.name.begin(), texture.name.end(),
+                       texture.name.begin(), ::tolower);
+        decoded &= decodeTexture(texNative, rootSection, texture);
 
-        inTextures[name] = texture;
+        fn(std::move(texture));
     }
+    return decoded;
+}
+
+bool TextureLoader::loadFromMemory(const FileHandle& file,
+                                   TextureArchive& inTextures) {
+    // Upload each texture as it's decoded, so only one is held at a time
+    forEachTexture(file, [&](DecodedTexture&& texture) {
+        inTextures[texture.name] = upload(texture);
+    });
 
     return true;
 }
+
+bool TextureLoader::decodeFromMemory(const FileHandle& file,
+                                     std::vector<DecodedTexture>& textures) {
+    return forEachTexture(file, [&](DecodedTexture&& texture) {
+        textures.push_back(std::move(texture));
+    });
+}
@@ -1,12 +1,42 @@
 #ifndef _LIBRW_TEXTURELOADER_HPP_
 #define _LIBRW_TEXTURELOADER_HPP_
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include <gl/TextureData.hpp>
 #include <rw/forward.hpp>
 
+/**
+ * A texture converted to RGBA with its mip levels, ready to upload
+ */
+struct DecodedTexture {
+    std::string name;
+    glm::ivec2 size{};
+    bool transparent = false;
+    uint16_t filterflags = 0;
+    uint8_t wrapU = 0;
+    uint8_t wrapV = 0;
+    /// Pixels of each level, largest first. Empty if it couldn't be decoded
+    std::vector<std::vector<uint32_t>> levels;
+};
+
 class TextureLoader {
 public:
     bool loadFromMemory(const FileHandle& file, TextureArchive& inTextures);
+
+    /// Decodes every texture in a TXD, without needing a GL context.
+    /// Returns false if any texture couldn't be decoded, it is still added
+    /// without any levels
+    bool decodeFromMemory(const FileHandle& file,
+                          std::vector<DecodedTexture>& textures);
+
+    /// Builds every mip level below the first
+    static void generateMips(DecodedTexture& texture);
+
+    /// Creates a GL texture, or returns the error texture if it has no pixels
+    static TextureData::Handle upload(const DecodedTexture& texture);
 };
 
 #endif
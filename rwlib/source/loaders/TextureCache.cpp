@@ -0,0 +1,398 @@
+#include "loaders/TextureCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "platform/FileHandle.hpp"
+#include "rw/defines.hpp"
+
+constexpr uint32_t TextureCache::kVersion;
+constexpr uint64_t TextureCache::kDefaultSizeLimit;
+
+namespace {
+constexpr uint32_t kCacheMagic = 0x43545752;     // "RWTC"
+constexpr uint32_t kManifestMagic = 0x4D545752;  // "RWTM"
+constexpr char kExtension[] = ".rwtc";
+constexpr char kManifestName[] = "manifest";
+/// Levels start on this boundary, so they can be used from a mapping
+constexpr size_t kAlignment = 16;
+constexpr size_t kNameLength = 32;
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t offset;
+    uint32_t textureCount;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+};
+static_assert(sizeof(CacheHeader) == 32, "CacheHeader has padding");
+
+struct CacheTexture {
+    char name[kNameLength];
+    uint16_t width;
+    uint16_t height;
+    uint16_t filterflags;
+    uint8_t wrapU;
+    uint8_t wrapV;
+    uint8_t transparent;
+    uint8_t levelCount;
+    uint8_t padding[6];
+    /// Where the first level starts, each one after is aligned again
+    uint64_t dataOffset;
+};
+static_assert(sizeof(CacheTexture) == 56, "CacheTexture has padding");
+
+size_t align(size_t offset) {
+    return (offset + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+size_t levelPixels(const glm::ivec2& size, size_t level) {
+    return size_t(std::max(1, size.x >> level)) *
+           size_t(std::max(1, size.y >> level));
+}
+
+bool sameTextures(const std::vector<DecodedTexture>& a,
+                  const std::vector<DecodedTexture>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const DecodedTexture& x, const DecodedTexture& y) {
+                          return x.name == y.name && x.size == y.size &&
+                                 x.transparent == y.transparent &&
+                                 x.filterflags == y.filterflags &&
+                                 x.wrapU == y.wrapU && x.wrapV == y.wrapV &&
+                                 x.levels == y.levels;
+                      });
+}
+
+template <class T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool readValue(std::istream& in, T& value) {
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}  // namespace
+
+TextureCache::TextureCache(const rwfs::path& directory, uint64_t sizeLimit)
+    : directory(directory), sizeLimit(sizeLimit) {
+    rwfs::error_code ec;
+    rwfs::create_directories(directory, ec);
+
+    for (const auto& file : rwfs::directory_iterator(directory, ec)) {
+        const auto& path = file.path();
+        if (path.extension().string() != kExtension) {
+            continue;
+        }
+        const auto size = uint64_t(rwfs::file_size(path, ec));
+        if (ec) {
+            continue;
+        }
+        entries[path.filename().string()] = {size, 0};
+        totalSize += size;
+    }
+
+    loadManifest();
+    // The limit may be lower than last time
+    evict();
+}
+
+TextureCache::~TextureCache() {
+    saveManifest();
+}
+
+TextureCache::Key TextureCache::makeKey(const FileHandle& file,
+                                        uint32_t offset) {
+    // FNV-1a a word at a time, folding the high bits of each step down
+    constexpr uint64_t kPrime = 0x100000001b3ull;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const size_t length = file->length;
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, file->data + i, sizeof(word));
+        hash = (hash ^ word) * kPrime;
+        hash ^= hash >> 29;
+    }
+    for (; i < length; ++i) {
+        hash = (hash ^ uint8_t(file->data[i])) * kPrime;
+    }
+
+    return {offset, uint64_t(length), hash};
+}
+
+std::string TextureCache::getFileName(const Key& key) {
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(8) << key.offset << "-"
+       << std::setw(16) << key.size << "-" << std::setw(16) << key.hash
+       << kExtension;
+    return ss.str();
+}
+
+bool TextureCache::decode(const FileHandle& file, uint32_t offset,
+                          std::vector<DecodedTexture>& textures) {
+    const auto key = makeKey(file, offset);
+
+    if (load(key, textures)) {
+        stats.hits++;
+        if (!validate) {
+            return true;
+        }
+
+        std::vector<DecodedTexture> decoded;
+        const bool complete = loader.decodeFromMemory(file, decoded);
+        if (sameTextures(textures, decoded)) {
+            return true;
+        }
+        RW_ERROR("Cached textures for " << getFileName(key)
+                                        << " differ from the source");
+        stats.invalid++;
+        textures = std::move(decoded);
+        if (complete) {
+            store(key, textures);
+        }
+        return complete;
+    }
+
+    stats.misses++;
+    textures.clear();
+    if (!loader.decodeFromMemory(file, textures)) {
+        return false;
+    }
+    store(key, textures);
+    return true;
+}
+
+bool TextureCache::load(const Key& key,
+                        std::vector<DecodedTexture>& textures) {
+    const auto name = getFileName(key);
+    auto entry = entries.find(name);
+    if (entry == entries.end()) {
+        return false;
+    }
+
+    std::ifstream in((directory / name).string(),
+                     std::ios_base::binary | std::ios_base::ate);
+    if (!in.is_open()) {
+        return false;
+    }
+    const auto length = size_t(in.tellg());
+    in.seekg(0);
+    std::vector<char> data(length);
+    if (length < sizeof(CacheHeader) || !in.read(data.data(), length)) {
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != kCacheMagic || header.version != kVersion ||
+        header.offset != key.offset || header.sourceSize != key.size ||
+        header.sourceHash != key.hash ||
+        header.textureCount > length / sizeof(CacheTexture)) {
+        return false;
+    }
+    if (sizeof(CacheHeader) + header.textureCount * sizeof(CacheTexture) >
+        length) {
+        return false;
+    }
+
+    std::vector<DecodedTexture> loaded(header.textureCount);
+    for (size_t t = 0; t < loaded.size(); ++t) {
+        CacheTexture row;
+        std::memcpy(&row,
+                    data.data() + sizeof(CacheHeader) + t * sizeof(row),
+                    sizeof(row));
+
+        auto& texture = loaded[t];
+        texture.name.assign(row.name, strnlen(row.name, kNameLength));
+        texture.size = {row.width, row.height};
+        texture.transparent = row.transparent != 0;
+        texture.filterflags = row.filterflags;
+        texture.wrapU = row.wrapU;
+        texture.wrapV = row.wrapV;
+
+        size_t offset = row.dataOffset;
+        for (size_t level = 0; level < row.levelCount; ++level) {
+            const size_t pixels = levelPixels(texture.size, level);
+            const size_t bytes = pixels * sizeof(uint32_t);
+            if (offset > length || bytes > length - offset) {
+                return false;
+            }
+            texture.levels.emplace_back(pixels);
+            std::memcpy(texture.levels.back().data(), data.data() + offset,
+                        bytes);
+            offset = align(offset + bytes);
+        }
+
+        if (texture.levels.size() == 1) {
+            TextureLoader::generateMips(texture);
+        }
+    }
+
+    textures = std::move(loaded);
+    entry->second.lastUse = ++useClock;
+    return true;
+}
+
+bool TextureCache::store(const Key& key,
+                         const std::vector<DecodedTexture>& textures) {
+    // Lay out the table first, the levels follow it in order
+    std::vector<CacheTexture> table(textures.size());
+    size_t end = align(sizeof(CacheHeader) +
+                       textures.size() * sizeof(CacheTexture));
+    for (size_t t = 0; t < textures.size(); ++t) {
+        const auto& texture = textures[t];
+        auto& row = table[t];
+        std::memcpy(row.name, texture.name.data(),
+                    std::min(texture.name.size(), kNameLength));
+        row.width = uint16_t(texture.size.x);
+        row.height = uint16_t(texture.size.y);
+        row.filterflags = texture.filterflags;
+        row.wrapU = texture.wrapU;
+        row.wrapV = texture.wrapV;
+        row.transparent = texture.transparent ? 1 : 0;
+        row.levelCount = uint8_t(
+            storeMips ? texture.levels.size()
+                      : std::min<size_t>(texture.levels.size(), 1));
+        row.dataOffset = end;
+        for (size_t level = 0; level < row.levelCount; ++level) {
+            end = align(end + texture.levels[level].size() * sizeof(uint32_t));
+        }
+    }
+
+    // Write to a temporary file, so a failed write never leaves an entry
+    // that looks valid
+    const auto name = getFileName(key);
+    const auto path = directory / name;
+    const auto temp = rwfs::path(path.string() + ".tmp");
+    {
+        std::ofstream out(temp.string(),
+                          std::ios_base::binary | std::ios_base::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        const CacheHeader header{kCacheMagic, kVersion,
+                                 key.offset, uint32_t(textures.size()),
+                                 key.size,   key.hash};
+        writeValue(out, header);
+        out.write(reinterpret_cast<const char*>(table.data()),
+                  std::streamsize(table.size() * sizeof(CacheTexture)));
+
+        size_t written =
+            sizeof(CacheHeader) + table.size() * sizeof(CacheTexture);
+        auto padTo = [&](size_t offset) {
+            static const char zeros[kAlignment] = {};
+            out.write(zeros, std::streamsize(offset - written));
+            written = offset;
+        };
+        for (size_t t = 0; t < textures.size(); ++t) {
+            for (size_t level = 0; level < table[t].levelCount; ++level) {
+                const auto& pixels = textures[t].levels[level];
+                padTo(align(written));
+                out.write(reinterpret_cast<const char*>(pixels.data()),
+                          std::streamsize(pixels.size() * sizeof(uint32_t)));
+                written += pixels.size() * sizeof(uint32_t);
+            }
+        }
+        padTo(end);
+
+        if (!out) {
+            out.close();
+            rwfs::error_code ec;
+            rwfs::remove(temp, ec);
+            return false;
+        }
+    }
+
+    rwfs::error_code ec;
+    rwfs::rename(temp, path, ec);
+    if (ec) {
+        rwfs::remove(temp, ec);
+        return false;
+    }
+
+    auto& entry = entries[name];
+    totalSize = totalSize - entry.size + end;
+    entry = {uint64_t(end), ++useClock};
+    evict();
+    return true;
+}
+
+void TextureCache::evict() {
+    if (totalSize <= sizeLimit) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> byUse;
+    byUse.reserve(entries.size());
+    for (const auto& entry : entries) {
+        byUse.emplace_back(entry.second.lastUse, entry.first);
+    }
+    std::sort(byUse.begin(), byUse.end());
+
+    rwfs::error_code ec;
+    for (const auto& use : byUse) {
+        if (totalSize <= sizeLimit) {
+            break;
+        }
+        rwfs::remove(directory / use.second, ec);
+        totalSize -= entries[use.second].size;
+        entries.erase(use.second);
+        stats.evictions++;
+    }
+}
+
+void TextureCache::loadManifest() {
+    std::ifstream in((directory / kManifestName).string(),
+                     std::ios_base::binary);
+    uint32_t magic, version, count;
+    uint64_t clock;
+    if (!readValue(in, magic) || !readValue(in, version) ||
+        magic != kManifestMagic || version != kVersion ||
+        !readValue(in, clock) || !readValue(in, count)) {
+        return;
+    }
+    useClock = clock;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t nameLength;
+        uint64_t lastUse;
+        if (!readValue(in, nameLength) || nameLength > 256) {
+            return;
+        }
+        std::string name(nameLength, '\0');
+        if (!in.read(&name[0], nameLength) || !readValue(in, lastUse)) {
+            return;
+        }
+        // Entries removed by hand are simply forgotten
+        auto entry = entries.find(name);
+        if (entry != entries.end()) {
+            entry->second.lastUse = lastUse;
+        }
+    }
+}
+
+void TextureCache::saveManifest() const {
+    std::ofstream out((directory / kManifestName).string(),
+                      std::ios_base::binary | std::ios_base::trunc);
+    if (!out.is_open()) {
+        return;
+    }
+
+    writeValue(out, kManifestMagic);
+    writeValue(out, kVersion);
+    writeValue(out, useClock);
+    writeValue(out, uint32_t(entries.size()));
+    for (const auto& entry : entries) {
+        writeValue(out, uint32_t(entry.first.size()));
+        out.write(entry.first.data(), std::streamsize(entry.first.size()));
+        writeValue(out, entry.second.lastUse);
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef _LIBRW_TEXTURECACHE_HPP_
+#define _LIBRW_TEXTURECACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <loaders/LoaderTXD.hpp>
+#include <rw/filesystem.hpp>
+#include <rw/forward.hpp>
+
+/**
+ * @brief Decoded textures of each TXD, kept on disk between sessions
+ *
+ * Each TXD is stored in its own file, named after the source's offset in
+ * its archive, size and hash. A file is a header, a table of textures and
+ * then their pixels, each level 16 byte aligned so the file can be mapped
+ * and uploaded from directly. When the directory grows past the size
+ * limit, the least recently used files are removed. Use times are kept in
+ * a manifest, written when the cache is destroyed.
+ *
+ * Not thread safe.
+ */
+class TextureCache {
+public:
+    static constexpr uint32_t kVersion = 1;
+    /// Largest the cache directory grows to by default, 512MB
+    static constexpr uint64_t kDefaultSizeLimit = uint64_t(512) << 20;
+
+    /// Identifies the TXD some textures were decoded from
+    struct Key {
+        /// Sector offset in its archive, 0 for loose files
+        uint32_t offset;
+        uint64_t size;
+        uint64_t hash;
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        /// Entries that didn't match the source when validating
+        size_t invalid = 0;
+        size_t evictions = 0;
+    };
+
+    explicit TextureCache(const rwfs::path& directory,
+                          uint64_t sizeLimit = kDefaultSizeLimit);
+    ~TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    static Key makeKey(const FileHandle& file, uint32_t offset);
+
+    /// When off, only the first level is stored and the rest are rebuilt
+    /// on load, which makes entries a quarter smaller
+    void setStoreMips(bool store) {
+        storeMips = store;
+    }
+
+    /// When on, every hit is also decoded from the source and compared,
+    /// and entries that differ are replaced
+    void setValidate(bool enable) {
+        validate = enable;
+    }
+
+    /**
+     * Decodes the textures in a TXD, from the cache if they are there and
+     * storing them otherwise. TXDs that don't fully decode aren't stored.
+     * @param offset the TXD's sector offset in its archive
+     * @return false if any texture couldn't be decoded
+     */
+    bool decode(const FileHandle& file, uint32_t offset,
+                std::vector<DecodedTexture>& textures);
+
+    /// Reads an entry, false if there is none or it can't be read
+    bool load(const Key& key, std::vector<DecodedTexture>& textures);
+
+    /// Writes an entry, then evicts entries until the cache fits its limit
+    bool store(const Key& key, const std::vector<DecodedTexture>& textures);
+
+    uint64_t getSize() const {
+        return totalSize;
+    }
+
+    size_t getEntryCount() const {
+        return entries.size();
+    }
+
+    bool contains(const Key& key) const {
+        return entries.count(getFileName(key)) != 0;
+    }
+
+    const Stats& getStats() const {
+        return stats;
+    }
+
+    static std::string getFileName(const Key& key);
+
+private:
+    struct Entry {
+        uint64_t size;
+        /// Value of useClock when last loaded or stored
+        uint64_t lastUse;
+    };
+
+    void evict();
+    void loadManifest();
+    void saveManifest() const;
+
+    rwfs::path directory;
+    uint64_t sizeLimit;
+    bool storeMips = true;
+    bool validate = false;
+
+    std::map<std::string, Entry> entries;
+    uint64_t totalSize = 0;
+    uint64_t useClock = 0;
+
+    TextureLoader loader;
+    Stats stats;
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "loaders/TextureDecoder.hpp"
+
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RW_TEXTURE_SIMD 1
+#include <immintrin.h>
+#else
+#define RW_TEXTURE_SIMD 0
+#endif
+
+namespace {
+void palette8Scalar(const uint8_t* indices, const uint32_t* palette,
+                    uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = palette[indices[i]];
+    }
+}
+
+/// Repeats the top bits in the bottom, so 0 and 31 become 0 and 255
+uint32_t expand5(uint32_t c) {
+    return (c << 3) | (c >> 2);
+}
+
+void convert1555Scalar(const uint16_t* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t p = in[i];
+        out[i] = expand5(p & 0x1f) | (expand5((p >> 5) & 0x1f) << 8) |
+                 (expand5((p >> 10) & 0x1f) << 16) |
+                 ((p & 0x8000) ? 0xFF000000u : 0u);
+    }
+}
+
+void bgraScalar(const uint32_t* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t p = in[i];
+        out[i] = (p & 0xFF00FF00u) | ((p >> 16) & 0xFFu) | ((p & 0xFFu) << 16);
+    }
+}
+
+/// Rounded average of four pixels, each channel in its own 16 bit lane
+uint32_t average(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    constexpr uint32_t kMask = 0x00FF00FFu;
+    constexpr uint32_t kRound = 0x00020002u;
+    const uint32_t even =
+        (a & kMask) + (b & kMask) + (c & kMask) + (d & kMask) + kRound;
+    const uint32_t odd = ((a >> 8) & kMask) + ((b >> 8) & kMask) +
+                         ((c >> 8) & kMask) + ((d >> 8) & kMask) + kRound;
+    return ((even >> 2) & kMask) | (((odd >> 2) & kMask) << 8);
+}
+
+#if RW_TEXTURE_SIMD
+__attribute__((target("ssse3"))) void convert1555SSSE3(const uint16_t* in,
+                                                        uint32_t* out,
+                                                        size_t count) {
+    const __m128i mask = _mm_set1_epi16(0x1f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i p =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i r5 = _mm_and_si128(p, mask);
+        const __m128i g5 = _mm_and_si128(_mm_srli_epi16(p, 5), mask);
+        const __m128i b5 = _mm_and_si128(_mm_srli_epi16(p, 10), mask);
+        // Repeat the top bits in the bottom, as expand5 does
+        const __m128i r =
+            _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+        const __m128i g =
+            _mm_or_si128(_mm_slli_epi16(g5, 3), _mm_srli_epi16(g5, 2));
+        const __m128i b =
+            _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+        // The alpha bit fills the lane, then shifts into the high byte
+        const __m128i a = _mm_slli_epi16(_mm_srai_epi16(p, 15), 8);
+
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        const __m128i ba = _mm_or_si128(b, a);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4),
+                         _mm_unpackhi_epi16(rg, ba));
+    }
+    convert1555Scalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("ssse3"))) void bgraSSSE3(const uint32_t* in,
+                                                 uint32_t* out,
+                                                 size_t count) {
+    const __m128i order =
+        _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i p =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_shuffle_epi8(p, order));
+    }
+    bgraScalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("avx2"))) void palette8AVX2(const uint8_t* indices,
+                                                   const uint32_t* palette,
+                                                   uint32_t* out,
+                                                   size_t count) {
+    const auto table = reinterpret_cast<const int*>(palette);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i index = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_i32gather_epi32(table, index, 4));
+    }
+    palette8Scalar(indices + i, palette, out + i, count - i);
+}
+
+__attribute__((target("avx2"))) void bgraAVX2(const uint32_t* in,
+                                               uint32_t* out, size_t count) {
+    const __m256i order = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, 2, 1, 0, 3, 6, 5,
+        4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i p =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_shuffle_epi8(p, order));
+    }
+    bgraScalar(in + i, out + i, count - i);
+}
+#endif
+}  // namespace
+
+TextureDecoder::InstructionSet TextureDecoder::getBestInstructionSet() {
+#if RW_TEXTURE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return InstructionSet::AVX2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return InstructionSet::SSSE3;
+    }
+#endif
+    return InstructionSet::Scalar;
+}
+
+TextureDecoder::TextureDecoder(InstructionSet requested)
+    : set(std::min(requested, getBestInstructionSet()))
+    , palette8(palette8Scalar)
+    , convert1555(convert1555Scalar)
+    , bgra(bgraScalar) {
+#if RW_TEXTURE_SIMD
+    switch (set) {
+        case InstructionSet::AVX2:
+            palette8 = palette8AVX2;
+            convert1555 = convert1555SSSE3;
+            bgra = bgraAVX2;
+            break;
+        case InstructionSet::SSSE3:
+            convert1555 = convert1555SSSE3;
+            bgra = bgraSSSE3;
+            break;
+        case InstructionSet::Scalar:
+            break;
+    }
+#endif
+}
+
+void TextureDecoder::downsample(const uint32_t* in, int width, int height,
+                                uint32_t* out) {
+    const int outWidth = std::max(1, width / 2);
+    const int outHeight = std::max(1, height / 2);
+
+    for (int y = 0; y < outHeight; ++y) {
+        // Images one pixel across reuse it for both samples
+        const auto row0 = in + size_t(std::min(2 * y, height - 1)) * width;
+        const auto row1 = in + size_t(std::min(2 * y + 1, height - 1)) * width;
+        for (int x = 0; x < outWidth; ++x) {
+            const int x0 = std::min(2 * x, width - 1);
+            const int x1 = std::min(2 * x + 1, width - 1);
+            *(out++) = average(row0[x0], row0[x1], row1[x0], row1[x1]);
+        }
+    }
+}
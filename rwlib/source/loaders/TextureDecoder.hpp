@@ -0,0 +1,63 @@
+#ifndef _LIBRW_TEXTUREDECODER_HPP_
+#define _LIBRW_TEXTUREDECODER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Converts texture rasters to 8 bit RGBA, and halves them for mips
+ *
+ * Each kernel has a plain C++ version, and on x86 with GCC or Clang, SIMD
+ * versions compiled for SSSE3 and AVX2. The best set the CPU supports is
+ * picked at run time; all sets give identical results.
+ */
+class TextureDecoder {
+public:
+    enum class InstructionSet { Scalar, SSSE3, AVX2 };
+
+    /// The best set this CPU and build support
+    static InstructionSet getBestInstructionSet();
+
+    /// Uses set, or the best supported set if set isn't supported
+    explicit TextureDecoder(InstructionSet set = getBestInstructionSet());
+
+    InstructionSet getInstructionSet() const {
+        return set;
+    }
+
+    /// Looks up count palette indices
+    void expandPalette(const uint8_t* indices, const uint32_t* palette,
+                       uint32_t* out, size_t count) const {
+        palette8(indices, palette, out, count);
+    }
+
+    /// Expands 1555 pixels, red in the low bits and alpha in the top bit
+    void expand1555(const uint16_t* in, uint32_t* out, size_t count) const {
+        convert1555(in, out, count);
+    }
+
+    /// Swaps the red and blue of BGRA pixels
+    void swizzleBGRA(const uint32_t* in, uint32_t* out, size_t count) const {
+        bgra(in, out, count);
+    }
+
+    /**
+     * Halves an image with a 2x2 box filter. The output is max(1, width/2)
+     * by max(1, height/2); the last row or column of odd sizes is dropped.
+     */
+    static void downsample(const uint32_t* in, int width, int height,
+                           uint32_t* out);
+
+private:
+    using PaletteKernel = void (*)(const uint8_t*, const uint32_t*,
+                                   uint32_t*, size_t);
+    using Kernel1555 = void (*)(const uint16_t*, uint32_t*, size_t);
+    using SwizzleKernel = void (*)(const uint32_t*, uint32_t*, size_t);
+
+    InstructionSet set;
+    PaletteKernel palette8;
+    Kernel1555 convert1555;
+    SwizzleKernel bgra;
+};
+
+#endif
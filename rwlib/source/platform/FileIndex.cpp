@@ -10,19 +10,72 @@
 #include "loaders/LoaderIMG.hpp"
 #include "platform/FileHandle.hpp"
 
+namespace {
+constexpr uint32_t kCacheMagic = 0x49465752;  // "RWFI"
+constexpr uint32_t kCacheVersion = 1;
+constexpr size_t kSectorSize = 2048;
+
+template <class T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writeValue(out, static_cast<uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+template <class T>
+bool readValue(std::istream& in, T& value) {
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readString(std::istream& in, std::string& str) {
+    uint32_t size;
+    if (!readValue(in, size)) {
+        return false;
+    }
+    str.resize(size);
+    return size == 0 || bool(in.read(&str[0], size));
+}
+}  // namespace
+
 void FileIndex::indexGameDirectory(const rwfs::path& base_path) {
     gamedatapath_ = base_path;
+    indexDirectory(base_path, true);
+}
+
+void FileIndex::indexDirectory(const rwfs::path& root, bool mapPaths) {
+    rwfs::error_code ec;
+    directoryStamps.push_back(
+        {root.string(), 0, rwfs::write_time_value(root, ec)});
 
-    for (const rwfs::path& path :
-         rwfs::recursive_directory_iterator(base_path)) {
-        if (!rwfs::is_regular_file(path)) {
-            continue;
+    for (const auto& entry : rwfs::recursive_directory_iterator(root)) {
+        const auto status = entry.status();
+        if (rwfs::is_directory(status)) {
+            const auto& path = entry.path();
+            directoryStamps.push_back(
+                {path.string(), 0, rwfs::write_time_value(path, ec)});
+        } else if (rwfs::is_regular_file(status)) {
+            indexFile(entry.path(), mapPaths);
         }
+    }
+}
 
-        std::string name = path.string();
-        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-        filesystemfiles_[name] = path;
+void FileIndex::indexFile(const rwfs::path& path, bool mapPath) {
+    std::string lowerPath = path.string();
+    std::transform(lowerPath.begin(), lowerPath.end(), lowerPath.begin(),
+                   ::tolower);
+    if (mapPath) {
+        filesystemfiles_[lowerPath] = path;
     }
+
+    // The lower case name is the tail of the lower case path
+    std::string realName = path.filename().string();
+    std::string lowerName =
+        lowerPath.substr(lowerPath.size() - realName.size());
+    files[lowerName] = {lowerName, realName, path.parent_path().string(), "",
+                        0, 0};
 }
 
 FileHandle FileIndex::openFilePath(const std::string& file_path) {
@@ -42,18 +95,7 @@ FileHandle FileIndex::openFilePath(const std::string& file_path) {
 }
 
 void FileIndex::indexTree(const rwfs::path& root) {
-    for (const rwfs::path& path : rwfs::recursive_directory_iterator(root)) {
-        if (!rwfs::is_regular_file(path)) {
-            continue;
-        }
-
-        std::string directory = path.parent_path().string();
-        std::string realName = path.filename().string();
-        std::string lowerName = realName;
-        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
-                       ::tolower);
-        files[lowerName] = {lowerName, realName, directory, ""};
-    }
+    indexDirectory(root, false);
 }
 
 void FileIndex::indexArchive(const std::string& archive) {
@@ -69,6 +111,13 @@ void FileIndex::indexArchive(const std::string& archive) {
                                  archive_full_path.string());
     }
 
+    auto dirPath = archive_full_path;
+    dirPath.replace_extension(".dir");
+    rwfs::error_code ec;
+    auto dirSize = rwfs::file_size(dirPath, ec);
+    archiveStamps.push_back({dirPath.string(), ec ? 0 : uint64_t(dirSize),
+                             rwfs::write_time_value(dirPath, ec)});
+
     std::string lowerName;
     for (size_t i = 0; i < img.getAssetCount(); ++i) {
         auto& asset = img.getAssetInfoByIndex(i);
@@ -79,9 +128,22 @@ void FileIndex::indexArchive(const std::string& archive) {
         std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                        ::tolower);
 
-        files[lowerName] = {lowerName, asset.name, directory.string(),
-                            archive_basename.string()};
+        files[lowerName] = {lowerName,
+                            asset.name,
+                            directory.string(),
+                            archive_basename.string(),
+                            asset.offset,
+                            asset.size};
+    }
+}
+
+const FileIndex::IndexData* FileIndex::findIndexData(
+    const std::string& filename) const {
+    auto iterator = files.find(filename);
+    if (iterator == files.end()) {
+        return nullptr;
     }
+    return &iterator->second;
 }
 
 FileHandle FileIndex::openFile(const std::string& filename) {
@@ -99,19 +161,19 @@ FileHandle FileIndex::openFile(const std::string& filename) {
     size_t length = 0;
 
     if (isArchive) {
+        // The index already holds the asset's location, no need to reread
+        // the archive's directory
         fsName = f.directory + "/" + f.archive;
 
-        LoaderIMG img;
-
-        if (!img.load(fsName)) {
+        std::ifstream dfile(fsName.c_str(), std::ios_base::binary);
+        if (!dfile.is_open()) {
             throw std::runtime_error("Failed to load IMG archive: " + fsName);
         }
 
-        LoaderIMGFile file;
-        if (img.findAssetInfo(f.originalName, file)) {
-            length = file.size * 2048;
-            data = img.loadToMemory(f.originalName);
-        }
+        length = size_t(f.size) * kSectorSize;
+        data = new char[length];
+        dfile.seekg(std::streamoff(f.offset) * kSectorSize);
+        dfile.read(data, length);
     } else {
         std::ifstream dfile(fsName.c_str(), std::ios_base::binary);
         if (!dfile.is_open()) {
@@ -131,3 +193,125 @@ FileHandle FileIndex::openFile(const std::string& filename) {
 
     return std::make_shared<FileContentsInfo>(data, length);
 }
+
+bool FileIndex::saveCache(const rwfs::path& cachePath) const {
+    std::ofstream out(cachePath.string(),
+                      std::ios_base::binary | std::ios_base::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    writeValue(out, kCacheMagic);
+    writeValue(out, kCacheVersion);
+    writeString(out, gamedatapath_.string());
+
+    for (const auto* stamps : {&directoryStamps, &archiveStamps}) {
+        writeValue(out, static_cast<uint32_t>(stamps->size()));
+        for (const auto& stamp : *stamps) {
+            writeString(out, stamp.path);
+            writeValue(out, stamp.size);
+            writeValue(out, stamp.writeTime);
+        }
+    }
+
+    writeValue(out, static_cast<uint32_t>(filesystemfiles_.size()));
+    for (const auto& p : filesystemfiles_) {
+        writeString(out, p.first.string());
+        writeString(out, p.second.string());
+    }
+
+    writeValue(out, static_cast<uint32_t>(files.size()));
+    for (const auto& p : files) {
+        const auto& f = p.second;
+        writeString(out, f.filename);
+        writeString(out, f.originalName);
+        writeString(out, f.directory);
+        writeString(out, f.archive);
+        writeValue(out, f.offset);
+        writeValue(out, f.size);
+    }
+
+    return bool(out);
+}
+
+bool FileIndex::loadCache(const rwfs::path& cachePath,
+                          const rwfs::path& base_path) {
+    std::ifstream in(cachePath.string(), std::ios_base::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    uint32_t magic, version;
+    std::string cachedBase;
+    if (!readValue(in, magic) || !readValue(in, version) ||
+        magic != kCacheMagic || version != kCacheVersion ||
+        !readString(in, cachedBase) || cachedBase != base_path.string()) {
+        return false;
+    }
+
+    std::vector<Stamp> directories, archives;
+    for (auto* stamps : {&directories, &archives}) {
+        uint32_t count;
+        if (!readValue(in, count)) {
+            return false;
+        }
+        stamps->resize(count);
+        for (auto& stamp : *stamps) {
+            if (!readString(in, stamp.path) || !readValue(in, stamp.size) ||
+                !readValue(in, stamp.writeTime)) {
+                return false;
+            }
+        }
+    }
+
+    // Adding, removing or renaming a file changes its directory's write time
+    rwfs::error_code ec;
+    for (const auto& stamp : directories) {
+        if (rwfs::write_time_value(stamp.path, ec) != stamp.writeTime ||
+            ec) {
+            return false;
+        }
+    }
+    for (const auto& stamp : archives) {
+        auto size = rwfs::file_size(stamp.path, ec);
+        if (ec || uint64_t(size) != stamp.size ||
+            rwfs::write_time_value(stamp.path, ec) != stamp.writeTime || ec) {
+            return false;
+        }
+    }
+
+    FileSystemMap paths;
+    uint32_t count;
+    if (!readValue(in, count)) {
+        return false;
+    }
+    std::string lower, real;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!readString(in, lower) || !readString(in, real)) {
+            return false;
+        }
+        paths[lower] = real;
+    }
+
+    std::map<std::string, IndexData> indexed;
+    if (!readValue(in, count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        IndexData f;
+        if (!readString(in, f.filename) || !readString(in, f.originalName) ||
+            !readString(in, f.directory) || !readString(in, f.archive) ||
+            !readValue(in, f.offset) || !readValue(in, f.size)) {
+            return false;
+        }
+        auto name = f.filename;
+        indexed.emplace(std::move(name), std::move(f));
+    }
+
+    gamedatapath_ = base_path;
+    filesystemfiles_ = std::move(paths);
+    files = std::move(indexed);
+    directoryStamps = std::move(directories);
+    archiveStamps = std::move(archives);
+    return true;
+}
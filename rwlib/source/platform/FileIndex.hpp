@@ -3,9 +3,11 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <rw/filesystem.hpp>
 #include <rw/forward.hpp>
@@ -28,6 +30,8 @@ public:
      * This is used to build the mapping of lower-case file paths to the
      * true case on the file system for platforms where this is an issue.
      *
+     * Also adds every file to the index as indexTree() would, in the same
+     * directory walk.
      */
     void indexGameDirectory(const rwfs::path& base_path);
 
@@ -64,6 +68,9 @@ public:
         std::string directory;
         /// The archive filename (if applicable)
         std::string archive;
+        /// Offset and size of an archived file, in 2048 byte sectors
+        uint32_t offset;
+        uint32_t size;
     };
 
     /**
@@ -84,8 +91,45 @@ public:
      */
     FileHandle openFile(const std::string& filename);
 
+    /**
+     * Returns where an indexed file is stored, or nullptr if it isn't in
+     * the index.
+     */
+    const IndexData* findIndexData(const std::string& filename) const;
+
+    /**
+     * Writes the index to a cache file, so that a later run can skip
+     * walking the game directory and reading archive directories.
+     * @return false if the cache couldn't be written
+     */
+    bool saveCache(const rwfs::path& cachePath) const;
+
+    /**
+     * Replaces the index with the one stored in a cache file.
+     *
+     * The cache is rejected if it was made for a different base_path, if any
+     * indexed directory has been modified since, or if any indexed archive's
+     * directory file has changed size or modification time.
+     * @return true if the cache was valid and loaded
+     */
+    bool loadCache(const rwfs::path& cachePath, const rwfs::path& base_path);
+
 private:
+    /// Adds a regular file found while walking a directory
+    void indexFile(const rwfs::path& path, bool mapPath);
+
+    void indexDirectory(const rwfs::path& root, bool mapPaths);
+
     std::map<std::string, IndexData> files;
+
+    /// Modification times used to validate the cache
+    struct Stamp {
+        std::string path;
+        uint64_t size;
+        int64_t writeTime;
+    };
+    std::vector<Stamp> directoryStamps;
+    std::vector<Stamp> archiveStamps;
 };
 
 #endif
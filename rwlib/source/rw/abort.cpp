@@ -1,7 +1,9 @@
 #include <functional>
+#include <string>
 
 #if RW_DEBUG
 std::function<void()> _rw_abort_cb[2] = {nullptr, nullptr};
+std::function<void(const std::string&)> _rw_error_cb = nullptr;
 
 #if defined(RW_WINDOWS)
 #define WINDOWS_LEAN_AND_MEAN
@@ -4,10 +4,15 @@
 #if RW_DEBUG
 #include <cstdlib>
 #include <functional>
+#include <string>
 
 extern std::function<void()> _rw_abort_cb[2];
 #define SET_RW_ABORT_CB(cb0, cb1) do { _rw_abort_cb[0] = cb0; _rw_abort_cb[1] = cb1;} while (0)
 
+/// Receives RW_ERROR messages instead of std::cerr when set
+extern std::function<void(const std::string&)> _rw_error_cb;
+#define SET_RW_ERROR_CB(cb) do { _rw_error_cb = cb; } while (0)
+
 #define RW_ABORT() do { if(_rw_abort_cb[0]) _rw_abort_cb[0](); ::abort(); } while (0)
 #define RW_ASSERT(cond) do { if (!(cond)) RW_ABORT();} while (0)
 
@@ -33,6 +38,7 @@ void WinBreak();
 
 #else
 #define SET_RW_ABORT_CB(cb0, cb1)
+#define SET_RW_ERROR_CB(cb)
 #define RW_ABORT()
 #define RW_ASSERT(cond)
 #define RW_BREAKPOINT()
@@ -41,10 +47,19 @@ void WinBreak();
 
 #if RW_DEBUG && RW_VERBOSE_DEBUG_MESSAGES
 #include <iostream>
+#include <sstream>
 #define RW_MESSAGE(msg) \
     std::cout << __FILE__ << ":" << __LINE__ << ": " << msg << std::endl
 #define RW_ERROR(msg) \
-    std::cerr << __FILE__ << ":" << __LINE__ << ": " << msg << std::endl
+    do { \
+        std::ostringstream _rw_error_ss; \
+        _rw_error_ss << __FILE__ << ":" << __LINE__ << ": " << msg; \
+        if (_rw_error_cb) { \
+            _rw_error_cb(_rw_error_ss.str()); \
+        } else { \
+            std::cerr << _rw_error_ss.str() << std::endl; \
+        } \
+    } while (0)
 #else
 #define RW_MESSAGE(msg)
 #define RW_ERROR(msg)
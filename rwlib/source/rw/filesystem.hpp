@@ -50,6 +50,23 @@ inline recursive_directory_iterator end(const recursive_directory_iterator&) {
 #error Invalid RW_FS_LIBRARY value
 #endif
 
+#include <cstdint>
+
+namespace rwfs {
+/**
+ * Modification time of p as an integer that can be stored and compared
+ * between runs, or 0 if ec is set.
+ */
+inline int64_t write_time_value(const path& p, error_code& ec) {
+    auto time = last_write_time(p, ec);
+#if RW_FS_LIBRARY == RW_FS_BOOST
+    return ec ? 0 : static_cast<int64_t>(time);
+#else
+    return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+#endif
+}
+}
+
 namespace std {
 template <>
 struct hash<rwfs::path> {
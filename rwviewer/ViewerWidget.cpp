@@ -143,7 +143,7 @@ void ViewerWidget::paintGL() {
 
 
     r.getRenderer()->invalidate();
-    r.setupRender();
+    r.setupRender(glm::vec4(0.3f, 0.3f, 0.3f, 1.f));
 
     switch (_viewMode) {
     case Mode::Model:
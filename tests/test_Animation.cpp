@@ -48,4 +48,83 @@ BOOST_AUTO_TEST_CASE(test_matrix) {
 }
 #endif
 
+namespace {
+/// A clump with one bone, and an animation moving it from 0 to 1 along y
+struct TestAnimation {
+    ClumpPtr clump = std::make_shared<Clump>();
+    ModelFrame* bone;
+    AnimationPtr animation = std::make_shared<Animation>();
+
+    TestAnimation() {
+        auto root = std::make_shared<ModelFrame>(0);
+        root->setName("root");
+        auto frame = std::make_shared<ModelFrame>(1);
+        frame->setName("bone");
+        root->addChild(frame);
+        clump->setFrame(root);
+        bone = frame.get();
+
+        animation->duration = 1.f;
+        animation->bones["bone"] = new AnimationBone{
+            "bone",
+            0,
+            0,
+            1.0f,
+            AnimationBone::RT0,
+            {
+                {glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, glm::vec3(0.f, 0.f, 0.f),
+                 glm::vec3(), 0.f, 0},
+                {glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, glm::vec3(0.f, 1.f, 0.f),
+                 glm::vec3(), 1.0f, 1},
+            }};
+    }
+
+    float getY() const {
+        return bone->getTransform()[3].y;
+    }
+};
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_choose_detail) {
+    BOOST_CHECK(Animator::chooseDetail(0.f, 10.f) == Animator::Detail::Full);
+    BOOST_CHECK(Animator::chooseDetail(0.f, Animator::kReducedDistance * 2.f) ==
+                Animator::Detail::Reduced);
+    BOOST_CHECK(Animator::chooseDetail(Animator::kHiddenTime * 2.f, 10.f) ==
+                Animator::Detail::TimeOnly);
+}
+
+BOOST_AUTO_TEST_CASE(test_time_only) {
+    TestAnimation test;
+    Animator animator(test.clump);
+    animator.playAnimation(0, test.animation, 1.f, false);
+
+    animator.setDetail(Animator::Detail::TimeOnly);
+    animator.tick(0.5f);
+    BOOST_CHECK_EQUAL(animator.getAnimationTime(0), 0.5f);
+    BOOST_CHECK_EQUAL(test.getY(), 0.f);
+
+    // Asking for the pose gives the exact one
+    animator.updatePose();
+    BOOST_CHECK_CLOSE(test.getY(), 0.5f, 0.1f);
+}
+
+BOOST_AUTO_TEST_CASE(test_reduced) {
+    TestAnimation test;
+    Animator animator(test.clump);
+    animator.playAnimation(0, test.animation, 1.f, false);
+    animator.setDetail(Animator::Detail::Reduced);
+
+    // Blends between poses a whole interval apart, which for a linear
+    // animation matches the keyframes
+    const float step = Animator::kReducedInterval / 4.f;
+    for (int i = 1; i <= 10; ++i) {
+        animator.tick(step);
+        BOOST_CHECK_CLOSE(test.getY(), step * i, 0.1f);
+    }
+
+    // Finished animations hold their last pose
+    animator.tick(1.f);
+    BOOST_CHECK_CLOSE(test.getY(), 1.f, 0.1f);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+#include <boost/test/unit_test.hpp>
+#include <loaders/BakedWorld.hpp>
+#include <rw/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace {
+/// Two small IPLs in a temporary directory
+struct BakeFixture {
+    rwfs::path root = rwfs::temp_directory_path() / "rwtest_bakedworld";
+    rwfs::path bakePath = root / "world.bake";
+    BakedWorld::SourceList sources;
+
+    BakeFixture() {
+        rwfs::remove_all(root);
+        rwfs::create_directories(root);
+        writeIPL("a.ipl",
+                 "inst\n"
+                 "100, model1, 1.0, 2.0, 3.0, 1, 1, 1, 0, 0, 0, 1\n"
+                 "101, model2, 4.0, 5.0, 6.0, 1, 1, 1, 0, 0, 0, 1\n"
+                 "end\n"
+                 "zone\n"
+                 "CITY, 0, -10, -10, -10, 10, 10, 10, 1\n"
+                 "end\n");
+        writeIPL("b.ipl",
+                 "inst\n"
+                 "200, model3, 7.0, 8.0, 9.0, 1, 1, 1, 0, 0, 0, 1\n"
+                 "end\n");
+    }
+
+    ~BakeFixture() {
+        rwfs::remove_all(root);
+    }
+
+    void writeIPL(const std::string& name, const std::string& contents) {
+        auto path = root / name;
+        std::ofstream(path.string()) << contents;
+        sources[name] = path.string();
+    }
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(BakedWorldTests)
+
+BOOST_FIXTURE_TEST_CASE(test_bake, BakeFixture) {
+    BakedWorld baked;
+    BOOST_REQUIRE(baked.bake(sources));
+
+    const auto& instances = baked.getInstances();
+    BOOST_REQUIRE_EQUAL(instances.size(), 3u);
+    BOOST_CHECK_EQUAL(instances[0].id, 100);
+    BOOST_CHECK_EQUAL(instances[1].position.y, 5.f);
+    BOOST_CHECK_EQUAL(instances[2].id, 200);
+    BOOST_CHECK_EQUAL(baked.getSourceName(instances[2]), "b.ipl");
+
+    BOOST_REQUIRE_EQUAL(baked.getZones().size(), 1u);
+    BOOST_CHECK_EQUAL(baked.getZones()[0].name, "CITY");
+}
+
+BOOST_FIXTURE_TEST_CASE(test_save_load, BakeFixture) {
+    {
+        BakedWorld baked;
+        BOOST_REQUIRE(baked.bake(sources));
+        BOOST_REQUIRE(baked.save(bakePath));
+    }
+
+    BakedWorld loaded;
+    BOOST_REQUIRE(loaded.load(bakePath, sources));
+    const auto& instances = loaded.getInstances();
+    BOOST_REQUIRE_EQUAL(instances.size(), 3u);
+    BOOST_CHECK_EQUAL(instances[1].id, 101);
+    BOOST_CHECK_EQUAL(instances[2].position.z, 9.f);
+    BOOST_CHECK_EQUAL(loaded.getSourceName(instances[0]), "a.ipl");
+    BOOST_REQUIRE_EQUAL(loaded.getZones().size(), 1u);
+    BOOST_CHECK_EQUAL(loaded.getZones()[0].max.x, 10.f);
+    BOOST_CHECK_EQUAL(loaded.getZones()[0].island, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_invalidated, BakeFixture) {
+    {
+        BakedWorld baked;
+        BOOST_REQUIRE(baked.bake(sources));
+        BOOST_REQUIRE(baked.save(bakePath));
+    }
+
+    // A different set of sources
+    auto fewer = sources;
+    fewer.erase("b.ipl");
+    BakedWorld loaded;
+    BOOST_CHECK(!loaded.load(bakePath, fewer));
+
+    // An edited source
+    writeIPL("b.ipl",
+             "inst\n"
+             "200, model3, 7.0, 8.0, 9.0, 1, 1, 1, 0, 0, 0, 1\n"
+             "201, model4, 7.0, 8.0, 9.0, 1, 1, 1, 0, 0, 0, 1\n"
+             "end\n");
+    BOOST_CHECK(!loaded.load(bakePath, sources));
+    BOOST_CHECK(loaded.getInstances().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
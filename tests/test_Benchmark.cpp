@@ -0,0 +1,67 @@
+#include <boost/test/unit_test.hpp>
+#include <BenchmarkStats.hpp>
+
+#include <sstream>
+
+BOOST_AUTO_TEST_SUITE(BenchmarkTests)
+
+BOOST_AUTO_TEST_CASE(test_percentile) {
+    std::vector<float> sorted;
+    for (int i = 1; i <= 100; ++i) {
+        sorted.push_back(static_cast<float>(i));
+    }
+
+    BOOST_CHECK_EQUAL(BenchmarkStats::percentile(sorted, 0.f), 1.f);
+    BOOST_CHECK_EQUAL(BenchmarkStats::percentile(sorted, 50.f), 50.f);
+    BOOST_CHECK_EQUAL(BenchmarkStats::percentile(sorted, 95.f), 95.f);
+    BOOST_CHECK_EQUAL(BenchmarkStats::percentile(sorted, 100.f), 100.f);
+    BOOST_CHECK_EQUAL(BenchmarkStats::percentile({}, 50.f), 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_summary) {
+    BenchmarkStats stats({20.f, 40.f});
+
+    FrameTimings timings;
+    for (int i = 0; i < 98; ++i) {
+        timings.total = 0.010f;
+        stats.addSample(0, timings);
+    }
+    timings.total = 0.030f;
+    stats.addSample(1, timings);
+    timings.total = 0.050f;
+    stats.addSample(1, timings);
+
+    auto summary = stats.summarise(BenchmarkStats::Total);
+    BOOST_CHECK_EQUAL(summary.count, 100);
+    BOOST_CHECK_CLOSE(summary.min, 10.f, 0.01f);
+    BOOST_CHECK_CLOSE(summary.p50, 10.f, 0.01f);
+    BOOST_CHECK_CLOSE(summary.p99, 30.f, 0.01f);
+    BOOST_CHECK_CLOSE(summary.max, 50.f, 0.01f);
+    BOOST_REQUIRE_EQUAL(summary.hitches.size(), 2);
+    BOOST_CHECK_EQUAL(summary.hitches[0], 2);
+    BOOST_CHECK_EQUAL(summary.hitches[1], 1);
+
+    auto update = stats.summarise(BenchmarkStats::Update);
+    BOOST_CHECK_EQUAL(update.max, 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_csv_output) {
+    BenchmarkStats stats;
+    FrameTimings timings;
+    timings.total = 0.016f;
+    stats.addSample(0, timings);
+    stats.addSample(1, timings);
+
+    std::stringstream ss;
+    stats.writeCSV(ss);
+
+    std::string line;
+    int lines = 0;
+    while (std::getline(ss, line)) {
+        lines++;
+    }
+    // Header plus one row per sample
+    BOOST_CHECK_EQUAL(lines, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
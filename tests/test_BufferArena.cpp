@@ -0,0 +1,76 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/BufferArena.hpp>
+
+BOOST_AUTO_TEST_SUITE(BufferArenaTests)
+
+BOOST_AUTO_TEST_CASE(test_allocate) {
+    BufferArena arena(100);
+
+    BOOST_CHECK_EQUAL(arena.allocate(40), 0u);
+    BOOST_CHECK_EQUAL(arena.allocate(40), 40u);
+    BOOST_CHECK_EQUAL(arena.getUsed(), 80u);
+
+    BOOST_CHECK_EQUAL(arena.allocate(30), BufferArena::kInvalidOffset);
+    BOOST_CHECK_EQUAL(arena.allocate(0), BufferArena::kInvalidOffset);
+    BOOST_CHECK_EQUAL(arena.allocate(20), 80u);
+    BOOST_CHECK_EQUAL(arena.allocate(1), BufferArena::kInvalidOffset);
+}
+
+BOOST_AUTO_TEST_CASE(test_free_reuse) {
+    BufferArena arena(100);
+    auto a = arena.allocate(30);
+    auto b = arena.allocate(30);
+    arena.allocate(30);
+
+    arena.free(b, 30);
+    BOOST_CHECK_EQUAL(arena.getUsed(), 60u);
+    // First fit reuses the hole before the free space at the end
+    BOOST_CHECK_EQUAL(arena.allocate(20), b);
+    BOOST_CHECK_EQUAL(arena.allocate(10), b + 20);
+
+    arena.free(a, 30);
+    BOOST_CHECK_EQUAL(arena.allocate(30), a);
+}
+
+BOOST_AUTO_TEST_CASE(test_coalesce) {
+    BufferArena arena(90);
+    auto a = arena.allocate(30);
+    auto b = arena.allocate(30);
+    auto c = arena.allocate(30);
+
+    arena.free(a, 30);
+    arena.free(c, 30);
+    BOOST_CHECK_EQUAL(arena.getStats().freeRanges, 2u);
+
+    // Freeing the middle joins both neighbours into one range
+    arena.free(b, 30);
+    auto stats = arena.getStats();
+    BOOST_CHECK_EQUAL(stats.freeRanges, 1u);
+    BOOST_CHECK_EQUAL(stats.largestFree, 90u);
+    BOOST_CHECK_EQUAL(stats.used, 0u);
+    BOOST_CHECK_EQUAL(arena.allocate(90), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_fragmentation) {
+    BufferArena arena(100);
+    BOOST_CHECK_EQUAL(arena.getStats().fragmentation(), 0.f);
+
+    size_t offsets[4];
+    for (auto& offset : offsets) {
+        offset = arena.allocate(25);
+    }
+    BOOST_CHECK_EQUAL(arena.getStats().fragmentation(), 0.f);
+
+    arena.free(offsets[0], 25);
+    arena.free(offsets[2], 25);
+    auto stats = arena.getStats();
+    BOOST_CHECK_EQUAL(stats.capacity, 100u);
+    BOOST_CHECK_EQUAL(stats.used, 50u);
+    BOOST_CHECK_EQUAL(stats.largestFree, 25u);
+    BOOST_CHECK_CLOSE(stats.fragmentation(), 0.5f, 0.01f);
+
+    // 50 units are free, but not in one piece
+    BOOST_CHECK_EQUAL(arena.allocate(50), BufferArena::kInvalidOffset);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+#include <boost/test/unit_test.hpp>
+#include <ai/CrowdSimulation.hpp>
+
+BOOST_AUTO_TEST_SUITE(CrowdSimulationTests)
+
+BOOST_AUTO_TEST_CASE(test_walking) {
+    CrowdSimulation crowd;
+    auto a = crowd.addAgent({0.f, 0.f}, {1.f, 0.f});
+    auto b = crowd.addAgent({10.f, 0.f}, {0.f, -2.f});
+    BOOST_CHECK_EQUAL(crowd.getAgentCount(), 2);
+
+    crowd.step(0.5f);
+
+    // Too far apart to notice each other
+    BOOST_CHECK_CLOSE(crowd.getPosition(a).x, 0.5f, 0.01f);
+    BOOST_CHECK_SMALL(crowd.getPosition(a).y, 0.0001f);
+    BOOST_CHECK_CLOSE(crowd.getPosition(b).x, 10.f, 0.01f);
+    BOOST_CHECK_CLOSE(crowd.getPosition(b).y, -1.f, 0.01f);
+}
+
+BOOST_AUTO_TEST_CASE(test_separation) {
+    CrowdSimulation crowd;
+    auto a = crowd.addAgent({0.f, 0.f}, {});
+    auto b = crowd.addAgent({0.5f, 0.f}, {});
+
+    crowd.step(0.1f);
+
+    // Pushed apart along the line between them, by the same amount
+    BOOST_CHECK_LT(crowd.getPosition(a).x, 0.f);
+    BOOST_CHECK_GT(crowd.getPosition(b).x, 0.5f);
+    BOOST_CHECK_CLOSE(-crowd.getPosition(a).x,
+                      crowd.getPosition(b).x - 0.5f, 0.01f);
+
+    // Agents on top of each other still split up
+    crowd.clear();
+    a = crowd.addAgent({3.f, 3.f}, {});
+    b = crowd.addAgent({3.f, 3.f}, {});
+    crowd.step(0.1f);
+    BOOST_CHECK_NE(crowd.getPosition(a).x, crowd.getPosition(b).x);
+}
+
+BOOST_AUTO_TEST_CASE(test_obstacles) {
+    CrowdSimulation crowd;
+    auto a = crowd.addAgent({0.f, 0.f}, {});
+    crowd.addObstacle({0.f, 0.5f});
+    BOOST_CHECK_EQUAL(crowd.getObstacleCount(), 1);
+
+    crowd.step(0.1f);
+    BOOST_CHECK_LT(crowd.getPosition(a).y, 0.f);
+
+    // Separation never gets faster than the limit however crowded it is
+    crowd.clear();
+    a = crowd.addAgent({0.f, 0.f}, {});
+    for (int i = 0; i < 8; ++i) {
+        crowd.addObstacle({0.1f, 0.01f * i});
+    }
+    crowd.step(1.f);
+    BOOST_CHECK_LE(glm::length(crowd.getPosition(a)),
+                   CrowdSimulation::kSeparationSpeed + 0.001f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <data/CutsceneData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <loaders/LoaderCutsceneDAT.hpp>
 #include "test_Globals.hpp"
 
@@ -28,6 +30,24 @@ BOOST_AUTO_TEST_CASE(test_load) {
         BOOST_CHECK(tracks.duration == 64.8f);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_background_load) {
+    auto world = Global::get().e;
+    auto animationCount = world->data->animations.size();
+
+    world->loadCutscene("INTRO");
+    auto cutscene = world->state->currentCutscene;
+    BOOST_REQUIRE(cutscene != nullptr);
+    BOOST_CHECK_EQUAL(cutscene->meta.name, "INTRO");
+
+    world->finishCutsceneLoad();
+    BOOST_CHECK(cutscene->tracks.duration == 64.8f);
+
+    // Cutscene animations don't leak into the global set
+    world->clearCutscene();
+    BOOST_CHECK(world->state->currentCutscene == nullptr);
+    BOOST_CHECK_EQUAL(world->data->animations.size(), animationCount);
+}
 #endif
 
 BOOST_AUTO_TEST_SUITE_END()
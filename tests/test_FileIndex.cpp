@@ -2,11 +2,107 @@
 #include <platform/FileIndex.hpp>
 #include "test_Globals.hpp"
 
+#include <platform/FileHandle.hpp>
 #include <rw/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <string>
 namespace fs = rwfs;
 
+namespace {
+/// A small game directory with one loose file and a one file archive
+struct TempGameDirectory {
+    fs::path root = fs::temp_directory_path() / "rwtest_fileindex";
+    fs::path cache = fs::temp_directory_path() / "rwtest_fileindex.cache";
+
+    TempGameDirectory() {
+        fs::remove_all(root);
+        fs::create_directories(root / "Data");
+        std::ofstream(fs::path(root / "Data/Loose.DAT").string()) << "loose";
+
+        char entry[32] = {};
+        uint32_t offset = 0, size = 1;
+        std::memcpy(entry, &offset, 4);
+        std::memcpy(entry + 4, &size, 4);
+        std::strcpy(entry + 8, "Packed.DFF");
+        std::ofstream(fs::path(root / "Data/test.dir").string(),
+                      std::ios::binary)
+            .write(entry, sizeof(entry));
+
+        std::string sector(2048, '\0');
+        sector.replace(0, 6, "packed");
+        std::ofstream(fs::path(root / "Data/test.img").string(),
+                      std::ios::binary)
+            << sector;
+    }
+
+    ~TempGameDirectory() {
+        fs::remove_all(root);
+        fs::remove(cache);
+    }
+
+    void index(FileIndex& index) {
+        index.indexGameDirectory(root);
+        index.indexArchive(index.findFilePath("data/test.img").string());
+    }
+};
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(FileIndexTests)
 
+BOOST_FIXTURE_TEST_CASE(test_single_pass_index, TempGameDirectory) {
+    FileIndex idx;
+    index(idx);
+
+    BOOST_CHECK_EQUAL(idx.findFilePath("DATA/LOOSE.DAT").string(),
+                      (root / "Data/Loose.DAT").string());
+
+    auto loose = idx.openFile("loose.dat");
+    BOOST_REQUIRE(loose != nullptr);
+    BOOST_CHECK_EQUAL(std::string(loose->data, loose->length), "loose");
+
+    auto packed = idx.openFile("packed.dff");
+    BOOST_REQUIRE(packed != nullptr);
+    BOOST_CHECK_EQUAL(packed->length, 2048u);
+    BOOST_CHECK_EQUAL(std::string(packed->data, 6), "packed");
+}
+
+BOOST_FIXTURE_TEST_CASE(test_cache_round_trip, TempGameDirectory) {
+    {
+        FileIndex idx;
+        index(idx);
+        BOOST_REQUIRE(idx.saveCache(cache));
+    }
+
+    FileIndex cached;
+    BOOST_REQUIRE(cached.loadCache(cache, root));
+    BOOST_CHECK_EQUAL(cached.findFilePath("data/loose.dat").string(),
+                      (root / "Data/Loose.DAT").string());
+    auto packed = cached.openFile("packed.dff");
+    BOOST_REQUIRE(packed != nullptr);
+    BOOST_CHECK_EQUAL(std::string(packed->data, 6), "packed");
+
+    FileIndex other;
+    BOOST_CHECK(!other.loadCache(cache, root / "Data"));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_cache_archive_changed, TempGameDirectory) {
+    {
+        FileIndex idx;
+        index(idx);
+        BOOST_REQUIRE(idx.saveCache(cache));
+    }
+
+    char entry[32] = {};
+    std::ofstream(fs::path(root / "Data/test.dir").string(),
+                  std::ios::binary | std::ios::app)
+        .write(entry, sizeof(entry));
+
+    FileIndex cached;
+    BOOST_CHECK(!cached.loadCache(cache, root));
+}
+
 #if RW_TEST_WITH_DATA
 BOOST_AUTO_TEST_CASE(test_directory_paths) {
     FileIndex index;
@@ -0,0 +1,103 @@
+#include <boost/test/unit_test.hpp>
+#include <core/JobSystem.hpp>
+#include <engine/WorldCommandBuffer.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(JobSystemTests)
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_visits_each_index) {
+    for (unsigned workers : {0u, 1u, 3u}) {
+        JobSystem jobs(workers);
+        BOOST_CHECK_EQUAL(jobs.getWorkerCount(), workers);
+
+        // Repeat to catch workers that miss a loop or run one twice
+        for (int run = 0; run < 20; ++run) {
+            // Boost.Test checks aren't thread safe, count on the workers
+            std::vector<std::atomic<int>> visits(1000);
+            std::atomic<int> oversized{0};
+            jobs.parallelFor(visits.size(), 7, [&](size_t begin, size_t end) {
+                oversized += end - begin > 7 ? 1 : 0;
+                for (size_t i = begin; i < end; ++i) {
+                    visits[i]++;
+                }
+            });
+
+            size_t once = 0;
+            for (auto& v : visits) {
+                once += v == 1 ? 1 : 0;
+            }
+            BOOST_CHECK_EQUAL(once, visits.size());
+            BOOST_CHECK_EQUAL(oversized, 0);
+        }
+
+        jobs.parallelFor(0, 7, [](size_t, size_t) { BOOST_ERROR("ran"); });
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_rethrows) {
+    JobSystem jobs(2);
+    std::atomic<int> chunks{0};
+    BOOST_CHECK_THROW(
+        jobs.parallelFor(100, 10,
+                         [&](size_t begin, size_t) {
+                             chunks++;
+                             if (begin == 50) {
+                                 throw std::runtime_error("chunk failed");
+                             }
+                         }),
+        std::runtime_error);
+    // The other chunks still ran
+    BOOST_CHECK_EQUAL(chunks, 10);
+}
+
+BOOST_AUTO_TEST_CASE(test_command_buffers_apply_in_chunk_order) {
+    JobSystem jobs(3);
+    const size_t count = 500;
+    const size_t grain = 16;
+    std::vector<WorldCommandBuffer> buffers((count + grain - 1) / grain);
+    std::vector<size_t> applied;
+
+    jobs.parallelFor(count, grain, [&](size_t begin, size_t end) {
+        WorldCommandBuffer::Scope scope(buffers[begin / grain]);
+        for (size_t i = begin; i < end; ++i) {
+            if (i % 3 == 0) {
+                WorldCommandBuffer::current()->push(
+                    [&applied, i] { applied.push_back(i); });
+            }
+        }
+    });
+    BOOST_CHECK(WorldCommandBuffer::current() == nullptr);
+    BOOST_CHECK(applied.empty());
+
+    for (auto& commands : buffers) {
+        commands.apply();
+        BOOST_CHECK(commands.empty());
+    }
+
+    // The same order as running the loop on one thread
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < count; i += 3) {
+        expected.push_back(i);
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(applied.begin(), applied.end(),
+                                  expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_command_buffer_scopes_nest) {
+    WorldCommandBuffer outer;
+    WorldCommandBuffer inner;
+    {
+        WorldCommandBuffer::Scope a(outer);
+        {
+            WorldCommandBuffer::Scope b(inner);
+            BOOST_CHECK_EQUAL(WorldCommandBuffer::current(), &inner);
+        }
+        BOOST_CHECK_EQUAL(WorldCommandBuffer::current(), &outer);
+    }
+    BOOST_CHECK(WorldCommandBuffer::current() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
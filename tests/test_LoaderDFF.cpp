@@ -1,5 +1,7 @@
 #include <boost/test/unit_test.hpp>
 #include <data/Clump.hpp>
+#include <glm/gtc/packing.hpp>
+#include <loaders/LoaderDFF.hpp>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(LoaderDFFTests)
@@ -25,8 +27,81 @@ BOOST_AUTO_TEST_CASE(test_load_dff) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_compact_memory) {
+    LoaderDFF loader;
+    loader.setCompactVertices(true);
+
+    // What the same geometry would use with the full layout, including the
+    // index copies that used to be kept on the CPU
+    size_t fullBytes = 0;
+    size_t compactBytes = 0;
+    size_t models = 0;
+    for (const auto& info : Global::get().d->modelinfo) {
+        auto file =
+            Global::get().d->index.openFile(info.second->name + ".dff");
+        if (!file) {
+            continue;
+        }
+        auto clump = loader.loadFromMemory(file);
+        BOOST_REQUIRE(clump);
+        models++;
+
+        for (const auto& atomic : clump->getAtomics()) {
+            const auto& geom = atomic->getGeometry();
+            size_t vertices = geom->gbuff.getCount();
+            size_t indices = 0;
+            for (const auto& sg : geom->subgeom) {
+                BOOST_CHECK(sg.indices.empty());
+                indices += sg.numIndices;
+            }
+            fullBytes += vertices * sizeof(GeometryVertex) +
+                         indices * sizeof(uint32_t) * 2;
+            compactBytes += vertices * sizeof(CompactGeometryVertex) +
+                            indices * geom->dbuff.getIndexSize();
+        }
+    }
+
+    BOOST_TEST_MESSAGE("Compact geometry for "
+                       << models << " models uses " << compactBytes
+                       << " bytes instead of " << fullBytes << ", saving "
+                       << fullBytes - compactBytes << " bytes");
+    BOOST_CHECK_GT(models, 0u);
+    BOOST_CHECK_LT(compactBytes, fullBytes);
+}
+
 #endif
 
+BOOST_AUTO_TEST_CASE(test_compact_vertex) {
+    BOOST_CHECK_EQUAL(sizeof(CompactGeometryVertex), 20u);
+
+    std::vector<GeometryVertex> vertices{
+        {{-10.f, 2.f, 0.5f}, {0.f, 0.f, 1.f}, {0.25f, 1.5f}, {1, 2, 3, 4}},
+        {{30.f, 2.f, 0.f}, {0.6f, -0.8f, 0.f}, {-1.f, 0.f}, {5, 6, 7, 8}},
+        {{5.f, 2.f, -4.f}, {1.f, 0.f, 0.f}, {2.f, 0.125f}, {9, 9, 9, 9}}};
+
+    glm::vec3 offset, scale;
+    auto compacted = CompactGeometryVertex::compact(vertices, offset, scale);
+    BOOST_REQUIRE_EQUAL(compacted.size(), vertices.size());
+    BOOST_CHECK_EQUAL(offset, glm::vec3(10.f, 2.f, -1.75f));
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const auto& original = vertices[i];
+        const auto& packed = compacted[i];
+
+        auto position = offset + glm::vec3(packed.position) / 32767.f * scale;
+        BOOST_CHECK_LT(glm::distance(position, original.position), 0.001f);
+
+        auto normal = glm::vec3(glm::unpackSnorm3x10_1x2(packed.normal));
+        BOOST_CHECK_LT(glm::distance(normal, original.normal), 0.005f);
+
+        BOOST_CHECK_EQUAL(glm::unpackHalf1x16(packed.texcoord.x),
+                          original.texcoord.x);
+        BOOST_CHECK_EQUAL(glm::unpackHalf1x16(packed.texcoord.y),
+                          original.texcoord.y);
+        BOOST_CHECK(packed.colour == original.colour);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_clump_clone) {
     {
         auto frame1 = std::make_shared<ModelFrame>(0);
@@ -1,6 +1,12 @@
 #include <boost/test/unit_test.hpp>
+#include <core/BoundedQueue.hpp>
 #include <core/Logger.hpp>
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 class CallbackReceiver : public Logger::MessageReceiver {
 public:
     std::function<void(const Logger::LogMessage&)> func;
@@ -12,8 +18,24 @@ public:
     virtual void messageReceived(const Logger::LogMessage& message) {
         func(message);
     }
+
+    void flush() override {
+        flushes++;
+    }
+
+    int flushes = 0;
 };
 
+/// Counts how many times it has been formatted into a message
+struct CountedFormat {
+    int* count;
+};
+
+std::ostream& operator<<(std::ostream& os, const CountedFormat& counted) {
+    ++*counted.count;
+    return os;
+}
+
 BOOST_AUTO_TEST_SUITE(LoggerTests)
 
 BOOST_AUTO_TEST_CASE(test_receiver) {
@@ -33,4 +55,159 @@ BOOST_AUTO_TEST_CASE(test_receiver) {
     BOOST_CHECK_EQUAL(lastMessage.message, "Test");
 }
 
+BOOST_AUTO_TEST_CASE(test_severity_filter) {
+    Logger log;
+    std::vector<Logger::LogMessage> messages;
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { messages.push_back(m); });
+    log.addReceiver(&receiver);
+
+    log.setMinimumSeverity(Logger::Warning);
+    log.setComponentSeverity("Noisy", Logger::Error);
+    log.setComponentSeverity("Debug", Logger::Verbose);
+
+    log.info("Tests", "Dropped");
+    log.warning("Tests", "Kept");
+    log.warning("Noisy", "Dropped");
+    log.verbose("Debug", "Kept");
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 2u);
+    BOOST_CHECK_EQUAL(messages[0].component, "Tests");
+    BOOST_CHECK_EQUAL(messages[1].component, "Debug");
+    BOOST_CHECK(!log.isEnabled("Tests", Logger::Info));
+}
+
+BOOST_AUTO_TEST_CASE(test_lazy_format) {
+    Logger log;
+    Logger::LogMessage lastMessage("", Logger::Error, "");
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { lastMessage = m; });
+    log.addReceiver(&receiver);
+
+    int formatted = 0;
+    CountedFormat counted{&formatted};
+    log.setMinimumSeverity(Logger::Info);
+    log.verbose("Tests", "Value ", counted);
+    BOOST_CHECK_EQUAL(formatted, 0);
+
+    log.info("Tests", "Instance ", 42, " in ", std::string("test.ipl"));
+    BOOST_CHECK_EQUAL(lastMessage.message, "Instance 42 in test.ipl");
+}
+
+BOOST_AUTO_TEST_CASE(test_async_flush) {
+    Logger log;
+    std::vector<std::string> messages;
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { messages.push_back(m.message); });
+    log.addReceiver(&receiver);
+
+    log.startAsync();
+    BOOST_CHECK(log.isAsync());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&log] {
+            for (int i = 0; i < 100; ++i) {
+                log.info("Tests", "Message");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Errors are delivered before log returns
+    log.error("Tests", "Error");
+    BOOST_REQUIRE(!messages.empty());
+    BOOST_CHECK_EQUAL(messages.back(), "Error");
+    BOOST_CHECK_EQUAL(messages.size() + log.getDroppedCount(), 401u);
+
+    log.stopAsync();
+    BOOST_CHECK(!log.isAsync());
+}
+
+BOOST_AUTO_TEST_CASE(test_async_drop) {
+    Logger log;
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+    std::atomic<int> received{0};
+    // Stall the sink thread inside the first message so the queue fills up
+    CallbackReceiver receiver([&](const Logger::LogMessage&) {
+        entered = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+        received++;
+    });
+    log.addReceiver(&receiver);
+
+    log.startAsync(4);
+    log.info("Tests", "Blocking");
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 10; ++i) {
+        log.info("Tests", "Message");
+    }
+    release = true;
+    log.stopAsync();
+
+    BOOST_CHECK_EQUAL(received, 5);
+    BOOST_CHECK_EQUAL(log.getDroppedCount(), 6u);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_error_not_dropped) {
+    Logger log;
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+    std::vector<std::string> messages;
+    CallbackReceiver receiver([&](const Logger::LogMessage& m) {
+        if (!entered) {
+            entered = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+        }
+        messages.push_back(m.message);
+    });
+    log.addReceiver(&receiver);
+
+    log.startAsync(4);
+    log.info("Tests", "Blocking");
+    while (!entered) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 10; ++i) {
+        log.info("Tests", "Message");
+    }
+
+    // The queue is full, the error waits for the receiver instead
+    std::thread error([&log] { log.error("Tests", "Error"); });
+    release = true;
+    error.join();
+
+    BOOST_REQUIRE(!messages.empty());
+    BOOST_CHECK_EQUAL(messages.back(), "Error");
+    BOOST_CHECK_EQUAL(messages.size(), 6u);
+    BOOST_CHECK_EQUAL(receiver.flushes, 1);
+    log.stopAsync();
+}
+
+BOOST_AUTO_TEST_CASE(test_bounded_queue) {
+    BoundedQueue<int> queue(3);
+    BOOST_CHECK_EQUAL(queue.getCapacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        BOOST_CHECK(queue.tryPush(int(i)));
+    }
+    BOOST_CHECK(!queue.tryPush(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        BOOST_REQUIRE(queue.tryPop(value));
+        BOOST_CHECK_EQUAL(value, i);
+    }
+    BOOST_CHECK(!queue.tryPop(value));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+#include <boost/test/unit_test.hpp>
+#include <data/CollisionModel.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <render/OcclusionBuffer.hpp>
+
+namespace {
+/// Looks down +x from the origin, like ViewCamera
+glm::mat4 viewProjection() {
+    auto view = glm::lookAt(glm::vec3(0.f), glm::vec3(1.f, 0.f, 0.f),
+                            glm::vec3(0.f, 0.f, 1.f));
+    auto proj = glm::perspective(glm::radians(60.f), 2.f, 0.1f, 1000.f);
+    return proj * view;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(OcclusionBufferTests)
+
+BOOST_AUTO_TEST_CASE(test_empty_buffer) {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK(buffer.isVisible(glm::vec3(50.f, 0.f, 0.f), 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_wall_occludes) {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+    buffer.addBox(glm::mat4(1.f), {20.f, -5.f, -5.f}, {21.f, 5.f, 5.f});
+    BOOST_CHECK(!buffer.empty());
+
+    // Depth of the front face in the middle of the screen
+    BOOST_CHECK_CLOSE(
+        buffer.getDepth(buffer.getWidth() / 2, buffer.getHeight() / 2),
+        1.f / 20.f, 1.f);
+
+    // Behind
+    BOOST_CHECK(!buffer.isVisible(glm::vec3(50.f, 0.f, 0.f), 2.f));
+    // In front
+    BOOST_CHECK(buffer.isVisible(glm::vec3(10.f, 0.f, 0.f), 2.f));
+    // Behind, but sticking out past the edge
+    BOOST_CHECK(buffer.isVisible(glm::vec3(50.f, 14.f, 0.f), 2.f));
+    // Far off to the side
+    BOOST_CHECK(buffer.isVisible(glm::vec3(50.f, 25.f, 0.f), 2.f));
+    // Around the camera
+    BOOST_CHECK(buffer.isVisible(glm::vec3(0.f), 2.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_depth_bias) {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+    buffer.addBox(glm::mat4(1.f), {20.f, -5.f, -5.f}, {21.f, 5.f, 5.f});
+
+    // Only hidden once it's further than the bias behind the front face
+    BOOST_CHECK(!buffer.isVisible(glm::vec3(21.5f, 0.f, 0.f), 0.1f));
+    BOOST_CHECK(buffer.isVisible(glm::vec3(20.6f, 0.f, 0.f), 0.1f));
+}
+
+BOOST_AUTO_TEST_CASE(test_near_plane) {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+
+    // Only the inside of the far face can be drawn, the rest is behind the
+    // camera and skipped
+    buffer.addBox(glm::mat4(1.f), {-5.f, -100.f, -100.f},
+                  {30.f, 100.f, 100.f});
+    BOOST_CHECK(buffer.isVisible(glm::vec3(10.f, 0.f, 0.f), 1.f));
+    BOOST_CHECK(!buffer.isVisible(glm::vec3(50.f, 0.f, 0.f), 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_collision_model) {
+    CollisionModel collision;
+    collision.vertices = {
+        {0.f, -5.f, -5.f}, {0.f, 5.f, -5.f}, {0.f, 5.f, 5.f}, {0.f, -5.f, 5.f}};
+    collision.faces = {{{0, 1, 2}, {}}, {{0, 2, 3}, {}}};
+
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+    auto transform = glm::translate(glm::mat4(1.f), glm::vec3(20.f, 0.f, 0.f));
+    BOOST_CHECK_EQUAL(buffer.addCollision(transform, collision), 2);
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 2);
+
+    BOOST_CHECK(!buffer.isVisible(glm::vec3(50.f, 0.f, 0.f), 2.f));
+    BOOST_CHECK(buffer.isVisible(glm::vec3(50.f, 14.f, 0.f), 2.f));
+
+    // Starting a new frame forgets the occluders
+    buffer.begin(viewProjection());
+    BOOST_CHECK(buffer.isVisible(glm::vec3(50.f, 0.f, 0.f), 2.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_occluder_score) {
+    const glm::vec3 camera(0.f);
+    const auto radius = OcclusionBuffer::kMinOccluderRadius;
+    BOOST_CHECK_EQUAL(
+        OcclusionBuffer::occluderScore(camera, {50.f, 0.f, 0.f}, radius / 2.f),
+        0.f);
+    BOOST_CHECK_GT(
+        OcclusionBuffer::occluderScore(camera, {50.f, 0.f, 0.f}, radius * 2.f),
+        OcclusionBuffer::occluderScore(camera, {50.f, 0.f, 0.f}, radius));
+    BOOST_CHECK_GT(
+        OcclusionBuffer::occluderScore(camera, {50.f, 0.f, 0.f}, radius),
+        OcclusionBuffer::occluderScore(camera, {100.f, 0.f, 0.f}, radius));
+    // Being inside the occluder is as good as it gets
+    BOOST_CHECK_EQUAL(
+        OcclusionBuffer::occluderScore(camera, {1.f, 0.f, 0.f}, radius), 1.f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
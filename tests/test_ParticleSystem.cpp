@@ -0,0 +1,106 @@
+#include <boost/test/unit_test.hpp>
+#include <render/ParticleSystem.hpp>
+#include "test_Globals.hpp"
+
+namespace {
+// The particle system never reads textures, so a fake handle will do. It
+// still releases its GL name on destruction, which needs a context.
+TextureData::Handle makeTexture() {
+    Global::get();
+    return std::make_shared<TextureData>(0, glm::ivec2(1, 1), false);
+}
+
+ParticleSystem::Particle makeParticle(const TextureData::Handle& texture,
+                                      float lifetime = -1.f) {
+    ParticleSystem::Particle particle;
+    particle.texture = texture;
+    particle.lifetime = lifetime;
+    return particle;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(ParticleSystemTests)
+
+BOOST_AUTO_TEST_CASE(test_pool_per_texture) {
+    ParticleSystem system;
+    auto texA = makeTexture();
+    auto texB = makeTexture();
+
+    system.spawn(makeParticle(texA));
+    system.spawn(makeParticle(texA));
+    system.spawn(makeParticle(texB));
+
+    BOOST_REQUIRE_EQUAL(system.getPools().size(), 2);
+    BOOST_CHECK_EQUAL(system.getPools()[0]->getCount(), 2);
+    BOOST_CHECK_EQUAL(system.getPools()[1]->getCount(), 1);
+    BOOST_CHECK_EQUAL(system.getParticleCount(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_handles_survive_removal) {
+    ParticleSystem system;
+    auto tex = makeTexture();
+
+    auto a = system.spawn(makeParticle(tex));
+    auto b = system.spawn(makeParticle(tex));
+    auto c = system.spawn(makeParticle(tex));
+
+    system.remove(a);
+    BOOST_CHECK(!system.isValid(a));
+    BOOST_CHECK(system.isValid(b));
+    BOOST_CHECK(system.isValid(c));
+
+    // c was moved into a's place, and must still be addressable
+    system.setPosition(c, glm::vec3(1.f, 2.f, 3.f));
+    const auto& pool = *system.getPools()[0];
+    BOOST_REQUIRE_EQUAL(pool.getCount(), 2);
+    BOOST_CHECK_EQUAL(pool.getPosition(0), glm::vec3(1.f, 2.f, 3.f));
+
+    // Removing twice, or through a reused slot, must be harmless
+    system.remove(a);
+    auto d = system.spawn(makeParticle(tex));
+    system.remove(a);
+    BOOST_CHECK(system.isValid(d));
+    BOOST_CHECK_EQUAL(system.getParticleCount(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_expiry) {
+    ParticleSystem system;
+    auto tex = makeTexture();
+
+    auto forever = system.spawn(makeParticle(tex));
+    auto shortLived = system.spawn(makeParticle(tex, 0.5f));
+    auto longLived = system.spawn(makeParticle(tex, 2.f));
+
+    system.tick(1.f, 0.f);
+    BOOST_CHECK(system.isValid(forever));
+    BOOST_CHECK(!system.isValid(shortLived));
+    BOOST_CHECK(system.isValid(longLived));
+
+    system.clearTransient();
+    BOOST_CHECK(system.isValid(forever));
+    BOOST_CHECK(!system.isValid(longLived));
+}
+
+BOOST_AUTO_TEST_CASE(test_integration) {
+    ParticleSystem system;
+    auto particle = makeParticle(makeTexture());
+    particle.velocity = glm::vec3(0.f, 0.f, 2.f);
+    system.spawn(particle);
+
+    system.tick(0.f, 0.5f);
+
+    BOOST_CHECK_EQUAL(system.getPools()[0]->getPosition(0),
+                      glm::vec3(0.f, 0.f, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_capacity) {
+    ParticleSystem system(2);
+    auto tex = makeTexture();
+
+    BOOST_CHECK(system.isValid(system.spawn(makeParticle(tex))));
+    BOOST_CHECK(system.isValid(system.spawn(makeParticle(tex))));
+    BOOST_CHECK(!system.isValid(system.spawn(makeParticle(tex))));
+    BOOST_CHECK_EQUAL(system.getDroppedCount(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
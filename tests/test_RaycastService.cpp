@@ -0,0 +1,125 @@
+#include <boost/test/unit_test.hpp>
+#include <btBulletDynamicsCommon.h>
+#include <core/JobSystem.hpp>
+#include <dynamics/RaycastService.hpp>
+
+#include <vector>
+
+namespace {
+/// A collision world with flat ground at z = 0, and a crate on it at x = 5
+struct TestWorld {
+    btDefaultCollisionConfiguration config;
+    btCollisionDispatcher dispatcher{&config};
+    btDbvtBroadphase broadphase;
+    btCollisionWorld world{&dispatcher, &broadphase, &config};
+
+    btBoxShape groundShape{btVector3(100.f, 100.f, 1.f)};
+    btBoxShape crateShape{btVector3(1.f, 1.f, 1.f)};
+    btCollisionObject ground;
+    btCollisionObject crate;
+
+    TestWorld() {
+        ground.setCollisionShape(&groundShape);
+        ground.getWorldTransform().setOrigin(btVector3(0.f, 0.f, -1.f));
+        world.addCollisionObject(&ground);
+
+        crate.setCollisionShape(&crateShape);
+        crate.setCollisionFlags(0);
+        crate.getWorldTransform().setOrigin(btVector3(5.f, 0.f, 1.f));
+        world.addCollisionObject(&crate);
+    }
+
+    ~TestWorld() {
+        world.removeCollisionObject(&crate);
+        world.removeCollisionObject(&ground);
+    }
+};
+
+glm::vec3 above(float x, float y) {
+    return {x, y, 10.f};
+}
+
+glm::vec3 below(float x, float y) {
+    return {x, y, -10.f};
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(RaycastServiceTests)
+
+BOOST_AUTO_TEST_CASE(test_cast_filters) {
+    TestWorld test;
+    RaycastService raycasts(test.broadphase);
+
+    auto hit = raycasts.cast(above(5.f, 0.f), below(5.f, 0.f));
+    BOOST_REQUIRE(hit.hit);
+    BOOST_CHECK(hit.object == &test.crate);
+    BOOST_CHECK_CLOSE(hit.position.z, 2.f, 0.1f);
+    BOOST_CHECK_CLOSE(hit.normal.z, 1.f, 0.1f);
+
+    // The crate isn't static
+    hit = raycasts.cast(above(5.f, 0.f), below(5.f, 0.f),
+                        RaycastService::Filter::Static);
+    BOOST_REQUIRE(hit.hit);
+    BOOST_CHECK(hit.object == &test.ground);
+    BOOST_CHECK_SMALL(hit.position.z, 0.01f);
+
+    hit = raycasts.cast(above(500.f, 0.f), below(500.f, 0.f));
+    BOOST_CHECK(!hit.hit);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_matches_cast) {
+    TestWorld test;
+    RaycastService raycasts(test.broadphase);
+    JobSystem jobs(3);
+
+    std::vector<glm::vec2> points;
+    std::vector<RaycastService::Handle> handles;
+    for (float x = -20.f; x < 20.f; x += 0.5f) {
+        for (float y = -5.f; y < 5.f; y += 0.5f) {
+            points.emplace_back(x, y);
+            handles.push_back(raycasts.queue(above(x, y), below(x, y)));
+        }
+    }
+    raycasts.flush(jobs);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto& p = points[i];
+        const auto& batched = raycasts.getResult(handles[i]);
+        auto single = raycasts.cast(above(p.x, p.y), below(p.x, p.y));
+        BOOST_CHECK_EQUAL(batched.hit, single.hit);
+        BOOST_CHECK(batched.object == single.object);
+        BOOST_CHECK_EQUAL(batched.position.z, single.position.z);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_frame_cache) {
+    TestWorld test;
+    RaycastService raycasts(test.broadphase);
+    JobSystem jobs(1);
+    const auto filter = RaycastService::Filter::Static;
+
+    {
+        RaycastService::Frame frame(raycasts);
+        raycasts.cast(above(1.f, 1.f), below(1.f, 1.f), filter);
+        auto handle = raycasts.queue(above(1.f, 1.f), below(1.f, 1.f), filter);
+        raycasts.flush(jobs);
+        BOOST_CHECK(raycasts.getResult(handle).object == &test.ground);
+
+        // Only static geometry is cached
+        raycasts.cast(above(5.f, 0.f), below(5.f, 0.f));
+        raycasts.cast(above(5.f, 0.f), below(5.f, 0.f));
+
+        const auto& stats = raycasts.getStats();
+        BOOST_CHECK_EQUAL(stats.requested, 4u);
+        BOOST_CHECK_EQUAL(stats.cast, 3u);
+        BOOST_CHECK_EQUAL(stats.cached, 1u);
+        BOOST_CHECK(!raycasts.isOverBudget());
+    }
+
+    // The cache ends with the frame
+    raycasts.cast(above(1.f, 1.f), below(1.f, 1.f), filter);
+    BOOST_CHECK_EQUAL(raycasts.getStats().cached, 1u);
+    BOOST_CHECK_EQUAL(raycasts.getStats().cast, 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
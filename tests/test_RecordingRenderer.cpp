@@ -0,0 +1,178 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/DrawBuffer.hpp>
+#include <render/ObjectRenderer.hpp>
+#include <render/RecordingRenderer.hpp>
+#include "test_Globals.hpp"
+
+#if RW_TEST_WITH_DATA
+#include <engine/GameWorld.hpp>
+#include <objects/CharacterObject.hpp>
+#include <render/ViewCamera.hpp>
+#endif
+
+namespace {
+Renderer::RenderInstruction makeInstruction(RenderKey key, DrawBuffer* dbuff,
+                                            GLuint texture, size_t count,
+                                            BlendMode blend =
+                                                BlendMode::BLEND_NONE) {
+    Renderer::DrawParameters dp;
+    dp.start = 0;
+    dp.count = count;
+    dp.textures = {texture};
+    dp.blendMode = blend;
+    return {key, glm::mat4(1.f), dbuff, dp};
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(RecordingRendererTests)
+
+BOOST_AUTO_TEST_CASE(test_batched_draws_are_recorded) {
+    DrawBuffer a, b;
+    RecordingRenderer renderer;
+    RenderList list{
+        makeInstruction(6, &a, 1, 30),  makeInstruction(5, &a, 1, 12),
+        makeInstruction(4, &a, 2, 9),   makeInstruction(3, &b, 2, 3),
+        makeInstruction(2, &b, 2, 6),   makeInstruction(1, &b, 3, 9),
+    };
+
+    renderer.drawBatched(list);
+
+    const auto& stats = renderer.getStats();
+    BOOST_CHECK_EQUAL(stats.draws, 6);
+    BOOST_CHECK_EQUAL(stats.primitives, 69);
+    BOOST_CHECK_EQUAL(stats.bufferChanges, 2);
+    BOOST_CHECK_EQUAL(stats.textureChanges, 3);
+    BOOST_CHECK_EQUAL(stats.blendChanges, 0);
+    BOOST_CHECK_EQUAL(stats.depthWriteChanges, 1);
+    BOOST_CHECK_EQUAL(stats.bytesUploaded,
+                      6 * sizeof(Renderer::ObjectUniformData));
+    BOOST_CHECK_EQUAL(renderer.getDrawCount(), 6);
+    BOOST_CHECK_EQUAL(renderer.getBufferCount(), 2);
+    BOOST_CHECK_EQUAL(renderer.getTextureCount(), 3);
+
+    const auto& commands = renderer.getCommands();
+    BOOST_REQUIRE_EQUAL(commands.size(), list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+        BOOST_CHECK(commands[i].type ==
+                    RecordingRenderer::CommandType::DrawBatched);
+        BOOST_CHECK_EQUAL(commands[i].key, list[i].sortKey);
+        BOOST_CHECK_EQUAL(commands[i].dbuff, list[i].dbuff);
+        BOOST_CHECK_EQUAL(commands[i].count, list[i].drawInfo.count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_state_cache) {
+    DrawBuffer a;
+    RecordingRenderer renderer;
+    auto program = renderer.createShader("", "");
+    RenderList list{makeInstruction(1, &a, 1, 3), makeInstruction(1, &a, 1, 3)};
+
+    renderer.useProgram(program.get());
+    renderer.setUniform(program.get(), "colour", glm::vec4(1.f));
+    renderer.drawBatched(list);
+    renderer.useProgram(program.get());
+    renderer.drawBatched(list);
+
+    BOOST_CHECK_EQUAL(renderer.getStats().programChanges, 1);
+    BOOST_CHECK_EQUAL(renderer.getStats().uniformSets, 1);
+    BOOST_CHECK_EQUAL(renderer.getStats().bufferChanges, 1);
+    BOOST_CHECK_EQUAL(renderer.getStats().textureChanges, 1);
+
+    // Reset keeps the state, as GL would between frames
+    renderer.reset();
+    BOOST_CHECK(renderer.getCommands().empty());
+    renderer.drawBatched(list);
+    BOOST_CHECK_EQUAL(renderer.getStats().bufferChanges, 0);
+    BOOST_CHECK_EQUAL(renderer.getStats().textureChanges, 0);
+
+    // Invalidating forgets it
+    renderer.invalidate();
+    renderer.useProgram(program.get());
+    renderer.drawBatched(list);
+    BOOST_CHECK_EQUAL(renderer.getStats().programChanges, 1);
+    BOOST_CHECK_EQUAL(renderer.getStats().bufferChanges, 1);
+    BOOST_CHECK_EQUAL(renderer.getStats().textureChanges, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_debug_groups) {
+    DrawBuffer a, b;
+    RecordingRenderer renderer;
+
+    renderer.pushDebugGroup("Outer");
+    renderer.drawBatched({makeInstruction(1, &a, 1, 3)});
+    renderer.pushDebugGroup("Inner");
+    renderer.drawBatched(
+        {makeInstruction(1, &b, 2, 6), makeInstruction(1, &b, 2, 6)});
+    const auto inner = renderer.popDebugGroup();
+    const auto outer = renderer.popDebugGroup();
+
+    BOOST_CHECK_EQUAL(inner.draws, 2);
+    BOOST_CHECK_EQUAL(inner.primitives, 12);
+    BOOST_CHECK_EQUAL(inner.buffers, 1);
+    BOOST_CHECK_EQUAL(outer.draws, 3);
+    BOOST_CHECK_EQUAL(outer.primitives, 15);
+    BOOST_CHECK_EQUAL(outer.buffers, 2);
+    BOOST_CHECK_EQUAL(outer.textures, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_sort_render_list) {
+    DrawBuffer a;
+    RenderList list{
+        makeInstruction(1, &a, 1, 3, BlendMode::BLEND_ALPHA),
+        makeInstruction(2, &a, 1, 3),
+        makeInstruction(3, &a, 1, 3, BlendMode::BLEND_ALPHA),
+        makeInstruction(4, &a, 1, 3),
+    };
+
+    ObjectRenderer::sortRenderList(list);
+
+    // Opaque first, each part from the highest key
+    BOOST_CHECK_EQUAL(list[0].sortKey, 4);
+    BOOST_CHECK_EQUAL(list[1].sortKey, 2);
+    BOOST_CHECK_EQUAL(list[2].sortKey, 3);
+    BOOST_CHECK_EQUAL(list[3].sortKey, 1);
+
+    RecordingRenderer renderer;
+    renderer.drawBatched(list);
+    BOOST_CHECK_EQUAL(renderer.getStats().blendChanges, 1);
+}
+
+#if RW_TEST_WITH_DATA
+BOOST_AUTO_TEST_CASE(test_world_render_list) {
+    auto world = Global::get().e;
+
+    std::vector<GameObject*> peds;
+    for (int i = 0; i < 8; ++i) {
+        peds.push_back(
+            world->createPedestrian(1, {10.f + i * 2.f, i * 1.f, 0.f}));
+    }
+
+    ViewCamera camera;
+    auto view = camera.getView();
+    camera.frustum.update(camera.frustum.projection() * view);
+
+    ObjectRenderer objectRenderer(world, camera, 1.f, 0);
+    RenderList list;
+    objectRenderer.buildWorldRenderList(nullptr, nullptr, list);
+    ObjectRenderer::sortRenderList(list);
+    BOOST_CHECK(!list.empty());
+
+    RecordingRenderer renderer;
+    renderer.drawBatched(list);
+
+    const auto& stats = renderer.getStats();
+    BOOST_CHECK_EQUAL(stats.draws, list.size());
+    BOOST_CHECK_LE(stats.bufferChanges, list.size());
+    BOOST_CHECK_LE(stats.textureChanges, list.size());
+    BOOST_REQUIRE_EQUAL(renderer.getCommands().size(), list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+        BOOST_CHECK_EQUAL(renderer.getCommands()[i].key, list[i].sortKey);
+    }
+
+    for (auto ped : peds) {
+        world->destroyObject(ped);
+    }
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,317 @@
+#include <boost/test/unit_test.hpp>
+#include "test_Globals.hpp"
+
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include <ai/RoutePlanner.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <queue>
+#include <random>
+
+#if RW_TEST_WITH_DATA
+#include <data/InstanceData.hpp>
+#include <data/ModelData.hpp>
+#include <engine/GameData.hpp>
+#include <loaders/LoaderIPL.hpp>
+#endif
+
+namespace {
+AIGraphNode* addNode(AIGraph& graph, const glm::vec3& position,
+                     AIGraphNode::NodeType type = AIGraphNode::Pedestrian) {
+    auto node = new AIGraphNode;
+    node->type = type;
+    node->position = position;
+    node->size = 1.f;
+    node->other_thing = 0;
+    node->other_thing2 = 0;
+    node->external = false;
+    node->flags = AIGraphNode::None;
+    node->nextIndex = -1;
+    node->disabled = false;
+    graph.nodes.push_back(node);
+    return node;
+}
+
+void connect(AIGraphNode* a, AIGraphNode* b) {
+    a->connections.push_back(b);
+    b->connections.push_back(a);
+}
+
+/// Grid of jittered nodes with some connections left out
+void makeGrid(AIGraph& graph, int size, unsigned seed) {
+    std::default_random_engine re(seed);
+    std::uniform_real_distribution<float> jitter(-3.f, 3.f);
+    std::uniform_int_distribution<int> drop(0, 4);
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            addNode(graph,
+                    {x * 10.f + jitter(re), y * 10.f + jitter(re), 0.f});
+        }
+    }
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            auto node = graph.nodes[y * size + x];
+            if (x + 1 < size && drop(re) != 0) {
+                connect(node, graph.nodes[y * size + x + 1]);
+            }
+            if (y + 1 < size && drop(re) != 0) {
+                connect(node, graph.nodes[(y + 1) * size + x]);
+            }
+        }
+    }
+}
+
+/// Dijkstra over the nodes themselves, to check the planner against
+float shortestDistance(AIGraphNode* start, AIGraphNode* goal) {
+    using Entry = std::pair<float, AIGraphNode*>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    std::map<AIGraphNode*, float> cost;
+    open.push({0.f, start});
+    cost[start] = 0.f;
+    while (!open.empty()) {
+        auto top = open.top();
+        open.pop();
+        if (top.second == goal) {
+            return top.first;
+        }
+        if (top.first > cost[top.second]) {
+            continue;
+        }
+        for (auto next : top.second->connections) {
+            if (next->disabled || next->type != start->type) {
+                continue;
+            }
+            float c = top.first + glm::distance(top.second->position,
+                                                next->position);
+            auto it = cost.find(next);
+            if (it == cost.end() || c < it->second) {
+                cost[next] = c;
+                open.push({c, next});
+            }
+        }
+    }
+    return -1.f;
+}
+
+float routeLength(const RoutePlanner::Route& route) {
+    float length = 0.f;
+    for (size_t i = 1; i < route.size(); ++i) {
+        auto& c = route[i - 1]->connections;
+        BOOST_REQUIRE(std::find(c.begin(), c.end(), route[i]) != c.end());
+        length += glm::distance(route[i - 1]->position, route[i]->position);
+    }
+    return length;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(RoutePlannerTests)
+
+BOOST_AUTO_TEST_CASE(test_shortest_routes) {
+    AIGraph graph;
+    makeGrid(graph, 20, 7);
+    RoutePlanner planner(graph);
+
+    std::default_random_engine re(11);
+    std::uniform_int_distribution<size_t> pick(0, graph.nodes.size() - 1);
+    for (int i = 0; i < 50; ++i) {
+        auto start = graph.nodes[pick(re)];
+        auto goal = graph.nodes[pick(re)];
+        auto route = planner.findRoute(start, goal, AIGraphNode::Pedestrian);
+        float expected = shortestDistance(start, goal);
+
+        if (expected < 0.f) {
+            BOOST_CHECK(route == nullptr);
+            continue;
+        }
+        BOOST_REQUIRE(route != nullptr);
+        BOOST_CHECK_EQUAL(route->front(), start);
+        BOOST_CHECK_EQUAL(route->back(), goal);
+        BOOST_CHECK_CLOSE(routeLength(*route) + 1.f, expected + 1.f, 0.01f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_disabled_and_types) {
+    AIGraph graph;
+    auto a = addNode(graph, {0.f, 0.f, 0.f});
+    auto b = addNode(graph, {10.f, 0.f, 0.f});
+    auto c = addNode(graph, {20.f, 0.f, 0.f});
+    auto detour = addNode(graph, {10.f, 20.f, 0.f});
+    auto road = addNode(graph, {0.f, 10.f, 0.f}, AIGraphNode::Vehicle);
+    connect(a, b);
+    connect(b, c);
+    connect(a, detour);
+    connect(detour, c);
+    connect(a, road);
+
+    RoutePlanner planner(graph);
+    auto route = planner.findRoute(a, c, AIGraphNode::Pedestrian);
+    BOOST_REQUIRE(route != nullptr);
+    BOOST_CHECK_EQUAL(route->size(), 3u);
+    BOOST_CHECK_EQUAL((*route)[1], b);
+
+    // Different types never mix
+    BOOST_CHECK(planner.findRoute(a, road, AIGraphNode::Pedestrian) ==
+                nullptr);
+    BOOST_CHECK(planner.findRoute(a, road, AIGraphNode::Vehicle) == nullptr);
+
+    b->disabled = true;
+    planner.invalidate();
+    route = planner.findRoute(a, c, AIGraphNode::Pedestrian);
+    BOOST_REQUIRE(route != nullptr);
+    BOOST_CHECK_EQUAL((*route)[1], detour);
+
+    detour->disabled = true;
+    planner.invalidate();
+    BOOST_CHECK(planner.findRoute(a, c, AIGraphNode::Pedestrian) == nullptr);
+
+    BOOST_CHECK_EQUAL(planner.findNearestNode({9.f, 1.f, 0.f},
+                                              AIGraphNode::Pedestrian),
+                      a);
+}
+
+BOOST_AUTO_TEST_CASE(test_cache) {
+    AIGraph graph;
+    makeGrid(graph, 10, 3);
+    RoutePlanner planner(graph, 2);
+
+    auto n = [&](size_t i) { return graph.nodes[i]; };
+    auto first = planner.findRoute(n(0), n(99), AIGraphNode::Pedestrian);
+    BOOST_CHECK_EQUAL(planner.getCacheMisses(), 1u);
+    BOOST_CHECK_EQUAL(planner.findRoute(n(0), n(99), AIGraphNode::Pedestrian),
+                      first);
+    BOOST_CHECK_EQUAL(planner.getCacheHits(), 1u);
+
+    planner.findRoute(n(1), n(98), AIGraphNode::Pedestrian);
+    planner.findRoute(n(2), n(97), AIGraphNode::Pedestrian);
+    BOOST_CHECK_EQUAL(planner.getCacheSize(), 2u);
+
+    // The oldest route was dropped
+    planner.findRoute(n(0), n(99), AIGraphNode::Pedestrian);
+    BOOST_CHECK_EQUAL(planner.getCacheMisses(), 4u);
+
+    // Adding nodes clears the cache
+    addNode(graph, {500.f, 500.f, 0.f});
+    planner.findRoute(n(0), n(99), AIGraphNode::Pedestrian);
+    BOOST_CHECK_EQUAL(planner.getCacheMisses(), 5u);
+    BOOST_CHECK_EQUAL(planner.getNodeCount(), 101u);
+}
+
+BOOST_AUTO_TEST_CASE(test_time_sliced) {
+    AIGraph graph;
+    makeGrid(graph, 20, 5);
+    RoutePlanner immediate(graph, 0);
+    RoutePlanner sliced(graph, 0);
+
+    auto start = graph.nodes[0];
+    auto goal = graph.nodes[399];
+    auto expected = immediate.findRoute(start, goal, AIGraphNode::Pedestrian);
+    BOOST_REQUIRE(expected != nullptr);
+
+    auto first = sliced.requestRoute(start, goal, AIGraphNode::Pedestrian);
+    auto second = sliced.requestRoute(goal, start, AIGraphNode::Pedestrian);
+    auto cancelled = sliced.requestRoute(start, goal, AIGraphNode::Vehicle);
+    sliced.cancelRoute(cancelled);
+
+    RoutePlanner::RoutePtr route;
+    int updates = 0;
+    while (sliced.collectRoute(first, route) ==
+           RoutePlanner::QueryStatus::Pending) {
+        sliced.update(10);
+        updates++;
+    }
+    BOOST_CHECK_GT(updates, 1);
+    BOOST_REQUIRE(route != nullptr);
+    BOOST_CHECK(*route == *expected);
+
+    while (sliced.collectRoute(second, route) ==
+           RoutePlanner::QueryStatus::Pending) {
+        sliced.update(10);
+    }
+    BOOST_REQUIRE(route != nullptr);
+    BOOST_CHECK_EQUAL(route->front(), goal);
+    BOOST_CHECK_EQUAL(route->back(), start);
+
+    BOOST_CHECK(sliced.collectRoute(first, route) ==
+                RoutePlanner::QueryStatus::Unknown);
+    BOOST_CHECK(sliced.collectRoute(cancelled, route) ==
+                RoutePlanner::QueryStatus::Unknown);
+}
+
+#if RW_TEST_WITH_DATA
+BOOST_AUTO_TEST_CASE(test_benchmark_city) {
+    // Build the path graph of the whole city the same way instances do
+    auto data = Global::get().d;
+    AIGraph graph;
+    for (const auto& ipl : data->iplLocations) {
+        LoaderIPL loader;
+        if (!loader.load(ipl.second)) {
+            continue;
+        }
+        for (const auto& inst : loader.m_instances) {
+            auto it = data->modelinfo.find(inst->id);
+            if (it == data->modelinfo.end() ||
+                it->second->type() != ModelDataType::SimpleInfo) {
+                continue;
+            }
+            auto simple = static_cast<SimpleModelInfo*>(it->second.get());
+            for (auto& path : simple->paths) {
+                graph.createPathNodes(inst->pos, inst->rot, path);
+            }
+        }
+    }
+    BOOST_REQUIRE(!graph.nodes.empty());
+
+    for (auto type : {AIGraphNode::Vehicle, AIGraphNode::Pedestrian}) {
+        std::vector<AIGraphNode*> typed;
+        for (auto node : graph.nodes) {
+            if (node->type == type) {
+                typed.push_back(node);
+            }
+        }
+        if (typed.empty()) {
+            continue;
+        }
+
+        std::default_random_engine re(1);
+        std::uniform_int_distribution<size_t> pick(0, typed.size() - 1);
+        std::vector<std::pair<AIGraphNode*, AIGraphNode*>> queries;
+        for (int i = 0; i < 200; ++i) {
+            queries.emplace_back(typed[pick(re)], typed[pick(re)]);
+        }
+
+        RoutePlanner planner(graph);
+        using Clock = std::chrono::steady_clock;
+        auto measure = [&] {
+            auto start = Clock::now();
+            size_t found = 0;
+            for (auto& q : queries) {
+                found += planner.findRoute(q.first, q.second, type) ? 1 : 0;
+            }
+            std::chrono::duration<double, std::milli> ms = Clock::now() - start;
+            return std::make_pair(ms.count(), found);
+        };
+
+        auto cold = measure();
+        const size_t expanded = planner.getExpandedCount();
+        auto warm = measure();
+
+        // Cached routes don't search again
+        BOOST_CHECK_EQUAL(cold.second, warm.second);
+        BOOST_CHECK_EQUAL(planner.getExpandedCount(), expanded);
+
+        BOOST_TEST_MESSAGE((type == AIGraphNode::Vehicle ? "Vehicle" : "Ped")
+                           << " graph: " << typed.size() << " nodes, "
+                           << queries.size() << " queries, " << cold.second
+                           << " routes, " << expanded << " expansions, "
+                           << cold.first << " ms cold, " << warm.first
+                           << " ms cached");
+    }
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,69 +1,158 @@
 #include <boost/test/unit_test.hpp>
+#include <core/Logger.hpp>
+#include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <engine/SaveGame.hpp>
+#include <script/SCMFile.hpp>
 #include <script/ScriptMachine.hpp>
+#include <script/ScriptModule.hpp>
 
-#include "test_Globals.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+char scmData[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+                  0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                  0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x28, 0x00, 0x00,
+                  0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                  0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+const char* kSavePath = "test_savegame.b";
+
+/// A world and script to save from and load into, no game data required
+struct SaveGameFixture {
+    Logger log;
+    GameData data{&log, "."};
+    GameWorld world{&log, &data};
+    SCMFile scm;
+    ScriptModule module{"test"};
+
+    SaveGameFixture() {
+        scm.loadFile(scmData, sizeof(scmData));
+    }
+
+    ~SaveGameFixture() {
+        std::remove(kSavePath);
+    }
+};
+}  // namespace
 
-#if 0  // Disabled until we make a start on saving the game
 BOOST_AUTO_TEST_SUITE(SaveGameTests)
 
-BOOST_AUTO_TEST_CASE(test_write_state)
-{
-	GameState state;
-
-	// Set some test data
-	state.world = nullptr;
-	state.currentProgress = 10;
-	state.maxProgress = 124;
-	state.numMissions = 12;
-	state.numHiddenPackages = 34;
-	state.numHiddenPackagesDiscovered = 11;
-	state.numUniqueJumps = 14;
-	state.numRampages = 7;
-	state.maxWantedLevel = 5;
-	state.currentWeather = 9;
-	state.overrideNextStart = true;
-	state.hour = 13;
-	state.minute = 32;
-
-	// This may break due to cwd issues
-	SaveGame::writeState(state, "test_savestate.sav");
-
-	GameState loaded;
-	loaded.world = nullptr;
-
-	BOOST_REQUIRE( SaveGame::loadState(loaded, "test_savestate.sav") );
-	BOOST_CHECK( loaded.world == nullptr );
-	BOOST_CHECK_EQUAL( loaded.currentProgress, state.currentProgress );
-	BOOST_CHECK_EQUAL( loaded.maxProgress, state.maxProgress );
-	BOOST_CHECK_EQUAL( loaded.numMissions, state.numMissions );
-	BOOST_CHECK_EQUAL( loaded.numHiddenPackages, state.numHiddenPackages );
-	BOOST_CHECK_EQUAL( loaded.numHiddenPackagesDiscovered, state.numHiddenPackagesDiscovered );
-	BOOST_CHECK_EQUAL( loaded.numUniqueJumps, state.numUniqueJumps );
-	BOOST_CHECK_EQUAL( loaded.numRampages, state.numRampages );
-	BOOST_CHECK_EQUAL( loaded.maxWantedLevel, state.maxWantedLevel );
-	BOOST_CHECK_EQUAL( loaded.currentWeather, state.currentWeather );
-	BOOST_CHECK_EQUAL( loaded.overrideNextStart, state.overrideNextStart );
-	BOOST_CHECK_EQUAL( loaded.hour, state.hour );
-	BOOST_CHECK_EQUAL( loaded.minute, state.minute );
-	
-	// Check Garage data + garage vehicle restoration
+BOOST_AUTO_TEST_CASE(test_save_info_missing_file) {
+    BasicState basic;
+    BOOST_CHECK(!SaveGame::getSaveInfo("does_not_exist.b", &basic));
 }
 
-BOOST_AUTO_TEST_CASE(test_load_game)
-{
-	GameState state;
-	GameWorld world();
-	SCMOpcodes s;
-	auto file = Global::get().d->loadSCM("main.scm");
-	ScriptMachine machine(&state, file, &s);
-	
-	state.world = Global::get().e;
-	state.script = &machine;
-
-	BOOST_REQUIRE( SaveGame::loadGame(state, "GTA3sf1.b") );
+BOOST_FIXTURE_TEST_CASE(test_save_info, SaveGameFixture) {
+    GameState state;
+    state.basic.saveName[0] = 'A';
+    state.basic.gameHour = 13;
+    state.basic.gameMinute = 32;
+    state.basic.cameraPosition = glm::vec3(1.f, 2.f, 3.f);
+
+    BOOST_REQUIRE(SaveGame::writeGame(state, kSavePath));
+
+    BasicState basic;
+    BOOST_REQUIRE(SaveGame::getSaveInfo(kSavePath, &basic));
+    BOOST_CHECK_EQUAL(basic.saveName[0], 'A');
+    BOOST_CHECK_EQUAL(basic.gameHour, 13);
+    BOOST_CHECK_EQUAL(basic.gameMinute, 32);
+    BOOST_CHECK_EQUAL(basic.cameraPosition.z, 3.f);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_round_trip, SaveGameFixture) {
+    GameState state;
+    ScriptMachine machine(&state, &scm, &module);
+    state.world = &world;
+    state.script = &machine;
+    world.state = &state;
+
+    state.basic.timeMS = 123456;
+    state.basic.lastTick = 120000;
+    state.playerInfo.money = 1500;
+    state.gameStats.playerKills = 7;
+    state.gameStats.distanceWalked = 42.5f;
+    state.importExportPortland.set(3);
+    state.garages.emplace_back(0, glm::vec3(1.f, 2.f, 3.f),
+                               glm::vec3(4.f, 5.f, 6.f), GarageType::Respray);
+    state.vehicleGenerators.emplace_back(0, glm::vec3(10.f, 20.f, 30.f), 90.f,
+                                         111, 1, 2, true, 0, 0, 1000, 2000, 0,
+                                         101);
+    machine.getGlobals()[4] = 0x5A;
+    state.scriptOnMissionFlag =
+        reinterpret_cast<int32_t*>(machine.getGlobals() + 4);
+    machine.startThread(0x28);
+    machine.getThreads().back().wakeCounter = 500;
+
+    BOOST_REQUIRE(SaveGame::writeGame(state, kSavePath));
+
+    GameState loaded;
+    ScriptMachine loadedMachine(&loaded, &scm, &module);
+    loaded.world = &world;
+    loaded.script = &loadedMachine;
+    world.state = &loaded;
+
+    BOOST_REQUIRE(SaveGame::loadGame(loaded, kSavePath));
+
+    BOOST_CHECK_EQUAL(loaded.basic.timeMS, 123456u);
+    BOOST_CHECK_EQUAL(loaded.playerInfo.money, 1500u);
+    BOOST_CHECK_EQUAL(loaded.gameStats.playerKills, 7u);
+    BOOST_CHECK_EQUAL(loaded.gameStats.distanceWalked, 42.5f);
+    BOOST_CHECK(loaded.importExportPortland.test(3));
+
+    BOOST_REQUIRE_EQUAL(loaded.garages.size(), 1u);
+    BOOST_CHECK(loaded.garages[0].type == GarageType::Respray);
+    BOOST_CHECK_EQUAL(loaded.garages[0].max.y, 5.f);
+
+    BOOST_REQUIRE_EQUAL(loaded.vehicleGenerators.size(), 1u);
+    BOOST_CHECK_EQUAL(loaded.vehicleGenerators[0].vehicleID, 111);
+    BOOST_CHECK_EQUAL(loaded.vehicleGenerators[0].position.y, 20.f);
+    BOOST_CHECK_EQUAL(loaded.vehicleGenerators[0].minDelay, 1000);
+
+    BOOST_CHECK_EQUAL(loadedMachine.getGlobals()[4], 0x5A);
+    BOOST_CHECK_EQUAL(reinterpret_cast<SCMByte*>(loaded.scriptOnMissionFlag),
+                      loadedMachine.getGlobals() + 4);
+
+    BOOST_REQUIRE_EQUAL(loadedMachine.getThreads().size(), 1u);
+    const auto& thread = loadedMachine.getThreads().back();
+    BOOST_CHECK_EQUAL(thread.programCounter, 0x28u);
+    BOOST_CHECK_EQUAL(thread.wakeCounter, 500);
+    BOOST_CHECK_EQUAL(std::string(thread.name), "THREAD");
+
+    world.state = nullptr;
+}
+
+BOOST_FIXTURE_TEST_CASE(test_truncated_save, SaveGameFixture) {
+    GameState state;
+    ScriptMachine machine(&state, &scm, &module);
+    state.world = &world;
+    state.script = &machine;
+
+    BOOST_REQUIRE(SaveGame::writeGame(state, kSavePath));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(kSavePath, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(kSavePath, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(),
+                  static_cast<std::streamsize>(bytes.size() / 2));
+    }
+
+    GameState loaded;
+    ScriptMachine loadedMachine(&loaded, &scm, &module);
+    loaded.world = &world;
+    loaded.script = &loadedMachine;
+
+    BOOST_CHECK(!SaveGame::loadGame(loaded, kSavePath));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
-#endif
@@ -1,6 +1,14 @@
 #include <boost/test/unit_test.hpp>
+#include <core/Logger.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <script/SCMFile.hpp>
 #include <script/ScriptMachine.hpp>
+#include <script/ScriptModule.hpp>
+
+#include <algorithm>
+#include <vector>
 
 SCMByte data[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
                   0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -8,6 +16,44 @@ SCMByte data[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
                   0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                   0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
+/// Header followed by two threads that wait 1024 and 10 ms forever
+SCMByte waitData[] = {
+    0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x18,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x01, 0x28, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x05, 0x00, 0x04, 0x01, 0x00, 0x05, 0x0A, 0x00};
+
+namespace {
+std::vector<SCMThread::pc_t> waitRuns;
+
+/// Waits without moving on, so each thread keeps waiting for the same time
+void waitForever(const ScriptArguments& args) {
+    auto thread = args.getThread();
+    waitRuns.push_back(thread->baseAddress);
+    thread->wakeCounter = args[0].integerValue();
+    thread->programCounter = thread->baseAddress;
+}
+
+/// A machine running waitData, no game data required
+struct WaitFixture {
+    Logger log;
+    GameData gameData{&log, "."};
+    GameWorld world{&log, &gameData};
+    SCMFile file;
+    GameState state;
+    ScriptModule module{"test"};
+
+    WaitFixture() {
+        file.loadFile(waitData, sizeof(waitData));
+        state.world = &world;
+        world.state = &state;
+        module.bind(0x0001, 1, waitForever);
+        waitRuns.clear();
+    }
+};
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(ScriptMachineTests)
 
 BOOST_AUTO_TEST_CASE(scmfile_test) {
@@ -19,4 +65,100 @@ BOOST_AUTO_TEST_CASE(scmfile_test) {
     BOOST_CHECK_EQUAL(f.getCodeSection(), 0x28);
 }
 
+BOOST_AUTO_TEST_CASE(test_snapshot_restore) {
+    SCMFile f;
+    f.loadFile(data, sizeof(data));
+    ScriptModule module("test");
+    GameState state;
+    ScriptMachine machine(&state, &f, &module);
+
+    machine.startThread(0x28);
+    machine.getGlobals()[0] = 0x11;
+    auto globals = machine.getGlobals();
+
+    auto snapshot = machine.createSnapshot();
+    auto expectedRandom = machine.getRandomNumber(0, 1000);
+
+    machine.getGlobals()[0] = 0x22;
+    machine.getThreads().back().programCounter = 0x30;
+    machine.startThread(0x28);
+
+    machine.restoreSnapshot(snapshot);
+
+    BOOST_CHECK(machine.getGlobals() == globals);
+    BOOST_CHECK_EQUAL(machine.getGlobals()[0], 0x11);
+    BOOST_REQUIRE_EQUAL(machine.getThreads().size(), 1u);
+    BOOST_CHECK_EQUAL(machine.getThreads().back().programCounter, 0x28u);
+    BOOST_CHECK_EQUAL(machine.getRandomNumber(0, 1000), expectedRandom);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_sleeping_threads, WaitFixture) {
+    auto& runs = waitRuns;
+    ScriptMachine machine(&state, &file, &module);
+    machine.startThread(0x30);
+    machine.startThread(0x35);
+
+    machine.execute(0.016f);
+    BOOST_CHECK_EQUAL(machine.getRunningThreadCount(), 2);
+    BOOST_CHECK_EQUAL(machine.getSleepingThreadCount(), 2);
+    BOOST_REQUIRE_EQUAL(runs.size(), 2);
+    BOOST_CHECK_EQUAL(runs[0], 0x30u);
+    BOOST_CHECK_EQUAL(runs[1], 0x35u);
+
+    // Only the short wait is visited until the long one runs out at 1040 ms
+    runs.clear();
+    for (int i = 1; i < 64; ++i) {
+        machine.execute(0.016f);
+        BOOST_CHECK_EQUAL(machine.getRunningThreadCount(), 1);
+    }
+    BOOST_CHECK_EQUAL(runs.size(), 63);
+    BOOST_CHECK(std::all_of(runs.begin(), runs.end(),
+                            [](SCMThread::pc_t pc) { return pc == 0x35u; }));
+
+    // Woken threads still run in the order they were started
+    runs.clear();
+    machine.execute(0.016f);
+    BOOST_REQUIRE_EQUAL(runs.size(), 2);
+    BOOST_CHECK_EQUAL(runs[0], 0x30u);
+    BOOST_CHECK_EQUAL(runs[1], 0x35u);
+
+    // Looking at the threads wakes them with the time they had left
+    machine.execute(0.016f);
+    auto& threads = machine.getThreads();
+    BOOST_CHECK_EQUAL(machine.getSleepingThreadCount(), 0);
+    BOOST_CHECK_EQUAL(threads.front().wakeCounter, 1024 - 16);
+
+    // Finishing a thread removes it
+    threads.front().finished = true;
+    machine.execute(0.016f);
+    BOOST_CHECK_EQUAL(machine.getThreads().size(), 1);
+    BOOST_CHECK_EQUAL(machine.getThreads().front().baseAddress, 0x35u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_profiling, WaitFixture) {
+    ScriptMachine machine(&state, &file, &module);
+    BOOST_CHECK(machine.getProfiler() == nullptr);
+    machine.setProfiling(true);
+    machine.startThread(0x30);
+    machine.startThread(0x35);
+    for (int i = 0; i < 4; ++i) {
+        machine.execute(0.016f);
+    }
+
+    auto profiler = machine.getProfiler();
+    BOOST_REQUIRE(profiler != nullptr);
+    BOOST_CHECK_EQUAL(profiler->getInstructionCount(), 5);
+    auto opcodes = profiler->getOpcodes();
+    BOOST_REQUIRE_EQUAL(opcodes.size(), 1);
+    BOOST_CHECK_EQUAL(opcodes[0].name, "0001");
+    BOOST_CHECK_EQUAL(opcodes[0].count, 5);
+    // Both threads share the name, each waits from its own block
+    BOOST_REQUIRE_EQUAL(profiler->getThreads().size(), 1);
+    BOOST_CHECK_EQUAL(profiler->getThreads()[0].name, "THREAD");
+    BOOST_CHECK_EQUAL(profiler->getBlocks().size(), 2);
+
+    machine.setProfiling(false);
+    BOOST_CHECK(machine.getProfiler() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
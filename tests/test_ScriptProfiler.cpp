@@ -0,0 +1,76 @@
+#include <boost/test/unit_test.hpp>
+#include <script/ScriptProfiler.hpp>
+
+#include <sstream>
+
+namespace {
+using std::chrono::microseconds;
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ScriptProfilerTests)
+
+BOOST_AUTO_TEST_CASE(test_summaries) {
+    ScriptProfiler profiler;
+    profiler.record("MAIN", 0x100, 0x108, 0x0001, microseconds(5));
+    profiler.record("MAIN", 0x100, 0x110, 0x00D6, microseconds(1));
+    profiler.record("MAIN", 0x200, 0x205, 0x0001, microseconds(2));
+    profiler.record("MAIN", 0x100, 0x108, 0x0001, microseconds(5));
+    profiler.record("MISSION1", 0x300, 0x304, 0x0002, microseconds(20));
+
+    BOOST_CHECK_EQUAL(profiler.getInstructionCount(), 5);
+    BOOST_CHECK(profiler.getTotalTime() == microseconds(33));
+
+    auto threads = profiler.getThreads();
+    BOOST_REQUIRE_EQUAL(threads.size(), 2);
+    BOOST_CHECK_EQUAL(threads[0].name, "MISSION1");
+    BOOST_CHECK_EQUAL(threads[1].name, "MAIN");
+    BOOST_CHECK_EQUAL(threads[1].count, 4);
+    BOOST_CHECK(threads[1].time == microseconds(13));
+
+    auto blocks = profiler.getBlocks();
+    BOOST_REQUIRE_EQUAL(blocks.size(), 3);
+    BOOST_CHECK_EQUAL(blocks[1].name, "MAIN@000100-000110");
+    BOOST_CHECK_EQUAL(blocks[1].count, 3);
+
+    auto opcodes = profiler.getOpcodes();
+    BOOST_REQUIRE_EQUAL(opcodes.size(), 3);
+    BOOST_CHECK_EQUAL(opcodes[0].name, "0002");
+    BOOST_CHECK_EQUAL(opcodes[1].name, "0001");
+    BOOST_CHECK_EQUAL(opcodes[1].count, 3);
+    BOOST_CHECK_EQUAL(opcodes[2].name, "00d6");
+
+    profiler.reset();
+    BOOST_CHECK_EQUAL(profiler.getInstructionCount(), 0);
+    BOOST_CHECK(profiler.getThreads().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_unterminated_thread_name) {
+    const char name[16] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
+                           'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P'};
+    ScriptProfiler profiler;
+    profiler.record(name, 0, 4, 1, microseconds(1));
+    BOOST_CHECK_EQUAL(profiler.getThreads()[0].name, "ABCDEFGHIJKLMNOP");
+}
+
+BOOST_AUTO_TEST_CASE(test_export) {
+    ScriptProfiler profiler;
+    profiler.record("MAIN", 0x100, 0x108, 0x0001, microseconds(5));
+    profiler.record("MAIN", 0x100, 0x110, 0x00D6, microseconds(1));
+
+    std::stringstream folded;
+    profiler.writeFolded(folded);
+    BOOST_CHECK_EQUAL(folded.str(),
+                      "MAIN;@000100-000110;0001 5000\n"
+                      "MAIN;@000100-000110;00d6 1000\n");
+
+    std::stringstream csv;
+    profiler.writeCSV(csv);
+    BOOST_CHECK_EQUAL(csv.str(),
+                      "type,name,count,total_us,mean_us\n"
+                      "thread,MAIN,2,6.000,3.000\n"
+                      "block,MAIN@000100-000110,2,6.000,3.000\n"
+                      "opcode,0001,1,5.000,5.000\n"
+                      "opcode,00d6,1,1.000,1.000\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,58 @@
+#include <boost/test/unit_test.hpp>
+#include <audio/SoundClipCache.hpp>
+
+namespace {
+SoundClipCache::ClipPtr makeClip(size_t samples) {
+    auto clip = std::make_shared<SoundClip>();
+    clip->samples.resize(samples);
+    clip->channels = 1;
+    clip->sampleRate = 22050;
+    return clip;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SoundClipCacheTests)
+
+BOOST_AUTO_TEST_CASE(test_find) {
+    SoundClipCache cache(100);
+    auto clip = makeClip(10);
+    cache.insert("a.wav", clip);
+
+    BOOST_CHECK(cache.find("a.wav") == clip);
+    BOOST_CHECK(cache.find("b.wav") == nullptr);
+    BOOST_CHECK_EQUAL(cache.getSize(), 20u);
+}
+
+BOOST_AUTO_TEST_CASE(test_evict_least_recent) {
+    SoundClipCache cache(100);
+    cache.insert("a.wav", makeClip(20));
+    cache.insert("b.wav", makeClip(20));
+    cache.find("a.wav");
+
+    // Needs 40 of the remaining 20 bytes, b is the least recently used
+    auto held = makeClip(20);
+    cache.insert("c.wav", held);
+    BOOST_CHECK(cache.find("a.wav") != nullptr);
+    BOOST_CHECK(cache.find("b.wav") == nullptr);
+    BOOST_CHECK_EQUAL(cache.getSize(), 80u);
+
+    // Evicted clips stay valid for whoever holds them
+    cache.clear();
+    BOOST_CHECK_EQUAL(held->samples.size(), 20u);
+    BOOST_CHECK_EQUAL(cache.getCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_oversized) {
+    SoundClipCache cache(100);
+    cache.insert("a.wav", makeClip(10));
+    cache.insert("big.wav", makeClip(60));
+
+    BOOST_CHECK(cache.find("big.wav") == nullptr);
+    BOOST_CHECK(cache.find("a.wav") != nullptr);
+
+    // Replacing a clip releases the old one's size
+    cache.insert("a.wav", makeClip(5));
+    BOOST_CHECK_EQUAL(cache.getSize(), 10u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
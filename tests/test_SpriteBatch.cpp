@@ -0,0 +1,82 @@
+#include <boost/test/unit_test.hpp>
+#include <render/SpriteBatch.hpp>
+
+BOOST_AUTO_TEST_SUITE(SpriteBatchTests)
+
+BOOST_AUTO_TEST_CASE(test_rect_vertices) {
+    SpriteBatch batch;
+    batch.addRect(1, {10.f, 20.f, 30.f, 40.f}, {0.f, 0.f, 1.f, 1.f},
+                  glm::u8vec4(255, 0, 0, 255), true);
+
+    std::vector<SpriteVertex> vertices;
+    std::vector<SpriteBatch::Batch> batches;
+    batch.build(vertices, batches);
+
+    BOOST_REQUIRE_EQUAL(vertices.size(), 6u);
+    BOOST_CHECK_EQUAL(vertices[0].position.x, 10.f);
+    BOOST_CHECK_EQUAL(vertices[0].position.y, 20.f);
+    BOOST_CHECK_EQUAL(vertices[2].position.x, 40.f);
+    BOOST_CHECK_EQUAL(vertices[2].position.y, 60.f);
+    BOOST_CHECK_EQUAL(vertices[2].texcoord.x, 1.f);
+    BOOST_CHECK_EQUAL(vertices[2].texcoord.y, 1.f);
+    BOOST_CHECK_EQUAL(vertices[4].texcoord.x, 0.f);
+    BOOST_CHECK_EQUAL(vertices[4].texcoord.y, 1.f);
+    BOOST_CHECK_EQUAL(vertices[0].colour.r, 255);
+    BOOST_CHECK_EQUAL(vertices[0].colour.g, 0);
+    BOOST_CHECK_EQUAL(vertices[0].alphaOnly, 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(test_texture_batches) {
+    SpriteBatch batch;
+    const glm::vec4 rect(0.f, 0.f, 1.f, 1.f);
+    batch.addRect(2, rect, rect, glm::u8vec4(1));
+    batch.addRect(1, rect, rect, glm::u8vec4(2));
+    batch.addRect(2, rect, rect, glm::u8vec4(3));
+    batch.addRect(1, rect, rect, glm::u8vec4(4));
+
+    std::vector<SpriteVertex> vertices;
+    std::vector<SpriteBatch::Batch> batches;
+    batch.build(vertices, batches);
+
+    BOOST_REQUIRE_EQUAL(batches.size(), 2u);
+    BOOST_CHECK_EQUAL(batches[0].texture, 1u);
+    BOOST_CHECK_EQUAL(batches[0].start, 0);
+    BOOST_CHECK_EQUAL(batches[0].count, 12);
+    BOOST_CHECK_EQUAL(batches[1].texture, 2u);
+    BOOST_CHECK_EQUAL(batches[1].start, 12);
+    BOOST_CHECK_EQUAL(batches[1].count, 12);
+
+    // Quads sharing a texture keep the order they were added in
+    BOOST_CHECK_EQUAL(vertices[0].colour.r, 2);
+    BOOST_CHECK_EQUAL(vertices[6].colour.r, 4);
+    BOOST_CHECK_EQUAL(vertices[12].colour.r, 1);
+    BOOST_CHECK_EQUAL(vertices[18].colour.r, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_layers) {
+    SpriteBatch batch;
+    const glm::vec4 rect(0.f, 0.f, 1.f, 1.f);
+    batch.setLayer(1);
+    batch.addRect(1, rect, rect, glm::u8vec4(1));
+    batch.setLayer(0);
+    batch.addRect(2, rect, rect, glm::u8vec4(2));
+    batch.addRect(1, rect, rect, glm::u8vec4(3));
+
+    std::vector<SpriteVertex> vertices;
+    std::vector<SpriteBatch::Batch> batches;
+    batch.build(vertices, batches);
+
+    // Layers are drawn in order even when that splits a texture
+    BOOST_REQUIRE_EQUAL(batches.size(), 3u);
+    BOOST_CHECK_EQUAL(batches[0].texture, 1u);
+    BOOST_CHECK_EQUAL(batches[1].texture, 2u);
+    BOOST_CHECK_EQUAL(batches[2].texture, 1u);
+    BOOST_CHECK_EQUAL(vertices[0].colour.r, 3);
+    BOOST_CHECK_EQUAL(vertices[12].colour.r, 1);
+
+    batch.clear();
+    BOOST_CHECK(batch.empty());
+    BOOST_CHECK_EQUAL(batch.getLayer(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
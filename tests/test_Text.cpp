@@ -2,12 +2,57 @@
 #include <data/GameTexts.hpp>
 #include <engine/ScreenText.hpp>
 #include <loaders/LoaderGXT.hpp>
+#include <render/TextLayoutCache.hpp>
 #include "test_Globals.hpp"
 
 #define T(x) GameStringUtil::fromString(x)
 
 BOOST_AUTO_TEST_SUITE(TextTests)
 
+BOOST_AUTO_TEST_CASE(layout_cache) {
+    TextLayoutCache cache(2);
+
+    const auto& layout = cache.layout(T("Hi ~r~there"), 0, 10.f, 0, false);
+    BOOST_REQUIRE_EQUAL(layout.glyphs.size(), 8u);
+    BOOST_CHECK(layout.glyphs[0].useBaseColour);
+    BOOST_CHECK(!layout.glyphs[3].useBaseColour);
+    BOOST_CHECK_EQUAL(layout.glyphs[3].colour.r, 113);
+    BOOST_CHECK_EQUAL(layout.glyphs[1].rect.x,
+                      layout.glyphs[0].rect.x + layout.glyphs[0].rect.z);
+    BOOST_CHECK_EQUAL(layout.size.y, 10.f);
+
+    cache.layout(T("Hi ~r~there"), 0, 10.f, 0, false);
+    BOOST_CHECK_EQUAL(cache.getHits(), 1u);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 1u);
+
+    // Forcing the colour is a different layout
+    const auto& forced = cache.layout(T("Hi ~r~there"), 0, 10.f, 0, true);
+    BOOST_CHECK(forced.glyphs[3].useBaseColour);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 2u);
+
+    // The least recently used layout is evicted
+    cache.layout(T("Other"), 0, 10.f, 0, false);
+    BOOST_CHECK_EQUAL(cache.getSize(), 2u);
+    cache.layout(T("Hi ~r~there"), 0, 10.f, 0, false);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(layout_wrap) {
+    TextLayoutCache cache;
+
+    const auto& layout = cache.layout(T("one two three"), 0, 10.f, 5, false);
+    BOOST_REQUIRE_EQUAL(layout.glyphs.size(), 13u);
+    BOOST_CHECK_EQUAL(layout.glyphs[4].rect.y, 10.f);
+    BOOST_CHECK_EQUAL(layout.glyphs[4].rect.x, 0.f);
+    // The last word is never wrapped
+    BOOST_CHECK_EQUAL(layout.glyphs[8].rect.y, 10.f);
+    BOOST_CHECK_EQUAL(layout.size.y, 20.f);
+
+    const auto& lines = cache.layout(T("a\nb"), 0, 10.f, 0, false);
+    BOOST_REQUIRE_EQUAL(lines.glyphs.size(), 2u);
+    BOOST_CHECK_EQUAL(lines.glyphs[1].rect.y, 10.f);
+}
+
 #if RW_TEST_WITH_DATA
 BOOST_AUTO_TEST_CASE(load_test) {
     {
@@ -0,0 +1,242 @@
+#include <boost/test/unit_test.hpp>
+#include <loaders/RWBinaryStream.hpp>
+#include <loaders/TextureCache.hpp>
+#include <platform/FileHandle.hpp>
+#include <rw/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#if RW_TEST_WITH_DATA
+#include "test_Globals.hpp"
+#endif
+
+namespace {
+struct CacheFixture {
+    rwfs::path root = rwfs::temp_directory_path() / "rwtest_texturecache";
+
+    CacheFixture() {
+        rwfs::remove_all(root);
+    }
+
+    ~CacheFixture() {
+        rwfs::remove_all(root);
+    }
+};
+
+FileHandle makeFile(const std::string& contents) {
+    auto data = new char[contents.size()];
+    std::memcpy(data, contents.data(), contents.size());
+    return std::make_shared<FileContentsInfo>(data, contents.size());
+}
+
+/// A TXD holding one texture for a platform the loader doesn't support
+FileHandle makeUnsupportedTXD() {
+    RW::BSTextureNative native{};
+    native.platform = 9;
+    std::strcpy(native.diffuseName, "ps2");
+    RW::BSTextureDictionary dictionary{1, 0};
+
+    const uint32_t header = sizeof(RW::BSSectionHeader);
+    const uint32_t nativeSize = header + sizeof(native);
+    const RW::BSSectionHeader sections[] = {
+        {RW::SID_TextureDictionary,
+         header + sizeof(dictionary) + header + nativeSize, 0},
+        {RW::SID_Struct, sizeof(dictionary), 0},
+        {RW::SID_TextureNative, nativeSize, 0},
+        {RW::SID_Struct, sizeof(native), 0},
+    };
+
+    std::string contents;
+    auto append = [&](const void* data, size_t size) {
+        contents.append(static_cast<const char*>(data), size);
+    };
+    append(&sections[0], header);
+    append(&sections[1], header);
+    append(&dictionary, sizeof(dictionary));
+    append(&sections[2], header);
+    append(&sections[3], header);
+    append(&native, sizeof(native));
+    return makeFile(contents);
+}
+
+/// A gradient texture with its full mip chain
+DecodedTexture makeTexture(const std::string& name, int width, int height) {
+    DecodedTexture texture;
+    texture.name = name;
+    texture.size = {width, height};
+    texture.transparent = true;
+    texture.filterflags = 0x1106;
+    texture.wrapU = 1;
+    texture.wrapV = 2;
+    texture.levels.emplace_back(size_t(width) * height);
+    for (size_t i = 0; i < texture.levels[0].size(); ++i) {
+        texture.levels[0][i] = uint32_t(i * 0x01020304u);
+    }
+    TextureLoader::generateMips(texture);
+    return texture;
+}
+
+void checkSame(const DecodedTexture& a, const DecodedTexture& b) {
+    BOOST_CHECK_EQUAL(a.name, b.name);
+    BOOST_CHECK(a.size == b.size);
+    BOOST_CHECK_EQUAL(a.transparent, b.transparent);
+    BOOST_CHECK_EQUAL(a.filterflags, b.filterflags);
+    BOOST_CHECK_EQUAL(a.wrapU, b.wrapU);
+    BOOST_CHECK_EQUAL(a.wrapV, b.wrapV);
+    BOOST_CHECK(a.levels == b.levels);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureCacheTests)
+
+BOOST_AUTO_TEST_CASE(test_make_key) {
+    const auto a = TextureCache::makeKey(makeFile("texture dictionary"), 4);
+    const auto b = TextureCache::makeKey(makeFile("texture dictionarz"), 4);
+    BOOST_CHECK_EQUAL(a.offset, 4u);
+    BOOST_CHECK_EQUAL(a.size, 18u);
+    BOOST_CHECK_NE(a.hash, b.hash);
+    BOOST_CHECK_NE(TextureCache::getFileName(a), TextureCache::getFileName(b));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_store_load, CacheFixture) {
+    const std::vector<DecodedTexture> textures{makeTexture("road", 8, 4),
+                                               makeTexture("grass", 3, 5)};
+    const TextureCache::Key key{10, 2048, 1234};
+
+    {
+        TextureCache cache(root);
+        BOOST_CHECK(!cache.contains(key));
+        BOOST_REQUIRE(cache.store(key, textures));
+        BOOST_CHECK(cache.contains(key));
+        BOOST_CHECK_EQUAL(cache.getEntryCount(), 1u);
+        const auto path = root / TextureCache::getFileName(key);
+        BOOST_CHECK_EQUAL(cache.getSize(), rwfs::file_size(path));
+    }
+
+    // A new instance finds the entry on disk
+    TextureCache cache(root);
+    std::vector<DecodedTexture> loaded;
+    BOOST_REQUIRE(cache.load(key, loaded));
+    BOOST_REQUIRE_EQUAL(loaded.size(), 2u);
+    checkSame(loaded[0], textures[0]);
+    checkSame(loaded[1], textures[1]);
+
+    const TextureCache::Key other{10, 2048, 1235};
+    BOOST_CHECK(!cache.load(other, loaded));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_corrupt_entry, CacheFixture) {
+    const TextureCache::Key key{0, 100, 5};
+    TextureCache cache(root);
+    BOOST_REQUIRE(cache.store(key, {makeTexture("sign", 16, 16)}));
+
+    // Truncate the pixels, the header still matches
+    const auto path = root / TextureCache::getFileName(key);
+    rwfs::resize_file(path, rwfs::file_size(path) / 2);
+
+    std::vector<DecodedTexture> loaded;
+    BOOST_CHECK(!cache.load(key, loaded));
+    BOOST_CHECK(loaded.empty());
+
+    // Garbage instead of a header
+    std::ofstream(path.string(), std::ios_base::trunc) << "not a cache";
+    BOOST_CHECK(!cache.load(key, loaded));
+}
+
+BOOST_FIXTURE_TEST_CASE(test_without_mips, CacheFixture) {
+    const auto texture = makeTexture("wall", 16, 8);
+    const TextureCache::Key key{0, 100, 6};
+
+    TextureCache full(root / "full");
+    BOOST_REQUIRE(full.store(key, {texture}));
+
+    TextureCache small(root / "small");
+    small.setStoreMips(false);
+    BOOST_REQUIRE(small.store(key, {texture}));
+    BOOST_CHECK_LT(small.getSize(), full.getSize());
+
+    // The levels that weren't stored are rebuilt the same way
+    std::vector<DecodedTexture> loaded;
+    BOOST_REQUIRE(small.load(key, loaded));
+    BOOST_REQUIRE_EQUAL(loaded.size(), 1u);
+    checkSame(loaded[0], texture);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_eviction, CacheFixture) {
+    const TextureCache::Key a{0, 1, 1};
+    const TextureCache::Key b{0, 1, 2};
+    const TextureCache::Key c{0, 1, 3};
+    const std::vector<DecodedTexture> textures{makeTexture("tex", 32, 32)};
+
+    uint64_t entrySize = 0;
+    {
+        TextureCache cache(root);
+        BOOST_REQUIRE(cache.store(a, textures));
+        entrySize = cache.getSize();
+        BOOST_REQUIRE(cache.store(b, textures));
+        // Use a again, so b is the oldest
+        std::vector<DecodedTexture> loaded;
+        BOOST_REQUIRE(cache.load(a, loaded));
+    }
+
+    // Use times survive between instances
+    TextureCache cache(root, entrySize * 2);
+    BOOST_REQUIRE(cache.store(c, textures));
+    BOOST_CHECK_EQUAL(cache.getStats().evictions, 1u);
+    BOOST_CHECK(cache.contains(a));
+    BOOST_CHECK(!cache.contains(b));
+    BOOST_CHECK(cache.contains(c));
+    BOOST_CHECK(!rwfs::exists(root / TextureCache::getFileName(b)));
+    BOOST_CHECK_EQUAL(cache.getSize(), entrySize * 2);
+
+    // Lowering the limit evicts on open
+    TextureCache smaller(root, entrySize);
+    BOOST_CHECK_EQUAL(smaller.getEntryCount(), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_decode_failure, CacheFixture) {
+    TextureCache cache(root);
+    std::vector<DecodedTexture> textures;
+    BOOST_CHECK(!cache.decode(makeUnsupportedTXD(), 0, textures));
+
+    // The texture is still there, without any pixels, and isn't stored
+    BOOST_REQUIRE_EQUAL(textures.size(), 1u);
+    BOOST_CHECK_EQUAL(textures[0].name, "ps2");
+    BOOST_CHECK(textures[0].levels.empty());
+    BOOST_CHECK_EQUAL(cache.getEntryCount(), 0u);
+    BOOST_CHECK_EQUAL(cache.getStats().misses, 1u);
+}
+
+#if RW_TEST_WITH_DATA
+BOOST_FIXTURE_TEST_CASE(test_decode_txd, CacheFixture) {
+    std::ifstream in(Global::getGamePath() + "/models/generic.txd",
+                     std::ios_base::binary | std::ios_base::ate);
+    BOOST_REQUIRE(in.is_open());
+    const auto length = size_t(in.tellg());
+    in.seekg(0);
+    auto data = new char[length];
+    in.read(data, length);
+    auto file = std::make_shared<FileContentsInfo>(data, length);
+
+    TextureLoader loader;
+    std::vector<DecodedTexture> expected;
+    BOOST_REQUIRE(loader.decodeFromMemory(file, expected));
+
+    TextureCache cache(root);
+    cache.setValidate(true);
+    std::vector<DecodedTexture> textures;
+    BOOST_CHECK(cache.decode(file, 0, textures));
+    BOOST_CHECK(cache.decode(file, 0, textures));
+    BOOST_CHECK_EQUAL(cache.getStats().misses, 1u);
+    BOOST_CHECK_EQUAL(cache.getStats().hits, 1u);
+    BOOST_CHECK_EQUAL(cache.getStats().invalid, 0u);
+    BOOST_REQUIRE_EQUAL(textures.size(), expected.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        checkSame(textures[i], expected[i]);
+    }
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
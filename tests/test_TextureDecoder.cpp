@@ -0,0 +1,157 @@
+#include <boost/test/unit_test.hpp>
+#include <loaders/TextureDecoder.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#if RW_TEST_WITH_DATA
+#include <loaders/LoaderIMG.hpp>
+#include <loaders/LoaderTXD.hpp>
+#include <platform/FileHandle.hpp>
+#include "test_Globals.hpp"
+#endif
+
+namespace {
+const TextureDecoder::InstructionSet kInstructionSets[] = {
+    TextureDecoder::InstructionSet::Scalar,
+    TextureDecoder::InstructionSet::SSSE3,
+    TextureDecoder::InstructionSet::AVX2,
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureDecoderTests)
+
+BOOST_AUTO_TEST_CASE(test_expand_1555) {
+    TextureDecoder decoder(TextureDecoder::InstructionSet::Scalar);
+    const std::vector<uint16_t> in{0x0000, 0xFFFF, 0x801F, 0x03E0,
+                                   0x7C00, 0x0210};
+    std::vector<uint32_t> out(in.size());
+    decoder.expand1555(in.data(), out.data(), in.size());
+
+    BOOST_CHECK_EQUAL(out[0], 0x00000000u);
+    BOOST_CHECK_EQUAL(out[1], 0xFFFFFFFFu);
+    BOOST_CHECK_EQUAL(out[2], 0xFF0000FFu);
+    BOOST_CHECK_EQUAL(out[3], 0x0000FF00u);
+    BOOST_CHECK_EQUAL(out[4], 0x00FF0000u);
+    // Green 16 and red 16 expand to 132
+    BOOST_CHECK_EQUAL(out[5], 0x00008484u);
+}
+
+BOOST_AUTO_TEST_CASE(test_swizzle_and_palette) {
+    TextureDecoder decoder(TextureDecoder::InstructionSet::Scalar);
+    const uint32_t bgra = 0x11223344;
+    uint32_t rgba = 0;
+    decoder.swizzleBGRA(&bgra, &rgba, 1);
+    BOOST_CHECK_EQUAL(rgba, 0x11443322u);
+
+    const uint32_t palette[256] = {0x01020304, 0x05060708};
+    const uint8_t indices[] = {1, 0, 1};
+    uint32_t out[3] = {};
+    decoder.expandPalette(indices, palette, out, 3);
+    BOOST_CHECK_EQUAL(out[0], 0x05060708u);
+    BOOST_CHECK_EQUAL(out[1], 0x01020304u);
+    BOOST_CHECK_EQUAL(out[2], 0x05060708u);
+}
+
+BOOST_AUTO_TEST_CASE(test_instruction_sets_match) {
+    // Not a multiple of any vector width, so the tails are covered too
+    constexpr size_t kCount = 1003;
+    std::mt19937 random(1);
+    std::vector<uint8_t> indices(kCount);
+    std::vector<uint16_t> packed(kCount);
+    std::vector<uint32_t> palette(256), pixels(kCount);
+    for (auto& i : indices) i = static_cast<uint8_t>(random());
+    for (auto& p : packed) p = static_cast<uint16_t>(random());
+    for (auto& p : palette) p = random();
+    for (auto& p : pixels) p = random();
+
+    TextureDecoder scalar(TextureDecoder::InstructionSet::Scalar);
+    std::vector<uint32_t> expectPalette(kCount), expect1555(kCount),
+        expectBGRA(kCount);
+    scalar.expandPalette(indices.data(), palette.data(), expectPalette.data(),
+                         kCount);
+    scalar.expand1555(packed.data(), expect1555.data(), kCount);
+    scalar.swizzleBGRA(pixels.data(), expectBGRA.data(), kCount);
+
+    for (auto set : kInstructionSets) {
+        TextureDecoder decoder(set);
+        BOOST_CHECK(decoder.getInstructionSet() <=
+                    TextureDecoder::getBestInstructionSet());
+
+        std::vector<uint32_t> out(kCount);
+        decoder.expandPalette(indices.data(), palette.data(), out.data(),
+                              kCount);
+        BOOST_CHECK(out == expectPalette);
+        decoder.expand1555(packed.data(), out.data(), kCount);
+        BOOST_CHECK(out == expect1555);
+        decoder.swizzleBGRA(pixels.data(), out.data(), kCount);
+        BOOST_CHECK(out == expectBGRA);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_downsample) {
+    // Channels are averaged separately, rounding to nearest
+    const uint32_t square[] = {0x00000000, 0x04040404, 0x08080808, 0xFF0000FF};
+    uint32_t out[2] = {};
+    TextureDecoder::downsample(square, 2, 2, out);
+    BOOST_CHECK_EQUAL(out[0], 0x43030343u);
+
+    // The odd column is dropped
+    const uint32_t row[] = {0x00000010, 0x00000020, 0x000000FF};
+    TextureDecoder::downsample(row, 3, 1, out);
+    BOOST_CHECK_EQUAL(out[0], 0x00000018u);
+
+    // A single column is only halved in height
+    const uint32_t column[] = {0x10, 0x20, 0x30, 0x40};
+    TextureDecoder::downsample(column, 1, 4, out);
+    BOOST_CHECK_EQUAL(out[0], 0x18u);
+    BOOST_CHECK_EQUAL(out[1], 0x38u);
+}
+
+#if RW_TEST_WITH_DATA
+BOOST_AUTO_TEST_CASE(benchmark_img_textures) {
+    LoaderIMG archive;
+    BOOST_REQUIRE(archive.load(Global::getGamePath() + "/models/gta3"));
+
+    std::vector<FileHandle> files;
+    for (uint32_t i = 0; i < archive.getAssetCount(); ++i) {
+        const auto& asset = archive.getAssetInfoByIndex(i);
+        std::string name = asset.name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txd") == 0) {
+            auto data = archive.loadToMemory(name);
+            if (data) {
+                files.push_back(std::make_shared<FileContentsInfo>(
+                    data, asset.size * 2048));
+            }
+        }
+    }
+    BOOST_REQUIRE(!files.empty());
+
+    TextureLoader loader;
+    size_t textures = 0;
+    size_t pixels = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& file : files) {
+        std::vector<DecodedTexture> decoded;
+        BOOST_CHECK(loader.decodeFromMemory(file, decoded));
+        for (const auto& texture : decoded) {
+            textures++;
+            for (const auto& level : texture.levels) {
+                pixels += level.size();
+            }
+        }
+    }
+    auto seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    BOOST_CHECK_GT(textures, 0u);
+    BOOST_TEST_MESSAGE("Decoded " << textures << " textures from "
+                                  << files.size() << " TXDs, " << pixels
+                                  << " pixels with mips, in "
+                                  << seconds * 1000.0 << "ms");
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#include <boost/test/unit_test.hpp>
+#include <core/TimerWheel.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+using Wheel = TimerWheel<int>;
+
+/// Advances one tick at a time, recording when each item expired
+std::vector<std::pair<int, Wheel::Time>> run(Wheel& wheel, Wheel::Time until,
+                                             Wheel::Time step = 1) {
+    std::vector<std::pair<int, Wheel::Time>> expired;
+    while (wheel.getTime() < until) {
+        wheel.advance(std::min(wheel.getTime() + step, until), [&](int item) {
+            expired.emplace_back(item, wheel.getTime());
+        });
+    }
+    return expired;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TimerWheelTests)
+
+BOOST_AUTO_TEST_CASE(test_expires_on_time) {
+    Wheel wheel;
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 5);
+    wheel.schedule(3, 10);
+    BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+    auto expired = run(wheel, 9);
+    BOOST_REQUIRE_EQUAL(expired.size(), 1);
+    BOOST_CHECK_EQUAL(expired[0].first, 2);
+    BOOST_CHECK_EQUAL(expired[0].second, 5);
+
+    expired = run(wheel, 10);
+    BOOST_REQUIRE_EQUAL(expired.size(), 2);
+    BOOST_CHECK_EQUAL(expired[0].first, 1);
+    BOOST_CHECK_EQUAL(expired[1].first, 3);
+    BOOST_CHECK(wheel.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_cascades_between_levels) {
+    const Wheel::Time times[] = {63, 64, 65, 4095, 4096, 4097, 300000,
+                                 (Wheel::Time(1) << 24) + 100};
+    Wheel wheel(7);
+    for (int i = 0; i < 8; ++i) {
+        wheel.schedule(i, wheel.getTime() + times[i]);
+    }
+
+    auto expired = run(wheel, wheel.getTime() + times[7] + 10, 97);
+    BOOST_REQUIRE_EQUAL(expired.size(), 8);
+    for (int i = 0; i < 8; ++i) {
+        BOOST_CHECK_EQUAL(expired[i].first, i);
+        // Large steps report the time of the whole advance
+        BOOST_CHECK_GE(expired[i].second, 7 + times[i]);
+        BOOST_CHECK_LT(expired[i].second, 7 + times[i] + 97);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_cascade_on_boundary) {
+    // Items coming down a level exactly when they are due expire that tick
+    Wheel wheel(60);
+    wheel.schedule(1, 128);
+    wheel.schedule(2, 4096);
+    wheel.schedule(3, 8192 + 64);
+
+    auto expired = run(wheel, 9000);
+    BOOST_REQUIRE_EQUAL(expired.size(), 3);
+    BOOST_CHECK_EQUAL(expired[0].second, 128);
+    BOOST_CHECK_EQUAL(expired[1].second, 4096);
+    BOOST_CHECK_EQUAL(expired[2].second, 8192 + 64);
+
+    for (Wheel::Time start = 0; start < 200; start += 13) {
+        Wheel stepped(start);
+        for (int i = 1; i <= 70; ++i) {
+            stepped.schedule(i, Wheel::Time(i) * 64);
+        }
+        for (const auto& e : run(stepped, 70 * 64)) {
+            BOOST_CHECK_EQUAL(e.second,
+                              std::max(Wheel::Time(e.first) * 64, start + 1));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_due_items_expire_next) {
+    Wheel wheel(100);
+    wheel.schedule(1, 50);
+    wheel.schedule(2, 100);
+
+    auto expired = run(wheel, 101);
+    BOOST_REQUIRE_EQUAL(expired.size(), 2);
+    BOOST_CHECK_EQUAL(expired[0].second, 101);
+    BOOST_CHECK_EQUAL(expired[1].second, 101);
+}
+
+BOOST_AUTO_TEST_CASE(test_reschedule_while_expiring) {
+    Wheel wheel;
+    wheel.schedule(1, 10);
+    int runs = 0;
+    wheel.advance(100, [&](int item) {
+        runs++;
+        wheel.schedule(item, wheel.getTime() + 10);
+    });
+    BOOST_CHECK_EQUAL(runs, 10);
+    BOOST_CHECK_EQUAL(wheel.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_drain) {
+    Wheel wheel;
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 1000);
+    wheel.schedule(3, 100000);
+
+    int visited = 0;
+    wheel.forEach([&](int, Wheel::Time) { visited++; });
+    BOOST_CHECK_EQUAL(visited, 3);
+
+    std::vector<std::pair<int, Wheel::Time>> drained;
+    wheel.drain([&](int item, Wheel::Time when) {
+        drained.emplace_back(item, when);
+    });
+    std::sort(drained.begin(), drained.end());
+    BOOST_REQUIRE_EQUAL(drained.size(), 3);
+    BOOST_CHECK_EQUAL(drained[1].first, 2);
+    BOOST_CHECK_EQUAL(drained[1].second, 1000);
+    BOOST_CHECK(wheel.empty());
+    BOOST_CHECK(run(wheel, 200000).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
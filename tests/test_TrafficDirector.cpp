@@ -166,4 +166,23 @@ BOOST_AUTO_TEST_CASE(test_create_traffic) {
 }
 #endif
 
+BOOST_AUTO_TEST_CASE(test_kinematic_simulation) {
+    const float radius = 60.f;
+    // Visible vehicles keep physics up to the radius
+    BOOST_CHECK(!TrafficDirector::useKinematicSimulation(false, 50.f, true,
+                                                         radius));
+    BOOST_CHECK(TrafficDirector::useKinematicSimulation(false, 70.f, true,
+                                                        radius));
+    // Off screen vehicles switch sooner
+    BOOST_CHECK(TrafficDirector::useKinematicSimulation(false, 40.f, false,
+                                                        radius));
+    BOOST_CHECK(!TrafficDirector::useKinematicSimulation(false, 20.f, false,
+                                                         radius));
+    // Switching back needs the vehicle a little closer
+    BOOST_CHECK(TrafficDirector::useKinematicSimulation(true, 58.f, true,
+                                                        radius));
+    BOOST_CHECK(!TrafficDirector::useKinematicSimulation(true, 50.f, true,
+                                                         radius));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,7 @@
 #include <boost/test/unit_test.hpp>
+#include <btBulletDynamicsCommon.h>
 #include <data/Clump.hpp>
+#include <dynamics/CollisionInstance.hpp>
 #include <objects/VehicleObject.hpp>
 #include "test_Globals.hpp"
 
@@ -71,6 +73,30 @@ BOOST_AUTO_TEST_CASE(vehicle_part_vis) {
     Global::get().e->destroyObject(vehicle);
 }
 
+BOOST_AUTO_TEST_CASE(test_kinematic_switch) {
+    VehicleObject* vehicle = Global::get().e->createVehicle(
+        90u, glm::vec3(10.f, 0.f, 0.f), glm::quat{1.0f,0.0f,0.0f,0.0f});
+
+    BOOST_REQUIRE(vehicle != nullptr);
+    auto body = vehicle->collision->getBulletBody();
+
+    vehicle->setKinematic(true);
+    BOOST_CHECK(vehicle->isKinematic());
+    BOOST_CHECK(body->isKinematicObject());
+    // Nobody's driving, so it stays where it is
+    BOOST_CHECK_EQUAL(vehicle->getVelocity(), 0.f);
+    vehicle->tickPhysics(1.f);
+    BOOST_CHECK_CLOSE(vehicle->getPosition().x, 10.f, 0.1f);
+
+    vehicle->setKinematic(false);
+    BOOST_CHECK(!vehicle->isKinematic());
+    BOOST_CHECK(!body->isKinematicObject());
+    BOOST_CHECK_CLOSE(body->getInvMass(), 1.f / vehicle->info->handling.mass,
+                      0.1f);
+
+    Global::get().e->destroyObject(vehicle);
+}
+
 BOOST_AUTO_TEST_CASE(test_door_position) {
     VehicleObject* vehicle = Global::get().e->createVehicle(
         90u, glm::vec3(10.f, 0.f, 0.f), glm::quat{1.0f,0.0f,0.0f,0.0f});
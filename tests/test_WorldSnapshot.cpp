@@ -0,0 +1,84 @@
+#include <boost/test/unit_test.hpp>
+#include <core/Logger.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
+#include <engine/WorldSnapshot.hpp>
+#include <objects/InstanceObject.hpp>
+#include <objects/VehicleObject.hpp>
+#include "test_Globals.hpp"
+
+BOOST_AUTO_TEST_SUITE(WorldSnapshotTests)
+
+BOOST_AUTO_TEST_CASE(test_restore_state) {
+    Logger log;
+    GameData data(&log, ".");
+    GameWorld world(&log, &data);
+    GameState state;
+    world.state = &state;
+    state.world = &world;
+
+    state.playerInfo.money = 100;
+    state.gameTime = 10.f;
+    WorldSnapshot snapshot(world);
+    auto expectedRandom = world.randomEngine();
+
+    state.playerInfo.money = 5000;
+    state.gameTime = 20.f;
+    state.addHospitalRestart(glm::vec4(1.f));
+    snapshot.restore(world);
+
+    BOOST_CHECK_EQUAL(state.playerInfo.money, 100u);
+    BOOST_CHECK_EQUAL(state.gameTime, 10.f);
+    BOOST_CHECK(state.hospitalRestarts.empty());
+    BOOST_CHECK(state.world == &world);
+    BOOST_CHECK_EQUAL(world.randomEngine(), expectedRandom);
+
+    world.state = nullptr;
+}
+
+#if RW_TEST_WITH_DATA
+BOOST_AUTO_TEST_CASE(test_restore_objects) {
+    GameWorld gw(&Global::get().log, Global::get().d);
+    GameState state;
+    gw.state = &state;
+    state.world = &gw;
+
+    auto vehicle = gw.createVehicle(90u, glm::vec3(10.f, 0.f, 0.f));
+    BOOST_REQUIRE(vehicle != nullptr);
+    auto vehicleID = vehicle->getGameObjectID();
+    vehicle->health = 500.f;
+
+    auto moved = gw.createInstance(1337, glm::vec3(100.f, 0.f, 0.f));
+    BOOST_REQUIRE(moved != nullptr);
+    auto movedID = moved->getGameObjectID();
+
+    WorldSnapshot snapshot(gw);
+    BOOST_CHECK_EQUAL(snapshot.getObjectCount(), 2u);
+
+    gw.destroyObject(vehicle);
+    moved->setPosition(glm::vec3(0.f, 0.f, 50.f));
+    auto added = gw.createInstance(1337, glm::vec3(0.f, 100.f, 0.f));
+    BOOST_REQUIRE(added != nullptr);
+
+    snapshot.restore(gw);
+
+    BOOST_CHECK_EQUAL(gw.allObjects.size(), 2u);
+    BOOST_CHECK_EQUAL(gw.instancePool.objects.size(), 1u);
+
+    auto restored =
+        static_cast<VehicleObject*>(gw.vehiclePool.find(vehicleID));
+    BOOST_REQUIRE(restored != nullptr);
+    BOOST_CHECK_EQUAL(restored->getPosition().x, 10.f);
+    BOOST_CHECK_EQUAL(restored->health, 500.f);
+
+    auto instance = gw.instancePool.find(movedID);
+    BOOST_REQUIRE(instance != nullptr);
+    BOOST_CHECK_EQUAL(instance->getPosition().x, 100.f);
+    BOOST_CHECK_EQUAL(instance->getPosition().z, 0.f);
+
+    gw.state = nullptr;
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 #include <data/ZoneData.hpp>
+#include <data/ZoneIndex.hpp>
 #include "test_Globals.hpp"
 
 BOOST_AUTO_TEST_SUITE(ZoneDataTests)
@@ -30,4 +31,68 @@ BOOST_AUTO_TEST_CASE(test_hierarchy) {
     BOOST_CHECK_EQUAL(zone.findLeafAtPoint({ 5.f, 5.f, 0.f}), &leaf);
 
 }
+
+namespace {
+ZoneDataList makeNestedZones() {
+    ZoneDataList zones;
+    zones.emplace_back("ROOT", 0, glm::vec3(-100.f, -100.f, -50.f),
+                       glm::vec3(100.f, 100.f, 50.f), 0, 0, 0);
+    zones.emplace_back("WEST", 0, glm::vec3(-100.f, -100.f, -50.f),
+                       glm::vec3(-5.f, 100.f, 50.f), 0, 0, 0);
+    zones.emplace_back("DOCKS", 0, glm::vec3(-90.f, -90.f, -50.f),
+                       glm::vec3(-40.f, -10.f, 0.f), 0, 0, 0);
+    zones.emplace_back("PIER", 0, glm::vec3(-70.f, -70.f, -50.f),
+                       glm::vec3(-50.f, -50.f, 0.f), 0, 0, 0);
+    zones.emplace_back("EAST", 0, glm::vec3(0.f, -80.f, -50.f),
+                       glm::vec3(90.f, 80.f, 50.f), 0, 0, 0);
+    // Overlaps EAST without being inside it
+    zones.emplace_back("BRIDGE", 0, glm::vec3(-20.f, -10.f, -50.f),
+                       glm::vec3(20.f, 10.f, 50.f), 0, 0, 0);
+    zones.emplace_back("PARK", 0, glm::vec3(37.f, 13.f, -50.f),
+                       glm::vec3(63.5f, 41.f, 50.f), 0, 0, 0);
+    zones.emplace_back("PARK", 0, glm::vec3(60.f, -60.f, -50.f),
+                       glm::vec3(70.f, -50.f, 50.f), 0, 0, 0);
+
+    for (auto& zone : zones) {
+        if (&zone != &zones.front()) {
+            zones.front().insertZone(zone);
+        }
+    }
+    return zones;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_index_matches_hierarchy) {
+    auto zones = makeNestedZones();
+
+    // Cell sizes that don't line up with the zone edges, and one large cell
+    for (float cellSize : {7.f, 25.f, 1000.f}) {
+        ZoneIndex index;
+        index.build(zones, cellSize);
+
+        for (float x = -110.f; x <= 110.f; x += 2.5f) {
+            for (float y = -110.f; y <= 110.f; y += 2.5f) {
+                for (float z : {-50.f, 25.f, 60.f}) {
+                    const glm::vec3 p(x, y, z);
+                    BOOST_CHECK_EQUAL(index.findLeafAt(p),
+                                      zones.front().findLeafAtPoint(p));
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_index_find_by_name) {
+    auto zones = makeNestedZones();
+    ZoneIndex index;
+    index.build(zones);
+
+    BOOST_CHECK_EQUAL(index.findZone("DOCKS"), &zones[2]);
+    BOOST_CHECK_EQUAL(index.findZone("PARK"), &zones[6]);
+    BOOST_CHECK(index.findZone("NOWHERE") == nullptr);
+
+    index.clear();
+    BOOST_CHECK(index.findZone("DOCKS") == nullptr);
+    BOOST_CHECK(index.findLeafAt({0.f, 0.f, 0.f}) == nullptr);
+}
 BOOST_AUTO_TEST_SUITE_END()